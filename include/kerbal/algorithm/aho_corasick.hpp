@@ -0,0 +1,378 @@
+/**
+ * @file       aho_corasick.hpp
+ * @brief
+ * @date       2020-11-16
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_ALGORITHM_AHO_CORASICK_HPP
+#define KERBAL_ALGORITHM_AHO_CORASICK_HPP
+
+#include <kerbal/algorithm/swap.hpp>
+#include <kerbal/compatibility/fixed_width_integer.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/compatibility/static_assert.hpp>
+#include <kerbal/iterator/iterator_traits.hpp>
+#include <kerbal/type_traits/cv_deduction.hpp>
+#include <kerbal/type_traits/fundamental_deduction.hpp>
+#include <kerbal/utility/throw_this_exception.hpp>
+
+#include <cstddef>
+#include <stdexcept>
+
+#include <kerbal/container/vector.hpp>
+
+namespace kerbal
+{
+
+	namespace algorithm
+	{
+
+		/**
+		 * A multi-pattern matcher over bytes: every occurrence of any of the inserted patterns in a text is found
+		 * in a single pass over it, whatever the number of patterns.
+		 *
+		 * build() turns the trie of the patterns into a deterministic automaton, the failure links being folded
+		 * into the transitions, so that each byte of the text costs exactly one lookup. The transitions are one
+		 * flat table: the bytes occurring in no pattern share a single column, the others have one each, and a
+		 * state is stored as the offset of its row. The states where some pattern ends come last, so that telling
+		 * them is a comparison rather than another lookup. The table has (number of states) * (number of distinct
+		 * bytes + 1) entries of 4 bytes, the number of states being at most the total length of the patterns + 1.
+		 * build() throws std::length_error if the table would have 2^32 entries or more.
+		 *
+		 * Empty patterns are given an id but never match.
+		 */
+		class aho_corasick
+		{
+			public:
+				typedef std::size_t							size_type;
+
+			private:
+				typedef kerbal::compatibility::uint32_t		state_type;
+
+				static state_type none() KERBAL_NOEXCEPT
+				{
+					return static_cast<state_type>(-1);
+				}
+
+				kerbal::container::vector<unsigned char> bytes;		// the patterns, one after the other
+				kerbal::container::vector<size_type> offsets;		// where each pattern begins in bytes, and a last end
+
+				unsigned char byte_class[256];						// the column of each byte
+				size_type stride;									// the number of columns
+				kerbal::container::vector<state_type> table;		// stride entries per state
+				state_type match_row;								// the row of the first state where some pattern ends
+				kerbal::container::vector<state_type> first_output;	// the first pattern ending in each state, none if none
+				kerbal::container::vector<state_type> next_output;	// the next pattern ending in the same state as each pattern
+				kerbal::container::vector<state_type> dict_link;	// the longest proper suffix state where some pattern ends
+				bool is_built;
+
+			public:
+				aho_corasick() :
+						bytes(), offsets(1, static_cast<size_type>(0)), stride(0), table(), match_row(0),
+						first_output(), next_output(), dict_link(), is_built(false)
+				{
+				}
+
+				/**
+				 * @return the number of inserted patterns
+				 */
+				size_type size() const KERBAL_NOEXCEPT
+				{
+					return this->offsets.size() - 1;
+				}
+
+				bool empty() const KERBAL_NOEXCEPT
+				{
+					return this->size() == 0;
+				}
+
+				size_type pattern_length(size_type id) const
+				{
+					return this->offsets[id + 1] - this->offsets[id];
+				}
+
+				/**
+				 * @return whether the automaton reflects all the inserted patterns
+				 */
+				bool built() const KERBAL_NOEXCEPT
+				{
+					return this->is_built;
+				}
+
+				/**
+				 * @return the number of states of the automaton
+				 * @pre built()
+				 */
+				size_type state_count() const KERBAL_NOEXCEPT
+				{
+					return this->first_output.size();
+				}
+
+				/**
+				 * @return the id of the pattern, i.e. the number of patterns inserted before it
+				 */
+				template <typename ForwardIterator>
+				size_type insert(ForwardIterator first, ForwardIterator last)
+				{
+					typedef typename kerbal::iterator::iterator_traits<ForwardIterator>::value_type value_type;
+					typedef typename kerbal::type_traits::remove_cv<value_type>::type element_type;
+
+					KERBAL_STATIC_ASSERT(kerbal::type_traits::is_integral<element_type>::value && sizeof(element_type) == 1,
+										"aho_corasick needs patterns of bytes");
+
+					size_type id = this->size();
+					while (first != last) {
+						this->bytes.push_back(static_cast<unsigned char>(*first));
+						++first;
+					}
+					this->offsets.push_back(this->bytes.size());
+					this->is_built = false;
+					return id;
+				}
+
+				void clear() KERBAL_NOEXCEPT
+				{
+					this->bytes.clear();
+					this->offsets.resize(1);
+					this->stride = 0;
+					this->table.clear();
+					this->match_row = 0;
+					this->first_output.clear();
+					this->next_output.clear();
+					this->dict_link.clear();
+					this->is_built = false;
+				}
+
+				void swap(aho_corasick & with) KERBAL_NOEXCEPT
+				{
+					this->bytes.swap(with.bytes);
+					this->offsets.swap(with.offsets);
+					kerbal::algorithm::swap(this->byte_class, with.byte_class);
+					kerbal::algorithm::swap(this->stride, with.stride);
+					this->table.swap(with.table);
+					kerbal::algorithm::swap(this->match_row, with.match_row);
+					this->first_output.swap(with.first_output);
+					this->next_output.swap(with.next_output);
+					this->dict_link.swap(with.dict_link);
+					kerbal::algorithm::swap(this->is_built, with.is_built);
+				}
+
+				/**
+				 * Build the automaton of the inserted patterns. To be called after the insertions and before the
+				 * searches.
+				 */
+				void build()
+				{
+					// not built until the end, should any step throw
+					this->is_built = false;
+					this->build_byte_classes();
+					this->build_trie();
+					this->build_transitions();
+					this->build_renumber();
+					this->is_built = true;
+				}
+
+				/**
+				 * Call handler(id, it) for each occurrence in [first, last), in the order of their ends, where id is
+				 * the id of the pattern and it is the iterator past the end of the occurrence. Among the patterns
+				 * ending at the same position, the longer ones come first.
+				 *
+				 * @pre built()
+				 */
+				template <typename InputIterator, typename MatchHandler>
+				void for_each_match(InputIterator first, InputIterator last, MatchHandler handler) const
+				{
+					const state_type * transitions = this->table.data();
+					state_type s = 0;
+					while (first != last) {
+						s = transitions[s + this->byte_class[static_cast<unsigned char>(*first)]];
+						++first;
+						if (s >= this->match_row) {
+							for (state_type t = static_cast<state_type>(s / this->stride); t != none(); t = this->dict_link[t]) {
+								for (state_type id = this->first_output[t]; id != none(); id = this->next_output[id]) {
+									handler(static_cast<size_type>(id), first);
+								}
+							}
+						}
+					}
+				}
+
+				/**
+				 * Find the occurrence of a pattern in [first, last) which ends first, the longest one among those
+				 * ending at the same position.
+				 *
+				 * @param id  Set to the id of the pattern, left untouched if none.
+				 * @return The iterator past the end of the occurrence, last if none.
+				 * @pre built()
+				 */
+				template <typename InputIterator>
+				InputIterator find(InputIterator first, InputIterator last, size_type & id) const
+				{
+					const state_type * transitions = this->table.data();
+					state_type s = 0;
+					while (first != last) {
+						s = transitions[s + this->byte_class[static_cast<unsigned char>(*first)]];
+						++first;
+						if (s >= this->match_row) {
+							state_type t = static_cast<state_type>(s / this->stride);
+							if (this->first_output[t] == none()) {
+								t = this->dict_link[t];
+							}
+							id = static_cast<size_type>(this->first_output[t]);
+							return first;
+						}
+					}
+					return last;
+				}
+
+			private:
+				void build_byte_classes() KERBAL_NOEXCEPT
+				{
+					bool used[256] = {};
+					for (size_type i = 0; i < this->bytes.size(); ++i) {
+						used[this->bytes[i]] = true;
+					}
+					size_type unused = 0;
+					for (size_type c = 0; c < 256; ++c) {
+						if (!used[c]) {
+							++unused;
+						}
+					}
+					// the unused bytes, if any, are column 0
+					size_type column = unused == 0 ? 0 : 1;
+					for (size_type c = 0; c < 256; ++c) {
+						this->byte_class[c] = static_cast<unsigned char>(used[c] ? column++ : 0);
+					}
+					this->stride = column;
+				}
+
+				/*
+				 * The trie, whose missing edges are none(); the states are numbered, not yet multiplied by the
+				 * stride.
+				 */
+				void build_trie()
+				{
+					this->table.assign(this->stride, none());
+					this->first_output.assign(1, none());
+					this->next_output.assign(this->size(), none());
+
+					// in reverse order, so that the patterns ending in the same state are listed by increasing id
+					for (size_type id = this->size(); id != 0; ) {
+						--id;
+						if (this->offsets[id] == this->offsets[id + 1]) {
+							continue;
+						}
+						state_type s = 0;
+						for (size_type i = this->offsets[id]; i != this->offsets[id + 1]; ++i) {
+							size_type e = s * this->stride + this->byte_class[this->bytes[i]];
+							if (this->table[e] == none()) {
+								// the offsets of the rows, and none(), are to fit in state_type
+								if (this->stride > static_cast<size_type>(none()) - this->table.size()) {
+									kerbal::utility::throw_this_exception_helper<std::length_error>::throw_this_exception((const char*)"aho_corasick is too large");
+								}
+								state_type child = static_cast<state_type>(this->first_output.size());
+								this->table[e] = child;
+								this->table.resize(this->table.size() + this->stride, none());
+								this->first_output.push_back(none());
+							}
+							s = this->table[e];
+						}
+						this->next_output[id] = this->first_output[s];
+						this->first_output[s] = static_cast<state_type>(id);
+					}
+				}
+
+				/*
+				 * Visits the states by increasing depth, so that the row of the failure state of a state is complete
+				 * when the state is visited, and a missing edge is the one of the failure state.
+				 */
+				void build_transitions()
+				{
+					size_type n = this->first_output.size();
+					kerbal::container::vector<state_type> fail(n, 0);
+					kerbal::container::vector<state_type> queue;
+					queue.reserve(n);
+					this->dict_link.assign(n, none());
+
+					for (size_type c = 0; c < this->stride; ++c) {
+						state_type child = this->table[c];
+						if (child == none()) {
+							this->table[c] = 0;
+						} else {
+							queue.push_back(child);
+						}
+					}
+					for (size_type head = 0; head != queue.size(); ++head) {
+						state_type s = queue[head];
+						const size_type row = s * this->stride;
+						const size_type fail_row = fail[s] * this->stride;
+						for (size_type c = 0; c < this->stride; ++c) {
+							state_type child = this->table[row + c];
+							if (child == none()) {
+								this->table[row + c] = this->table[fail_row + c];
+							} else {
+								state_type f = this->table[fail_row + c];
+								fail[child] = f;
+								this->dict_link[child] = this->first_output[f] != none() ? f : this->dict_link[f];
+								queue.push_back(child);
+							}
+						}
+					}
+				}
+
+				/*
+				 * Numbers the states where no pattern ends first, the root staying 0, and turns the state numbers
+				 * of the transitions into the offsets of their rows.
+				 */
+				void build_renumber()
+				{
+					size_type n = this->first_output.size();
+					kerbal::container::vector<state_type> renumber(n, 0);
+					state_type k = 0;
+					for (size_type t = 0; t < n; ++t) {
+						if (this->first_output[t] == none() && this->dict_link[t] == none()) {
+							renumber[t] = k++;
+						}
+					}
+					this->match_row = static_cast<state_type>(k * this->stride);
+					for (size_type t = 0; t < n; ++t) {
+						if (this->first_output[t] != none() || this->dict_link[t] != none()) {
+							renumber[t] = k++;
+						}
+					}
+
+					kerbal::container::vector<state_type> new_table(this->table.size(), 0);
+					kerbal::container::vector<state_type> new_first_output(n, 0);
+					kerbal::container::vector<state_type> new_dict_link(n, 0);
+					for (size_type t = 0; t < n; ++t) {
+						const state_type * from = this->table.data() + t * this->stride;
+						state_type * to = new_table.data() + renumber[t] * this->stride;
+						for (size_type c = 0; c < this->stride; ++c) {
+							to[c] = static_cast<state_type>(renumber[from[c]] * this->stride);
+						}
+						new_first_output[renumber[t]] = this->first_output[t];
+						new_dict_link[renumber[t]] = this->dict_link[t] == none() ? none() : renumber[this->dict_link[t]];
+					}
+					this->table.swap(new_table);
+					this->first_output.swap(new_first_output);
+					this->dict_link.swap(new_dict_link);
+				}
+
+		};
+
+		inline
+		void swap(aho_corasick & lhs, aho_corasick & rhs) KERBAL_NOEXCEPT
+		{
+			lhs.swap(rhs);
+		}
+
+	} // namespace algorithm
+
+} // namespace kerbal
+
+#endif // KERBAL_ALGORITHM_AHO_CORASICK_HPP
@@ -15,9 +15,17 @@
 #include <kerbal/algorithm/binary_type_predicate.hpp>
 #include <kerbal/algorithm/querier.hpp>
 #include <kerbal/compatibility/constexpr.hpp>
+#include <kerbal/compatibility/is_constant_evaluated.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/compatibility/prefetch.hpp>
 #include <kerbal/compatibility/static_assert.hpp>
 #include <kerbal/iterator/iterator.hpp>
+#include <kerbal/iterator/iterator_traits.hpp>
 #include <kerbal/type_traits/cv_deduction.hpp>
+#include <kerbal/type_traits/fundamental_deduction.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+#include <kerbal/type_traits/pointer_deduction.hpp>
+#include <kerbal/utility/addressof.hpp>
 
 
 namespace kerbal
@@ -26,6 +34,96 @@ namespace kerbal
 	namespace algorithm
 	{
 
+		namespace detail
+		{
+
+			/*
+			 * The branchless searches pay off when an element compares in a single instruction, so that the
+			 * ternary of each step is compiled to a conditional move instead of a hard-to-predict branch, and when
+			 * the elements are contiguous in memory, so that the candidates of the next step can be prefetched.
+			 */
+			template <typename RandomAccessIterator>
+			struct binary_search_branchless_enable:
+					kerbal::type_traits::bool_constant<
+						kerbal::iterator::is_contiguous_iterator<RandomAccessIterator>::value && (
+							kerbal::type_traits::is_arithmetic<
+								typename kerbal::iterator::iterator_traits<RandomAccessIterator>::value_type
+							>::value ||
+							kerbal::type_traits::is_pointer<
+								typename kerbal::iterator::iterator_traits<RandomAccessIterator>::value_type
+							>::value
+						)
+					>
+			{
+			};
+
+			template <typename RandomAccessIterator>
+			void binary_search_prefetch(const RandomAccessIterator &, kerbal::type_traits::false_type) KERBAL_NOEXCEPT
+			{
+			}
+
+			template <typename RandomAccessIterator>
+			void binary_search_prefetch(const RandomAccessIterator & it, kerbal::type_traits::true_type)
+			{
+				KERBAL_PREFETCH_READ(kerbal::utility::addressof(*it));
+			}
+
+			template <typename RandomAccessIterator>
+			void binary_search_prefetch(const RandomAccessIterator & it)
+			{
+				binary_search_prefetch(it, kerbal::iterator::is_contiguous_iterator<RandomAccessIterator>());
+			}
+
+			/*
+			 * Every step halves the range without looking at where the answer is, so the number of steps only
+			 * depends on the length. While the middle element is compared, the middles of both halves are
+			 * prefetched: one of them is the next element to be compared.
+			 */
+			template <typename RandomAccessIterator, typename Tp, typename Comparator>
+			RandomAccessIterator
+			lower_bound_branchless(RandomAccessIterator first,
+									typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type len,
+									const Tp & value, Comparator comparator)
+			{
+				typedef typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+
+				if (len == 0) {
+					return first;
+				}
+				while (len > 1) {
+					difference_type half(len >> 1);
+					binary_search_prefetch(first + (half >> 1));
+					binary_search_prefetch(first + (half + (half >> 1)));
+					first = static_cast<bool>(comparator(first[half], value)) ? first + half : first;
+					len -= half;
+				}
+				return static_cast<bool>(comparator(*first, value)) ? first + 1 : first;
+			}
+
+			template <typename RandomAccessIterator, typename Tp, typename Comparator>
+			RandomAccessIterator
+			upper_bound_branchless(RandomAccessIterator first,
+									typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type len,
+									const Tp & value, Comparator comparator)
+			{
+				typedef typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+
+				if (len == 0) {
+					return first;
+				}
+				while (len > 1) {
+					difference_type half(len >> 1);
+					binary_search_prefetch(first + (half >> 1));
+					binary_search_prefetch(first + (half + (half >> 1)));
+					first = static_cast<bool>(comparator(value, first[half])) ? first : first + half;
+					len -= half;
+				}
+				return static_cast<bool>(comparator(value, *first)) ? first : first + 1;
+			}
+
+		} // namespace detail
+
+
 		template <typename ForwardIterator, typename Tp, typename Comparator>
 		KERBAL_CONSTEXPR14
 		ForwardIterator
@@ -63,6 +161,11 @@ namespace kerbal
 
 			difference_type len(kerbal::iterator::distance(first, last));
 
+			if (kerbal::algorithm::detail::binary_search_branchless_enable<iterator>::value &&
+				KERBAL_CONSTEXPR14_RUNTIME_PATH()) {
+				return kerbal::algorithm::detail::lower_bound_branchless(first, len, value, comparator);
+			}
+
 			while (len > 0) {
 				difference_type half(len >> 1);
 				iterator middle(kerbal::iterator::next(first, half));
@@ -99,6 +202,109 @@ namespace kerbal
 
 
 
+		template <typename ForwardIterator, typename ForwardIterator2, typename OutputIterator, typename Comparator>
+		OutputIterator
+		__lower_bound_batch(ForwardIterator first, ForwardIterator last,
+							ForwardIterator2 keys_first, ForwardIterator2 keys_last, OutputIterator out,
+							Comparator comparator, std::forward_iterator_tag)
+		{
+			while (keys_first != keys_last) {
+				*out = kerbal::algorithm::lower_bound(first, last, *keys_first, comparator);
+				++out;
+				++keys_first;
+			}
+			return out;
+		}
+
+		/*
+		 * The searches of a batch run in lockstep over the same range. As a branchless search takes a number of
+		 * steps that only depends on the length of the range, all of them step together: the loads of one step
+		 * are independent of each other, so their cache misses overlap instead of being paid one after another.
+		 */
+		template <typename RandomAccessIterator, typename ForwardIterator, typename OutputIterator, typename Comparator>
+		OutputIterator
+		__lower_bound_batch(RandomAccessIterator first, RandomAccessIterator last,
+							ForwardIterator keys_first, ForwardIterator keys_last, OutputIterator out,
+							Comparator comparator, std::random_access_iterator_tag)
+		{
+			typedef typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+			typedef typename kerbal::iterator::iterator_traits<ForwardIterator>::value_type key_type;
+
+			enum
+			{
+				LANES = 8
+			};
+
+			difference_type len(kerbal::iterator::distance(first, last));
+			const key_type * keys[LANES];
+			difference_type bases[LANES];
+
+			while (keys_first != keys_last) {
+				int lanes = 0;
+				while (lanes < LANES && keys_first != keys_last) {
+					keys[lanes] = kerbal::utility::addressof(*keys_first);
+					bases[lanes] = 0;
+					++lanes;
+					++keys_first;
+				}
+				if (len != 0) {
+					difference_type n(len);
+					while (n > 1) {
+						difference_type half(n >> 1);
+						for (int i = 0; i < lanes; ++i) {
+							kerbal::algorithm::detail::binary_search_prefetch(first + (bases[i] + (half >> 1)));
+							kerbal::algorithm::detail::binary_search_prefetch(first + (bases[i] + half + (half >> 1)));
+						}
+						for (int i = 0; i < lanes; ++i) {
+							bases[i] += static_cast<bool>(comparator(first[bases[i] + half], *keys[i])) ? half : 0;
+						}
+						n -= half;
+					}
+					for (int i = 0; i < lanes; ++i) {
+						bases[i] += static_cast<bool>(comparator(first[bases[i]], *keys[i])) ? 1 : 0;
+					}
+				}
+				for (int i = 0; i < lanes; ++i) {
+					*out = first + bases[i];
+					++out;
+				}
+			}
+			return out;
+		}
+
+		/**
+		 * Writes lower_bound(first, last, key, comparator) of every key of [keys_first, keys_last) to out, in
+		 * the order of the keys. The keys need not be sorted.
+		 *
+		 * Over a random access range the searches are interleaved, which hides the memory latency of a big
+		 * range far better than a loop of lower_bound does.
+		 *
+		 * @param comparator requires: comparator(value_type, key_type)
+		 * @return the end of the output range
+		 */
+		template <typename ForwardIterator, typename ForwardIterator2, typename OutputIterator, typename Comparator>
+		OutputIterator
+		lower_bound_batch(ForwardIterator first, ForwardIterator last,
+						  ForwardIterator2 keys_first, ForwardIterator2 keys_last, OutputIterator out,
+						  Comparator comparator)
+		{
+			return kerbal::algorithm::__lower_bound_batch(first, last, keys_first, keys_last, out, comparator,
+															kerbal::iterator::iterator_category(first));
+		}
+
+		template <typename ForwardIterator, typename ForwardIterator2, typename OutputIterator>
+		OutputIterator
+		lower_bound_batch(ForwardIterator first, ForwardIterator last,
+						  ForwardIterator2 keys_first, ForwardIterator2 keys_last, OutputIterator out)
+		{
+			typedef typename kerbal::iterator::iterator_traits<ForwardIterator>::value_type type;
+			typedef typename kerbal::iterator::iterator_traits<ForwardIterator2>::value_type key_type;
+			return kerbal::algorithm::lower_bound_batch(first, last, keys_first, keys_last, out,
+														kerbal::algorithm::binary_type_less<type, key_type>());
+		}
+
+
+
 		template <typename BidirectionalIterator, typename Tp, typename Comparator>
 		KERBAL_CONSTEXPR14
 		BidirectionalIterator
@@ -150,6 +356,11 @@ namespace kerbal
 
 			difference_type len(kerbal::iterator::distance(first, last));
 
+			if (kerbal::algorithm::detail::binary_search_branchless_enable<iterator>::value &&
+				KERBAL_CONSTEXPR14_RUNTIME_PATH()) {
+				return kerbal::algorithm::detail::upper_bound_branchless(first, len, value, comparator);
+			}
+
 			while (len > 0) {
 				difference_type half(len >> 1);
 				iterator middle(kerbal::iterator::next(first, half));
@@ -0,0 +1,396 @@
+/**
+ * @file       modifier_simd.hpp
+ * @brief
+ * @date       2020-11-14
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_ALGORITHM_DETAIL_MODIFIER_SIMD_HPP
+#define KERBAL_ALGORITHM_DETAIL_MODIFIER_SIMD_HPP
+
+#include <kerbal/algorithm/detail/modifier_x86_kernel.hpp>
+
+#include <kerbal/compatibility/fixed_width_integer.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/compatibility/noinline.hpp>
+#include <kerbal/compatibility/x86_cpu_feature.hpp>
+#include <kerbal/config/x86_intrinsics.hpp>
+#include <kerbal/iterator/iterator_traits.hpp>
+#include <kerbal/type_traits/conditional.hpp>
+#include <kerbal/type_traits/fundamental_deduction.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+#include <kerbal/type_traits/is_same.hpp>
+#include <kerbal/type_traits/is_trivially_copyable.hpp>
+#include <kerbal/type_traits/reference_deduction.hpp>
+#include <kerbal/type_traits/volatile_deduction.hpp>
+#include <kerbal/utility/addressof.hpp>
+
+#include <cstddef>
+#include <cstring>
+
+
+/*
+ * The copies and the fills of at least this many bytes are done with non-temporal stores, which do not
+ * pollute the caches with the destination. It is meant to be about the size of the last level cache.
+ */
+#ifndef KERBAL_ALGORITHM_NON_TEMPORAL_THRESHOLD
+#	define KERBAL_ALGORITHM_NON_TEMPORAL_THRESHOLD (static_cast<std::size_t>(1) << 22u)
+#endif
+
+
+namespace kerbal
+{
+
+	namespace algorithm
+	{
+
+		namespace detail
+		{
+
+			/*
+			 * Whether the elements of a range may be read and written as bytes: contiguous, not volatile and
+			 * trivially copyable.
+			 */
+			template <typename ContiguousIterator>
+			struct modifier_simd_bytes_helper
+			{
+					typedef typename kerbal::iterator::iterator_traits<ContiguousIterator>::value_type value_type;
+					typedef typename kerbal::iterator::iterator_traits<ContiguousIterator>::reference reference;
+
+					typedef kerbal::type_traits::bool_constant<
+							kerbal::iterator::is_contiguous_iterator<ContiguousIterator>::value &&
+							!kerbal::type_traits::is_volatile<
+								typename kerbal::type_traits::remove_reference<reference>::type
+							>::value &&
+							kerbal::type_traits::is_trivially_copyable<value_type>::value
+					> ACCEPTABLE;
+			};
+
+			/*
+			 * copy, copy_backward, move and move_backward are memmove when both ranges hold the same trivially
+			 * copyable type.
+			 */
+			template <typename InputIterator, typename OutputIterator, typename InputIteratorEnd = InputIterator>
+			struct modifier_simd_copy_enable:
+					kerbal::type_traits::bool_constant<
+						modifier_simd_bytes_helper<InputIterator>::ACCEPTABLE::value &&
+						modifier_simd_bytes_helper<OutputIterator>::ACCEPTABLE::value &&
+						kerbal::type_traits::is_same<
+							typename modifier_simd_bytes_helper<InputIterator>::value_type,
+							typename modifier_simd_bytes_helper<OutputIterator>::value_type
+						>::value &&
+						kerbal::type_traits::is_same<InputIterator, InputIteratorEnd>::value
+					>
+			{
+			};
+
+			/*
+			 * fill writes the bytes of the value converted to the element type, when the assignment is nothing
+			 * else: the same type, or the conversion between arithmetic types.
+			 */
+			template <typename ContiguousIterator, typename Tp>
+			struct modifier_simd_fill_enable:
+					kerbal::type_traits::bool_constant<
+						modifier_simd_bytes_helper<ContiguousIterator>::ACCEPTABLE::value && (
+							kerbal::type_traits::is_same<
+								Tp, typename modifier_simd_bytes_helper<ContiguousIterator>::value_type
+							>::value || (
+								kerbal::type_traits::is_arithmetic<Tp>::value &&
+								!kerbal::type_traits::is_volatile<Tp>::value &&
+								kerbal::type_traits::is_arithmetic<
+									typename modifier_simd_bytes_helper<ContiguousIterator>::value_type
+								>::value
+							)
+						)
+					>
+			{
+			};
+
+			/*
+			 * The element type the vectorized iota computes a value_type in, void for the types it does not accept.
+			 * The integers are computed as the unsigned ones of the same size, whose wrap around is what the
+			 * processor does.
+			 */
+			template <typename Tp>
+			struct modifier_simd_iota_lane
+			{
+					typedef typename kerbal::type_traits::conditional<
+						kerbal::type_traits::is_integral<Tp>::value && sizeof(Tp) == 4,
+						kerbal::compatibility::uint32_t,
+						typename kerbal::type_traits::conditional<
+							kerbal::type_traits::is_integral<Tp>::value && sizeof(Tp) == 8,
+							kerbal::compatibility::uint64_t,
+							void
+						>::type
+					>::type type;
+			};
+
+			template <>
+			struct modifier_simd_iota_lane<float>
+			{
+					typedef float type;
+			};
+
+			template <>
+			struct modifier_simd_iota_lane<double>
+			{
+					typedef double type;
+			};
+
+			template <typename ContiguousIterator, typename Tp>
+			struct modifier_simd_iota_enable:
+					kerbal::type_traits::bool_constant<
+						KERBAL_X86_INTRINSICS_SUPPORTED &&
+						modifier_simd_bytes_helper<ContiguousIterator>::ACCEPTABLE::value &&
+						kerbal::type_traits::is_same<
+							Tp, typename modifier_simd_bytes_helper<ContiguousIterator>::value_type
+						>::value &&
+						!kerbal::type_traits::is_same<typename modifier_simd_iota_lane<Tp>::type, void>::value
+					>
+			{
+			};
+
+
+
+			/*
+			 * Not inlined, the compilers would warn that the path for the huge sizes overflows the small objects
+			 * of the callers.
+			 */
+			inline KERBAL_NOINLINE
+			void modifier_simd_memmove(void * to, const void * from, std::size_t n) KERBAL_NOEXCEPT
+			{
+
+#	if KERBAL_X86_INTRINSICS_SUPPORTED
+
+				if (n >= KERBAL_ALGORITHM_NON_TEMPORAL_THRESHOLD) {
+					unsigned char * d = static_cast<unsigned char *>(to);
+					const unsigned char * s = static_cast<const unsigned char *>(from);
+					if ((d + n <= s || s + n <= d) && kerbal::compatibility::x86_cpu_feature::instance().sse2) {
+						modifier_stream_copy_sse2(d, s, n);
+						return;
+					}
+				}
+
+#	endif
+
+				std::memmove(to, from, n);
+			}
+
+			/*
+			 * Fills n objects of size bytes from p with the bytes of value: memset if all of them are the same,
+			 * the vectorized repetition of the pattern otherwise.
+			 * @return false if it is not done, for a size which does not divide the width of the vectors or
+			 *         without the x86 instruction sets
+			 * Not inlined for the same reason as modifier_simd_memmove.
+			 */
+			inline KERBAL_NOINLINE
+			bool modifier_simd_fill_bytes(unsigned char * p, std::size_t n,
+											const unsigned char * value, std::size_t size) KERBAL_NOEXCEPT
+			{
+				bool uniform = true;
+				for (std::size_t i = 1; i < size; ++i) {
+					if (value[i] != value[0]) {
+						uniform = false;
+						break;
+					}
+				}
+				std::size_t bytes = n * size;
+
+#	if KERBAL_X86_INTRINSICS_SUPPORTED
+
+				bool stream = bytes >= KERBAL_ALGORITHM_NON_TEMPORAL_THRESHOLD &&
+								reinterpret_cast<std::size_t>(p) % size == 0;
+				if (16 % size == 0 && (stream || !uniform) &&
+						kerbal::compatibility::x86_cpu_feature::instance().sse2) {
+					unsigned char pattern[16];
+					for (std::size_t i = 0; i < 16; ++i) {
+						pattern[i] = value[i % size];
+					}
+					modifier_fill_sse2(p, bytes, pattern, stream);
+					return true;
+				}
+
+#	endif
+
+				if (uniform) {
+					std::memset(p, value[0], bytes);
+					return true;
+				}
+				return false;
+			}
+
+			/*
+			 * Whether value, value + 1, ..., value + n - 1 are all exact, so that they may be computed in any order.
+			 * The integers wrap around, the floating points have to hold integers below 2 ** digits.
+			 */
+			template <typename Tp>
+			bool modifier_simd_iota_exact(Tp /*value*/, std::size_t /*n*/) KERBAL_NOEXCEPT
+			{
+				return true;
+			}
+
+			inline
+			bool modifier_simd_iota_exact(float value, std::size_t n) KERBAL_NOEXCEPT
+			{
+				const float limit = 16777216.0f; // 2 ** 24
+				if (!(-limit < value && value < limit)) { // also excludes NaN
+					return false;
+				}
+				if (static_cast<float>(static_cast<long>(value)) != value) {
+					return false;
+				}
+				return static_cast<double>(n) < static_cast<double>(limit) - static_cast<double>(value);
+			}
+
+			inline
+			bool modifier_simd_iota_exact(double value, std::size_t n) KERBAL_NOEXCEPT
+			{
+				const double limit = 9007199254740992.0; // 2 ** 53
+				if (!(-limit < value && value < limit)) { // also excludes NaN
+					return false;
+				}
+				if (static_cast<double>(static_cast<long long>(value)) != value) {
+					return false;
+				}
+				return static_cast<double>(n) < limit - value;
+			}
+
+#	if KERBAL_X86_INTRINSICS_SUPPORTED
+
+			template <typename Tp>
+			bool modifier_simd_iota(unsigned char * p, std::size_t n, Tp value) KERBAL_NOEXCEPT
+			{
+				const kerbal::compatibility::x86_cpu_feature & feature = kerbal::compatibility::x86_cpu_feature::instance();
+				if (feature.avx2) {
+					modifier_iota_avx2(p, n, value);
+					return true;
+				}
+				if (feature.sse2) {
+					modifier_iota_sse2(p, n, value);
+					return true;
+				}
+				return false;
+			}
+
+#	endif
+
+
+
+			/*
+			 * The entries of modifier.hpp. Each one takes the result of its enable trait, the false_type overloads
+			 * are never called and only keep the portable functions compiling for any type.
+			 */
+
+			template <typename InputIterator, typename InputIteratorEnd, typename OutputIterator>
+			OutputIterator
+			modifier_simd_copy(InputIterator /*first*/, InputIteratorEnd /*last*/, OutputIterator to,
+								kerbal::type_traits::false_type) KERBAL_NOEXCEPT
+			{
+				return to;
+			}
+
+			template <typename InputIterator, typename InputIteratorEnd, typename OutputIterator>
+			OutputIterator
+			modifier_simd_copy(InputIterator first, InputIteratorEnd last, OutputIterator to,
+								kerbal::type_traits::true_type) KERBAL_NOEXCEPT
+			{
+				typedef typename kerbal::iterator::iterator_traits<InputIterator>::value_type value_type;
+
+				if (first == last) {
+					return to;
+				}
+				std::size_t n = static_cast<std::size_t>(last - first);
+				modifier_simd_memmove(kerbal::utility::addressof(*to), kerbal::utility::addressof(*first),
+										n * sizeof(value_type));
+				return to + (last - first);
+			}
+
+			template <typename BidirectionalIterator, typename OutputIterator>
+			OutputIterator
+			modifier_simd_copy_backward(BidirectionalIterator /*first*/, BidirectionalIterator /*last*/,
+										OutputIterator to_last, kerbal::type_traits::false_type) KERBAL_NOEXCEPT
+			{
+				return to_last;
+			}
+
+			template <typename BidirectionalIterator, typename OutputIterator>
+			OutputIterator
+			modifier_simd_copy_backward(BidirectionalIterator first, BidirectionalIterator last,
+										OutputIterator to_last, kerbal::type_traits::true_type) KERBAL_NOEXCEPT
+			{
+				typedef typename kerbal::iterator::iterator_traits<BidirectionalIterator>::value_type value_type;
+
+				if (first == last) {
+					return to_last;
+				}
+				std::size_t n = static_cast<std::size_t>(last - first);
+				OutputIterator to_first(to_last - (last - first));
+				modifier_simd_memmove(kerbal::utility::addressof(*to_first), kerbal::utility::addressof(*first),
+										n * sizeof(value_type));
+				return to_first;
+			}
+
+			template <typename ContiguousIterator, typename Tp>
+			bool modifier_simd_fill(ContiguousIterator /*first*/, ContiguousIterator /*last*/, const Tp & /*val*/,
+									kerbal::type_traits::false_type) KERBAL_NOEXCEPT
+			{
+				return false;
+			}
+
+			template <typename ContiguousIterator, typename Tp>
+			bool modifier_simd_fill(ContiguousIterator first, ContiguousIterator last, const Tp & val,
+									kerbal::type_traits::true_type) KERBAL_NOEXCEPT
+			{
+				typedef typename kerbal::iterator::iterator_traits<ContiguousIterator>::value_type value_type;
+
+				if (first == last) {
+					return true;
+				}
+				const value_type & v = val; // converted once, as each assignment would do
+				return modifier_simd_fill_bytes(
+							reinterpret_cast<unsigned char *>(kerbal::utility::addressof(*first)),
+							static_cast<std::size_t>(last - first),
+							reinterpret_cast<const unsigned char *>(kerbal::utility::addressof(v)),
+							sizeof(value_type));
+			}
+
+			template <typename ContiguousIterator, typename Tp>
+			bool modifier_simd_iota(ContiguousIterator /*first*/, ContiguousIterator /*last*/, const Tp & /*value*/,
+									kerbal::type_traits::false_type) KERBAL_NOEXCEPT
+			{
+				return false;
+			}
+
+#	if KERBAL_X86_INTRINSICS_SUPPORTED
+
+			template <typename ContiguousIterator, typename Tp>
+			bool modifier_simd_iota(ContiguousIterator first, ContiguousIterator last, const Tp & value,
+									kerbal::type_traits::true_type) KERBAL_NOEXCEPT
+			{
+				typedef typename modifier_simd_iota_lane<Tp>::type lane_type;
+
+				if (last - first < 16) {
+					return false;
+				}
+				std::size_t n = static_cast<std::size_t>(last - first);
+				if (!modifier_simd_iota_exact(value, n)) {
+					return false;
+				}
+				return modifier_simd_iota(
+							reinterpret_cast<unsigned char *>(kerbal::utility::addressof(*first)),
+							n, static_cast<lane_type>(value));
+			}
+
+#	endif
+
+		} // namespace detail
+
+	} // namespace algorithm
+
+} // namespace kerbal
+
+#endif // KERBAL_ALGORITHM_DETAIL_MODIFIER_SIMD_HPP
@@ -0,0 +1,430 @@
+/**
+ * @file       modifier_x86_kernel.hpp
+ * @brief
+ * @date       2020-11-14
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_ALGORITHM_DETAIL_MODIFIER_X86_KERNEL_HPP
+#define KERBAL_ALGORITHM_DETAIL_MODIFIER_X86_KERNEL_HPP
+
+#include <kerbal/compatibility/fixed_width_integer.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/config/x86_intrinsics.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+
+#include <cstddef>
+#include <cstring>
+
+namespace kerbal
+{
+
+	namespace algorithm
+	{
+
+		namespace detail
+		{
+
+#	if KERBAL_X86_INTRINSICS_SUPPORTED
+
+			/*
+			 * Copies n bytes with non-temporal stores, which bypass the caches: a copy larger than the last level
+			 * cache would otherwise evict all of it for data the caller is not going to read soon.
+			 * pre: [d, d + n) and [s, s + n) do not overlap
+			 */
+			KERBAL_X86_TARGET("sse2")
+			inline
+			void modifier_stream_copy_sse2(unsigned char * d, const unsigned char * s, std::size_t n) KERBAL_NOEXCEPT
+			{
+				std::size_t head = (16u - (reinterpret_cast<std::size_t>(d) & 15u)) & 15u;
+				if (head > n) {
+					head = n;
+				}
+				std::memcpy(d, s, head);
+				d += head;
+				s += head;
+				n -= head;
+				while (n >= 64) {
+					__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s));
+					__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + 16));
+					__m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + 32));
+					__m128i e = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + 48));
+					_mm_stream_si128(reinterpret_cast<__m128i *>(d), a);
+					_mm_stream_si128(reinterpret_cast<__m128i *>(d + 16), b);
+					_mm_stream_si128(reinterpret_cast<__m128i *>(d + 32), c);
+					_mm_stream_si128(reinterpret_cast<__m128i *>(d + 48), e);
+					d += 64;
+					s += 64;
+					n -= 64;
+				}
+				while (n >= 16) {
+					_mm_stream_si128(reinterpret_cast<__m128i *>(d), _mm_loadu_si128(reinterpret_cast<const __m128i *>(s)));
+					d += 16;
+					s += 16;
+					n -= 16;
+				}
+				_mm_sfence();
+				std::memcpy(d, s, n);
+			}
+
+			/*
+			 * Fills n bytes with the repetition of a 16 bytes pattern, with non-temporal stores if stream.
+			 * pre: the period of the pattern divides 16, and also the address of p if stream (the stores are
+			 *      aligned by writing some periods first)
+			 */
+			KERBAL_X86_TARGET("sse2")
+			inline
+			void modifier_fill_sse2(unsigned char * p, std::size_t n, const unsigned char * pattern,
+									bool stream) KERBAL_NOEXCEPT
+			{
+				const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pattern));
+				if (stream) {
+					std::size_t head = (16u - (reinterpret_cast<std::size_t>(p) & 15u)) & 15u;
+					if (head > n) {
+						head = n;
+					}
+					std::memcpy(p, pattern, head);
+					p += head;
+					n -= head;
+					while (n >= 64) {
+						_mm_stream_si128(reinterpret_cast<__m128i *>(p), v);
+						_mm_stream_si128(reinterpret_cast<__m128i *>(p + 16), v);
+						_mm_stream_si128(reinterpret_cast<__m128i *>(p + 32), v);
+						_mm_stream_si128(reinterpret_cast<__m128i *>(p + 48), v);
+						p += 64;
+						n -= 64;
+					}
+					while (n >= 16) {
+						_mm_stream_si128(reinterpret_cast<__m128i *>(p), v);
+						p += 16;
+						n -= 16;
+					}
+					_mm_sfence();
+				} else {
+					while (n >= 64) {
+						_mm_storeu_si128(reinterpret_cast<__m128i *>(p), v);
+						_mm_storeu_si128(reinterpret_cast<__m128i *>(p + 16), v);
+						_mm_storeu_si128(reinterpret_cast<__m128i *>(p + 32), v);
+						_mm_storeu_si128(reinterpret_cast<__m128i *>(p + 48), v);
+						p += 64;
+						n -= 64;
+					}
+					while (n >= 16) {
+						_mm_storeu_si128(reinterpret_cast<__m128i *>(p), v);
+						p += 16;
+						n -= 16;
+					}
+				}
+				std::memcpy(p, pattern, n);
+			}
+
+			/*
+			 * Lanes of a vector register for iota, one specialization per element type:
+			 *  - load, store: unaligned
+			 *  - add: lane-wise, wrapping for the integers
+			 */
+			template <typename Tp>
+			struct modifier_sse2_lane;
+
+			template <>
+			struct modifier_sse2_lane<kerbal::compatibility::uint32_t>
+			{
+					typedef kerbal::compatibility::uint32_t value_type;
+					typedef __m128i vec;
+					typedef kerbal::type_traits::integral_constant<std::size_t, 4> WIDTH;
+
+					KERBAL_X86_TARGET("sse2")
+					static vec load(const value_type * p) KERBAL_NOEXCEPT
+					{
+						return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+					}
+
+					KERBAL_X86_TARGET("sse2")
+					static void store(void * p, vec x) KERBAL_NOEXCEPT
+					{
+						_mm_storeu_si128(static_cast<__m128i *>(p), x);
+					}
+
+					KERBAL_X86_TARGET("sse2")
+					static vec add(vec a, vec b) KERBAL_NOEXCEPT
+					{
+						return _mm_add_epi32(a, b);
+					}
+			};
+
+			template <>
+			struct modifier_sse2_lane<kerbal::compatibility::uint64_t>
+			{
+					typedef kerbal::compatibility::uint64_t value_type;
+					typedef __m128i vec;
+					typedef kerbal::type_traits::integral_constant<std::size_t, 2> WIDTH;
+
+					KERBAL_X86_TARGET("sse2")
+					static vec load(const value_type * p) KERBAL_NOEXCEPT
+					{
+						return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+					}
+
+					KERBAL_X86_TARGET("sse2")
+					static void store(void * p, vec x) KERBAL_NOEXCEPT
+					{
+						_mm_storeu_si128(static_cast<__m128i *>(p), x);
+					}
+
+					KERBAL_X86_TARGET("sse2")
+					static vec add(vec a, vec b) KERBAL_NOEXCEPT
+					{
+						return _mm_add_epi64(a, b);
+					}
+			};
+
+			template <>
+			struct modifier_sse2_lane<float>
+			{
+					typedef float value_type;
+					typedef __m128 vec;
+					typedef kerbal::type_traits::integral_constant<std::size_t, 4> WIDTH;
+
+					KERBAL_X86_TARGET("sse2")
+					static vec load(const value_type * p) KERBAL_NOEXCEPT
+					{
+						return _mm_loadu_ps(p);
+					}
+
+					KERBAL_X86_TARGET("sse2")
+					static void store(void * p, vec x) KERBAL_NOEXCEPT
+					{
+						_mm_storeu_ps(static_cast<float *>(p), x);
+					}
+
+					KERBAL_X86_TARGET("sse2")
+					static vec add(vec a, vec b) KERBAL_NOEXCEPT
+					{
+						return _mm_add_ps(a, b);
+					}
+			};
+
+			template <>
+			struct modifier_sse2_lane<double>
+			{
+					typedef double value_type;
+					typedef __m128d vec;
+					typedef kerbal::type_traits::integral_constant<std::size_t, 2> WIDTH;
+
+					KERBAL_X86_TARGET("sse2")
+					static vec load(const value_type * p) KERBAL_NOEXCEPT
+					{
+						return _mm_loadu_pd(p);
+					}
+
+					KERBAL_X86_TARGET("sse2")
+					static void store(void * p, vec x) KERBAL_NOEXCEPT
+					{
+						_mm_storeu_pd(static_cast<double *>(p), x);
+					}
+
+					KERBAL_X86_TARGET("sse2")
+					static vec add(vec a, vec b) KERBAL_NOEXCEPT
+					{
+						return _mm_add_pd(a, b);
+					}
+			};
+
+			template <typename Tp>
+			struct modifier_avx2_lane;
+
+			template <>
+			struct modifier_avx2_lane<kerbal::compatibility::uint32_t>
+			{
+					typedef kerbal::compatibility::uint32_t value_type;
+					typedef __m256i vec;
+					typedef kerbal::type_traits::integral_constant<std::size_t, 8> WIDTH;
+
+					KERBAL_X86_TARGET("avx2")
+					static vec load(const value_type * p) KERBAL_NOEXCEPT
+					{
+						return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+					}
+
+					KERBAL_X86_TARGET("avx2")
+					static void store(void * p, vec x) KERBAL_NOEXCEPT
+					{
+						_mm256_storeu_si256(static_cast<__m256i *>(p), x);
+					}
+
+					KERBAL_X86_TARGET("avx2")
+					static vec add(vec a, vec b) KERBAL_NOEXCEPT
+					{
+						return _mm256_add_epi32(a, b);
+					}
+			};
+
+			template <>
+			struct modifier_avx2_lane<kerbal::compatibility::uint64_t>
+			{
+					typedef kerbal::compatibility::uint64_t value_type;
+					typedef __m256i vec;
+					typedef kerbal::type_traits::integral_constant<std::size_t, 4> WIDTH;
+
+					KERBAL_X86_TARGET("avx2")
+					static vec load(const value_type * p) KERBAL_NOEXCEPT
+					{
+						return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+					}
+
+					KERBAL_X86_TARGET("avx2")
+					static void store(void * p, vec x) KERBAL_NOEXCEPT
+					{
+						_mm256_storeu_si256(static_cast<__m256i *>(p), x);
+					}
+
+					KERBAL_X86_TARGET("avx2")
+					static vec add(vec a, vec b) KERBAL_NOEXCEPT
+					{
+						return _mm256_add_epi64(a, b);
+					}
+			};
+
+			template <>
+			struct modifier_avx2_lane<float>
+			{
+					typedef float value_type;
+					typedef __m256 vec;
+					typedef kerbal::type_traits::integral_constant<std::size_t, 8> WIDTH;
+
+					KERBAL_X86_TARGET("avx2")
+					static vec load(const value_type * p) KERBAL_NOEXCEPT
+					{
+						return _mm256_loadu_ps(p);
+					}
+
+					KERBAL_X86_TARGET("avx2")
+					static void store(void * p, vec x) KERBAL_NOEXCEPT
+					{
+						_mm256_storeu_ps(static_cast<float *>(p), x);
+					}
+
+					KERBAL_X86_TARGET("avx2")
+					static vec add(vec a, vec b) KERBAL_NOEXCEPT
+					{
+						return _mm256_add_ps(a, b);
+					}
+			};
+
+			template <>
+			struct modifier_avx2_lane<double>
+			{
+					typedef double value_type;
+					typedef __m256d vec;
+					typedef kerbal::type_traits::integral_constant<std::size_t, 4> WIDTH;
+
+					KERBAL_X86_TARGET("avx2")
+					static vec load(const value_type * p) KERBAL_NOEXCEPT
+					{
+						return _mm256_loadu_pd(p);
+					}
+
+					KERBAL_X86_TARGET("avx2")
+					static void store(void * p, vec x) KERBAL_NOEXCEPT
+					{
+						_mm256_storeu_pd(static_cast<double *>(p), x);
+					}
+
+					KERBAL_X86_TARGET("avx2")
+					static vec add(vec a, vec b) KERBAL_NOEXCEPT
+					{
+						return _mm256_add_pd(a, b);
+					}
+			};
+
+			/*
+			 * Writes value, value + 1, ... to the n elements from p. Four vectors are kept apart so that the
+			 * latency of the additions is hidden behind the stores.
+			 * The first lanes are incremented one by one as iota does, the other ones are reached by adding the
+			 * multiples of the width, which gives the same result as long as the values are exact (always for
+			 * the integers).
+			 */
+#	define KERBAL_MODIFIER_IOTA_KERNEL_BODY(LANE) \
+				typedef LANE lane; \
+				typedef typename lane::vec vec; \
+				const std::size_t width = lane::WIDTH::value; \
+ \
+				Tp buffer[4 * lane::WIDTH::value]; \
+				for (std::size_t i = 0; i < 4 * width; ++i) { \
+					buffer[i] = value; \
+					++value; \
+				} \
+				vec v0 = lane::load(buffer); \
+				vec v1 = lane::load(buffer + width); \
+				vec v2 = lane::load(buffer + 2 * width); \
+				vec v3 = lane::load(buffer + 3 * width); \
+				for (std::size_t i = 0; i < width; ++i) { \
+					buffer[i] = static_cast<Tp>(4 * width); \
+				} \
+				const vec step4 = lane::load(buffer); \
+				while (n >= 4 * width) { \
+					lane::store(p, v0); \
+					lane::store(p + width * sizeof(Tp), v1); \
+					lane::store(p + 2 * width * sizeof(Tp), v2); \
+					lane::store(p + 3 * width * sizeof(Tp), v3); \
+					v0 = lane::add(v0, step4); \
+					v1 = lane::add(v1, step4); \
+					v2 = lane::add(v2, step4); \
+					v3 = lane::add(v3, step4); \
+					p += 4 * width * sizeof(Tp); \
+					n -= 4 * width; \
+				} \
+				/* at most 3 whole vectors remain, v0, v1, v2 hold their values */ \
+				if (n >= width) { \
+					lane::store(p, v0); \
+					p += width * sizeof(Tp); \
+					n -= width; \
+					v0 = v1; \
+					v1 = v2; \
+					v2 = v3; \
+				} \
+				if (n >= width) { \
+					lane::store(p, v0); \
+					p += width * sizeof(Tp); \
+					n -= width; \
+					v0 = v1; \
+					v1 = v2; \
+				} \
+				if (n >= width) { \
+					lane::store(p, v0); \
+					p += width * sizeof(Tp); \
+					n -= width; \
+					v0 = v1; \
+				} \
+				lane::store(buffer, v0); \
+				std::memcpy(p, buffer, n * sizeof(Tp));
+
+			template <typename Tp>
+			KERBAL_X86_TARGET("sse2")
+			void modifier_iota_sse2(unsigned char * p, std::size_t n, Tp value) KERBAL_NOEXCEPT
+			{
+				KERBAL_MODIFIER_IOTA_KERNEL_BODY(modifier_sse2_lane<Tp>)
+			}
+
+			template <typename Tp>
+			KERBAL_X86_TARGET("avx2")
+			void modifier_iota_avx2(unsigned char * p, std::size_t n, Tp value) KERBAL_NOEXCEPT
+			{
+				KERBAL_MODIFIER_IOTA_KERNEL_BODY(modifier_avx2_lane<Tp>)
+			}
+
+#	undef KERBAL_MODIFIER_IOTA_KERNEL_BODY
+
+#	endif
+
+		} // namespace detail
+
+	} // namespace algorithm
+
+} // namespace kerbal
+
+#endif // KERBAL_ALGORITHM_DETAIL_MODIFIER_X86_KERNEL_HPP
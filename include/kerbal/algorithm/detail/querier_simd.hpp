@@ -0,0 +1,400 @@
+/**
+ * @file       querier_simd.hpp
+ * @brief
+ * @date       2020-11-13
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_ALGORITHM_DETAIL_QUERIER_SIMD_HPP
+#define KERBAL_ALGORITHM_DETAIL_QUERIER_SIMD_HPP
+
+#include <kerbal/algorithm/detail/querier_x86_kernel.hpp>
+
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/compatibility/x86_cpu_feature.hpp>
+#include <kerbal/config/x86_intrinsics.hpp>
+#include <kerbal/iterator/iterator.hpp>
+#include <kerbal/iterator/iterator_traits.hpp>
+#include <kerbal/type_traits/cv_deduction.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+#include <kerbal/type_traits/is_same.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <utility>
+
+namespace kerbal
+{
+
+	namespace algorithm
+	{
+
+		namespace detail
+		{
+
+			/*
+			 * The element type the vectorized find and count see a value_type as: the one of the same size
+			 * they may alias, void for the types they do not accept.
+			 */
+			template <typename Tp>
+			struct querier_simd_eq_lane
+			{
+					typedef void type;
+			};
+
+			template <>
+			struct querier_simd_eq_lane<char>
+			{
+					typedef unsigned char type;
+			};
+
+			template <>
+			struct querier_simd_eq_lane<signed char>
+			{
+					typedef unsigned char type;
+			};
+
+			template <>
+			struct querier_simd_eq_lane<unsigned char>
+			{
+					typedef unsigned char type;
+			};
+
+			template <>
+			struct querier_simd_eq_lane<int>
+			{
+					typedef int type;
+			};
+
+			template <>
+			struct querier_simd_eq_lane<unsigned int>
+			{
+					typedef int type;
+			};
+
+			template <>
+			struct querier_simd_eq_lane<float>
+			{
+					typedef float type;
+			};
+
+			template <>
+			struct querier_simd_eq_lane<double>
+			{
+					typedef double type;
+			};
+
+			template <typename ContiguousIterator, typename Type>
+			struct querier_simd_eq_helper
+			{
+					typedef typename kerbal::iterator::iterator_traits<ContiguousIterator>::value_type value_type;
+					typedef typename kerbal::type_traits::remove_cv<value_type>::type element_type;
+					typedef typename querier_simd_eq_lane<element_type>::type lane_type;
+
+					typedef kerbal::type_traits::bool_constant<
+							kerbal::iterator::is_contiguous_iterator<ContiguousIterator>::value &&
+							kerbal::type_traits::is_same<typename kerbal::type_traits::remove_cv<Type>::type, element_type>::value &&
+							!kerbal::type_traits::is_same<lane_type, void>::value
+					> ACCEPTABLE;
+			};
+
+			/*
+			 * find over bytes is memchr, available everywhere; the other types need the x86 kernels.
+			 */
+			template <typename ContiguousIterator, typename Type>
+			struct querier_simd_find_enable:
+					kerbal::type_traits::bool_constant<
+						querier_simd_eq_helper<ContiguousIterator, Type>::ACCEPTABLE::value && (
+							KERBAL_X86_INTRINSICS_SUPPORTED ||
+							kerbal::type_traits::is_same<
+								typename querier_simd_eq_helper<ContiguousIterator, Type>::lane_type, unsigned char
+							>::value
+						)
+					>
+			{
+			};
+
+			template <typename ContiguousIterator, typename Type>
+			struct querier_simd_count_enable:
+					kerbal::type_traits::bool_constant<
+						querier_simd_eq_helper<ContiguousIterator, Type>::ACCEPTABLE::value &&
+						KERBAL_X86_INTRINSICS_SUPPORTED
+					>
+			{
+			};
+
+			/*
+			 * min / max reductions: int, float and double under std::less or std::greater, which is what
+			 * min_element, max_element and minmax_element use by default.
+			 */
+			template <typename ContiguousIterator, typename BinaryPredicate>
+			struct querier_simd_min_max_enable:
+					kerbal::type_traits::bool_constant<
+						KERBAL_X86_INTRINSICS_SUPPORTED &&
+						kerbal::iterator::is_contiguous_iterator<ContiguousIterator>::value && (
+							kerbal::type_traits::is_same<
+								typename kerbal::iterator::iterator_traits<ContiguousIterator>::value_type, int
+							>::value ||
+							kerbal::type_traits::is_same<
+								typename kerbal::iterator::iterator_traits<ContiguousIterator>::value_type, float
+							>::value ||
+							kerbal::type_traits::is_same<
+								typename kerbal::iterator::iterator_traits<ContiguousIterator>::value_type, double
+							>::value
+						) && (
+							kerbal::type_traits::is_same<
+								BinaryPredicate,
+								std::less<typename kerbal::iterator::iterator_traits<ContiguousIterator>::value_type>
+							>::value ||
+							kerbal::type_traits::is_same<
+								BinaryPredicate,
+								std::greater<typename kerbal::iterator::iterator_traits<ContiguousIterator>::value_type>
+							>::value
+						)
+					>
+			{
+			};
+
+
+
+#	if KERBAL_X86_INTRINSICS_SUPPORTED
+
+			template <typename Tp>
+			const Tp * querier_simd_find(const Tp * first, const Tp * last, Tp value) KERBAL_NOEXCEPT
+			{
+				const kerbal::compatibility::x86_cpu_feature & feature = kerbal::compatibility::x86_cpu_feature::instance();
+				if (feature.avx2) {
+					return querier_find_avx2(first, last, value);
+				}
+				if (feature.sse41) {
+					return querier_find_sse41(first, last, value);
+				}
+				while (first != last && !(*first == value)) {
+					++first;
+				}
+				return first;
+			}
+
+			template <typename Tp>
+			const Tp * querier_simd_find_last(const Tp * first, const Tp * last, Tp value) KERBAL_NOEXCEPT
+			{
+				const kerbal::compatibility::x86_cpu_feature & feature = kerbal::compatibility::x86_cpu_feature::instance();
+				if (feature.avx2) {
+					return querier_find_last_avx2(first, last, value);
+				}
+				if (feature.sse41) {
+					return querier_find_last_sse41(first, last, value);
+				}
+				const Tp * back = last;
+				while (back != first) {
+					--back;
+					if (*back == value) {
+						return back;
+					}
+				}
+				return last;
+			}
+
+			template <typename Tp>
+			std::size_t querier_simd_count(const Tp * first, const Tp * last, Tp value) KERBAL_NOEXCEPT
+			{
+				const kerbal::compatibility::x86_cpu_feature & feature = kerbal::compatibility::x86_cpu_feature::instance();
+				if (feature.avx2) {
+					return querier_count_avx2(first, last, value);
+				}
+				if (feature.sse41) {
+					return querier_count_sse41(first, last, value);
+				}
+				std::size_t cnt = 0;
+				for (; first != last; ++first) {
+					if (*first == value) {
+						++cnt;
+					}
+				}
+				return cnt;
+			}
+
+			/*
+			 * @return false if the range has a NaN or the processor has no suitable instruction set, the caller
+			 *         then goes on with its portable loop
+			 */
+			template <typename Tp>
+			bool querier_simd_min_max(const Tp * first, const Tp * last, Tp & mini, Tp & maxi) KERBAL_NOEXCEPT
+			{
+				const kerbal::compatibility::x86_cpu_feature & feature = kerbal::compatibility::x86_cpu_feature::instance();
+				if (feature.avx2) {
+					return querier_min_max_avx2(first, last, mini, maxi);
+				}
+				if (feature.sse41) {
+					return querier_min_max_sse41(first, last, mini, maxi);
+				}
+				return false;
+			}
+
+#	endif
+
+
+
+			/*
+			 * The entries of querier.hpp. Each one takes the result of its enable trait, the false_type overloads
+			 * are never called and only keep the portable functions compiling for any type.
+			 */
+
+			template <typename ContiguousIterator, typename Type>
+			ContiguousIterator
+			querier_simd_find(ContiguousIterator /*first*/, ContiguousIterator last, const Type & /*value*/,
+								kerbal::type_traits::false_type) KERBAL_NOEXCEPT
+			{
+				return last;
+			}
+
+			template <typename ContiguousIterator, typename Type>
+			ContiguousIterator
+			querier_simd_find(ContiguousIterator first, ContiguousIterator last, const Type & value,
+								kerbal::type_traits::true_type) KERBAL_NOEXCEPT
+			{
+				typedef typename querier_simd_eq_helper<ContiguousIterator, Type>::lane_type lane_type;
+
+				if (first == last) {
+					return first;
+				}
+				const lane_type * p = reinterpret_cast<const lane_type *>(&*first);
+				const lane_type * q = p + (last - first);
+				const lane_type v = static_cast<lane_type>(value);
+				const lane_type * r;
+
+				if (kerbal::type_traits::is_same<lane_type, unsigned char>::value) {
+					const void * found = std::memchr(p, static_cast<unsigned char>(v), static_cast<std::size_t>(q - p));
+					r = found == NULL ? q : static_cast<const lane_type *>(found);
+				} else {
+
+#	if KERBAL_X86_INTRINSICS_SUPPORTED
+					r = querier_simd_find(p, q, v);
+#	else
+					r = q; // not reached, see querier_simd_find_enable
+#	endif
+
+				}
+				return first + (r - p);
+			}
+
+			template <typename ContiguousIterator, typename Type>
+			std::size_t
+			querier_simd_count(ContiguousIterator /*first*/, ContiguousIterator /*last*/, const Type & /*value*/,
+								kerbal::type_traits::false_type) KERBAL_NOEXCEPT
+			{
+				return 0;
+			}
+
+#	if KERBAL_X86_INTRINSICS_SUPPORTED
+
+			template <typename ContiguousIterator, typename Type>
+			std::size_t
+			querier_simd_count(ContiguousIterator first, ContiguousIterator last, const Type & value,
+								kerbal::type_traits::true_type) KERBAL_NOEXCEPT
+			{
+				typedef typename querier_simd_eq_helper<ContiguousIterator, Type>::lane_type lane_type;
+
+				if (first == last) {
+					return 0;
+				}
+				const lane_type * p = reinterpret_cast<const lane_type *>(&*first);
+				return querier_simd_count(p, p + (last - first), static_cast<lane_type>(value));
+			}
+
+#	endif
+
+			template <typename ContiguousIterator, typename BinaryPredicate>
+			bool querier_simd_better_element(ContiguousIterator /*first*/, ContiguousIterator /*last*/,
+												BinaryPredicate /*pred*/, ContiguousIterator & /*result*/,
+												kerbal::type_traits::false_type) KERBAL_NOEXCEPT
+			{
+				return false;
+			}
+
+#	if KERBAL_X86_INTRINSICS_SUPPORTED
+
+			/*
+			 * Reduces the range to its least and greatest values, then finds where the wanted one first occurs,
+			 * which stops early on average. The range is left to the portable loop when it has a NaN, whose
+			 * result depends on the position of the NaN.
+			 */
+			template <typename ContiguousIterator, typename BinaryPredicate>
+			bool querier_simd_better_element(ContiguousIterator first, ContiguousIterator last,
+												BinaryPredicate /*pred*/, ContiguousIterator & result,
+												kerbal::type_traits::true_type) KERBAL_NOEXCEPT
+			{
+				typedef typename kerbal::iterator::iterator_traits<ContiguousIterator>::value_type value_type;
+
+				if (last - first < 16) {
+					return false;
+				}
+				const value_type * p = &*first;
+				const value_type * q = p + (last - first);
+				value_type mini, maxi;
+				if (!querier_simd_min_max(p, q, mini, maxi)) {
+					return false;
+				}
+				value_type wanted(kerbal::type_traits::is_same<BinaryPredicate, std::less<value_type> >::value ? mini : maxi);
+				result = first + (querier_simd_find(p, q, wanted) - p);
+				return true;
+			}
+
+#	endif
+
+			template <typename ContiguousIterator, typename BinaryPredicate>
+			bool querier_simd_minmax_element(ContiguousIterator /*first*/, ContiguousIterator /*last*/,
+												BinaryPredicate /*pred*/,
+												std::pair<ContiguousIterator, ContiguousIterator> & /*result*/,
+												kerbal::type_traits::false_type) KERBAL_NOEXCEPT
+			{
+				return false;
+			}
+
+#	if KERBAL_X86_INTRINSICS_SUPPORTED
+
+			/*
+			 * As minmax_element: the first of the least elements and the last of the greatest ones according to
+			 * pred.
+			 */
+			template <typename ContiguousIterator, typename BinaryPredicate>
+			bool querier_simd_minmax_element(ContiguousIterator first, ContiguousIterator last,
+												BinaryPredicate /*pred*/,
+												std::pair<ContiguousIterator, ContiguousIterator> & result,
+												kerbal::type_traits::true_type) KERBAL_NOEXCEPT
+			{
+				typedef typename kerbal::iterator::iterator_traits<ContiguousIterator>::value_type value_type;
+
+				if (last - first < 16) {
+					return false;
+				}
+				const value_type * p = &*first;
+				const value_type * q = p + (last - first);
+				value_type mini, maxi;
+				if (!querier_simd_min_max(p, q, mini, maxi)) {
+					return false;
+				}
+				if (!kerbal::type_traits::is_same<BinaryPredicate, std::less<value_type> >::value) { // std::greater
+					value_type t(mini);
+					mini = maxi;
+					maxi = t;
+				}
+				result.first = first + (querier_simd_find(p, q, mini) - p);
+				result.second = first + (querier_simd_find_last(p, q, maxi) - p);
+				return true;
+			}
+
+#	endif
+
+		} // namespace detail
+
+	} // namespace algorithm
+
+} // namespace kerbal
+
+#endif // KERBAL_ALGORITHM_DETAIL_QUERIER_SIMD_HPP
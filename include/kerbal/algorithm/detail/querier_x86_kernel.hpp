@@ -0,0 +1,812 @@
+/**
+ * @file       querier_x86_kernel.hpp
+ * @brief
+ * @date       2020-11-13
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_ALGORITHM_DETAIL_QUERIER_X86_KERNEL_HPP
+#define KERBAL_ALGORITHM_DETAIL_QUERIER_X86_KERNEL_HPP
+
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/config/compiler_id.hpp>
+#include <kerbal/config/x86_intrinsics.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+
+#include <cstddef>
+
+namespace kerbal
+{
+
+	namespace algorithm
+	{
+
+		namespace detail
+		{
+
+#	if KERBAL_X86_INTRINSICS_SUPPORTED
+
+			/*
+			 * Bit scans of the lane masks. numeric/bit.hpp is not used here, it would make querier.hpp include
+			 * modifier.hpp, which depends on it.
+			 */
+
+			// pre: mask != 0
+			inline
+			int querier_mask_lowest(unsigned int mask) KERBAL_NOEXCEPT
+			{
+
+#		if KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_MSVC
+				unsigned long i;
+				_BitScanForward(&i, mask);
+				return static_cast<int>(i);
+#		else
+				return __builtin_ctz(mask);
+#		endif
+
+			}
+
+			// pre: mask != 0
+			inline
+			int querier_mask_highest(unsigned int mask) KERBAL_NOEXCEPT
+			{
+
+#		if KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_MSVC
+				unsigned long i;
+				_BitScanReverse(&i, mask);
+				return static_cast<int>(i);
+#		else
+				return 31 - __builtin_clz(mask);
+#		endif
+
+			}
+
+			// the popcnt instruction is not implied by the targets of the kernels
+			inline
+			unsigned int querier_mask_popcount(unsigned int mask) KERBAL_NOEXCEPT
+			{
+				mask = mask - ((mask >> 1u) & 0x55555555u);
+				mask = (mask & 0x33333333u) + ((mask >> 2u) & 0x33333333u);
+				mask = (mask + (mask >> 4u)) & 0x0F0F0F0Fu;
+				return (mask * 0x01010101u) >> 24u;
+			}
+
+			/*
+			 * Lanes of a vector register, one specialization per element type:
+			 *  - load, set1: unaligned load, broadcast
+			 *  - eq_mask: one bit per lane equal in both vectors, lane 0 in bit 0
+			 *  - min, max, store, nan_*, is_nan: for the min / max reduction (not provided for bytes)
+			 */
+			template <typename Tp>
+			struct querier_sse41_lane;
+
+			template <>
+			struct querier_sse41_lane<unsigned char>
+			{
+					typedef __m128i vec;
+					typedef kerbal::type_traits::integral_constant<std::size_t, 16> WIDTH;
+
+					KERBAL_X86_TARGET("sse4.1")
+					static vec load(const unsigned char * p) KERBAL_NOEXCEPT
+					{
+						return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+					}
+
+					KERBAL_X86_TARGET("sse4.1")
+					static vec set1(unsigned char x) KERBAL_NOEXCEPT
+					{
+						return _mm_set1_epi8(static_cast<char>(x));
+					}
+
+					KERBAL_X86_TARGET("sse4.1")
+					static unsigned int eq_mask(vec a, vec b) KERBAL_NOEXCEPT
+					{
+						return static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)));
+					}
+			};
+
+			template <>
+			struct querier_sse41_lane<int>
+			{
+					typedef __m128i vec;
+					typedef kerbal::type_traits::integral_constant<std::size_t, 4> WIDTH;
+
+					KERBAL_X86_TARGET("sse4.1")
+					static vec load(const int * p) KERBAL_NOEXCEPT
+					{
+						return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+					}
+
+					KERBAL_X86_TARGET("sse4.1")
+					static void store(int * p, vec v) KERBAL_NOEXCEPT
+					{
+						_mm_storeu_si128(reinterpret_cast<__m128i *>(p), v);
+					}
+
+					KERBAL_X86_TARGET("sse4.1")
+					static vec set1(int x) KERBAL_NOEXCEPT
+					{
+						return _mm_set1_epi32(x);
+					}
+
+					KERBAL_X86_TARGET("sse4.1")
+					static unsigned int eq_mask(vec a, vec b) KERBAL_NOEXCEPT
+					{
+						return static_cast<unsigned int>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b))));
+					}
+
+					KERBAL_X86_TARGET("sse4.1")
+					static vec min(vec a, vec b) KERBAL_NOEXCEPT
+					{
+						return _mm_min_epi32(a, b);
+					}
+
+					KERBAL_X86_TARGET("sse4.1")
+					static vec max(vec a, vec b) KERBAL_NOEXCEPT
+					{
+						return _mm_max_epi32(a, b);
+					}
+
+					KERBAL_X86_TARGET("sse4.1")
+					static vec nan_init() KERBAL_NOEXCEPT
+					{
+						return _mm_setzero_si128();
+					}
+
+					KERBAL_X86_TARGET("sse4.1")
+					static vec nan_accumulate(vec acc, vec /*v*/) KERBAL_NOEXCEPT
+					{
+						return acc;
+					}
+
+					KERBAL_X86_TARGET("sse4.1")
+					static bool nan_any(vec /*acc*/) KERBAL_NOEXCEPT
+					{
+						return false;
+					}
+
+					static bool is_nan(int /*x*/) KERBAL_NOEXCEPT
+					{
+						return false;
+					}
+			};
+
+			template <>
+			struct querier_sse41_lane<float>
+			{
+					typedef __m128 vec;
+					typedef kerbal::type_traits::integral_constant<std::size_t, 4> WIDTH;
+
+					KERBAL_X86_TARGET("sse4.1")
+					static vec load(const float * p) KERBAL_NOEXCEPT
+					{
+						return _mm_loadu_ps(p);
+					}
+
+					KERBAL_X86_TARGET("sse4.1")
+					static void store(float * p, vec v) KERBAL_NOEXCEPT
+					{
+						_mm_storeu_ps(p, v);
+					}
+
+					KERBAL_X86_TARGET("sse4.1")
+					static vec set1(float x) KERBAL_NOEXCEPT
+					{
+						return _mm_set1_ps(x);
+					}
+
+					KERBAL_X86_TARGET("sse4.1")
+					static unsigned int eq_mask(vec a, vec b) KERBAL_NOEXCEPT
+					{
+						return static_cast<unsigned int>(_mm_movemask_ps(_mm_cmpeq_ps(a, b)));
+					}
+
+					KERBAL_X86_TARGET("sse4.1")
+					static vec min(vec a, vec b) KERBAL_NOEXCEPT
+					{
+						return _mm_min_ps(a, b);
+					}
+
+					KERBAL_X86_TARGET("sse4.1")
+					static vec max(vec a, vec b) KERBAL_NOEXCEPT
+					{
+						return _mm_max_ps(a, b);
+					}
+
+					KERBAL_X86_TARGET("sse4.1")
+					static vec nan_init() KERBAL_NOEXCEPT
+					{
+						return _mm_setzero_ps();
+					}
+
+					KERBAL_X86_TARGET("sse4.1")
+					static vec nan_accumulate(vec acc, vec v) KERBAL_NOEXCEPT
+					{
+						return _mm_or_ps(acc, _mm_cmpunord_ps(v, v));
+					}
+
+					KERBAL_X86_TARGET("sse4.1")
+					static bool nan_any(vec acc) KERBAL_NOEXCEPT
+					{
+						return _mm_movemask_ps(acc) != 0;
+					}
+
+					static bool is_nan(float x) KERBAL_NOEXCEPT
+					{
+						return x != x;
+					}
+			};
+
+			template <>
+			struct querier_sse41_lane<double>
+			{
+					typedef __m128d vec;
+					typedef kerbal::type_traits::integral_constant<std::size_t, 2> WIDTH;
+
+					KERBAL_X86_TARGET("sse4.1")
+					static vec load(const double * p) KERBAL_NOEXCEPT
+					{
+						return _mm_loadu_pd(p);
+					}
+
+					KERBAL_X86_TARGET("sse4.1")
+					static void store(double * p, vec v) KERBAL_NOEXCEPT
+					{
+						_mm_storeu_pd(p, v);
+					}
+
+					KERBAL_X86_TARGET("sse4.1")
+					static vec set1(double x) KERBAL_NOEXCEPT
+					{
+						return _mm_set1_pd(x);
+					}
+
+					KERBAL_X86_TARGET("sse4.1")
+					static unsigned int eq_mask(vec a, vec b) KERBAL_NOEXCEPT
+					{
+						return static_cast<unsigned int>(_mm_movemask_pd(_mm_cmpeq_pd(a, b)));
+					}
+
+					KERBAL_X86_TARGET("sse4.1")
+					static vec min(vec a, vec b) KERBAL_NOEXCEPT
+					{
+						return _mm_min_pd(a, b);
+					}
+
+					KERBAL_X86_TARGET("sse4.1")
+					static vec max(vec a, vec b) KERBAL_NOEXCEPT
+					{
+						return _mm_max_pd(a, b);
+					}
+
+					KERBAL_X86_TARGET("sse4.1")
+					static vec nan_init() KERBAL_NOEXCEPT
+					{
+						return _mm_setzero_pd();
+					}
+
+					KERBAL_X86_TARGET("sse4.1")
+					static vec nan_accumulate(vec acc, vec v) KERBAL_NOEXCEPT
+					{
+						return _mm_or_pd(acc, _mm_cmpunord_pd(v, v));
+					}
+
+					KERBAL_X86_TARGET("sse4.1")
+					static bool nan_any(vec acc) KERBAL_NOEXCEPT
+					{
+						return _mm_movemask_pd(acc) != 0;
+					}
+
+					static bool is_nan(double x) KERBAL_NOEXCEPT
+					{
+						return x != x;
+					}
+			};
+
+			template <typename Tp>
+			struct querier_avx2_lane;
+
+			template <>
+			struct querier_avx2_lane<unsigned char>
+			{
+					typedef __m256i vec;
+					typedef kerbal::type_traits::integral_constant<std::size_t, 32> WIDTH;
+
+					KERBAL_X86_TARGET("avx2")
+					static vec load(const unsigned char * p) KERBAL_NOEXCEPT
+					{
+						return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+					}
+
+					KERBAL_X86_TARGET("avx2")
+					static vec set1(unsigned char x) KERBAL_NOEXCEPT
+					{
+						return _mm256_set1_epi8(static_cast<char>(x));
+					}
+
+					KERBAL_X86_TARGET("avx2")
+					static unsigned int eq_mask(vec a, vec b) KERBAL_NOEXCEPT
+					{
+						return static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+					}
+			};
+
+			template <>
+			struct querier_avx2_lane<int>
+			{
+					typedef __m256i vec;
+					typedef kerbal::type_traits::integral_constant<std::size_t, 8> WIDTH;
+
+					KERBAL_X86_TARGET("avx2")
+					static vec load(const int * p) KERBAL_NOEXCEPT
+					{
+						return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+					}
+
+					KERBAL_X86_TARGET("avx2")
+					static void store(int * p, vec v) KERBAL_NOEXCEPT
+					{
+						_mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v);
+					}
+
+					KERBAL_X86_TARGET("avx2")
+					static vec set1(int x) KERBAL_NOEXCEPT
+					{
+						return _mm256_set1_epi32(x);
+					}
+
+					KERBAL_X86_TARGET("avx2")
+					static unsigned int eq_mask(vec a, vec b) KERBAL_NOEXCEPT
+					{
+						return static_cast<unsigned int>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b))));
+					}
+
+					KERBAL_X86_TARGET("avx2")
+					static vec min(vec a, vec b) KERBAL_NOEXCEPT
+					{
+						return _mm256_min_epi32(a, b);
+					}
+
+					KERBAL_X86_TARGET("avx2")
+					static vec max(vec a, vec b) KERBAL_NOEXCEPT
+					{
+						return _mm256_max_epi32(a, b);
+					}
+
+					KERBAL_X86_TARGET("avx2")
+					static vec nan_init() KERBAL_NOEXCEPT
+					{
+						return _mm256_setzero_si256();
+					}
+
+					KERBAL_X86_TARGET("avx2")
+					static vec nan_accumulate(vec acc, vec /*v*/) KERBAL_NOEXCEPT
+					{
+						return acc;
+					}
+
+					KERBAL_X86_TARGET("avx2")
+					static bool nan_any(vec /*acc*/) KERBAL_NOEXCEPT
+					{
+						return false;
+					}
+
+					static bool is_nan(int /*x*/) KERBAL_NOEXCEPT
+					{
+						return false;
+					}
+			};
+
+			template <>
+			struct querier_avx2_lane<float>
+			{
+					typedef __m256 vec;
+					typedef kerbal::type_traits::integral_constant<std::size_t, 8> WIDTH;
+
+					KERBAL_X86_TARGET("avx2")
+					static vec load(const float * p) KERBAL_NOEXCEPT
+					{
+						return _mm256_loadu_ps(p);
+					}
+
+					KERBAL_X86_TARGET("avx2")
+					static void store(float * p, vec v) KERBAL_NOEXCEPT
+					{
+						_mm256_storeu_ps(p, v);
+					}
+
+					KERBAL_X86_TARGET("avx2")
+					static vec set1(float x) KERBAL_NOEXCEPT
+					{
+						return _mm256_set1_ps(x);
+					}
+
+					KERBAL_X86_TARGET("avx2")
+					static unsigned int eq_mask(vec a, vec b) KERBAL_NOEXCEPT
+					{
+						return static_cast<unsigned int>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)));
+					}
+
+					KERBAL_X86_TARGET("avx2")
+					static vec min(vec a, vec b) KERBAL_NOEXCEPT
+					{
+						return _mm256_min_ps(a, b);
+					}
+
+					KERBAL_X86_TARGET("avx2")
+					static vec max(vec a, vec b) KERBAL_NOEXCEPT
+					{
+						return _mm256_max_ps(a, b);
+					}
+
+					KERBAL_X86_TARGET("avx2")
+					static vec nan_init() KERBAL_NOEXCEPT
+					{
+						return _mm256_setzero_ps();
+					}
+
+					KERBAL_X86_TARGET("avx2")
+					static vec nan_accumulate(vec acc, vec v) KERBAL_NOEXCEPT
+					{
+						return _mm256_or_ps(acc, _mm256_cmp_ps(v, v, _CMP_UNORD_Q));
+					}
+
+					KERBAL_X86_TARGET("avx2")
+					static bool nan_any(vec acc) KERBAL_NOEXCEPT
+					{
+						return _mm256_movemask_ps(acc) != 0;
+					}
+
+					static bool is_nan(float x) KERBAL_NOEXCEPT
+					{
+						return x != x;
+					}
+			};
+
+			template <>
+			struct querier_avx2_lane<double>
+			{
+					typedef __m256d vec;
+					typedef kerbal::type_traits::integral_constant<std::size_t, 4> WIDTH;
+
+					KERBAL_X86_TARGET("avx2")
+					static vec load(const double * p) KERBAL_NOEXCEPT
+					{
+						return _mm256_loadu_pd(p);
+					}
+
+					KERBAL_X86_TARGET("avx2")
+					static void store(double * p, vec v) KERBAL_NOEXCEPT
+					{
+						_mm256_storeu_pd(p, v);
+					}
+
+					KERBAL_X86_TARGET("avx2")
+					static vec set1(double x) KERBAL_NOEXCEPT
+					{
+						return _mm256_set1_pd(x);
+					}
+
+					KERBAL_X86_TARGET("avx2")
+					static unsigned int eq_mask(vec a, vec b) KERBAL_NOEXCEPT
+					{
+						return static_cast<unsigned int>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)));
+					}
+
+					KERBAL_X86_TARGET("avx2")
+					static vec min(vec a, vec b) KERBAL_NOEXCEPT
+					{
+						return _mm256_min_pd(a, b);
+					}
+
+					KERBAL_X86_TARGET("avx2")
+					static vec max(vec a, vec b) KERBAL_NOEXCEPT
+					{
+						return _mm256_max_pd(a, b);
+					}
+
+					KERBAL_X86_TARGET("avx2")
+					static vec nan_init() KERBAL_NOEXCEPT
+					{
+						return _mm256_setzero_pd();
+					}
+
+					KERBAL_X86_TARGET("avx2")
+					static vec nan_accumulate(vec acc, vec v) KERBAL_NOEXCEPT
+					{
+						return _mm256_or_pd(acc, _mm256_cmp_pd(v, v, _CMP_UNORD_Q));
+					}
+
+					KERBAL_X86_TARGET("avx2")
+					static bool nan_any(vec acc) KERBAL_NOEXCEPT
+					{
+						return _mm256_movemask_pd(acc) != 0;
+					}
+
+					static bool is_nan(double x) KERBAL_NOEXCEPT
+					{
+						return x != x;
+					}
+			};
+
+
+
+			/*
+			 * The kernels. The ones of each instruction set are spelled out separately, a kernel must carry the
+			 * target of the lanes it uses for them to be inlined.
+			 */
+
+			template <typename Tp>
+			KERBAL_X86_TARGET("sse4.1")
+			const Tp * querier_find_sse41(const Tp * first, const Tp * last, Tp value) KERBAL_NOEXCEPT
+			{
+				typedef querier_sse41_lane<Tp> lane;
+				typedef typename lane::vec vec;
+				const std::size_t width = lane::WIDTH::value;
+
+				const vec v = lane::set1(value);
+				while (static_cast<std::size_t>(last - first) >= width) {
+					unsigned int mask = lane::eq_mask(lane::load(first), v);
+					if (mask != 0) {
+						return first + querier_mask_lowest(mask);
+					}
+					first += width;
+				}
+				while (first != last && !(*first == value)) {
+					++first;
+				}
+				return first;
+			}
+
+			/*
+			 * @return the last element equal to value, or last if there is none
+			 */
+			template <typename Tp>
+			KERBAL_X86_TARGET("sse4.1")
+			const Tp * querier_find_last_sse41(const Tp * first, const Tp * last, Tp value) KERBAL_NOEXCEPT
+			{
+				typedef querier_sse41_lane<Tp> lane;
+				typedef typename lane::vec vec;
+				const std::size_t width = lane::WIDTH::value;
+
+				const vec v = lane::set1(value);
+				const Tp * back = last;
+				while (static_cast<std::size_t>(back - first) >= width) {
+					back -= width;
+					unsigned int mask = lane::eq_mask(lane::load(back), v);
+					if (mask != 0) {
+						return back + querier_mask_highest(mask);
+					}
+				}
+				while (back != first) {
+					--back;
+					if (*back == value) {
+						return back;
+					}
+				}
+				return last;
+			}
+
+			template <typename Tp>
+			KERBAL_X86_TARGET("sse4.1")
+			std::size_t querier_count_sse41(const Tp * first, const Tp * last, Tp value) KERBAL_NOEXCEPT
+			{
+				typedef querier_sse41_lane<Tp> lane;
+				typedef typename lane::vec vec;
+				const std::size_t width = lane::WIDTH::value;
+
+				std::size_t cnt = 0;
+				const vec v = lane::set1(value);
+				while (static_cast<std::size_t>(last - first) >= width) {
+					cnt += querier_mask_popcount(lane::eq_mask(lane::load(first), v));
+					first += width;
+				}
+				while (first != last) {
+					if (*first == value) {
+						++cnt;
+					}
+					++first;
+				}
+				return cnt;
+			}
+
+			/*
+			 * pre: first != last
+			 * @return false if there is a NaN in the range
+			 */
+			template <typename Tp>
+			KERBAL_X86_TARGET("sse4.1")
+			bool querier_min_max_sse41(const Tp * first, const Tp * last, Tp & mini, Tp & maxi) KERBAL_NOEXCEPT
+			{
+				typedef querier_sse41_lane<Tp> lane;
+				typedef typename lane::vec vec;
+				const std::size_t width = lane::WIDTH::value;
+
+				Tp lo = *first;
+				Tp hi = *first;
+				if (static_cast<std::size_t>(last - first) >= width) {
+					vec vlo = lane::load(first);
+					vec vhi = vlo;
+					vec nan = lane::nan_accumulate(lane::nan_init(), vlo);
+					first += width;
+					while (static_cast<std::size_t>(last - first) >= width) {
+						vec v = lane::load(first);
+						vlo = lane::min(vlo, v);
+						vhi = lane::max(vhi, v);
+						nan = lane::nan_accumulate(nan, v);
+						first += width;
+					}
+					if (lane::nan_any(nan)) {
+						return false;
+					}
+					Tp buf[lane::WIDTH::value];
+					lane::store(buf, vlo);
+					for (std::size_t i = 0; i < width; ++i) {
+						if (buf[i] < lo) {
+							lo = buf[i];
+						}
+					}
+					lane::store(buf, vhi);
+					for (std::size_t i = 0; i < width; ++i) {
+						if (hi < buf[i]) {
+							hi = buf[i];
+						}
+					}
+				}
+				while (first != last) {
+					if (lane::is_nan(*first)) {
+						return false;
+					}
+					if (*first < lo) {
+						lo = *first;
+					}
+					if (hi < *first) {
+						hi = *first;
+					}
+					++first;
+				}
+				mini = lo;
+				maxi = hi;
+				return true;
+			}
+
+			template <typename Tp>
+			KERBAL_X86_TARGET("avx2")
+			const Tp * querier_find_avx2(const Tp * first, const Tp * last, Tp value) KERBAL_NOEXCEPT
+			{
+				typedef querier_avx2_lane<Tp> lane;
+				typedef typename lane::vec vec;
+				const std::size_t width = lane::WIDTH::value;
+
+				const vec v = lane::set1(value);
+				while (static_cast<std::size_t>(last - first) >= width) {
+					unsigned int mask = lane::eq_mask(lane::load(first), v);
+					if (mask != 0) {
+						return first + querier_mask_lowest(mask);
+					}
+					first += width;
+				}
+				while (first != last && !(*first == value)) {
+					++first;
+				}
+				return first;
+			}
+
+			template <typename Tp>
+			KERBAL_X86_TARGET("avx2")
+			const Tp * querier_find_last_avx2(const Tp * first, const Tp * last, Tp value) KERBAL_NOEXCEPT
+			{
+				typedef querier_avx2_lane<Tp> lane;
+				typedef typename lane::vec vec;
+				const std::size_t width = lane::WIDTH::value;
+
+				const vec v = lane::set1(value);
+				const Tp * back = last;
+				while (static_cast<std::size_t>(back - first) >= width) {
+					back -= width;
+					unsigned int mask = lane::eq_mask(lane::load(back), v);
+					if (mask != 0) {
+						return back + querier_mask_highest(mask);
+					}
+				}
+				while (back != first) {
+					--back;
+					if (*back == value) {
+						return back;
+					}
+				}
+				return last;
+			}
+
+			template <typename Tp>
+			KERBAL_X86_TARGET("avx2")
+			std::size_t querier_count_avx2(const Tp * first, const Tp * last, Tp value) KERBAL_NOEXCEPT
+			{
+				typedef querier_avx2_lane<Tp> lane;
+				typedef typename lane::vec vec;
+				const std::size_t width = lane::WIDTH::value;
+
+				std::size_t cnt = 0;
+				const vec v = lane::set1(value);
+				while (static_cast<std::size_t>(last - first) >= width) {
+					cnt += querier_mask_popcount(lane::eq_mask(lane::load(first), v));
+					first += width;
+				}
+				while (first != last) {
+					if (*first == value) {
+						++cnt;
+					}
+					++first;
+				}
+				return cnt;
+			}
+
+			template <typename Tp>
+			KERBAL_X86_TARGET("avx2")
+			bool querier_min_max_avx2(const Tp * first, const Tp * last, Tp & mini, Tp & maxi) KERBAL_NOEXCEPT
+			{
+				typedef querier_avx2_lane<Tp> lane;
+				typedef typename lane::vec vec;
+				const std::size_t width = lane::WIDTH::value;
+
+				Tp lo = *first;
+				Tp hi = *first;
+				if (static_cast<std::size_t>(last - first) >= width) {
+					vec vlo = lane::load(first);
+					vec vhi = vlo;
+					vec nan = lane::nan_accumulate(lane::nan_init(), vlo);
+					first += width;
+					while (static_cast<std::size_t>(last - first) >= width) {
+						vec v = lane::load(first);
+						vlo = lane::min(vlo, v);
+						vhi = lane::max(vhi, v);
+						nan = lane::nan_accumulate(nan, v);
+						first += width;
+					}
+					if (lane::nan_any(nan)) {
+						return false;
+					}
+					Tp buf[lane::WIDTH::value];
+					lane::store(buf, vlo);
+					for (std::size_t i = 0; i < width; ++i) {
+						if (buf[i] < lo) {
+							lo = buf[i];
+						}
+					}
+					lane::store(buf, vhi);
+					for (std::size_t i = 0; i < width; ++i) {
+						if (hi < buf[i]) {
+							hi = buf[i];
+						}
+					}
+				}
+				while (first != last) {
+					if (lane::is_nan(*first)) {
+						return false;
+					}
+					if (*first < lo) {
+						lo = *first;
+					}
+					if (hi < *first) {
+						hi = *first;
+					}
+					++first;
+				}
+				mini = lo;
+				maxi = hi;
+				return true;
+			}
+
+#	endif
+
+		} // namespace detail
+
+	} // namespace algorithm
+
+} // namespace kerbal
+
+#endif // KERBAL_ALGORITHM_DETAIL_QUERIER_X86_KERNEL_HPP
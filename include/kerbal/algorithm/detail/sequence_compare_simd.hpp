@@ -0,0 +1,249 @@
+/**
+ * @file       sequence_compare_simd.hpp
+ * @brief
+ * @date       2020-11-15
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_ALGORITHM_DETAIL_SEQUENCE_COMPARE_SIMD_HPP
+#define KERBAL_ALGORITHM_DETAIL_SEQUENCE_COMPARE_SIMD_HPP
+
+#include <kerbal/algorithm/detail/sequence_compare_x86_kernel.hpp>
+
+#include <kerbal/algorithm/binary_type_predicate.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/compatibility/x86_cpu_feature.hpp>
+#include <kerbal/config/x86_intrinsics.hpp>
+#include <kerbal/iterator/iterator_traits.hpp>
+#include <kerbal/type_traits/cv_deduction.hpp>
+#include <kerbal/type_traits/fundamental_deduction.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+#include <kerbal/type_traits/is_same.hpp>
+#include <kerbal/type_traits/reference_deduction.hpp>
+#include <kerbal/type_traits/volatile_deduction.hpp>
+#include <kerbal/utility/addressof.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+
+namespace kerbal
+{
+
+	namespace algorithm
+	{
+
+		namespace detail
+		{
+
+			/*
+			 * Two integers are equal if and only if their bytes are, so two contiguous ranges of the same
+			 * integral type are compared as bytes.
+			 */
+			template <typename ContiguousIterator1, typename ContiguousIterator2>
+			struct sequence_compare_simd_helper
+			{
+					typedef typename kerbal::iterator::iterator_traits<ContiguousIterator1>::value_type value_type1;
+					typedef typename kerbal::iterator::iterator_traits<ContiguousIterator2>::value_type value_type2;
+					typedef typename kerbal::iterator::iterator_traits<ContiguousIterator1>::reference reference1;
+					typedef typename kerbal::iterator::iterator_traits<ContiguousIterator2>::reference reference2;
+					typedef typename kerbal::type_traits::remove_cv<value_type1>::type element_type;
+
+					typedef kerbal::type_traits::bool_constant<
+							kerbal::iterator::is_contiguous_iterator<ContiguousIterator1>::value &&
+							kerbal::iterator::is_contiguous_iterator<ContiguousIterator2>::value &&
+							!kerbal::type_traits::is_volatile<
+								typename kerbal::type_traits::remove_reference<reference1>::type
+							>::value &&
+							!kerbal::type_traits::is_volatile<
+								typename kerbal::type_traits::remove_reference<reference2>::type
+							>::value &&
+							kerbal::type_traits::is_same<
+								element_type, typename kerbal::type_traits::remove_cv<value_type2>::type
+							>::value &&
+							kerbal::type_traits::is_integral<element_type>::value
+					> ACCEPTABLE;
+			};
+
+			template <typename ContiguousIterator1, typename ContiguousIterator2, typename BinaryPredicate>
+			struct sequence_compare_simd_equal_enable:
+					kerbal::type_traits::bool_constant<
+						sequence_compare_simd_helper<ContiguousIterator1, ContiguousIterator2>::ACCEPTABLE::value && (
+							kerbal::type_traits::is_same<
+								BinaryPredicate,
+								kerbal::algorithm::binary_type_equal_to<
+									typename sequence_compare_simd_helper<ContiguousIterator1, ContiguousIterator2>::value_type1,
+									typename sequence_compare_simd_helper<ContiguousIterator1, ContiguousIterator2>::value_type2
+								>
+							>::value ||
+							kerbal::type_traits::is_same<
+								BinaryPredicate,
+								std::equal_to<
+									typename sequence_compare_simd_helper<ContiguousIterator1, ContiguousIterator2>::value_type1
+								>
+							>::value
+						)
+					>
+			{
+			};
+
+			template <typename ContiguousIterator1, typename ContiguousIterator2, typename BinaryPredicate>
+			struct sequence_compare_simd_not_equal_enable:
+					kerbal::type_traits::bool_constant<
+						sequence_compare_simd_helper<ContiguousIterator1, ContiguousIterator2>::ACCEPTABLE::value && (
+							kerbal::type_traits::is_same<
+								BinaryPredicate,
+								kerbal::algorithm::binary_type_not_equal_to<
+									typename sequence_compare_simd_helper<ContiguousIterator1, ContiguousIterator2>::value_type1,
+									typename sequence_compare_simd_helper<ContiguousIterator1, ContiguousIterator2>::value_type2
+								>
+							>::value ||
+							kerbal::type_traits::is_same<
+								BinaryPredicate,
+								std::not_equal_to<
+									typename sequence_compare_simd_helper<ContiguousIterator1, ContiguousIterator2>::value_type1
+								>
+							>::value
+						)
+					>
+			{
+			};
+
+			/*
+			 * The ordering algorithms find the first differing elements as bytes and compare them as values.
+			 * ExpectedPredicate is the std::less, std::greater... the calling algorithm is equivalent to
+			 * with the default predicate.
+			 */
+			template <typename ContiguousIterator1, typename ContiguousIterator2,
+						typename BinaryPredicate, typename ExpectedPredicate>
+			struct sequence_compare_simd_order_enable:
+					kerbal::type_traits::bool_constant<
+						sequence_compare_simd_helper<ContiguousIterator1, ContiguousIterator2>::ACCEPTABLE::value &&
+						kerbal::type_traits::is_same<BinaryPredicate, ExpectedPredicate>::value
+					>
+			{
+			};
+
+
+
+			/*
+			 * The index of the first element which differs in [a, a + n) and [b, b + n), n if none.
+			 */
+			template <typename Tp>
+			std::size_t sequence_compare_simd_mismatch(const Tp * a, const Tp * b, std::size_t n) KERBAL_NOEXCEPT
+			{
+
+#	if KERBAL_X86_INTRINSICS_SUPPORTED
+
+				const kerbal::compatibility::x86_cpu_feature & feature = kerbal::compatibility::x86_cpu_feature::instance();
+				if (feature.avx2) {
+					return sequence_compare_mismatch_avx2(reinterpret_cast<const unsigned char *>(a),
+														reinterpret_cast<const unsigned char *>(b),
+														n * sizeof(Tp)) / sizeof(Tp);
+				}
+				if (feature.sse2) {
+					return sequence_compare_mismatch_sse2(reinterpret_cast<const unsigned char *>(a),
+														reinterpret_cast<const unsigned char *>(b),
+														n * sizeof(Tp)) / sizeof(Tp);
+				}
+
+#	endif
+
+				std::size_t i = 0;
+				while (i != n && a[i] == b[i]) {
+					++i;
+				}
+				return i;
+			}
+
+			/*
+			 * Lexicographical three-way comparison: negative, zero or positive. The unsigned bytes, whose order
+			 * is the one of memcmp, are left to it.
+			 */
+			template <typename Tp>
+			int sequence_compare_simd_three_way(const Tp * a, std::size_t na,
+												const Tp * b, std::size_t nb) KERBAL_NOEXCEPT
+			{
+				std::size_t m = na < nb ? na : nb;
+				if (sizeof(Tp) == 1 && static_cast<Tp>(-1) > static_cast<Tp>(0)) {
+					int r = m == 0 ? 0 : std::memcmp(a, b, m);
+					if (r != 0) {
+						return r;
+					}
+				} else {
+					std::size_t i = sequence_compare_simd_mismatch(a, b, m);
+					if (i != m) {
+						return a[i] < b[i] ? -1 : 1;
+					}
+				}
+				return na < nb ? -1 : (nb < na ? 1 : 0);
+			}
+
+
+
+			/*
+			 * The entries of sequence_compare.hpp. Each one takes the result of its enable trait, the false_type
+			 * overloads are never called and only keep the portable functions compiling for any type.
+			 */
+
+			template <typename ContiguousIterator1, typename ContiguousIterator2>
+			bool sequence_compare_simd_equal(ContiguousIterator1 /*a_first*/, ContiguousIterator1 /*a_last*/,
+											ContiguousIterator2 /*b_first*/,
+											kerbal::type_traits::false_type) KERBAL_NOEXCEPT
+			{
+				return false;
+			}
+
+			/*
+			 * pre: [b_first, b_first + (a_last - a_first)) is valid
+			 */
+			template <typename ContiguousIterator1, typename ContiguousIterator2>
+			bool sequence_compare_simd_equal(ContiguousIterator1 a_first, ContiguousIterator1 a_last,
+											ContiguousIterator2 b_first,
+											kerbal::type_traits::true_type) KERBAL_NOEXCEPT
+			{
+				typedef typename sequence_compare_simd_helper<ContiguousIterator1, ContiguousIterator2>::element_type element_type;
+
+				if (a_first == a_last) {
+					return true;
+				}
+				return std::memcmp(kerbal::utility::addressof(*a_first), kerbal::utility::addressof(*b_first),
+									static_cast<std::size_t>(a_last - a_first) * sizeof(element_type)) == 0;
+			}
+
+			template <typename ContiguousIterator1, typename ContiguousIterator2>
+			int sequence_compare_simd_three_way(ContiguousIterator1 /*a_first*/, ContiguousIterator1 /*a_last*/,
+												ContiguousIterator2 /*b_first*/, ContiguousIterator2 /*b_last*/,
+												kerbal::type_traits::false_type) KERBAL_NOEXCEPT
+			{
+				return 0;
+			}
+
+			template <typename ContiguousIterator1, typename ContiguousIterator2>
+			int sequence_compare_simd_three_way(ContiguousIterator1 a_first, ContiguousIterator1 a_last,
+												ContiguousIterator2 b_first, ContiguousIterator2 b_last,
+												kerbal::type_traits::true_type) KERBAL_NOEXCEPT
+			{
+				typedef typename sequence_compare_simd_helper<ContiguousIterator1, ContiguousIterator2>::element_type element_type;
+
+				std::size_t na = static_cast<std::size_t>(a_last - a_first);
+				std::size_t nb = static_cast<std::size_t>(b_last - b_first);
+				if (na == 0 || nb == 0) {
+					return na == nb ? 0 : (na == 0 ? -1 : 1);
+				}
+				const element_type * a = kerbal::utility::addressof(*a_first);
+				const element_type * b = kerbal::utility::addressof(*b_first);
+				return sequence_compare_simd_three_way(a, na, b, nb);
+			}
+
+		} // namespace detail
+
+	} // namespace algorithm
+
+} // namespace kerbal
+
+#endif // KERBAL_ALGORITHM_DETAIL_SEQUENCE_COMPARE_SIMD_HPP
@@ -0,0 +1,124 @@
+/**
+ * @file       sequence_compare_x86_kernel.hpp
+ * @brief
+ * @date       2020-11-15
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_ALGORITHM_DETAIL_SEQUENCE_COMPARE_X86_KERNEL_HPP
+#define KERBAL_ALGORITHM_DETAIL_SEQUENCE_COMPARE_X86_KERNEL_HPP
+
+#include <kerbal/algorithm/detail/querier_x86_kernel.hpp>
+
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/config/x86_intrinsics.hpp>
+
+#include <cstddef>
+
+namespace kerbal
+{
+
+	namespace algorithm
+	{
+
+		namespace detail
+		{
+
+#	if KERBAL_X86_INTRINSICS_SUPPORTED
+
+			/*
+			 * The offset of the first byte which differs in [a, a + n) and [b, b + n), n if none.
+			 * The last vector is loaded overlapping the previous ones, whose bytes are known to be equal.
+			 */
+			KERBAL_X86_TARGET("sse2")
+			inline
+			std::size_t sequence_compare_mismatch_sse2(const unsigned char * a, const unsigned char * b,
+														std::size_t n) KERBAL_NOEXCEPT
+			{
+				if (n < 16) {
+					std::size_t i = 0;
+					while (i != n && a[i] == b[i]) {
+						++i;
+					}
+					return i;
+				}
+				std::size_t i = 0;
+				while (n - i >= 16) {
+					__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+					__m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+					unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y))) ^ 0xFFFFu;
+					if (mask != 0) {
+						return i + static_cast<std::size_t>(querier_mask_lowest(mask));
+					}
+					i += 16;
+				}
+				if (i != n) {
+					i = n - 16;
+					__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+					__m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+					unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y))) ^ 0xFFFFu;
+					if (mask != 0) {
+						return i + static_cast<std::size_t>(querier_mask_lowest(mask));
+					}
+				}
+				return n;
+			}
+
+			KERBAL_X86_TARGET("avx2")
+			inline
+			std::size_t sequence_compare_mismatch_avx2(const unsigned char * a, const unsigned char * b,
+														std::size_t n) KERBAL_NOEXCEPT
+			{
+				if (n < 32) {
+					return sequence_compare_mismatch_sse2(a, b, n);
+				}
+				std::size_t i = 0;
+				while (n - i >= 64) { // the two vectors are tested at once, which is where equal prefixes spend time
+					__m256i e0 = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i)),
+													_mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i)));
+					__m256i e1 = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i + 32)),
+													_mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i + 32)));
+					if (static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_and_si256(e0, e1))) != 0xFFFFFFFFu) {
+						unsigned int mask = ~static_cast<unsigned int>(_mm256_movemask_epi8(e0));
+						if (mask != 0) {
+							return i + static_cast<std::size_t>(querier_mask_lowest(mask));
+						}
+						mask = ~static_cast<unsigned int>(_mm256_movemask_epi8(e1));
+						return i + 32 + static_cast<std::size_t>(querier_mask_lowest(mask));
+					}
+					i += 64;
+				}
+				while (n - i >= 32) {
+					__m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+					__m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+					unsigned int mask = ~static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+					if (mask != 0) {
+						return i + static_cast<std::size_t>(querier_mask_lowest(mask));
+					}
+					i += 32;
+				}
+				if (i != n) {
+					i = n - 32;
+					__m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+					__m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+					unsigned int mask = ~static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+					if (mask != 0) {
+						return i + static_cast<std::size_t>(querier_mask_lowest(mask));
+					}
+				}
+				return n;
+			}
+
+#	endif
+
+		} // namespace detail
+
+	} // namespace algorithm
+
+} // namespace kerbal
+
+#endif // KERBAL_ALGORITHM_DETAIL_SEQUENCE_COMPARE_X86_KERNEL_HPP
@@ -0,0 +1,187 @@
+/**
+ * @file       substring_search_simd.hpp
+ * @brief
+ * @date       2020-11-16
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_ALGORITHM_DETAIL_SUBSTRING_SEARCH_SIMD_HPP
+#define KERBAL_ALGORITHM_DETAIL_SUBSTRING_SEARCH_SIMD_HPP
+
+#include <kerbal/algorithm/detail/substring_search_x86_kernel.hpp>
+
+#include <kerbal/algorithm/horspool.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/compatibility/x86_cpu_feature.hpp>
+#include <kerbal/config/x86_intrinsics.hpp>
+#include <kerbal/iterator/iterator_traits.hpp>
+#include <kerbal/type_traits/cv_deduction.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+#include <kerbal/type_traits/is_same.hpp>
+#include <kerbal/type_traits/reference_deduction.hpp>
+#include <kerbal/type_traits/volatile_deduction.hpp>
+#include <kerbal/utility/addressof.hpp>
+
+#include <cstddef>
+#include <cstring>
+
+
+/*
+ * Without the vector kernels, the patterns of at least this many bytes are searched by Boyer-Moore-Horspool,
+ * whose shifts grow with the length of the pattern, the shorter ones by the memchr filter. The vector filter
+ * stays ahead of Horspool whatever the length of the pattern.
+ */
+#ifndef KERBAL_ALGORITHM_SUBSTRING_SEARCH_HORSPOOL_THRESHOLD
+#	define KERBAL_ALGORITHM_SUBSTRING_SEARCH_HORSPOOL_THRESHOLD 16
+#endif
+
+
+namespace kerbal
+{
+
+	namespace algorithm
+	{
+
+		namespace detail
+		{
+
+			/*
+			 * Both ranges are contiguous, not volatile and hold the same byte type.
+			 */
+			template <typename ContiguousIterator1, typename ContiguousIterator2>
+			struct substring_search_simd_helper
+			{
+					typedef typename kerbal::iterator::iterator_traits<ContiguousIterator1>::value_type value_type1;
+					typedef typename kerbal::iterator::iterator_traits<ContiguousIterator2>::value_type value_type2;
+					typedef typename kerbal::iterator::iterator_traits<ContiguousIterator1>::reference reference1;
+					typedef typename kerbal::iterator::iterator_traits<ContiguousIterator2>::reference reference2;
+					typedef typename kerbal::type_traits::remove_cv<value_type1>::type element_type;
+
+					typedef kerbal::type_traits::bool_constant<
+							kerbal::iterator::is_contiguous_iterator<ContiguousIterator1>::value &&
+							kerbal::iterator::is_contiguous_iterator<ContiguousIterator2>::value &&
+							!kerbal::type_traits::is_volatile<
+								typename kerbal::type_traits::remove_reference<reference1>::type
+							>::value &&
+							!kerbal::type_traits::is_volatile<
+								typename kerbal::type_traits::remove_reference<reference2>::type
+							>::value &&
+							kerbal::type_traits::is_same<
+								element_type, typename kerbal::type_traits::remove_cv<value_type2>::type
+							>::value &&
+							kerbal::algorithm::__horspool_byte_alphabet<element_type>::value
+					> ACCEPTABLE;
+			};
+
+			template <typename ContiguousIterator1, typename ContiguousIterator2>
+			struct substring_search_simd_enable:
+					substring_search_simd_helper<ContiguousIterator1, ContiguousIterator2>::ACCEPTABLE
+			{
+			};
+
+			/*
+			 * The portable first / last byte filter: memchr finds the candidates for the first byte.
+			 * pre: 2 <= m <= n
+			 */
+			inline
+			std::size_t substring_search_first_last(const unsigned char * h, std::size_t n,
+													const unsigned char * p, std::size_t m) KERBAL_NOEXCEPT
+			{
+				const unsigned char * it = h;
+				const unsigned char * const last_start = h + (n - m);
+				while (it <= last_start) {
+					const void * found = std::memchr(it, p[0], static_cast<std::size_t>(last_start - it) + 1);
+					if (found == NULL) {
+						break;
+					}
+					it = static_cast<const unsigned char *>(found);
+					if (it[m - 1] == p[m - 1] && std::memcmp(it + 1, p + 1, m - 2) == 0) {
+						return static_cast<std::size_t>(it - h);
+					}
+					++it;
+				}
+				return n;
+			}
+
+			/*
+			 * The offset of the first occurrence of [p, p + m) in [h, h + n), n if none.
+			 */
+			inline
+			std::size_t substring_search_simd(const unsigned char * h, std::size_t n,
+												const unsigned char * p, std::size_t m) KERBAL_NOEXCEPT
+			{
+				if (m == 0) {
+					return 0;
+				}
+				if (m > n) {
+					return n;
+				}
+				if (m == 1) {
+					const void * found = std::memchr(h, p[0], n);
+					return found == NULL ? n : static_cast<std::size_t>(static_cast<const unsigned char *>(found) - h);
+				}
+
+#	if KERBAL_X86_INTRINSICS_SUPPORTED
+
+				const kerbal::compatibility::x86_cpu_feature & feature = kerbal::compatibility::x86_cpu_feature::instance();
+				if (feature.avx2) {
+					return substring_search_first_last_avx2(h, n, p, m);
+				}
+				if (feature.sse2) {
+					return substring_search_first_last_sse2(h, n, p, m);
+				}
+
+#	endif
+
+				if (m >= KERBAL_ALGORITHM_SUBSTRING_SEARCH_HORSPOOL_THRESHOLD) {
+					return static_cast<std::size_t>(kerbal::algorithm::horspool(h, h + n, p, p + m) - h);
+				}
+				return substring_search_first_last(h, n, p, m);
+			}
+
+
+
+			/*
+			 * The entry of substring_search.hpp. The false_type overload is never called and only keeps the
+			 * portable function compiling for any type.
+			 */
+
+			template <typename ContiguousIterator1, typename ContiguousIterator2>
+			ContiguousIterator1
+			substring_search_simd(ContiguousIterator1 host_first, ContiguousIterator1 /*host_last*/,
+									ContiguousIterator2 /*pattern_first*/, ContiguousIterator2 /*pattern_last*/,
+									kerbal::type_traits::false_type) KERBAL_NOEXCEPT
+			{
+				return host_first;
+			}
+
+			template <typename ContiguousIterator1, typename ContiguousIterator2>
+			ContiguousIterator1
+			substring_search_simd(ContiguousIterator1 host_first, ContiguousIterator1 host_last,
+									ContiguousIterator2 pattern_first, ContiguousIterator2 pattern_last,
+									kerbal::type_traits::true_type) KERBAL_NOEXCEPT
+			{
+				std::size_t n = static_cast<std::size_t>(host_last - host_first);
+				std::size_t m = static_cast<std::size_t>(pattern_last - pattern_first);
+				if (m == 0) {
+					return host_first;
+				}
+				if (m > n) {
+					return host_last;
+				}
+				const unsigned char * h = reinterpret_cast<const unsigned char *>(kerbal::utility::addressof(*host_first));
+				const unsigned char * p = reinterpret_cast<const unsigned char *>(kerbal::utility::addressof(*pattern_first));
+				return host_first + static_cast<std::ptrdiff_t>(substring_search_simd(h, n, p, m));
+			}
+
+		} // namespace detail
+
+	} // namespace algorithm
+
+} // namespace kerbal
+
+#endif // KERBAL_ALGORITHM_DETAIL_SUBSTRING_SEARCH_SIMD_HPP
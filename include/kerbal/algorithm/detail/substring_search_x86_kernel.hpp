@@ -0,0 +1,137 @@
+/**
+ * @file       substring_search_x86_kernel.hpp
+ * @brief
+ * @date       2020-11-16
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_ALGORITHM_DETAIL_SUBSTRING_SEARCH_X86_KERNEL_HPP
+#define KERBAL_ALGORITHM_DETAIL_SUBSTRING_SEARCH_X86_KERNEL_HPP
+
+#include <kerbal/algorithm/detail/querier_x86_kernel.hpp>
+
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/config/x86_intrinsics.hpp>
+
+#include <cstddef>
+#include <cstring>
+
+namespace kerbal
+{
+
+	namespace algorithm
+	{
+
+		namespace detail
+		{
+
+#	if KERBAL_X86_INTRINSICS_SUPPORTED
+
+			/*
+			 * First / last byte filter: a vector of host bytes is compared with the first byte of the pattern,
+			 * the vector m - 1 bytes further with its last one, and only the starts where both match have their
+			 * middle bytes compared. The last vector is loaded overlapping the previous ones and the starts
+			 * already tested are masked out.
+			 *
+			 * The offset of the first occurrence of [p, p + m) in [h, h + n), n if none.
+			 * pre: 2 <= m <= n
+			 */
+			KERBAL_X86_TARGET("sse2")
+			inline
+			std::size_t substring_search_first_last_sse2(const unsigned char * h, std::size_t n,
+														const unsigned char * p, std::size_t m) KERBAL_NOEXCEPT
+			{
+				const std::size_t last_start = n - m;
+				const __m128i first = _mm_set1_epi8(static_cast<char>(p[0]));
+				const __m128i last = _mm_set1_epi8(static_cast<char>(p[m - 1]));
+
+#		define KERBAL_SUBSTRING_SEARCH_SSE2_MASK(i) \
+				static_cast<unsigned int>(_mm_movemask_epi8(_mm_and_si128( \
+					_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(h + (i))), first), \
+					_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(h + (i) + m - 1)), last) \
+				)))
+
+#		define KERBAL_SUBSTRING_SEARCH_VERIFY(i, mask) do { \
+					while (mask != 0) { \
+						std::size_t k = (i) + static_cast<std::size_t>(querier_mask_lowest(mask)); \
+						if (std::memcmp(h + k + 1, p + 1, m - 2) == 0) { \
+							return k; \
+						} \
+						mask &= mask - 1; \
+					} \
+				} while (false)
+
+				if (last_start < 15) {
+					for (std::size_t i = 0; i <= last_start; ++i) {
+						if (h[i] == p[0] && h[i + m - 1] == p[m - 1] && std::memcmp(h + i + 1, p + 1, m - 2) == 0) {
+							return i;
+						}
+					}
+					return n;
+				}
+				std::size_t i = 0;
+				while (i + 15 <= last_start) {
+					unsigned int mask = KERBAL_SUBSTRING_SEARCH_SSE2_MASK(i);
+					KERBAL_SUBSTRING_SEARCH_VERIFY(i, mask);
+					i += 16;
+				}
+				if (i <= last_start) {
+					std::size_t j = last_start - 15;
+					unsigned int mask = KERBAL_SUBSTRING_SEARCH_SSE2_MASK(j) & (~0u << (i - j));
+					KERBAL_SUBSTRING_SEARCH_VERIFY(j, mask);
+				}
+				return n;
+
+#		undef KERBAL_SUBSTRING_SEARCH_SSE2_MASK
+
+			}
+
+			KERBAL_X86_TARGET("avx2")
+			inline
+			std::size_t substring_search_first_last_avx2(const unsigned char * h, std::size_t n,
+														const unsigned char * p, std::size_t m) KERBAL_NOEXCEPT
+			{
+				const std::size_t last_start = n - m;
+				if (last_start < 31) {
+					return substring_search_first_last_sse2(h, n, p, m);
+				}
+				const __m256i first = _mm256_set1_epi8(static_cast<char>(p[0]));
+				const __m256i last = _mm256_set1_epi8(static_cast<char>(p[m - 1]));
+
+#		define KERBAL_SUBSTRING_SEARCH_AVX2_MASK(i) \
+				static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_and_si256( \
+					_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(h + (i))), first), \
+					_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(h + (i) + m - 1)), last) \
+				)))
+
+				std::size_t i = 0;
+				while (i + 31 <= last_start) {
+					unsigned int mask = KERBAL_SUBSTRING_SEARCH_AVX2_MASK(i);
+					KERBAL_SUBSTRING_SEARCH_VERIFY(i, mask);
+					i += 32;
+				}
+				if (i <= last_start) {
+					std::size_t j = last_start - 31;
+					unsigned int mask = KERBAL_SUBSTRING_SEARCH_AVX2_MASK(j) & (~0u << (i - j));
+					KERBAL_SUBSTRING_SEARCH_VERIFY(j, mask);
+				}
+				return n;
+
+#		undef KERBAL_SUBSTRING_SEARCH_AVX2_MASK
+#		undef KERBAL_SUBSTRING_SEARCH_VERIFY
+
+			}
+
+#	endif
+
+		} // namespace detail
+
+	} // namespace algorithm
+
+} // namespace kerbal
+
+#endif // KERBAL_ALGORITHM_DETAIL_SUBSTRING_SEARCH_X86_KERNEL_HPP
@@ -13,9 +13,16 @@
 #define KERBAL_ALGORITHM_HEAP_HPP
 
 #include <kerbal/algorithm/swap.hpp>
+#include <kerbal/compatibility/constexpr.hpp>
+#include <kerbal/compatibility/move.hpp>
+#include <kerbal/compatibility/static_assert.hpp>
 #include <kerbal/iterator/iterator.hpp>
 #include <kerbal/iterator/iterator_traits.hpp>
 
+#include <climits>
+#include <cstddef>
+#include <functional>
+
 namespace kerbal
 {
 
@@ -214,6 +221,58 @@ namespace kerbal
 				kerbal::algorithm::detail::adjust_top_down_unguarded(first, last, cmp, kerbal::iterator::iterator_category(first));
 			}
 
+			/*
+			 * Bottom-up ("bounce") pop of a d-ary heap: the hole left by the top goes down along the greatest sons
+			 * to a leaf without comparing them with the back element, which is then sifted up from the leaf. As
+			 * the back element usually belongs near the leaves, this spends about one comparison less per level
+			 * than the usual sift-down, i.e. half of them for a binary heap.
+			 *
+			 * pre: last - first >= 2
+			 */
+			template <std::size_t Arity, typename RandomAccessIterator, typename Compare>
+			KERBAL_CONSTEXPR14
+			void heap_pop_bottom_up(RandomAccessIterator first, RandomAccessIterator last, Compare cmp)
+			{
+				typedef RandomAccessIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+
+				const difference_type arity(static_cast<difference_type>(Arity));
+
+				--last;
+				value_type back(kerbal::compatibility::to_xvalue(*last));
+				*last = kerbal::compatibility::to_xvalue(*first);
+
+				difference_type len(kerbal::iterator::distance(first, last));
+				difference_type hole(0);
+				if (len >= 2) {
+					const difference_type last_parent((len - 2) / arity);
+					while (hole <= last_parent) {
+						difference_type son(hole * arity + 1);
+						difference_type sons_end(len - son > arity ? son + arity : len);
+						difference_type max_one(son);
+						for (++son; son < sons_end; ++son) {
+							if (cmp(first[max_one], first[son])) {
+								max_one = son;
+							}
+						}
+						first[hole] = kerbal::compatibility::to_xvalue(first[max_one]);
+						hole = max_one;
+					}
+				}
+				while (hole > 0) {
+					difference_type parent((hole - 1) / arity);
+					if (cmp(first[parent], back)) { // parent < back
+						first[hole] = kerbal::compatibility::to_xvalue(first[parent]);
+						hole = parent;
+					} else {
+						break;
+					}
+				}
+				first[hole] = kerbal::compatibility::to_xvalue(back);
+			}
+
+
 		} // namespace detail
 
 		template <typename BidirectionalIterator, typename Compare>
@@ -246,17 +305,40 @@ namespace kerbal
 			kerbal::algorithm::push_heap(first, last, std::less<value_type>());
 		}
 
-		template <typename BidirectionalIterator, typename Compare>
-		KERBAL_CONSTEXPR14
-		void pop_heap(BidirectionalIterator first, BidirectionalIterator last, Compare cmp)
+		namespace detail
 		{
-			if (first != last) {
-				--last;
+
+			template <typename BidirectionalIterator, typename Compare>
+			KERBAL_CONSTEXPR14
+			void pop_heap(BidirectionalIterator first, BidirectionalIterator last, Compare cmp,
+							std::bidirectional_iterator_tag)
+			{
 				if (first != last) {
-					kerbal::algorithm::iter_swap(first, last);
-					kerbal::algorithm::detail::adjust_top_down_unguarded(first, last, cmp);
+					--last;
+					if (first != last) {
+						kerbal::algorithm::iter_swap(first, last);
+						kerbal::algorithm::detail::adjust_top_down_unguarded(first, last, cmp);
+					}
+				}
+			}
+
+			template <typename RandomAccessIterator, typename Compare>
+			KERBAL_CONSTEXPR14
+			void pop_heap(RandomAccessIterator first, RandomAccessIterator last, Compare cmp,
+							std::random_access_iterator_tag)
+			{
+				if (kerbal::iterator::distance(first, last) >= 2) {
+					kerbal::algorithm::detail::heap_pop_bottom_up<2>(first, last, cmp);
 				}
 			}
+
+		} // namespace detail
+
+		template <typename BidirectionalIterator, typename Compare>
+		KERBAL_CONSTEXPR14
+		void pop_heap(BidirectionalIterator first, BidirectionalIterator last, Compare cmp)
+		{
+			kerbal::algorithm::detail::pop_heap(first, last, cmp, kerbal::iterator::iterator_category(first));
 		}
 
 		template <typename BidirectionalIterator>
@@ -268,20 +350,44 @@ namespace kerbal
 			kerbal::algorithm::pop_heap(first, last, std::less<value_type>());
 		}
 
+		namespace detail
+		{
+
+			template <typename BidirectionalIterator, typename Compare>
+			KERBAL_CONSTEXPR14
+			void sort_heap(BidirectionalIterator first, BidirectionalIterator last, Compare cmp,
+							std::bidirectional_iterator_tag)
+			{
+				typedef BidirectionalIterator iterator;
+				if (first == last) {
+					return;
+				}
+				iterator next_after_first(kerbal::iterator::next(first));
+				while (next_after_first != last) {
+					--last;
+					kerbal::algorithm::iter_swap(first, last);
+					kerbal::algorithm::detail::adjust_top_down_unguarded(first, last, cmp);
+				}
+			}
+
+			template <typename RandomAccessIterator, typename Compare>
+			KERBAL_CONSTEXPR14
+			void sort_heap(RandomAccessIterator first, RandomAccessIterator last, Compare cmp,
+							std::random_access_iterator_tag)
+			{
+				while (kerbal::iterator::distance(first, last) >= 2) {
+					kerbal::algorithm::detail::heap_pop_bottom_up<2>(first, last, cmp);
+					--last;
+				}
+			}
+
+		} // namespace detail
+
 		template <typename BidirectionalIterator, typename Compare>
 		KERBAL_CONSTEXPR14
 		void sort_heap(BidirectionalIterator first, BidirectionalIterator last, Compare cmp)
 		{
-			typedef BidirectionalIterator iterator;
-			if (first == last) {
-				return;
-			}
-			iterator next_after_first(kerbal::iterator::next(first));
-			while (next_after_first != last) {
-				--last;
-				kerbal::algorithm::iter_swap(first, last);
-				kerbal::algorithm::detail::adjust_top_down_unguarded(first, last, cmp);
-			}
+			kerbal::algorithm::detail::sort_heap(first, last, cmp, kerbal::iterator::iterator_category(first));
 		}
 
 		template <typename BidirectionalIterator>
@@ -349,18 +455,84 @@ namespace kerbal
 		namespace detail
 		{
 
+			/*
+			 * Sifts down the father at index i of a heap of length len. level_first[k] is the leftmost descendant
+			 * of the father at depth k, for k <= height: the son at depth k is reached from it, in less than 2^k
+			 * steps, rather than from its own father, in as many steps as the index of the latter.
+			 */
+			template <typename BidirectionalIterator, typename Compare>
+			KERBAL_CONSTEXPR14
+			void heap_adjust_down_walk(const BidirectionalIterator * level_first, int height,
+									typename kerbal::iterator::iterator_traits<BidirectionalIterator>::difference_type i,
+									typename kerbal::iterator::iterator_traits<BidirectionalIterator>::difference_type len,
+									Compare cmp)
+			{
+				typedef BidirectionalIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+
+				iterator current(level_first[0]);
+				difference_type offset(0); // of current from level_first[k]
+				for (int k = 1; k <= height; ++k) {
+					difference_type son(2 * i + 1);
+					if (son >= len) {
+						break;
+					}
+					offset *= 2;
+					iterator max_one(kerbal::iterator::next(level_first[k], offset));
+					if (son + 1 < len) {
+						iterator right_son(kerbal::iterator::next(max_one));
+						if (cmp(*max_one, *right_son)) {
+							max_one = right_son;
+							++son;
+							++offset;
+						}
+					}
+					if (cmp(*current, *max_one)) { // current < max_one
+						kerbal::algorithm::iter_swap(current, max_one);
+						current = max_one;
+						i = son;
+					} else {
+						break;
+					}
+				}
+			}
+
+			/*
+			 * Floyd's construction: sift down every father, from the last one back to the root, in O(n) comparisons.
+			 * The leftmost descendants of the father at each depth k, i.e. the indices (i + 1) * 2^k - 1, move back
+			 * by 2^k along with it. Moving them and sifting down both cost O(n / i) steps for the father i, so
+			 * O(n log n) steps in all.
+			 */
 			template <typename BidirectionalIterator, typename Compare>
 			KERBAL_CONSTEXPR14
 			void make_heap(BidirectionalIterator first, BidirectionalIterator last, Compare cmp, std::bidirectional_iterator_tag)
 			{
 				typedef BidirectionalIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
 
-				iterator current_adjust(first);
-				while (current_adjust != last) {
-					kerbal::algorithm::push_heap(first, current_adjust, cmp);
-					++current_adjust;
+				difference_type len(kerbal::iterator::distance(first, last));
+				if (len < 2) {
+					return;
+				}
+				iterator level_first[sizeof(difference_type) * CHAR_BIT];
+				difference_type i((len - 2) / 2);
+				level_first[0] = kerbal::iterator::next(first, i);
+				int height = 0; // the deepest depth where the father has a descendant
+				while (true) {
+					// (i + 1) * 2^(height + 1) - 1 < len
+					while ((i + 1) <= (len >> (height + 1))) {
+						level_first[height + 1] = kerbal::iterator::next(level_first[height], (i + 1) << height);
+						++height;
+					}
+					kerbal::algorithm::detail::heap_adjust_down_walk(level_first + 0, height, i, len, cmp);
+					if (i == 0) {
+						break;
+					}
+					for (int k = 0; k <= height; ++k) {
+						level_first[k] = kerbal::iterator::prev(level_first[k], static_cast<difference_type>(1) << k);
+					}
+					--i;
 				}
-				kerbal::algorithm::push_heap(first, last, cmp);
 			}
 
 			template <typename RandomAccessIterator, typename Compare>
@@ -409,6 +581,308 @@ namespace kerbal
 			kerbal::algorithm::make_heap(first, last, std::less<value_type>());
 		}
 
+
+		/*
+		 * d-ary heaps
+		 *
+		 * The overloads taking the arity as their first template argument, e.g. push_heap<4>(first, last, cmp),
+		 * work on a heap in which node i has the sons Arity * i + 1, ..., Arity * i + Arity. A wider heap is
+		 * shallower, so push does fewer comparisons and the sons of a node share a cache line or two, which
+		 * usually makes 4-ary and 8-ary heaps faster than binary ones for workloads dominated by push and pop.
+		 * They require random access iterators. The overloads without the arity work on binary heaps.
+		 */
+
+		namespace detail
+		{
+
+			template <std::size_t Arity, typename RandomAccessIterator, typename Compare>
+			KERBAL_CONSTEXPR14
+			void d_ary_heap_adjust_up(RandomAccessIterator first,
+									typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type current,
+									Compare cmp)
+			{
+				KERBAL_STATIC_ASSERT(Arity >= 2, "the arity of a heap must be at least 2");
+
+				typedef typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+
+				while (current > 0) {
+					difference_type parent((current - 1) / static_cast<difference_type>(Arity));
+					if (cmp(first[parent], first[current])) { // parent < current
+						kerbal::algorithm::iter_swap(first + parent, first + current);
+						current = parent;
+					} else {
+						break;
+					}
+				}
+			}
+
+			template <std::size_t Arity, typename RandomAccessIterator, typename Compare>
+			KERBAL_CONSTEXPR14
+			void d_ary_heap_adjust_down(RandomAccessIterator first,
+									typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type current,
+									typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type len,
+									Compare cmp)
+			{
+				KERBAL_STATIC_ASSERT(Arity >= 2, "the arity of a heap must be at least 2");
+
+				typedef typename kerbal::iterator::iterator_traits<RandomAccessIterator>::difference_type difference_type;
+
+				const difference_type arity(static_cast<difference_type>(Arity));
+				if (len < 2) {
+					return;
+				}
+				const difference_type last_parent((len - 2) / arity);
+				while (current <= last_parent) {
+					difference_type son(current * arity + 1);
+					difference_type sons_end(len - son > arity ? son + arity : len);
+					difference_type max_one(son);
+					for (++son; son < sons_end; ++son) {
+						if (cmp(first[max_one], first[son])) {
+							max_one = son;
+						}
+					}
+					if (cmp(first[current], first[max_one])) { // current < max_one
+						kerbal::algorithm::iter_swap(first + current, first + max_one);
+						current = max_one;
+					} else {
+						break;
+					}
+				}
+			}
+
+		} // namespace detail
+
+		template <std::size_t Arity, typename RandomAccessIterator, typename Compare>
+		KERBAL_CONSTEXPR14
+		void push_heap(RandomAccessIterator first, RandomAccessIterator last, Compare cmp)
+		{
+			if (first == last) {
+				return;
+			}
+			kerbal::algorithm::detail::d_ary_heap_adjust_up<Arity>(first, kerbal::iterator::distance(first, last) - 1, cmp);
+		}
+
+		template <std::size_t Arity, typename RandomAccessIterator>
+		KERBAL_CONSTEXPR14
+		void push_heap(RandomAccessIterator first, RandomAccessIterator last)
+		{
+			typedef RandomAccessIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+			kerbal::algorithm::push_heap<Arity>(first, last, std::less<value_type>());
+		}
+
+		template <std::size_t Arity, typename RandomAccessIterator, typename Compare>
+		KERBAL_CONSTEXPR14
+		void pop_heap(RandomAccessIterator first, RandomAccessIterator last, Compare cmp)
+		{
+			KERBAL_STATIC_ASSERT(Arity >= 2, "the arity of a heap must be at least 2");
+
+			if (kerbal::iterator::distance(first, last) >= 2) {
+				kerbal::algorithm::detail::heap_pop_bottom_up<Arity>(first, last, cmp);
+			}
+		}
+
+		template <std::size_t Arity, typename RandomAccessIterator>
+		KERBAL_CONSTEXPR14
+		void pop_heap(RandomAccessIterator first, RandomAccessIterator last)
+		{
+			typedef RandomAccessIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+			kerbal::algorithm::pop_heap<Arity>(first, last, std::less<value_type>());
+		}
+
+		template <std::size_t Arity, typename RandomAccessIterator, typename Compare>
+		KERBAL_CONSTEXPR14
+		void sort_heap(RandomAccessIterator first, RandomAccessIterator last, Compare cmp)
+		{
+			while (kerbal::iterator::distance(first, last) > 1) {
+				kerbal::algorithm::pop_heap<Arity>(first, last, cmp);
+				--last;
+			}
+		}
+
+		template <std::size_t Arity, typename RandomAccessIterator>
+		KERBAL_CONSTEXPR14
+		void sort_heap(RandomAccessIterator first, RandomAccessIterator last)
+		{
+			typedef RandomAccessIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+			kerbal::algorithm::sort_heap<Arity>(first, last, std::less<value_type>());
+		}
+
+		template <std::size_t Arity, typename RandomAccessIterator, typename Compare>
+		KERBAL_CONSTEXPR14
+		RandomAccessIterator
+		is_heap_until(RandomAccessIterator first, RandomAccessIterator last, Compare cmp)
+		{
+			KERBAL_STATIC_ASSERT(Arity >= 2, "the arity of a heap must be at least 2");
+
+			typedef RandomAccessIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+
+			difference_type len(kerbal::iterator::distance(first, last));
+			for (difference_type i = 1; i < len; ++i) {
+				if (cmp(first[(i - 1) / static_cast<difference_type>(Arity)], first[i])) {
+					return first + i;
+				}
+			}
+			return last;
+		}
+
+		template <std::size_t Arity, typename RandomAccessIterator>
+		KERBAL_CONSTEXPR14
+		RandomAccessIterator
+		is_heap_until(RandomAccessIterator first, RandomAccessIterator last)
+		{
+			typedef RandomAccessIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+			return kerbal::algorithm::is_heap_until<Arity>(first, last, std::less<value_type>());
+		}
+
+		template <std::size_t Arity, typename RandomAccessIterator, typename Compare>
+		KERBAL_CONSTEXPR14
+		bool is_heap(RandomAccessIterator first, RandomAccessIterator last, Compare cmp)
+		{
+			return kerbal::algorithm::is_heap_until<Arity>(first, last, cmp) == last;
+		}
+
+		template <std::size_t Arity, typename RandomAccessIterator>
+		KERBAL_CONSTEXPR14
+		bool is_heap(RandomAccessIterator first, RandomAccessIterator last)
+		{
+			typedef RandomAccessIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+			return kerbal::algorithm::is_heap<Arity>(first, last, std::less<value_type>());
+		}
+
+		template <std::size_t Arity, typename RandomAccessIterator, typename Compare>
+		KERBAL_CONSTEXPR14
+		void make_heap(RandomAccessIterator first, RandomAccessIterator last, Compare cmp)
+		{
+			typedef RandomAccessIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+
+			difference_type len(kerbal::iterator::distance(first, last));
+			if (len < 2) {
+				return;
+			}
+			difference_type current((len - 2) / static_cast<difference_type>(Arity)); // the last parent
+			while (true) {
+				kerbal::algorithm::detail::d_ary_heap_adjust_down<Arity>(first, current, len, cmp);
+				if (current == 0) {
+					break;
+				}
+				--current;
+			}
+		}
+
+		template <std::size_t Arity, typename RandomAccessIterator>
+		KERBAL_CONSTEXPR14
+		void make_heap(RandomAccessIterator first, RandomAccessIterator last)
+		{
+			typedef RandomAccessIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+			kerbal::algorithm::make_heap<Arity>(first, last, std::less<value_type>());
+		}
+
+
+
+		namespace detail
+		{
+
+			/*
+			 * Whether it is cheaper to rebuild a heap of len elements, k of which are new, than to push the new
+			 * ones: Floyd's construction costs about 2 * len comparisons, k pushes up to k * log2(len).
+			 */
+			template <typename Size>
+			KERBAL_CONSTEXPR14
+			bool heap_push_range_rebuild(Size len, Size k)
+			{
+				Size log2_len(0);
+				for (Size n(len); n > 1; n >>= 1) {
+					++log2_len;
+				}
+				return k * log2_len > 2 * len;
+			}
+
+		} // namespace detail
+
+		/**
+		 * Makes [first, last) a heap, given that [first, middle) is one. The elements of [middle, last) are
+		 * pushed one by one, or the whole range is rebuilt when there are many of them.
+		 */
+		template <std::size_t Arity, typename RandomAccessIterator, typename Compare>
+		KERBAL_CONSTEXPR14
+		void heap_push_range(RandomAccessIterator first, RandomAccessIterator middle, RandomAccessIterator last, Compare cmp)
+		{
+			typedef RandomAccessIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+
+			difference_type len(kerbal::iterator::distance(first, last));
+			difference_type k(kerbal::iterator::distance(middle, last));
+			if (kerbal::algorithm::detail::heap_push_range_rebuild(len, k)) {
+				kerbal::algorithm::make_heap<Arity>(first, last, cmp);
+				return;
+			}
+			while (middle != last) {
+				++middle;
+				kerbal::algorithm::push_heap<Arity>(first, middle, cmp);
+			}
+		}
+
+		template <std::size_t Arity, typename RandomAccessIterator>
+		KERBAL_CONSTEXPR14
+		void heap_push_range(RandomAccessIterator first, RandomAccessIterator middle, RandomAccessIterator last)
+		{
+			typedef RandomAccessIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+			kerbal::algorithm::heap_push_range<Arity>(first, middle, last, std::less<value_type>());
+		}
+
+		namespace detail
+		{
+
+			template <typename BidirectionalIterator, typename Compare>
+			KERBAL_CONSTEXPR14
+			void heap_push_range(BidirectionalIterator first, BidirectionalIterator middle, BidirectionalIterator last,
+								Compare cmp, std::bidirectional_iterator_tag)
+			{
+				while (middle != last) {
+					++middle;
+					kerbal::algorithm::push_heap(first, middle, cmp);
+				}
+			}
+
+			template <typename RandomAccessIterator, typename Compare>
+			KERBAL_CONSTEXPR14
+			void heap_push_range(RandomAccessIterator first, RandomAccessIterator middle, RandomAccessIterator last,
+								Compare cmp, std::random_access_iterator_tag)
+			{
+				kerbal::algorithm::heap_push_range<2>(first, middle, last, cmp);
+			}
+
+		} // namespace detail
+
+		/**
+		 * Makes [first, last) a binary heap, given that [first, middle) is one.
+		 */
+		template <typename BidirectionalIterator, typename Compare>
+		KERBAL_CONSTEXPR14
+		void heap_push_range(BidirectionalIterator first, BidirectionalIterator middle, BidirectionalIterator last,
+							Compare cmp)
+		{
+			kerbal::algorithm::detail::heap_push_range(first, middle, last, cmp, kerbal::iterator::iterator_category(first));
+		}
+
+		template <typename BidirectionalIterator>
+		KERBAL_CONSTEXPR14
+		void heap_push_range(BidirectionalIterator first, BidirectionalIterator middle, BidirectionalIterator last)
+		{
+			typedef BidirectionalIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+			kerbal::algorithm::heap_push_range(first, middle, last, std::less<value_type>());
+		}
+
 	} // namespace algorithm
 
 } // namespace kerbal
@@ -0,0 +1,139 @@
+/**
+ * @file       horspool.hpp
+ * @brief
+ * @date       2020-11-16
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_ALGORITHM_HORSPOOL_HPP
+#define KERBAL_ALGORITHM_HORSPOOL_HPP
+
+#include <kerbal/compatibility/constexpr.hpp>
+#include <kerbal/compatibility/static_assert.hpp>
+#include <kerbal/iterator/iterator.hpp>
+#include <kerbal/iterator/iterator_traits.hpp>
+#include <kerbal/type_traits/cv_deduction.hpp>
+#include <kerbal/type_traits/fundamental_deduction.hpp>
+
+#include <cstddef>
+
+namespace kerbal
+{
+
+	namespace algorithm
+	{
+
+		/*
+		 * Boyer-Moore-Horspool works over a byte alphabet: the shift table is indexed by the byte of the host
+		 * aligned with the last one of the pattern.
+		 */
+		template <typename Tp>
+		struct __horspool_byte_alphabet
+		{
+				typedef typename kerbal::type_traits::remove_cv<Tp>::type type;
+
+				static const bool value = kerbal::type_traits::is_integral<type>::value && sizeof(type) == 1;
+		};
+
+		/**
+		 * @brief Generate the bad character shift table of pattern.
+		 *
+		 * @param shift_table   Array, vector, etc. of at least 256 std::size_t, the distance the pattern can slide
+		 *                      by according to the host byte aligned with its last byte.
+		 */
+		template <typename ForwardIterator, typename ShiftTable>
+		KERBAL_CONSTEXPR14
+		void horspool_shift_table(ForwardIterator pattern_first, ForwardIterator pattern_last, ShiftTable & shift_table)
+		{
+			typedef typename kerbal::iterator::iterator_traits<ForwardIterator>::value_type pattern_value_type;
+
+			KERBAL_STATIC_ASSERT(__horspool_byte_alphabet<pattern_value_type>::value,
+								"horspool needs a pattern of bytes");
+
+			std::size_t m = static_cast<std::size_t>(kerbal::iterator::distance(pattern_first, pattern_last));
+			for (std::size_t c = 0; c < 256; ++c) {
+				shift_table[c] = m;
+			}
+			if (m == 0) {
+				return;
+			}
+			std::size_t i = 0;
+			while (i != m - 1) {
+				shift_table[static_cast<unsigned char>(*pattern_first)] = m - 1 - i;
+				++pattern_first;
+				++i;
+			}
+		}
+
+		/**
+		 * @brief Find the first occurrence of [pattern_first, pattern_last) in [host_first, host_last).
+		 *
+		 * @param shift_table   The table horspool_shift_table generated for the pattern.
+		 * @return Iterator to the beginning of the occurrence, host_last if none.
+		 */
+		template <typename RandomAccessHostIterator, typename ForwardPatternIterator, typename ShiftTable>
+		KERBAL_CONSTEXPR14
+		RandomAccessHostIterator
+		horspool(RandomAccessHostIterator host_first, RandomAccessHostIterator host_last,
+				ForwardPatternIterator pattern_first, ForwardPatternIterator pattern_last,
+				const ShiftTable & shift_table)
+		{
+			typedef RandomAccessHostIterator host_iterator;
+			typedef ForwardPatternIterator pattern_iterator;
+			typedef typename kerbal::iterator::iterator_traits<host_iterator>::value_type host_value_type;
+			typedef typename kerbal::iterator::iterator_traits<host_iterator>::difference_type difference_type;
+
+			KERBAL_STATIC_ASSERT(__horspool_byte_alphabet<host_value_type>::value,
+								"horspool needs a host of bytes");
+
+			difference_type m(kerbal::iterator::distance(pattern_first, pattern_last));
+			if (m == 0) {
+				return host_first;
+			}
+			if (host_last - host_first < m) {
+				return host_last;
+			}
+
+			pattern_iterator pattern_back(kerbal::iterator::next(pattern_first, m - 1));
+			host_iterator it(host_first + (m - 1)); // the host byte aligned with pattern_back
+			while (true) {
+				if (*it == *pattern_back) {
+					host_iterator h(it - (m - 1));
+					pattern_iterator p(pattern_first);
+					while (p != pattern_back && *h == *p) {
+						++h;
+						++p;
+					}
+					if (p == pattern_back) {
+						return it - (m - 1);
+					}
+				}
+				std::size_t shift = shift_table[static_cast<unsigned char>(*it)];
+				if (static_cast<std::size_t>(host_last - it) <= shift) {
+					break;
+				}
+				it += static_cast<difference_type>(shift);
+			}
+			return host_last;
+		}
+
+		template <typename RandomAccessHostIterator, typename ForwardPatternIterator>
+		KERBAL_CONSTEXPR14
+		RandomAccessHostIterator
+		horspool(RandomAccessHostIterator host_first, RandomAccessHostIterator host_last,
+				ForwardPatternIterator pattern_first, ForwardPatternIterator pattern_last)
+		{
+			std::size_t shift_table[256] = {};
+			kerbal::algorithm::horspool_shift_table(pattern_first, pattern_last, shift_table);
+			return kerbal::algorithm::horspool(host_first, host_last, pattern_first, pattern_last, shift_table);
+		}
+
+	} // namespace algorithm
+
+} // namespace kerbal
+
+#endif // KERBAL_ALGORITHM_HORSPOOL_HPP
@@ -15,7 +15,9 @@
 #include <kerbal/algorithm/binary_type_predicate.hpp>
 #include <kerbal/algorithm/querier.hpp>
 #include <kerbal/algorithm/swap.hpp>
+#include <kerbal/algorithm/detail/modifier_simd.hpp>
 #include <kerbal/compatibility/constexpr.hpp>
+#include <kerbal/compatibility/is_constant_evaluated.hpp>
 #include <kerbal/compatibility/move.hpp>
 #include <kerbal/compatibility/noexcept.hpp>
 #include <kerbal/iterator/iterator.hpp>
@@ -57,6 +59,13 @@ namespace kerbal
 			typedef RandomAccessIterator iterator;
 			typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
 
+			typedef kerbal::algorithm::detail::modifier_simd_copy_enable<
+					iterator, OutputIterator, RandomAccessIteratorEnd
+			> SIMD_ENABLE;
+			if (SIMD_ENABLE::value && KERBAL_CONSTEXPR14_RUNTIME_PATH()) {
+				return kerbal::algorithm::detail::modifier_simd_copy(first, last, to, SIMD_ENABLE());
+			}
+
 #	define EACH() do {\
 				kerbal::operators::generic_assign(*to, *first); /*  *to = *first; */\
 				++to;\
@@ -198,6 +207,11 @@ namespace kerbal
 			typedef RandomAccessIterator iterator;
 			typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
 
+			typedef kerbal::algorithm::detail::modifier_simd_copy_enable<iterator, OutputIterator> SIMD_ENABLE;
+			if (SIMD_ENABLE::value && KERBAL_CONSTEXPR14_RUNTIME_PATH()) {
+				return kerbal::algorithm::detail::modifier_simd_copy_backward(first, last, to_last, SIMD_ENABLE());
+			}
+
 #	define EACH() do {\
 				--last;\
 				--to_last;\
@@ -326,6 +340,11 @@ namespace kerbal
 			typedef RandomAccessIterator iterator;
 			typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
 
+			typedef kerbal::algorithm::detail::modifier_simd_copy_enable<iterator, OutputIterator> SIMD_ENABLE;
+			if (SIMD_ENABLE::value && KERBAL_CONSTEXPR14_RUNTIME_PATH()) { // moving a trivially copyable object copies it
+				return kerbal::algorithm::detail::modifier_simd_copy(first, last, to, SIMD_ENABLE());
+			}
+
 #	define EACH() do {\
 				kerbal::operators::generic_assign(*to, kerbal::compatibility::to_xvalue(*first));\
 				/*  *to = kerbal::compatibility::to_xvalue(*first); */\
@@ -390,6 +409,11 @@ namespace kerbal
 			typedef RandomAccessIterator iterator;
 			typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
 
+			typedef kerbal::algorithm::detail::modifier_simd_copy_enable<iterator, OutputIterator> SIMD_ENABLE;
+			if (SIMD_ENABLE::value && KERBAL_CONSTEXPR14_RUNTIME_PATH()) {
+				return kerbal::algorithm::detail::modifier_simd_copy_backward(first, last, to_last, SIMD_ENABLE());
+			}
+
 #	define EACH() do {\
 				--last;\
 				--to_last;\
@@ -819,6 +843,13 @@ namespace kerbal
 			typedef RandomAccessIterator iterator;
 			typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
 
+			typedef kerbal::algorithm::detail::modifier_simd_fill_enable<iterator, Tp> SIMD_ENABLE;
+			if (SIMD_ENABLE::value && KERBAL_CONSTEXPR14_RUNTIME_PATH()) {
+				if (kerbal::algorithm::detail::modifier_simd_fill(first, last, val, SIMD_ENABLE())) {
+					return;
+				}
+			}
+
 #	define EACH() do {\
 				kerbal::operators::generic_assign(*first, val); /*  *first = val;  */\
 				++first;\
@@ -952,6 +983,13 @@ namespace kerbal
 			typedef RandomAccessIterator iterator;
 			typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
 
+			typedef kerbal::algorithm::detail::modifier_simd_iota_enable<iterator, Tp> SIMD_ENABLE;
+			if (SIMD_ENABLE::value && KERBAL_CONSTEXPR14_RUNTIME_PATH()) {
+				if (kerbal::algorithm::detail::modifier_simd_iota(first, last, value, SIMD_ENABLE())) {
+					return;
+				}
+			}
+
 #	define EACH() do {\
 				*first = value;\
 				++first;\
@@ -13,7 +13,9 @@
 #define KERBAL_ALGORITHM_QUERIER_HPP
 
 #include <kerbal/algorithm/binary_type_predicate.hpp>
+#include <kerbal/algorithm/detail/querier_simd.hpp>
 #include <kerbal/compatibility/constexpr.hpp>
+#include <kerbal/compatibility/is_constant_evaluated.hpp>
 #include <kerbal/compatibility/move.hpp>
 #include <kerbal/compatibility/noexcept.hpp>
 #include <kerbal/iterator/iterator.hpp>
@@ -149,6 +151,11 @@ namespace kerbal
 			typedef RandomAccessIterator iterator;
 			typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
 
+			typedef kerbal::algorithm::detail::querier_simd_find_enable<iterator, Type> SIMD_ENABLE;
+			if (SIMD_ENABLE::value && KERBAL_CONSTEXPR14_RUNTIME_PATH()) {
+				return kerbal::algorithm::detail::querier_simd_find(first, last, value, SIMD_ENABLE());
+			}
+
 #	define EACH() do {\
 				if (*first == value) {\
 					return first;\
@@ -474,6 +481,11 @@ namespace kerbal
 			typedef RandomAccessIterator iterator;
 			typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
 
+			typedef kerbal::algorithm::detail::querier_simd_count_enable<iterator, Type> SIMD_ENABLE;
+			if (SIMD_ENABLE::value && KERBAL_CONSTEXPR14_RUNTIME_PATH()) {
+				return kerbal::algorithm::detail::querier_simd_count(first, last, value, SIMD_ENABLE());
+			}
+
 			size_t cnt = 0;
 
 #	define EACH() do {\
@@ -601,6 +613,14 @@ namespace kerbal
 			typedef RandomAccessIterator iterator;
 			typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
 
+			typedef kerbal::algorithm::detail::querier_simd_min_max_enable<iterator, BinaryPredicate> SIMD_ENABLE;
+			if (SIMD_ENABLE::value && KERBAL_CONSTEXPR14_RUNTIME_PATH()) {
+				iterator result(first);
+				if (kerbal::algorithm::detail::querier_simd_better_element(first, last, pred, result, SIMD_ENABLE())) {
+					return result;
+				}
+			}
+
 			iterator selected(first);
 			if (first != last) {
 				++first;
@@ -701,6 +721,14 @@ namespace kerbal
 			typedef RandomAccessIterator iterator;
 			typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
 
+			typedef kerbal::algorithm::detail::querier_simd_min_max_enable<iterator, BinaryPredicate> SIMD_ENABLE;
+			if (SIMD_ENABLE::value && KERBAL_CONSTEXPR14_RUNTIME_PATH()) {
+				std::pair<iterator, iterator> result(first, first);
+				if (kerbal::algorithm::detail::querier_simd_minmax_element(first, last, pred, result, SIMD_ENABLE())) {
+					return result;
+				}
+			}
+
 			iterator mini(first);
 			iterator maxi(first);
 			if (first != last) {
@@ -0,0 +1,302 @@
+/**
+ * @file       search_policy.hpp
+ * @brief
+ * @date       2020-11-09
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_ALGORITHM_SEARCH_POLICY_HPP
+#define KERBAL_ALGORITHM_SEARCH_POLICY_HPP
+
+#include <kerbal/algorithm/binary_search.hpp>
+#include <kerbal/algorithm/binary_type_predicate.hpp>
+#include <kerbal/compatibility/constexpr.hpp>
+#include <kerbal/iterator/iterator.hpp>
+#include <kerbal/iterator/iterator_traits.hpp>
+
+namespace kerbal
+{
+
+	namespace algorithm
+	{
+
+		template <typename ForwardIterator, typename Tp, typename Comparator>
+		KERBAL_CONSTEXPR14
+		ForwardIterator
+		__exponential_lower_bound(ForwardIterator first, ForwardIterator last, const Tp & value,
+									ForwardIterator hint, Comparator comparator, std::forward_iterator_tag)
+		{
+			return kerbal::algorithm::lower_bound_hint(first, last, value, hint, comparator);
+		}
+
+		template <typename RandomAccessIterator, typename Tp, typename Comparator>
+		KERBAL_CONSTEXPR14
+		RandomAccessIterator
+		__exponential_lower_bound(RandomAccessIterator first, RandomAccessIterator last, const Tp & value,
+									RandomAccessIterator hint, Comparator comparator, std::random_access_iterator_tag)
+		{
+			typedef RandomAccessIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+
+			difference_type step(1);
+			if (hint != last && static_cast<bool>(comparator(*hint, value))) { // *hint < value, gallop forward
+				iterator lo(hint + 1);
+				while (last - lo > step) {
+					iterator probe(lo + (step - 1));
+					if (!static_cast<bool>(comparator(*probe, value))) { // *probe >= value
+						return kerbal::algorithm::__lower_bound(lo, probe, value, comparator,
+																std::random_access_iterator_tag());
+					}
+					lo = probe + 1;
+					step *= 2;
+				}
+				return kerbal::algorithm::__lower_bound(lo, last, value, comparator,
+														std::random_access_iterator_tag());
+			} else { // *hint >= value, gallop backward
+				iterator hi(hint);
+				while (hi - first > step) {
+					iterator probe(hi - step);
+					if (static_cast<bool>(comparator(*probe, value))) { // *probe < value
+						return kerbal::algorithm::__lower_bound(probe + 1, hi, value, comparator,
+																std::random_access_iterator_tag());
+					}
+					hi = probe;
+					step *= 2;
+				}
+				return kerbal::algorithm::__lower_bound(first, hi, value, comparator,
+														std::random_access_iterator_tag());
+			}
+		}
+
+		/**
+		 * Gallops from hint with steps of 1, 2, 4, ... until it passes the position of value, then binary
+		 * searches the last step. It costs O(log d) comparisons, where d is the distance from hint to the result,
+		 * which makes it the search of choice when successive queries are close to each other.
+		 *
+		 * @param comparator requires: comparator(value_type, Tp)
+		 */
+		template <typename ForwardIterator, typename Tp, typename Comparator>
+		KERBAL_CONSTEXPR14
+		ForwardIterator
+		exponential_lower_bound(ForwardIterator first, ForwardIterator last, const Tp & value,
+								ForwardIterator hint, Comparator comparator)
+		{
+			return kerbal::algorithm::__exponential_lower_bound(first, last, value, hint, comparator,
+																kerbal::iterator::iterator_category(first));
+		}
+
+		template <typename ForwardIterator, typename Tp>
+		KERBAL_CONSTEXPR14
+		ForwardIterator
+		exponential_lower_bound(ForwardIterator first, ForwardIterator last, const Tp & value, ForwardIterator hint)
+		{
+			typedef ForwardIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type type;
+			return kerbal::algorithm::exponential_lower_bound(first, last, value, hint,
+																kerbal::algorithm::binary_type_less<type, Tp>());
+		}
+
+
+
+		/**
+		 * The metric of interpolation_lower_bound for arithmetic elements: the signed distance from value to item.
+		 */
+		struct interpolation_default_metric
+		{
+				template <typename Up, typename Tp>
+				KERBAL_CONSTEXPR
+				double operator()(const Up & item, const Tp & value) const
+				{
+					return static_cast<double>(item) - static_cast<double>(value);
+				}
+		};
+
+		template <typename ForwardIterator, typename Tp, typename Comparator, typename Metric>
+		KERBAL_CONSTEXPR14
+		ForwardIterator
+		__interpolation_lower_bound(ForwardIterator first, ForwardIterator last, const Tp & value,
+									Comparator comparator, Metric /*metric*/, std::forward_iterator_tag)
+		{
+			return kerbal::algorithm::lower_bound(first, last, value, comparator);
+		}
+
+		template <typename RandomAccessIterator, typename Tp, typename Comparator, typename Metric>
+		KERBAL_CONSTEXPR14
+		RandomAccessIterator
+		__interpolation_lower_bound(RandomAccessIterator first, RandomAccessIterator last, const Tp & value,
+									Comparator comparator, Metric metric, std::random_access_iterator_tag)
+		{
+			typedef RandomAccessIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+
+			// below it the binary search is as fast and does not pay for the arithmetic of the probes
+			const difference_type threshold(8);
+
+			// the result is in [first, last]
+			while (last - first > threshold) {
+				iterator back(last - 1);
+				if (!static_cast<bool>(comparator(*first, value))) { // *first >= value
+					return first;
+				}
+				if (static_cast<bool>(comparator(*back, value))) { // *back < value
+					return last;
+				}
+
+				// *first < value <= *back
+				difference_type len(last - first);
+				double dfirst = metric(*first, value);
+				double dback = metric(*back, value);
+				double ratio = dfirst / (dfirst - dback);
+				difference_type n(back - first);
+				difference_type offset(1);
+				if (ratio >= 1.0) { // also catches a ratio of inf
+					offset = n - 1;
+				} else if (ratio > 0.0) { // not taken by NaN
+					offset = static_cast<difference_type>(ratio * static_cast<double>(n));
+					if (offset < 1) {
+						offset = 1;
+					} else if (offset > n - 1) {
+						offset = n - 1;
+					}
+				}
+				iterator probe(first + offset);
+				if (static_cast<bool>(comparator(*probe, value))) { // *probe < value
+					first = probe + 1;
+				} else {
+					last = probe;
+				}
+
+				// the keys are far from uniform here, bisect once so that the worst case stays O(log n)
+				if (last - first > len / 2) {
+					iterator middle(first + ((last - first) >> 1));
+					if (static_cast<bool>(comparator(*middle, value))) {
+						first = middle + 1;
+					} else {
+						last = middle;
+					}
+				}
+			}
+			return kerbal::algorithm::__lower_bound(first, last, value, comparator, std::random_access_iterator_tag());
+		}
+
+		/**
+		 * Probes where value would be if the elements were evenly spread between the bounds of the range, which
+		 * takes about log(log(n)) probes over near-uniform keys (e.g. timestamps). A bisection step follows every
+		 * probe that fails to halve the range, so skewed keys cost at most twice the probes of a binary search.
+		 *
+		 * @param comparator requires: comparator(value_type, Tp)
+		 * @param metric requires: metric(value_type, Tp) is the signed distance from value to the element as a
+		 *        double, monotone along the range. Only the position of the probes depends on it, the result is
+		 *        decided by comparator.
+		 */
+		template <typename ForwardIterator, typename Tp, typename Comparator, typename Metric>
+		KERBAL_CONSTEXPR14
+		ForwardIterator
+		interpolation_lower_bound(ForwardIterator first, ForwardIterator last, const Tp & value,
+									Comparator comparator, Metric metric)
+		{
+			return kerbal::algorithm::__interpolation_lower_bound(first, last, value, comparator, metric,
+																	kerbal::iterator::iterator_category(first));
+		}
+
+		template <typename ForwardIterator, typename Tp, typename Comparator>
+		KERBAL_CONSTEXPR14
+		ForwardIterator
+		interpolation_lower_bound(ForwardIterator first, ForwardIterator last, const Tp & value, Comparator comparator)
+		{
+			return kerbal::algorithm::interpolation_lower_bound(first, last, value, comparator,
+																kerbal::algorithm::interpolation_default_metric());
+		}
+
+		template <typename ForwardIterator, typename Tp>
+		KERBAL_CONSTEXPR14
+		ForwardIterator
+		interpolation_lower_bound(ForwardIterator first, ForwardIterator last, const Tp & value)
+		{
+			typedef ForwardIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type type;
+			return kerbal::algorithm::interpolation_lower_bound(first, last, value,
+																kerbal::algorithm::binary_type_less<type, Tp>());
+		}
+
+
+
+		/*
+		 * The search policies select the engine of a lower_bound with a hint. All of them provide
+		 *
+		 *     iterator lower_bound(first, last, value, hint, comparator) const;
+		 *
+		 * with comparator(value_type, Tp), as kerbal::algorithm::lower_bound_hint.
+		 */
+
+		/**
+		 * Checks the neighbourhood of hint, then binary searches. See lower_bound_hint.
+		 */
+		struct binary_search_policy
+		{
+				template <typename ForwardIterator, typename Tp, typename Comparator>
+				KERBAL_CONSTEXPR14
+				ForwardIterator
+				lower_bound(ForwardIterator first, ForwardIterator last, const Tp & value,
+							ForwardIterator hint, Comparator comparator) const
+				{
+					return kerbal::algorithm::lower_bound_hint(first, last, value, hint, comparator);
+				}
+		};
+
+		/**
+		 * Gallops from hint, for monotone queries where each one starts from the result of the previous one.
+		 * See exponential_lower_bound.
+		 */
+		struct exponential_search_policy
+		{
+				template <typename ForwardIterator, typename Tp, typename Comparator>
+				KERBAL_CONSTEXPR14
+				ForwardIterator
+				lower_bound(ForwardIterator first, ForwardIterator last, const Tp & value,
+							ForwardIterator hint, Comparator comparator) const
+				{
+					return kerbal::algorithm::exponential_lower_bound(first, last, value, hint, comparator);
+				}
+		};
+
+		/**
+		 * Interpolates over the whole range and ignores the hint, for near-uniform numeric keys.
+		 * See interpolation_lower_bound.
+		 */
+		template <typename Metric = kerbal::algorithm::interpolation_default_metric>
+		struct interpolation_search_policy
+		{
+				Metric metric;
+
+				KERBAL_CONSTEXPR
+				interpolation_search_policy() :
+						metric()
+				{
+				}
+
+				KERBAL_CONSTEXPR
+				explicit interpolation_search_policy(const Metric & metric) :
+						metric(metric)
+				{
+				}
+
+				template <typename ForwardIterator, typename Tp, typename Comparator>
+				KERBAL_CONSTEXPR14
+				ForwardIterator
+				lower_bound(ForwardIterator first, ForwardIterator last, const Tp & value,
+							ForwardIterator /*hint*/, Comparator comparator) const
+				{
+					return kerbal::algorithm::interpolation_lower_bound(first, last, value, comparator, this->metric);
+				}
+		};
+
+	} // namespace algorithm
+
+} // namespace kerbal
+
+#endif // KERBAL_ALGORITHM_SEARCH_POLICY_HPP
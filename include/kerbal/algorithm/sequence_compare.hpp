@@ -13,7 +13,9 @@
 #define KERBAL_ALGORITHM_SEQUENCE_COMPARE_HPP
 
 #include <kerbal/algorithm/binary_type_predicate.hpp>
+#include <kerbal/algorithm/detail/sequence_compare_simd.hpp>
 #include <kerbal/compatibility/constexpr.hpp>
+#include <kerbal/compatibility/is_constant_evaluated.hpp>
 #include <kerbal/compatibility/noexcept.hpp>
 #include <kerbal/compatibility/static_assert.hpp>
 #include <kerbal/container/nonmember_container_access.hpp>
@@ -75,6 +77,13 @@ namespace kerbal
 				return false;
 			}
 
+			typedef kerbal::algorithm::detail::sequence_compare_simd_equal_enable<
+					RandomAccessIterator1, RandomAccessIterator2, BinaryTypeEqualToPredicate
+			> SIMD_ENABLE;
+			if (SIMD_ENABLE::value && KERBAL_CONSTEXPR14_RUNTIME_PATH()) {
+				return kerbal::algorithm::detail::sequence_compare_simd_equal(a_first, a_last, b_first, SIMD_ENABLE());
+			}
+
 //			while (a_first != a_last) { // size are equal and b will not out of range
 //				if (equal_to(*a_first, *b_first)) { // namely *a == *b
 //					++a_first;
@@ -243,6 +252,13 @@ namespace kerbal
 				return true;
 			}
 
+			typedef kerbal::algorithm::detail::sequence_compare_simd_not_equal_enable<
+					RandomAccessIterator1, RandomAccessIterator2, BinaryTypeNotEqualToPredicate
+			> SIMD_ENABLE;
+			if (SIMD_ENABLE::value && KERBAL_CONSTEXPR14_RUNTIME_PATH()) {
+				return !kerbal::algorithm::detail::sequence_compare_simd_equal(a_first, a_last, b_first, SIMD_ENABLE());
+			}
+
 //			while (a_first != a_last) { // size are equal and b will not out of range
 //				if (not_equal_to(*a_first, *b_first)) { // namely *a != *b
 //					return true;
@@ -376,6 +392,15 @@ namespace kerbal
 							InputIterator2 b_first, InputIterator2 b_last,
 							LessPredicate less)
 		{
+			typedef kerbal::algorithm::detail::sequence_compare_simd_order_enable<
+					InputIterator1, InputIterator2, LessPredicate,
+					std::less<typename kerbal::iterator::iterator_traits<InputIterator1>::value_type>
+			> SIMD_ENABLE;
+			if (SIMD_ENABLE::value && KERBAL_CONSTEXPR14_RUNTIME_PATH()) {
+				return kerbal::algorithm::detail::sequence_compare_simd_three_way(
+							a_first, a_last, b_first, b_last, SIMD_ENABLE()) < 0;
+			}
+
 			while (static_cast<bool>(a_first != a_last) && static_cast<bool>(b_first != b_last)) {
 				if (less(*a_first, *b_first)) { // namely *a < *b
 					return true;
@@ -451,6 +476,15 @@ namespace kerbal
 							InputIterator2 b_first, InputIterator2 b_last,
 							GreaterPredicate greater)
 		{
+			typedef kerbal::algorithm::detail::sequence_compare_simd_order_enable<
+					InputIterator1, InputIterator2, GreaterPredicate,
+					std::greater<typename kerbal::iterator::iterator_traits<InputIterator1>::value_type>
+			> SIMD_ENABLE;
+			if (SIMD_ENABLE::value && KERBAL_CONSTEXPR14_RUNTIME_PATH()) {
+				return kerbal::algorithm::detail::sequence_compare_simd_three_way(
+							a_first, a_last, b_first, b_last, SIMD_ENABLE()) > 0;
+			}
+
 			while (static_cast<bool>(a_first != a_last) && static_cast<bool>(b_first != b_last)) {
 				if (greater(*a_first, *b_first)) { // namely *a > *b
 					return true;
@@ -512,6 +546,15 @@ namespace kerbal
 								InputIterator2 b_first, InputIterator2 b_last,
 								LessEqualPredicate less_equal)
 		{
+			typedef kerbal::algorithm::detail::sequence_compare_simd_order_enable<
+					InputIterator1, InputIterator2, LessEqualPredicate,
+					std::less_equal<typename kerbal::iterator::iterator_traits<InputIterator1>::value_type>
+			> SIMD_ENABLE;
+			if (SIMD_ENABLE::value && KERBAL_CONSTEXPR14_RUNTIME_PATH()) {
+				return kerbal::algorithm::detail::sequence_compare_simd_three_way(
+							a_first, a_last, b_first, b_last, SIMD_ENABLE()) <= 0;
+			}
+
 			while (static_cast<bool>(a_first != a_last) && static_cast<bool>(b_first != b_last)) {
 				if (less_equal(*a_first, *b_first)) { // namely *a <= *b
 					if (less_equal(*b_first, *a_first)) { // namely *a >= *b
@@ -574,6 +617,15 @@ namespace kerbal
 									InputIterator2 b_first, InputIterator2 b_last,
 									GreaterEqualPredicate greater_equal)
 		{
+			typedef kerbal::algorithm::detail::sequence_compare_simd_order_enable<
+					InputIterator1, InputIterator2, GreaterEqualPredicate,
+					std::greater_equal<typename kerbal::iterator::iterator_traits<InputIterator1>::value_type>
+			> SIMD_ENABLE;
+			if (SIMD_ENABLE::value && KERBAL_CONSTEXPR14_RUNTIME_PATH()) {
+				return kerbal::algorithm::detail::sequence_compare_simd_three_way(
+							a_first, a_last, b_first, b_last, SIMD_ENABLE()) >= 0;
+			}
+
 			while (static_cast<bool>(a_first != a_last) && static_cast<bool>(b_first != b_last)) {
 				if (greater_equal(*a_first, *b_first)) { // namely *a >= *b
 					if (greater_equal(*b_first, *a_first)) { // namely *a <= *b
@@ -18,6 +18,8 @@
 #include <kerbal/algorithm/sort/intro_sort.hpp>
 #include <kerbal/algorithm/sort/is_sorted.hpp>
 #include <kerbal/algorithm/sort/merge_sort.hpp>
+#include <kerbal/algorithm/sort/nth_element.hpp>
+#include <kerbal/algorithm/sort/partial_sort.hpp>
 #include <kerbal/algorithm/sort/pigeonhole_sort.hpp>
 #include <kerbal/algorithm/sort/quick_sort.hpp>
 #include <kerbal/algorithm/sort/radix_sort.hpp>
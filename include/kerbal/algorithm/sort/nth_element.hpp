@@ -0,0 +1,115 @@
+/**
+ * @file       nth_element.hpp
+ * @brief
+ * @date       2020-11-12
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_ALGORITHM_SORT_NTH_ELEMENT_HPP
+#define KERBAL_ALGORITHM_SORT_NTH_ELEMENT_HPP
+
+#include <kerbal/algorithm/swap.hpp>
+#include <kerbal/algorithm/sort/detail/quick_sort_pivot.hpp>
+#include <kerbal/algorithm/sort/insertion_sort.hpp>
+#include <kerbal/algorithm/sort/intro_sort.hpp>
+#include <kerbal/algorithm/sort/partial_sort.hpp>
+#include <kerbal/compatibility/constexpr.hpp>
+#include <kerbal/iterator/iterator.hpp>
+#include <kerbal/iterator/iterator_traits.hpp>
+
+#include <functional>
+
+namespace kerbal
+{
+
+	namespace algorithm
+	{
+
+		namespace detail
+		{
+
+			template <typename BidirectionalIterator, typename Compare>
+			KERBAL_CONSTEXPR14
+			void nth_element(BidirectionalIterator first, BidirectionalIterator nth, BidirectionalIterator last,
+							Compare cmp, size_t depth_limit)
+			{
+				typedef BidirectionalIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::difference_type difference_type;
+
+				difference_type k(kerbal::iterator::distance(first, nth));
+				while (kerbal::iterator::distance_greater_than(first, last, 16)) {
+					if (depth_limit == 0) {
+						iterator nth_next(kerbal::iterator::next(nth));
+						kerbal::algorithm::detail::heap_select(first, nth_next, last, cmp);
+						kerbal::algorithm::iter_swap(first, nth);
+						return;
+					}
+
+					--depth_limit;
+
+					iterator back(kerbal::iterator::prev(last));
+					detail::quick_sort_select_pivot(first, back, cmp);
+					iterator partition_point(detail::quick_sort_partition(first, back, *back, cmp));
+
+					if (partition_point != back) {
+						if (cmp(*back, *partition_point)) {
+							kerbal::algorithm::iter_swap(back, partition_point);
+						}
+					}
+					// the pivot is at its final place, only the side holding nth goes on
+
+					difference_type p(kerbal::iterator::distance(first, partition_point));
+					if (k == p) {
+						return;
+					}
+					if (k < p) {
+						last = partition_point;
+					} else {
+						first = kerbal::iterator::next(partition_point);
+						k -= p + 1;
+					}
+				}
+				// dist <= 16
+				kerbal::algorithm::directly_insertion_sort(first, last, cmp);
+			}
+
+		} // namespace detail
+
+		/**
+		 * Rearranges [first, last) so that nth holds the element that would be there if the range were sorted,
+		 * no element of [first, nth) is greater than it and no element of (nth, last) is less than it.
+		 *
+		 * Introselect: quickselect with median-of-three pivots, which falls back to a heap selection after
+		 * 2 * log2(n) partitions, so it costs O(n) on average and O(n log(n)) at worst. Typical use is a
+		 * percentile of a sample, e.g. nth = first + n * 99 / 100 for the p99.
+		 */
+		template <typename BidirectionalIterator, typename Compare>
+		KERBAL_CONSTEXPR14
+		void nth_element(BidirectionalIterator first, BidirectionalIterator nth, BidirectionalIterator last,
+						Compare cmp)
+		{
+			if (nth == last) {
+				return;
+			}
+			kerbal::algorithm::detail::nth_element(first, nth, last, cmp,
+						2 * detail::lg(kerbal::iterator::distance(first, last)));
+		}
+
+		template <typename BidirectionalIterator>
+		KERBAL_CONSTEXPR14
+		void nth_element(BidirectionalIterator first, BidirectionalIterator nth, BidirectionalIterator last)
+		{
+			typedef BidirectionalIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+			kerbal::algorithm::nth_element(first, nth, last, std::less<value_type>());
+		}
+
+	} // namespace algorithm
+
+} // namespace kerbal
+
+#endif // KERBAL_ALGORITHM_SORT_NTH_ELEMENT_HPP
@@ -0,0 +1,133 @@
+/**
+ * @file       partial_sort.hpp
+ * @brief
+ * @date       2020-11-12
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_ALGORITHM_SORT_PARTIAL_SORT_HPP
+#define KERBAL_ALGORITHM_SORT_PARTIAL_SORT_HPP
+
+#include <kerbal/algorithm/heap.hpp>
+#include <kerbal/algorithm/swap.hpp>
+#include <kerbal/compatibility/constexpr.hpp>
+#include <kerbal/iterator/iterator.hpp>
+#include <kerbal/iterator/iterator_traits.hpp>
+
+#include <functional>
+
+namespace kerbal
+{
+
+	namespace algorithm
+	{
+
+		namespace detail
+		{
+
+			/*
+			 * Gathers the middle - first least elements of [first, last) in [first, middle), as a heap whose top
+			 * is the greatest of them. Each element of [middle, last) costs one comparison with the top, plus a
+			 * sift-down when it enters the heap.
+			 *
+			 * pre: first != middle
+			 */
+			template <typename BidirectionalIterator, typename Compare>
+			KERBAL_CONSTEXPR14
+			void heap_select(BidirectionalIterator first, BidirectionalIterator middle, BidirectionalIterator last,
+							Compare cmp)
+			{
+				typedef BidirectionalIterator iterator;
+
+				kerbal::algorithm::make_heap(first, middle, cmp);
+				for (iterator it(middle); it != last; ++it) {
+					if (cmp(*it, *first)) { // *it < top
+						kerbal::algorithm::iter_swap(first, it);
+						kerbal::algorithm::detail::adjust_top_down_unguarded(first, middle, cmp);
+					}
+				}
+			}
+
+		} // namespace detail
+
+		/**
+		 * Rearranges [first, last) so that [first, middle) holds its middle - first least elements in ascending
+		 * order. The order of the rest is unspecified. It costs O(n log(m)) comparisons with m = middle - first,
+		 * much less than sorting the whole range when only its head is needed.
+		 */
+		template <typename BidirectionalIterator, typename Compare>
+		KERBAL_CONSTEXPR14
+		void partial_sort(BidirectionalIterator first, BidirectionalIterator middle, BidirectionalIterator last,
+							Compare cmp)
+		{
+			if (first == middle) {
+				return;
+			}
+			kerbal::algorithm::detail::heap_select(first, middle, last, cmp);
+			kerbal::algorithm::sort_heap(first, middle, cmp);
+		}
+
+		template <typename BidirectionalIterator>
+		KERBAL_CONSTEXPR14
+		void partial_sort(BidirectionalIterator first, BidirectionalIterator middle, BidirectionalIterator last)
+		{
+			typedef BidirectionalIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+			kerbal::algorithm::partial_sort(first, middle, last, std::less<value_type>());
+		}
+
+		/**
+		 * Copies the min(n, r_last - r_first) least elements of [first, last) in ascending order to
+		 * [r_first, r_last), reading the input only once.
+		 *
+		 * @return the end of the copied elements
+		 */
+		template <typename InputIterator, typename BidirectionalIterator, typename Compare>
+		KERBAL_CONSTEXPR14
+		BidirectionalIterator
+		partial_sort_copy(InputIterator first, InputIterator last,
+							BidirectionalIterator r_first, BidirectionalIterator r_last, Compare cmp)
+		{
+			typedef BidirectionalIterator iterator;
+
+			iterator r_end(r_first);
+			while (first != last && r_end != r_last) {
+				*r_end = *first;
+				++r_end;
+				++first;
+			}
+			if (r_first == r_end) {
+				return r_end;
+			}
+			kerbal::algorithm::make_heap(r_first, r_end, cmp);
+			while (first != last) {
+				if (cmp(*first, *r_first)) { // *first < top
+					*r_first = *first;
+					kerbal::algorithm::detail::adjust_top_down_unguarded(r_first, r_end, cmp);
+				}
+				++first;
+			}
+			kerbal::algorithm::sort_heap(r_first, r_end, cmp);
+			return r_end;
+		}
+
+		template <typename InputIterator, typename BidirectionalIterator>
+		KERBAL_CONSTEXPR14
+		BidirectionalIterator
+		partial_sort_copy(InputIterator first, InputIterator last,
+							BidirectionalIterator r_first, BidirectionalIterator r_last)
+		{
+			typedef BidirectionalIterator iterator;
+			typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+			return kerbal::algorithm::partial_sort_copy(first, last, r_first, r_last, std::less<value_type>());
+		}
+
+	} // namespace algorithm
+
+} // namespace kerbal
+
+#endif // KERBAL_ALGORITHM_SORT_PARTIAL_SORT_HPP
@@ -18,11 +18,10 @@
 #include <kerbal/compatibility/static_assert.hpp>
 #include <kerbal/iterator/iterator.hpp>
 #include <kerbal/memory/allocator_traits.hpp>
+#include <kerbal/operators/generic_assign.hpp>
 
 #include <memory>
 
-#include <kerbal/algorithm/sort/detail/merge_sort_merge.hpp>
-
 namespace kerbal
 {
 
@@ -65,6 +64,34 @@ namespace kerbal
 				return false;
 			}
 
+			/*
+			 * Merges the sorted second half held by the buffer with the sorted first half lying at the end of the
+			 * range, to the front of the range. The first half goes first among the equivalent elements.
+			 */
+			template <typename ForwardIterator1, typename ForwardIterator2, typename Compare>
+			KERBAL_CONSTEXPR14
+			void stable_sort_merge_buffered_second_half(ForwardIterator1 buffer_first, ForwardIterator1 buffer_last,
+														ForwardIterator2 mid, ForwardIterator2 last,
+														ForwardIterator2 to, Compare cmp)
+			{
+				while (buffer_first != buffer_last) {
+					if (mid != last) {
+						if (cmp(*buffer_first, *mid)) { // buffer_first < mid
+							kerbal::operators::generic_assign(*to, *buffer_first); // *to = *buffer_first;
+							++to;
+							++buffer_first;
+						} else { // buffer_first >= mid
+							kerbal::operators::generic_assign(*to, *mid); // *to = *mid;
+							++to;
+							++mid;
+						}
+					} else {
+						kerbal::algorithm::copy(buffer_first, buffer_last, to);
+						return;
+					}
+				}
+			}
+
 		} // namespace detail
 
 		/*
@@ -101,7 +128,7 @@ namespace kerbal
 			const iterator t(kerbal::iterator::next(b_end, static_cast<size_t>(second_half_len - first_half_len)));
 			kerbal::algorithm::merge(first, a_end, a_end, b_end, t, cmp);
 
-			kerbal::algorithm::detail::merge_sort_merge(buffer, buffer_end, t, d_end, first, cmp);
+			kerbal::algorithm::detail::stable_sort_merge_buffered_second_half(buffer, buffer_end, t, d_end, first, cmp);
 			return d_end;
 		}
 
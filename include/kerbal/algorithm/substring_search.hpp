@@ -0,0 +1,64 @@
+/**
+ * @file       substring_search.hpp
+ * @brief
+ * @date       2020-11-16
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_ALGORITHM_SUBSTRING_SEARCH_HPP
+#define KERBAL_ALGORITHM_SUBSTRING_SEARCH_HPP
+
+#include <kerbal/algorithm/horspool.hpp>
+#include <kerbal/algorithm/detail/substring_search_simd.hpp>
+#include <kerbal/compatibility/constexpr.hpp>
+#include <kerbal/compatibility/is_constant_evaluated.hpp>
+
+#include <cstring>
+
+namespace kerbal
+{
+
+	namespace algorithm
+	{
+
+		/**
+		 * @brief Find the first occurrence of [pattern_first, pattern_last) in [host_first, host_last), two
+		 *        ranges of bytes.
+		 *
+		 * Over contiguous ranges, the candidates are found by comparing vectors of the host with the first and
+		 * the last bytes of the pattern. Where there is no vector kernel, the patterns of at least
+		 * KERBAL_ALGORITHM_SUBSTRING_SEARCH_HORSPOOL_THRESHOLD bytes are searched by Boyer-Moore-Horspool,
+		 * which is also the algorithm for the other ranges and in constant evaluation.
+		 *
+		 * @return Iterator to the beginning of the occurrence, host_last if none.
+		 */
+		template <typename RandomAccessHostIterator, typename RandomAccessPatternIterator>
+		KERBAL_CONSTEXPR14
+		RandomAccessHostIterator
+		substring_search(RandomAccessHostIterator host_first, RandomAccessHostIterator host_last,
+						RandomAccessPatternIterator pattern_first, RandomAccessPatternIterator pattern_last)
+		{
+			typedef kerbal::algorithm::detail::substring_search_simd_enable<
+					RandomAccessHostIterator, RandomAccessPatternIterator
+			> SIMD_ENABLE;
+			if (SIMD_ENABLE::value && KERBAL_CONSTEXPR14_RUNTIME_PATH()) {
+				return kerbal::algorithm::detail::substring_search_simd(host_first, host_last,
+																		pattern_first, pattern_last, SIMD_ENABLE());
+			}
+			return kerbal::algorithm::horspool(host_first, host_last, pattern_first, pattern_last);
+		}
+
+		inline const char* substring_search(const char* host, const char* pattern)
+		{
+			return kerbal::algorithm::substring_search(host, host + strlen(host), pattern, pattern + strlen(pattern));
+		}
+
+	} // namespace algorithm
+
+} // namespace kerbal
+
+#endif // KERBAL_ALGORITHM_SUBSTRING_SEARCH_HPP
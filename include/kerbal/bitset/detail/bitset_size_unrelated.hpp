@@ -13,6 +13,11 @@
 #define KERBAL_BITSET_DETAIL_BITSET_SIZE_UNRELATED_HPP
 
 #include <kerbal/algorithm/sequence_compare.hpp>
+#include <kerbal/bitset/detail/bitset_x86_kernel.hpp>
+#include <kerbal/compatibility/constexpr.hpp>
+#include <kerbal/compatibility/is_constant_evaluated.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/numeric/bit.hpp>
 #include <kerbal/type_traits/integral_constant.hpp>
 
 #include <climits>
@@ -45,10 +50,39 @@ namespace kerbal
 				protected:
 					typedef kerbal::type_traits::integral_constant<block_type, static_cast<block_type>(~static_cast<block_type>(0))> ALL_ONE;
 
+#			if KERBAL_BITSET_X86_KERNEL_SUPPORTED
+
+					/*
+					 * Large arrays are handed to the vectorized kernels when not constant evaluated,
+					 * the unrolled loops below remain the constexpr path.
+					 */
+					static bool use_x86_kernel(block_width_type block_width) KERBAL_NOEXCEPT
+					{
+						return detail::bitset_x86_kernel_usable(block_width * sizeof(block_type));
+					}
+
+					static unsigned char * bytes_of(block_type m_block[]) KERBAL_NOEXCEPT
+					{
+						return reinterpret_cast<unsigned char *>(m_block);
+					}
+
+					static const unsigned char * bytes_of(const block_type m_block[]) KERBAL_NOEXCEPT
+					{
+						return reinterpret_cast<const unsigned char *>(m_block);
+					}
+
+#			endif
+
 					KERBAL_CONSTEXPR14
 					static bool all_trunk(const block_type m_block[], block_width_type trunk_size) KERBAL_NOEXCEPT
 					{
 
+#				if KERBAL_BITSET_X86_KERNEL_SUPPORTED
+						if (KERBAL_CONSTEXPR14_RUNTIME_PATH() && use_x86_kernel(trunk_size)) {
+							return detail::bitset_all_x86(bytes_of(m_block), trunk_size * sizeof(block_type));
+						}
+#				endif
+
 #				define EACH(idx) if (m_block[idx] != ALL_ONE::value) {return false;}
 
 							for (size_t i = 0; i + 4 <= trunk_size; i += 4) {
@@ -76,6 +110,12 @@ namespace kerbal
 					static bool any_trunk(const block_type m_block[], block_width_type trunk_size) KERBAL_NOEXCEPT
 					{
 
+#				if KERBAL_BITSET_X86_KERNEL_SUPPORTED
+						if (KERBAL_CONSTEXPR14_RUNTIME_PATH() && use_x86_kernel(trunk_size)) {
+							return detail::bitset_any_x86(bytes_of(m_block), trunk_size * sizeof(block_type));
+						}
+#				endif
+
 #				define EACH(idx) if (m_block[idx]) {return true;}
 
 						for (size_t i = 0; i + 4 <= trunk_size; i += 4) {
@@ -103,6 +143,12 @@ namespace kerbal
 					static bool none_trunk(const block_type m_block[], block_width_type trunk_size) KERBAL_NOEXCEPT
 					{
 
+#				if KERBAL_BITSET_X86_KERNEL_SUPPORTED
+						if (KERBAL_CONSTEXPR14_RUNTIME_PATH() && use_x86_kernel(trunk_size)) {
+							return !detail::bitset_any_x86(bytes_of(m_block), trunk_size * sizeof(block_type));
+						}
+#				endif
+
 #				define EACH(idx) if (m_block[idx]) {return false;}
 
 						for (size_t i = 0; i + 4 <= trunk_size; i += 4) {
@@ -130,10 +176,138 @@ namespace kerbal
 //						});
 					}
 
+					KERBAL_CONSTEXPR14
+					static size_t count_trunk(const block_type m_block[], block_width_type trunk_size) KERBAL_NOEXCEPT
+					{
+
+#				if KERBAL_BITSET_X86_KERNEL_SUPPORTED
+						if (KERBAL_CONSTEXPR14_RUNTIME_PATH() && use_x86_kernel(trunk_size)) {
+							size_t cnt = 0;
+							if (detail::bitset_count_x86(bytes_of(m_block), trunk_size * sizeof(block_type), cnt)) {
+								return cnt;
+							}
+						}
+#				endif
+
+						size_t cnt = 0;
+
+#				define EACH(idx) cnt += kerbal::numeric::popcount(m_block[idx])
+
+						for (size_t i = 0; i + 4 <= trunk_size; i += 4) {
+							EACH(i);
+							EACH(i + 1);
+							EACH(i + 2);
+							EACH(i + 3);
+						}
+
+						switch (trunk_size % 4) {
+							case 3:
+								EACH(trunk_size - 3);
+							case 2:
+								EACH(trunk_size - 2);
+							case 1:
+								EACH(trunk_size - 1);
+						}
+
+#				undef EACH
+
+						return cnt;
+					}
+
+					/*
+					 * Index of the first block in [first, trunk_size) which is not zero, or trunk_size if none.
+					 */
+					KERBAL_CONSTEXPR14
+					static block_width_type find_first_block(const block_type m_block[], block_width_type first,
+															block_width_type trunk_size) KERBAL_NOEXCEPT
+					{
+						while (first < trunk_size && m_block[first] == 0) {
+							++first;
+						}
+						return first;
+					}
+
+					/*
+					 * Shifts the whole block array towards the higher bit indexes. Bits shifted out are lost,
+					 * the vacated ones are filled by 0.
+					 */
+					KERBAL_CONSTEXPR14
+					static void left_shift_assign(block_type m_block[], block_width_type block_width, size_t n) KERBAL_NOEXCEPT
+					{
+						block_width_type word_shift = n / BITS_PER_BLOCK::value;
+						size_t bit_shift = n % BITS_PER_BLOCK::value;
+
+						if (word_shift >= block_width) {
+							for (block_width_type i = 0; i < block_width; ++i) {
+								m_block[i] = 0;
+							}
+							return;
+						}
+
+						if (bit_shift == 0) {
+							for (block_width_type i = block_width; i != word_shift; ) {
+								--i;
+								m_block[i] = m_block[i - word_shift];
+							}
+						} else {
+							for (block_width_type i = block_width - 1; i != word_shift; --i) {
+								m_block[i] = static_cast<block_type>(
+										(m_block[i - word_shift] << bit_shift) |
+										(m_block[i - word_shift - 1] >> (BITS_PER_BLOCK::value - bit_shift)));
+							}
+							m_block[word_shift] = static_cast<block_type>(m_block[0] << bit_shift);
+						}
+						for (block_width_type i = 0; i < word_shift; ++i) {
+							m_block[i] = 0;
+						}
+					}
+
+					/*
+					 * Shifts the whole block array towards the lower bit indexes. Bits shifted out are lost,
+					 * the vacated ones are filled by 0.
+					 */
+					KERBAL_CONSTEXPR14
+					static void right_shift_assign(block_type m_block[], block_width_type block_width, size_t n) KERBAL_NOEXCEPT
+					{
+						block_width_type word_shift = n / BITS_PER_BLOCK::value;
+						size_t bit_shift = n % BITS_PER_BLOCK::value;
+
+						if (word_shift >= block_width) {
+							for (block_width_type i = 0; i < block_width; ++i) {
+								m_block[i] = 0;
+							}
+							return;
+						}
+
+						block_width_type last = block_width - word_shift - 1;
+						if (bit_shift == 0) {
+							for (block_width_type i = 0; i <= last; ++i) {
+								m_block[i] = m_block[i + word_shift];
+							}
+						} else {
+							for (block_width_type i = 0; i < last; ++i) {
+								m_block[i] = static_cast<block_type>(
+										(m_block[i + word_shift] >> bit_shift) |
+										(m_block[i + word_shift + 1] << (BITS_PER_BLOCK::value - bit_shift)));
+							}
+							m_block[last] = static_cast<block_type>(m_block[block_width - 1] >> bit_shift);
+						}
+						for (block_width_type i = last + 1; i < block_width; ++i) {
+							m_block[i] = 0;
+						}
+					}
+
 					KERBAL_CONSTEXPR14
 					static void flip(block_type m_block[], block_width_type block_width) KERBAL_NOEXCEPT
 					{
 
+#				if KERBAL_BITSET_X86_KERNEL_SUPPORTED
+						if (KERBAL_CONSTEXPR14_RUNTIME_PATH() && use_x86_kernel(block_width)) {
+							detail::bitset_flip_x86(bytes_of(m_block), block_width * sizeof(block_type));
+							return;
+						}
+#				endif
+
 #				define EACH(idx) m_block[idx] = ~m_block[idx]
 
 						for (size_t i = 0; i + 4 <= block_width; i += 4) {
@@ -159,6 +333,12 @@ namespace kerbal
 					KERBAL_CONSTEXPR14
 					static bool equal_trunk(const block_type m_block[], const block_type ano[], block_width_type trunk_size) KERBAL_NOEXCEPT
 					{
+
+#				if KERBAL_BITSET_X86_KERNEL_SUPPORTED
+						if (KERBAL_CONSTEXPR14_RUNTIME_PATH() && use_x86_kernel(trunk_size)) {
+							return detail::bitset_equal_x86(bytes_of(m_block), bytes_of(ano), trunk_size * sizeof(block_type));
+						}
+#				endif
 						return kerbal::algorithm::sequence_equal_to(
 								m_block, m_block + trunk_size,
 								ano, ano + trunk_size
@@ -169,6 +349,13 @@ namespace kerbal
 					static void bit_and_assign(block_type m_block[], const block_type ano[], block_width_type block_width) KERBAL_NOEXCEPT
 					{
 
+#				if KERBAL_BITSET_X86_KERNEL_SUPPORTED
+						if (KERBAL_CONSTEXPR14_RUNTIME_PATH() && use_x86_kernel(block_width)) {
+							detail::bitset_and_assign_x86(bytes_of(m_block), bytes_of(ano), block_width * sizeof(block_type));
+							return;
+						}
+#				endif
+
 #				define EACH(idx) m_block[idx] &= ano[idx]
 
 						for (size_t i = 0; i + 4 <= block_width; i += 4) {
@@ -195,6 +382,13 @@ namespace kerbal
 					static void bit_or_assign(block_type m_block[], const block_type ano[], block_width_type block_width) KERBAL_NOEXCEPT
 					{
 
+#				if KERBAL_BITSET_X86_KERNEL_SUPPORTED
+						if (KERBAL_CONSTEXPR14_RUNTIME_PATH() && use_x86_kernel(block_width)) {
+							detail::bitset_or_assign_x86(bytes_of(m_block), bytes_of(ano), block_width * sizeof(block_type));
+							return;
+						}
+#				endif
+
 #				define EACH(idx) m_block[idx] |= ano[idx]
 
 						for (size_t i = 0; i + 4 <= block_width; i += 4) {
@@ -221,6 +415,13 @@ namespace kerbal
 					static void bit_xor_assign(block_type m_block[], const block_type ano[], block_width_type block_width) KERBAL_NOEXCEPT
 					{
 
+#				if KERBAL_BITSET_X86_KERNEL_SUPPORTED
+						if (KERBAL_CONSTEXPR14_RUNTIME_PATH() && use_x86_kernel(block_width)) {
+							detail::bitset_xor_assign_x86(bytes_of(m_block), bytes_of(ano), block_width * sizeof(block_type));
+							return;
+						}
+#				endif
+
 #				define EACH(idx) m_block[idx] ^= ano[idx]
 
 						for (size_t i = 0; i + 4 <= block_width; i += 4) {
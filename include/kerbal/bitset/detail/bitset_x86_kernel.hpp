@@ -0,0 +1,631 @@
+/**
+ * @file       bitset_x86_kernel.hpp
+ * @brief
+ * @date       2020-10-28
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_BITSET_DETAIL_BITSET_X86_KERNEL_HPP
+#define KERBAL_BITSET_DETAIL_BITSET_X86_KERNEL_HPP
+
+#include <kerbal/compatibility/fixed_width_integer.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/compatibility/x86_cpu_feature.hpp>
+#include <kerbal/config/architecture.hpp>
+#include <kerbal/config/x86_intrinsics.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+
+#include <cstddef>
+#include <cstring>
+
+#if KERBAL_X86_INTRINSICS_SUPPORTED
+#	define KERBAL_BITSET_X86_KERNEL_SUPPORTED 1
+#else
+#	define KERBAL_BITSET_X86_KERNEL_SUPPORTED 0
+#endif
+
+namespace kerbal
+{
+
+	namespace bitset
+	{
+
+		namespace detail
+		{
+
+			/*
+			 * Bitsets shorter than this (in bytes) keep using the unrolled scalar loops,
+			 * the dispatch would cost more than it saves.
+			 */
+			typedef kerbal::type_traits::integral_constant<std::size_t, 256> BITSET_X86_KERNEL_THRESHOLD;
+
+#	if KERBAL_BITSET_X86_KERNEL_SUPPORTED
+
+			/*
+			 * All the kernels work on the object representation of the block array, the last
+			 * (bytes % vector width) bytes are processed one by one.
+			 */
+
+#		define KERBAL_BITSET_X86_BINARY_KERNEL(NAME, TARGET, VEC, WIDTH, LOADU, STOREU, OP) \
+			KERBAL_X86_TARGET(TARGET) \
+			inline \
+			void NAME(unsigned char * a, const unsigned char * b, std::size_t bytes) KERBAL_NOEXCEPT \
+			{ \
+				std::size_t i = 0; \
+				for (; i + 4 * WIDTH <= bytes; i += 4 * WIDTH) { \
+					VEC a0 = LOADU(reinterpret_cast<const VEC *>(a + i + 0 * WIDTH)); \
+					VEC a1 = LOADU(reinterpret_cast<const VEC *>(a + i + 1 * WIDTH)); \
+					VEC a2 = LOADU(reinterpret_cast<const VEC *>(a + i + 2 * WIDTH)); \
+					VEC a3 = LOADU(reinterpret_cast<const VEC *>(a + i + 3 * WIDTH)); \
+					STOREU(reinterpret_cast<VEC *>(a + i + 0 * WIDTH), OP(a0, LOADU(reinterpret_cast<const VEC *>(b + i + 0 * WIDTH)))); \
+					STOREU(reinterpret_cast<VEC *>(a + i + 1 * WIDTH), OP(a1, LOADU(reinterpret_cast<const VEC *>(b + i + 1 * WIDTH)))); \
+					STOREU(reinterpret_cast<VEC *>(a + i + 2 * WIDTH), OP(a2, LOADU(reinterpret_cast<const VEC *>(b + i + 2 * WIDTH)))); \
+					STOREU(reinterpret_cast<VEC *>(a + i + 3 * WIDTH), OP(a3, LOADU(reinterpret_cast<const VEC *>(b + i + 3 * WIDTH)))); \
+				} \
+				for (; i + WIDTH <= bytes; i += WIDTH) { \
+					VEC x = LOADU(reinterpret_cast<const VEC *>(a + i)); \
+					STOREU(reinterpret_cast<VEC *>(a + i), OP(x, LOADU(reinterpret_cast<const VEC *>(b + i)))); \
+				} \
+				for (; i < bytes; ++i) { \
+					unsigned char x = a[i]; \
+					unsigned char y = b[i]; \
+					a[i] = static_cast<unsigned char>(OP##_SCALAR(x, y)); \
+				} \
+			}
+
+#		define KERBAL_BITSET_X86_AND_SCALAR(x, y) ((x) & (y))
+#		define KERBAL_BITSET_X86_OR_SCALAR(x, y) ((x) | (y))
+#		define KERBAL_BITSET_X86_XOR_SCALAR(x, y) ((x) ^ (y))
+
+#		define KERBAL_BITSET_X86_SSE2_AND _mm_and_si128
+#		define KERBAL_BITSET_X86_SSE2_OR _mm_or_si128
+#		define KERBAL_BITSET_X86_SSE2_XOR _mm_xor_si128
+#		define KERBAL_BITSET_X86_SSE2_AND_SCALAR KERBAL_BITSET_X86_AND_SCALAR
+#		define KERBAL_BITSET_X86_SSE2_OR_SCALAR KERBAL_BITSET_X86_OR_SCALAR
+#		define KERBAL_BITSET_X86_SSE2_XOR_SCALAR KERBAL_BITSET_X86_XOR_SCALAR
+
+#		define KERBAL_BITSET_X86_AVX2_AND _mm256_and_si256
+#		define KERBAL_BITSET_X86_AVX2_OR _mm256_or_si256
+#		define KERBAL_BITSET_X86_AVX2_XOR _mm256_xor_si256
+#		define KERBAL_BITSET_X86_AVX2_AND_SCALAR KERBAL_BITSET_X86_AND_SCALAR
+#		define KERBAL_BITSET_X86_AVX2_OR_SCALAR KERBAL_BITSET_X86_OR_SCALAR
+#		define KERBAL_BITSET_X86_AVX2_XOR_SCALAR KERBAL_BITSET_X86_XOR_SCALAR
+
+#		define KERBAL_BITSET_X86_AVX512_AND _mm512_and_si512
+#		define KERBAL_BITSET_X86_AVX512_OR _mm512_or_si512
+#		define KERBAL_BITSET_X86_AVX512_XOR _mm512_xor_si512
+#		define KERBAL_BITSET_X86_AVX512_AND_SCALAR KERBAL_BITSET_X86_AND_SCALAR
+#		define KERBAL_BITSET_X86_AVX512_OR_SCALAR KERBAL_BITSET_X86_OR_SCALAR
+#		define KERBAL_BITSET_X86_AVX512_XOR_SCALAR KERBAL_BITSET_X86_XOR_SCALAR
+
+			KERBAL_BITSET_X86_BINARY_KERNEL(bitset_and_assign_sse2, "sse2", __m128i, 16, _mm_loadu_si128, _mm_storeu_si128, KERBAL_BITSET_X86_SSE2_AND)
+			KERBAL_BITSET_X86_BINARY_KERNEL(bitset_or_assign_sse2, "sse2", __m128i, 16, _mm_loadu_si128, _mm_storeu_si128, KERBAL_BITSET_X86_SSE2_OR)
+			KERBAL_BITSET_X86_BINARY_KERNEL(bitset_xor_assign_sse2, "sse2", __m128i, 16, _mm_loadu_si128, _mm_storeu_si128, KERBAL_BITSET_X86_SSE2_XOR)
+
+			KERBAL_BITSET_X86_BINARY_KERNEL(bitset_and_assign_avx2, "avx2", __m256i, 32, _mm256_loadu_si256, _mm256_storeu_si256, KERBAL_BITSET_X86_AVX2_AND)
+			KERBAL_BITSET_X86_BINARY_KERNEL(bitset_or_assign_avx2, "avx2", __m256i, 32, _mm256_loadu_si256, _mm256_storeu_si256, KERBAL_BITSET_X86_AVX2_OR)
+			KERBAL_BITSET_X86_BINARY_KERNEL(bitset_xor_assign_avx2, "avx2", __m256i, 32, _mm256_loadu_si256, _mm256_storeu_si256, KERBAL_BITSET_X86_AVX2_XOR)
+
+			KERBAL_BITSET_X86_BINARY_KERNEL(bitset_and_assign_avx512, "avx512f", __m512i, 64, _mm512_loadu_si512, _mm512_storeu_si512, KERBAL_BITSET_X86_AVX512_AND)
+			KERBAL_BITSET_X86_BINARY_KERNEL(bitset_or_assign_avx512, "avx512f", __m512i, 64, _mm512_loadu_si512, _mm512_storeu_si512, KERBAL_BITSET_X86_AVX512_OR)
+			KERBAL_BITSET_X86_BINARY_KERNEL(bitset_xor_assign_avx512, "avx512f", __m512i, 64, _mm512_loadu_si512, _mm512_storeu_si512, KERBAL_BITSET_X86_AVX512_XOR)
+
+#		undef KERBAL_BITSET_X86_AVX512_XOR_SCALAR
+#		undef KERBAL_BITSET_X86_AVX512_OR_SCALAR
+#		undef KERBAL_BITSET_X86_AVX512_AND_SCALAR
+#		undef KERBAL_BITSET_X86_AVX512_XOR
+#		undef KERBAL_BITSET_X86_AVX512_OR
+#		undef KERBAL_BITSET_X86_AVX512_AND
+#		undef KERBAL_BITSET_X86_AVX2_XOR_SCALAR
+#		undef KERBAL_BITSET_X86_AVX2_OR_SCALAR
+#		undef KERBAL_BITSET_X86_AVX2_AND_SCALAR
+#		undef KERBAL_BITSET_X86_AVX2_XOR
+#		undef KERBAL_BITSET_X86_AVX2_OR
+#		undef KERBAL_BITSET_X86_AVX2_AND
+#		undef KERBAL_BITSET_X86_SSE2_XOR_SCALAR
+#		undef KERBAL_BITSET_X86_SSE2_OR_SCALAR
+#		undef KERBAL_BITSET_X86_SSE2_AND_SCALAR
+#		undef KERBAL_BITSET_X86_SSE2_XOR
+#		undef KERBAL_BITSET_X86_SSE2_OR
+#		undef KERBAL_BITSET_X86_SSE2_AND
+#		undef KERBAL_BITSET_X86_XOR_SCALAR
+#		undef KERBAL_BITSET_X86_OR_SCALAR
+#		undef KERBAL_BITSET_X86_AND_SCALAR
+#		undef KERBAL_BITSET_X86_BINARY_KERNEL
+
+
+			KERBAL_X86_TARGET("sse2")
+			inline
+			void bitset_flip_sse2(unsigned char * a, std::size_t bytes) KERBAL_NOEXCEPT
+			{
+				const __m128i ones = _mm_set1_epi32(-1);
+				std::size_t i = 0;
+				for (; i + 16 <= bytes; i += 16) {
+					__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+					_mm_storeu_si128(reinterpret_cast<__m128i *>(a + i), _mm_xor_si128(x, ones));
+				}
+				for (; i < bytes; ++i) {
+					a[i] = static_cast<unsigned char>(~a[i]);
+				}
+			}
+
+			KERBAL_X86_TARGET("avx2")
+			inline
+			void bitset_flip_avx2(unsigned char * a, std::size_t bytes) KERBAL_NOEXCEPT
+			{
+				const __m256i ones = _mm256_set1_epi32(-1);
+				std::size_t i = 0;
+				for (; i + 32 <= bytes; i += 32) {
+					__m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+					_mm256_storeu_si256(reinterpret_cast<__m256i *>(a + i), _mm256_xor_si256(x, ones));
+				}
+				for (; i < bytes; ++i) {
+					a[i] = static_cast<unsigned char>(~a[i]);
+				}
+			}
+
+			KERBAL_X86_TARGET("avx512f")
+			inline
+			void bitset_flip_avx512(unsigned char * a, std::size_t bytes) KERBAL_NOEXCEPT
+			{
+				const __m512i ones = _mm512_set1_epi32(-1);
+				std::size_t i = 0;
+				for (; i + 64 <= bytes; i += 64) {
+					__m512i x = _mm512_loadu_si512(a + i);
+					_mm512_storeu_si512(a + i, _mm512_xor_si512(x, ones));
+				}
+				for (; i < bytes; ++i) {
+					a[i] = static_cast<unsigned char>(~a[i]);
+				}
+			}
+
+
+			/*
+			 * any: some bit of a is set
+			 * all: every bit of a is set
+			 * equal: a == b
+			 *
+			 * Four vectors are folded together before each test, so that there is one branch per 4 vectors.
+			 */
+
+			KERBAL_X86_TARGET("sse2")
+			inline
+			bool bitset_any_sse2(const unsigned char * a, std::size_t bytes) KERBAL_NOEXCEPT
+			{
+				const __m128i zero = _mm_setzero_si128();
+				std::size_t i = 0;
+				for (; i + 64 <= bytes; i += 64) {
+					__m128i x = _mm_or_si128(
+							_mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i)),
+										_mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i + 16))),
+							_mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i + 32)),
+										_mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i + 48))));
+					if (_mm_movemask_epi8(_mm_cmpeq_epi8(x, zero)) != 0xFFFF) {
+						return true;
+					}
+				}
+				for (; i + 16 <= bytes; i += 16) {
+					__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+					if (_mm_movemask_epi8(_mm_cmpeq_epi8(x, zero)) != 0xFFFF) {
+						return true;
+					}
+				}
+				for (; i < bytes; ++i) {
+					if (a[i] != 0) {
+						return true;
+					}
+				}
+				return false;
+			}
+
+			KERBAL_X86_TARGET("avx2")
+			inline
+			bool bitset_any_avx2(const unsigned char * a, std::size_t bytes) KERBAL_NOEXCEPT
+			{
+				std::size_t i = 0;
+				for (; i + 128 <= bytes; i += 128) {
+					__m256i x = _mm256_or_si256(
+							_mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i)),
+											_mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i + 32))),
+							_mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i + 64)),
+											_mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i + 96))));
+					if (!_mm256_testz_si256(x, x)) {
+						return true;
+					}
+				}
+				for (; i + 32 <= bytes; i += 32) {
+					__m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+					if (!_mm256_testz_si256(x, x)) {
+						return true;
+					}
+				}
+				for (; i < bytes; ++i) {
+					if (a[i] != 0) {
+						return true;
+					}
+				}
+				return false;
+			}
+
+			KERBAL_X86_TARGET("avx512f")
+			inline
+			bool bitset_any_avx512(const unsigned char * a, std::size_t bytes) KERBAL_NOEXCEPT
+			{
+				std::size_t i = 0;
+				for (; i + 256 <= bytes; i += 256) {
+					__m512i x = _mm512_or_si512(
+							_mm512_or_si512(_mm512_loadu_si512(a + i), _mm512_loadu_si512(a + i + 64)),
+							_mm512_or_si512(_mm512_loadu_si512(a + i + 128), _mm512_loadu_si512(a + i + 192)));
+					if (_mm512_test_epi64_mask(x, x) != 0) {
+						return true;
+					}
+				}
+				for (; i + 64 <= bytes; i += 64) {
+					__m512i x = _mm512_loadu_si512(a + i);
+					if (_mm512_test_epi64_mask(x, x) != 0) {
+						return true;
+					}
+				}
+				for (; i < bytes; ++i) {
+					if (a[i] != 0) {
+						return true;
+					}
+				}
+				return false;
+			}
+
+			KERBAL_X86_TARGET("sse2")
+			inline
+			bool bitset_all_sse2(const unsigned char * a, std::size_t bytes) KERBAL_NOEXCEPT
+			{
+				const __m128i ones = _mm_set1_epi32(-1);
+				std::size_t i = 0;
+				for (; i + 64 <= bytes; i += 64) {
+					__m128i x = _mm_and_si128(
+							_mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i)),
+										_mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i + 16))),
+							_mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i + 32)),
+										_mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i + 48))));
+					if (_mm_movemask_epi8(_mm_cmpeq_epi8(x, ones)) != 0xFFFF) {
+						return false;
+					}
+				}
+				for (; i + 16 <= bytes; i += 16) {
+					__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+					if (_mm_movemask_epi8(_mm_cmpeq_epi8(x, ones)) != 0xFFFF) {
+						return false;
+					}
+				}
+				for (; i < bytes; ++i) {
+					if (a[i] != 0xFFu) {
+						return false;
+					}
+				}
+				return true;
+			}
+
+			KERBAL_X86_TARGET("avx2")
+			inline
+			bool bitset_all_avx2(const unsigned char * a, std::size_t bytes) KERBAL_NOEXCEPT
+			{
+				const __m256i ones = _mm256_set1_epi32(-1);
+				std::size_t i = 0;
+				for (; i + 128 <= bytes; i += 128) {
+					__m256i x = _mm256_and_si256(
+							_mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i)),
+											_mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i + 32))),
+							_mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i + 64)),
+											_mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i + 96))));
+					if (!_mm256_testc_si256(x, ones)) {
+						return false;
+					}
+				}
+				for (; i + 32 <= bytes; i += 32) {
+					__m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+					if (!_mm256_testc_si256(x, ones)) {
+						return false;
+					}
+				}
+				for (; i < bytes; ++i) {
+					if (a[i] != 0xFFu) {
+						return false;
+					}
+				}
+				return true;
+			}
+
+			KERBAL_X86_TARGET("avx512f")
+			inline
+			bool bitset_all_avx512(const unsigned char * a, std::size_t bytes) KERBAL_NOEXCEPT
+			{
+				const __m512i ones = _mm512_set1_epi32(-1);
+				std::size_t i = 0;
+				for (; i + 256 <= bytes; i += 256) {
+					__m512i x = _mm512_and_si512(
+							_mm512_and_si512(_mm512_loadu_si512(a + i), _mm512_loadu_si512(a + i + 64)),
+							_mm512_and_si512(_mm512_loadu_si512(a + i + 128), _mm512_loadu_si512(a + i + 192)));
+					if (_mm512_cmpneq_epi64_mask(x, ones) != 0) {
+						return false;
+					}
+				}
+				for (; i + 64 <= bytes; i += 64) {
+					__m512i x = _mm512_loadu_si512(a + i);
+					if (_mm512_cmpneq_epi64_mask(x, ones) != 0) {
+						return false;
+					}
+				}
+				for (; i < bytes; ++i) {
+					if (a[i] != 0xFFu) {
+						return false;
+					}
+				}
+				return true;
+			}
+
+			KERBAL_X86_TARGET("sse2")
+			inline
+			bool bitset_equal_sse2(const unsigned char * a, const unsigned char * b, std::size_t bytes) KERBAL_NOEXCEPT
+			{
+				std::size_t i = 0;
+				for (; i + 16 <= bytes; i += 16) {
+					__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+					__m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+					if (_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) != 0xFFFF) {
+						return false;
+					}
+				}
+				for (; i < bytes; ++i) {
+					if (a[i] != b[i]) {
+						return false;
+					}
+				}
+				return true;
+			}
+
+			KERBAL_X86_TARGET("avx2")
+			inline
+			bool bitset_equal_avx2(const unsigned char * a, const unsigned char * b, std::size_t bytes) KERBAL_NOEXCEPT
+			{
+				std::size_t i = 0;
+				for (; i + 64 <= bytes; i += 64) {
+					__m256i x = _mm256_or_si256(
+							_mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i)),
+											_mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i))),
+							_mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i + 32)),
+											_mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i + 32))));
+					if (!_mm256_testz_si256(x, x)) {
+						return false;
+					}
+				}
+				for (; i < bytes; ++i) {
+					if (a[i] != b[i]) {
+						return false;
+					}
+				}
+				return true;
+			}
+
+			KERBAL_X86_TARGET("avx512f")
+			inline
+			bool bitset_equal_avx512(const unsigned char * a, const unsigned char * b, std::size_t bytes) KERBAL_NOEXCEPT
+			{
+				std::size_t i = 0;
+				for (; i + 64 <= bytes; i += 64) {
+					if (_mm512_cmpneq_epi64_mask(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i)) != 0) {
+						return false;
+					}
+				}
+				for (; i < bytes; ++i) {
+					if (a[i] != b[i]) {
+						return false;
+					}
+				}
+				return true;
+			}
+
+
+			/*
+			 * popcount of the whole array
+			 *
+			 * The AVX2 version uses the nibble lookup table of Muła, Kurz and Lemire,
+			 * "Faster Population Counts Using AVX2 Instructions".
+			 */
+
+			KERBAL_X86_TARGET("popcnt")
+			inline
+			std::size_t bitset_count_popcnt(const unsigned char * a, std::size_t bytes) KERBAL_NOEXCEPT
+			{
+				std::size_t cnt = 0;
+				std::size_t i = 0;
+
+#		if KERBAL_ARCHITECTURE == KERBAL_ARCHITECTURE_AMD64
+				for (; i + 8 <= bytes; i += 8) {
+					kerbal::compatibility::uint64_t x;
+					std::memcpy(&x, a + i, 8);
+					cnt += static_cast<std::size_t>(_mm_popcnt_u64(x));
+				}
+#		endif
+
+				for (; i + 4 <= bytes; i += 4) {
+					kerbal::compatibility::uint32_t x;
+					std::memcpy(&x, a + i, 4);
+					cnt += static_cast<std::size_t>(_mm_popcnt_u32(x));
+				}
+				for (; i < bytes; ++i) {
+					cnt += static_cast<std::size_t>(_mm_popcnt_u32(a[i]));
+				}
+				return cnt;
+			}
+
+			KERBAL_X86_TARGET("avx2,popcnt")
+			inline
+			std::size_t bitset_count_avx2(const unsigned char * a, std::size_t bytes) KERBAL_NOEXCEPT
+			{
+				const __m256i lookup = _mm256_setr_epi8(
+						0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+						0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+				const __m256i low_mask = _mm256_set1_epi8(0x0f);
+
+				__m256i acc = _mm256_setzero_si256();
+				std::size_t i = 0;
+				while (i + 32 <= bytes) {
+					// the byte counters can hold at most 255 / 8 = 31 iterations
+					__m256i local = _mm256_setzero_si256();
+					for (int k = 0; k < 31 && i + 32 <= bytes; ++k, i += 32) {
+						__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+						__m256i lo = _mm256_and_si256(v, low_mask);
+						__m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+						local = _mm256_add_epi8(local, _mm256_shuffle_epi8(lookup, lo));
+						local = _mm256_add_epi8(local, _mm256_shuffle_epi8(lookup, hi));
+					}
+					acc = _mm256_add_epi64(acc, _mm256_sad_epu8(local, _mm256_setzero_si256()));
+				}
+
+				kerbal::compatibility::uint64_t lanes[4];
+				_mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), acc);
+				std::size_t cnt = static_cast<std::size_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+				return cnt + bitset_count_popcnt(a + i, bytes - i);
+			}
+
+
+			/*
+			 * Runtime dispatchers
+			 */
+
+			inline
+			void bitset_and_assign_x86(unsigned char * a, const unsigned char * b, std::size_t bytes) KERBAL_NOEXCEPT
+			{
+				const kerbal::compatibility::x86_cpu_feature & feature = kerbal::compatibility::x86_cpu_feature::instance();
+				if (feature.avx512f) {
+					bitset_and_assign_avx512(a, b, bytes);
+				} else if (feature.avx2) {
+					bitset_and_assign_avx2(a, b, bytes);
+				} else {
+					bitset_and_assign_sse2(a, b, bytes);
+				}
+			}
+
+			inline
+			void bitset_or_assign_x86(unsigned char * a, const unsigned char * b, std::size_t bytes) KERBAL_NOEXCEPT
+			{
+				const kerbal::compatibility::x86_cpu_feature & feature = kerbal::compatibility::x86_cpu_feature::instance();
+				if (feature.avx512f) {
+					bitset_or_assign_avx512(a, b, bytes);
+				} else if (feature.avx2) {
+					bitset_or_assign_avx2(a, b, bytes);
+				} else {
+					bitset_or_assign_sse2(a, b, bytes);
+				}
+			}
+
+			inline
+			void bitset_xor_assign_x86(unsigned char * a, const unsigned char * b, std::size_t bytes) KERBAL_NOEXCEPT
+			{
+				const kerbal::compatibility::x86_cpu_feature & feature = kerbal::compatibility::x86_cpu_feature::instance();
+				if (feature.avx512f) {
+					bitset_xor_assign_avx512(a, b, bytes);
+				} else if (feature.avx2) {
+					bitset_xor_assign_avx2(a, b, bytes);
+				} else {
+					bitset_xor_assign_sse2(a, b, bytes);
+				}
+			}
+
+			inline
+			void bitset_flip_x86(unsigned char * a, std::size_t bytes) KERBAL_NOEXCEPT
+			{
+				const kerbal::compatibility::x86_cpu_feature & feature = kerbal::compatibility::x86_cpu_feature::instance();
+				if (feature.avx512f) {
+					bitset_flip_avx512(a, bytes);
+				} else if (feature.avx2) {
+					bitset_flip_avx2(a, bytes);
+				} else {
+					bitset_flip_sse2(a, bytes);
+				}
+			}
+
+			inline
+			bool bitset_any_x86(const unsigned char * a, std::size_t bytes) KERBAL_NOEXCEPT
+			{
+				const kerbal::compatibility::x86_cpu_feature & feature = kerbal::compatibility::x86_cpu_feature::instance();
+				if (feature.avx512f) {
+					return bitset_any_avx512(a, bytes);
+				} else if (feature.avx2) {
+					return bitset_any_avx2(a, bytes);
+				} else {
+					return bitset_any_sse2(a, bytes);
+				}
+			}
+
+			inline
+			bool bitset_all_x86(const unsigned char * a, std::size_t bytes) KERBAL_NOEXCEPT
+			{
+				const kerbal::compatibility::x86_cpu_feature & feature = kerbal::compatibility::x86_cpu_feature::instance();
+				if (feature.avx512f) {
+					return bitset_all_avx512(a, bytes);
+				} else if (feature.avx2) {
+					return bitset_all_avx2(a, bytes);
+				} else {
+					return bitset_all_sse2(a, bytes);
+				}
+			}
+
+			inline
+			bool bitset_equal_x86(const unsigned char * a, const unsigned char * b, std::size_t bytes) KERBAL_NOEXCEPT
+			{
+				const kerbal::compatibility::x86_cpu_feature & feature = kerbal::compatibility::x86_cpu_feature::instance();
+				if (feature.avx512f) {
+					return bitset_equal_avx512(a, b, bytes);
+				} else if (feature.avx2) {
+					return bitset_equal_avx2(a, b, bytes);
+				} else {
+					return bitset_equal_sse2(a, b, bytes);
+				}
+			}
+
+			/*
+			 * @return false if the processor has no popcnt instruction, the caller should use its scalar loop
+			 */
+			inline
+			bool bitset_count_x86(const unsigned char * a, std::size_t bytes, std::size_t & cnt) KERBAL_NOEXCEPT
+			{
+				const kerbal::compatibility::x86_cpu_feature & feature = kerbal::compatibility::x86_cpu_feature::instance();
+				if (feature.avx2 && feature.popcnt) {
+					cnt = bitset_count_avx2(a, bytes);
+					return true;
+				} else if (feature.popcnt) {
+					cnt = bitset_count_popcnt(a, bytes);
+					return true;
+				}
+				return false;
+			}
+
+			/*
+			 * SSE2 is part of amd64, but has to be checked on 32-bits x86
+			 */
+			inline
+			bool bitset_x86_kernel_usable(std::size_t bytes) KERBAL_NOEXCEPT
+			{
+
+#		if KERBAL_ARCHITECTURE == KERBAL_ARCHITECTURE_AMD64
+				return bytes >= BITSET_X86_KERNEL_THRESHOLD::value;
+#		else
+				return bytes >= BITSET_X86_KERNEL_THRESHOLD::value &&
+						kerbal::compatibility::x86_cpu_feature::instance().sse2;
+#		endif
+
+			}
+
+#	endif
+
+		} // namespace detail
+
+	} // namespace bitset
+
+} // namespace kerbal
+
+#endif // KERBAL_BITSET_DETAIL_BITSET_X86_KERNEL_HPP
@@ -0,0 +1,632 @@
+/**
+ * @file       roaring_container.hpp
+ * @brief
+ * @date       2020-10-29
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_BITSET_DETAIL_ROARING_CONTAINER_HPP
+#define KERBAL_BITSET_DETAIL_ROARING_CONTAINER_HPP
+
+#include <kerbal/algorithm/binary_search.hpp>
+#include <kerbal/algorithm/swap.hpp>
+#include <kerbal/compatibility/fixed_width_integer.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/numeric/bit.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+
+#include <cstddef>
+#include <vector>
+
+#include <kerbal/bitset/detail/bitset_size_unrelated.hpp>
+
+namespace kerbal
+{
+
+	namespace bitset
+	{
+
+		namespace detail
+		{
+
+			struct roaring_bitmap_words:
+					protected kerbal::bitset::detail::bitset_size_unrelated<kerbal::compatibility::uint64_t>
+			{
+				private:
+					typedef kerbal::bitset::detail::bitset_size_unrelated<kerbal::compatibility::uint64_t> super;
+
+				public:
+					using super::count_trunk;
+					using super::equal_trunk;
+					using super::bit_and_assign;
+					using super::bit_or_assign;
+			};
+
+			/*
+			 * Holds the values of one 2^16 chunk of a roaring_bitmap, sharing the same high 16 bits (the key).
+			 *
+			 * ARRAY:  sorted low 16 bits, used while there are at most 4096 of them
+			 * BITMAP: 2^16 bits
+			 * RUN:    pairs of (start, length - 1), only produced by run_optimize()
+			 *
+			 * ARRAY and BITMAP are canonical: a container which is not a RUN one is an ARRAY one iff
+			 * its cardinality is at most ARRAY_MAX. Containers are never empty.
+			 */
+			class roaring_container
+			{
+				public:
+					typedef kerbal::compatibility::uint16_t		value_type;
+					typedef kerbal::compatibility::uint64_t		word_type;
+					typedef kerbal::compatibility::uint32_t		cardinality_type;
+
+					enum kind_type
+					{
+						ARRAY, BITMAP, RUN
+					};
+
+					typedef kerbal::type_traits::integral_constant<std::size_t, 4096>	ARRAY_MAX;
+					typedef kerbal::type_traits::integral_constant<std::size_t, 1024>	BITMAP_WORDS;
+
+				private:
+					typedef std::vector<value_type>		value_vector;
+					typedef std::vector<word_type>		word_vector;
+
+				public:
+					value_type key;
+					kind_type kind;
+					cardinality_type card;
+					value_vector values;
+					word_vector words;
+
+					explicit roaring_container(value_type key) :
+							key(key), kind(ARRAY), card(0)
+					{
+					}
+
+				private:
+					static bool word_test(const word_type w[], value_type x) KERBAL_NOEXCEPT
+					{
+						return (w[x >> 6u] >> (x & 63u)) & 1u;
+					}
+
+					// sets the bits of [lo, hi]
+					static void word_set_range(word_type w[], std::size_t lo, std::size_t hi) KERBAL_NOEXCEPT
+					{
+						std::size_t lw = lo >> 6u;
+						std::size_t hw = hi >> 6u;
+						word_type lmask = ~static_cast<word_type>(0) << (lo & 63u);
+						word_type hmask = ~static_cast<word_type>(0) >> (63u - (hi & 63u));
+						if (lw == hw) {
+							w[lw] |= lmask & hmask;
+							return;
+						}
+						w[lw] |= lmask;
+						for (std::size_t i = lw + 1; i < hw; ++i) {
+							w[i] = ~static_cast<word_type>(0);
+						}
+						w[hw] |= hmask;
+					}
+
+					bool run_contains(value_type x) const KERBAL_NOEXCEPT
+					{
+						std::size_t lo = 0, hi = this->values.size() / 2;
+						// the last run whose start <= x
+						while (lo < hi) {
+							std::size_t mid = lo + (hi - lo) / 2;
+							if (this->values[2 * mid] <= x) {
+								lo = mid + 1;
+							} else {
+								hi = mid;
+							}
+						}
+						if (lo == 0) {
+							return false;
+						}
+						std::size_t start = this->values[2 * (lo - 1)];
+						return x <= start + this->values[2 * (lo - 1) + 1];
+					}
+
+					static void set_array_bits(const value_vector & v, word_type w[]) KERBAL_NOEXCEPT
+					{
+						for (std::size_t i = 0; i < v.size(); ++i) {
+							w[v[i] >> 6u] |= static_cast<word_type>(1) << (v[i] & 63u);
+						}
+					}
+
+					static void set_run_bits(const value_vector & v, word_type w[]) KERBAL_NOEXCEPT
+					{
+						for (std::size_t i = 0; i < v.size(); i += 2) {
+							word_set_range(w, v[i], static_cast<std::size_t>(v[i]) + v[i + 1]);
+						}
+					}
+
+					void assign_array_from_bitmap()
+					{
+						value_vector v;
+						v.reserve(this->card);
+						for (std::size_t i = 0; i < BITMAP_WORDS::value; ++i) {
+							word_type w = this->words[i];
+							while (w != 0) {
+								v.push_back(static_cast<value_type>(i * 64 + kerbal::numeric::countr_zero(w)));
+								w &= w - 1;
+							}
+						}
+						this->values.swap(v);
+					}
+
+				public:
+
+					bool contains(value_type x) const KERBAL_NOEXCEPT
+					{
+						switch (this->kind) {
+							case ARRAY: {
+								value_vector::const_iterator it(kerbal::algorithm::lower_bound(this->values.begin(), this->values.end(), x));
+								return it != this->values.end() && *it == x;
+							}
+							case BITMAP: {
+								return word_test(&this->words[0], x);
+							}
+							default: {
+								return this->run_contains(x);
+							}
+						}
+					}
+
+					void to_bitmap()
+					{
+						if (this->kind == BITMAP) {
+							return;
+						}
+						this->words.assign(BITMAP_WORDS::value, 0);
+						if (this->kind == ARRAY) {
+							set_array_bits(this->values, &this->words[0]);
+						} else {
+							set_run_bits(this->values, &this->words[0]);
+						}
+						value_vector().swap(this->values);
+						this->kind = BITMAP;
+					}
+
+					/*
+					 * Brings a container back to the canonical ARRAY / BITMAP form.
+					 */
+					void normalize()
+					{
+						if (this->kind == RUN) {
+							this->to_bitmap();
+						}
+						if (this->kind == BITMAP && this->card <= ARRAY_MAX::value) {
+							this->assign_array_from_bitmap();
+							word_vector().swap(this->words);
+							this->kind = ARRAY;
+						}
+					}
+
+					// @return true if x was not in the container
+					bool add(value_type x)
+					{
+						if (this->kind == RUN) {
+							if (this->run_contains(x)) {
+								return false;
+							}
+							this->normalize();
+						}
+						if (this->kind == ARRAY) {
+							value_vector::iterator it(kerbal::algorithm::lower_bound(this->values.begin(), this->values.end(), x));
+							if (it != this->values.end() && *it == x) {
+								return false;
+							}
+							if (this->values.size() < ARRAY_MAX::value) {
+								this->values.insert(it, x);
+								++this->card;
+								return true;
+							}
+							this->to_bitmap();
+						}
+						word_type & w = this->words[x >> 6u];
+						word_type bit = static_cast<word_type>(1) << (x & 63u);
+						if (w & bit) {
+							return false;
+						}
+						w |= bit;
+						++this->card;
+						return true;
+					}
+
+					// @return true if x was in the container
+					bool remove(value_type x)
+					{
+						if (this->kind == RUN) {
+							if (!this->run_contains(x)) {
+								return false;
+							}
+							this->normalize();
+						}
+						if (this->kind == ARRAY) {
+							value_vector::iterator it(kerbal::algorithm::lower_bound(this->values.begin(), this->values.end(), x));
+							if (it == this->values.end() || *it != x) {
+								return false;
+							}
+							this->values.erase(it);
+							--this->card;
+							return true;
+						}
+						word_type & w = this->words[x >> 6u];
+						word_type bit = static_cast<word_type>(1) << (x & 63u);
+						if (!(w & bit)) {
+							return false;
+						}
+						w &= ~bit;
+						--this->card;
+						this->normalize();
+						return true;
+					}
+
+					std::size_t run_count() const KERBAL_NOEXCEPT
+					{
+						switch (this->kind) {
+							case ARRAY: {
+								std::size_t n = 0;
+								for (std::size_t i = 0; i < this->values.size(); ++i) {
+									if (i == 0 || this->values[i] != this->values[i - 1] + 1) {
+										++n;
+									}
+								}
+								return n;
+							}
+							case BITMAP: {
+								// a run starts at each set bit whose predecessor is not set
+								std::size_t n = 0;
+								word_type carry = 0;
+								for (std::size_t i = 0; i < BITMAP_WORDS::value; ++i) {
+									word_type w = this->words[i];
+									n += kerbal::numeric::popcount(static_cast<word_type>(w & ~((w << 1u) | carry)));
+									carry = w >> 63u;
+								}
+								return n;
+							}
+							default: {
+								return this->values.size() / 2;
+							}
+						}
+					}
+
+					/*
+					 * Switches to whichever of the three representations is the smallest.
+					 *
+					 * @return true if the container is a RUN one afterwards
+					 */
+					bool run_optimize()
+					{
+						std::size_t runs = this->run_count();
+						std::size_t run_bytes = 4 * runs;
+						std::size_t other_bytes = this->card <= ARRAY_MAX::value ? 2 * this->card : 8 * BITMAP_WORDS::value;
+						if (run_bytes >= other_bytes) {
+							this->normalize();
+							return false;
+						}
+						if (this->kind == RUN) {
+							return true;
+						}
+						this->to_bitmap();
+						value_vector v;
+						v.reserve(2 * runs);
+						std::size_t i = 0;
+						while (i < 65536) {
+							std::size_t wi = i >> 6u;
+							word_type w = this->words[wi] & (~static_cast<word_type>(0) << (i & 63u));
+							while (w == 0 && ++wi < BITMAP_WORDS::value) {
+								w = this->words[wi];
+							}
+							if (w == 0) {
+								break;
+							}
+							std::size_t start = wi * 64 + kerbal::numeric::countr_zero(w);
+							// first zero at or after start
+							w = ~this->words[wi] & (~static_cast<word_type>(0) << (start & 63u));
+							while (w == 0 && ++wi < BITMAP_WORDS::value) {
+								w = ~this->words[wi];
+							}
+							std::size_t end = w == 0 ? 65536 : wi * 64 + kerbal::numeric::countr_zero(w);
+							v.push_back(static_cast<value_type>(start));
+							v.push_back(static_cast<value_type>(end - start - 1));
+							i = end;
+						}
+						this->values.swap(v);
+						word_vector().swap(this->words);
+						this->kind = RUN;
+						return true;
+					}
+
+					template <typename UnaryFunction>
+					void for_each(UnaryFunction & f) const
+					{
+						kerbal::compatibility::uint32_t high = static_cast<kerbal::compatibility::uint32_t>(this->key) << 16u;
+						switch (this->kind) {
+							case ARRAY: {
+								for (std::size_t i = 0; i < this->values.size(); ++i) {
+									f(high | this->values[i]);
+								}
+								break;
+							}
+							case BITMAP: {
+								for (std::size_t i = 0; i < BITMAP_WORDS::value; ++i) {
+									word_type w = this->words[i];
+									while (w != 0) {
+										f(high | static_cast<kerbal::compatibility::uint32_t>(i * 64 + kerbal::numeric::countr_zero(w)));
+										w &= w - 1;
+									}
+								}
+								break;
+							}
+							default: {
+								for (std::size_t i = 0; i < this->values.size(); i += 2) {
+									kerbal::compatibility::uint32_t x = this->values[i];
+									kerbal::compatibility::uint32_t last = x + this->values[i + 1];
+									for (; x <= last; ++x) {
+										f(high | x);
+									}
+								}
+								break;
+							}
+						}
+					}
+
+				private:
+					static void bitmap_of(const roaring_container & c, word_vector & w)
+					{
+						if (c.kind == BITMAP) {
+							w = c.words;
+							return;
+						}
+						w.assign(BITMAP_WORDS::value, 0);
+						if (c.kind == ARRAY) {
+							set_array_bits(c.values, &w[0]);
+						} else {
+							set_run_bits(c.values, &w[0]);
+						}
+					}
+
+					static void union_run(const roaring_container & a, const roaring_container & b, roaring_container & r)
+					{
+						value_vector v;
+						v.reserve(a.values.size() + b.values.size());
+						std::size_t i = 0, j = 0;
+						while (i < a.values.size() || j < b.values.size()) {
+							const value_vector * src;
+							std::size_t * k;
+							if (j == b.values.size() || (i < a.values.size() && a.values[i] <= b.values[j])) {
+								src = &a.values;
+								k = &i;
+							} else {
+								src = &b.values;
+								k = &j;
+							}
+							std::size_t start = (*src)[*k];
+							std::size_t last = start + (*src)[*k + 1];
+							*k += 2;
+							if (!v.empty()) {
+								std::size_t pstart = v[v.size() - 2];
+								std::size_t plast = pstart + v[v.size() - 1];
+								if (start <= plast + 1) {
+									if (last > plast) {
+										v[v.size() - 1] = static_cast<value_type>(last - pstart);
+									}
+									continue;
+								}
+							}
+							v.push_back(static_cast<value_type>(start));
+							v.push_back(static_cast<value_type>(last - start));
+						}
+						r.values.swap(v);
+						r.kind = RUN;
+						r.card = 0;
+						for (std::size_t k = 0; k < r.values.size(); k += 2) {
+							r.card += static_cast<cardinality_type>(r.values[k + 1]) + 1;
+						}
+					}
+
+					static void intersect_run(const roaring_container & a, const roaring_container & b, roaring_container & r)
+					{
+						value_vector v;
+						std::size_t i = 0, j = 0;
+						cardinality_type card = 0;
+						while (i < a.values.size() && j < b.values.size()) {
+							std::size_t as = a.values[i], al = as + a.values[i + 1];
+							std::size_t bs = b.values[j], bl = bs + b.values[j + 1];
+							std::size_t s = as > bs ? as : bs;
+							std::size_t l = al < bl ? al : bl;
+							if (s <= l) {
+								v.push_back(static_cast<value_type>(s));
+								v.push_back(static_cast<value_type>(l - s));
+								card += static_cast<cardinality_type>(l - s + 1);
+							}
+							if (al < bl) {
+								i += 2;
+							} else {
+								j += 2;
+							}
+						}
+						r.values.swap(v);
+						r.kind = RUN;
+						r.card = card;
+					}
+
+				public:
+
+					/*
+					 * r = a | b, r must be a fresh container
+					 */
+					static void union_of(const roaring_container & a, const roaring_container & b, roaring_container & r)
+					{
+						if (a.kind == RUN && b.kind == RUN) {
+							union_run(a, b, r);
+							return;
+						}
+						if (a.kind == ARRAY && b.kind == ARRAY && a.card + b.card <= ARRAY_MAX::value) {
+							value_vector v;
+							v.reserve(a.card + b.card);
+							std::size_t i = 0, j = 0;
+							while (i < a.values.size() && j < b.values.size()) {
+								if (a.values[i] < b.values[j]) {
+									v.push_back(a.values[i++]);
+								} else if (b.values[j] < a.values[i]) {
+									v.push_back(b.values[j++]);
+								} else {
+									v.push_back(a.values[i++]);
+									++j;
+								}
+							}
+							v.insert(v.end(), a.values.begin() + i, a.values.end());
+							v.insert(v.end(), b.values.begin() + j, b.values.end());
+							r.values.swap(v);
+							r.kind = ARRAY;
+							r.card = static_cast<cardinality_type>(r.values.size());
+							return;
+						}
+						const roaring_container & base = b.kind == BITMAP ? b : a;
+						const roaring_container & other = b.kind == BITMAP ? a : b;
+						bitmap_of(base, r.words);
+						r.kind = BITMAP;
+						if (other.kind == BITMAP) {
+							roaring_bitmap_words::bit_or_assign(&r.words[0], &other.words[0], BITMAP_WORDS::value);
+						} else if (other.kind == ARRAY) {
+							set_array_bits(other.values, &r.words[0]);
+						} else {
+							set_run_bits(other.values, &r.words[0]);
+						}
+						r.card = static_cast<cardinality_type>(roaring_bitmap_words::count_trunk(&r.words[0], BITMAP_WORDS::value));
+						r.normalize();
+					}
+
+					/*
+					 * r = a & b, r must be a fresh container, r may be empty afterwards
+					 */
+					static void intersection_of(const roaring_container & a, const roaring_container & b, roaring_container & r)
+					{
+						if (a.kind == RUN && b.kind == RUN) {
+							intersect_run(a, b, r);
+							return;
+						}
+						if (a.kind == ARRAY || b.kind == ARRAY) {
+							const roaring_container & arr = a.kind == ARRAY ? a : b;
+							const roaring_container & other = a.kind == ARRAY ? b : a;
+							value_vector v;
+							if (other.kind == ARRAY) {
+								std::size_t i = 0, j = 0;
+								while (i < arr.values.size() && j < other.values.size()) {
+									if (arr.values[i] < other.values[j]) {
+										++i;
+									} else if (other.values[j] < arr.values[i]) {
+										++j;
+									} else {
+										v.push_back(arr.values[i]);
+										++i;
+										++j;
+									}
+								}
+							} else {
+								for (std::size_t i = 0; i < arr.values.size(); ++i) {
+									if (other.contains(arr.values[i])) {
+										v.push_back(arr.values[i]);
+									}
+								}
+							}
+							r.values.swap(v);
+							r.kind = ARRAY;
+							r.card = static_cast<cardinality_type>(r.values.size());
+							return;
+						}
+						bitmap_of(a, r.words);
+						r.kind = BITMAP;
+						if (b.kind == BITMAP) {
+							roaring_bitmap_words::bit_and_assign(&r.words[0], &b.words[0], BITMAP_WORDS::value);
+						} else {
+							word_vector w;
+							bitmap_of(b, w);
+							roaring_bitmap_words::bit_and_assign(&r.words[0], &w[0], BITMAP_WORDS::value);
+						}
+						r.card = static_cast<cardinality_type>(roaring_bitmap_words::count_trunk(&r.words[0], BITMAP_WORDS::value));
+						r.normalize();
+					}
+
+					static cardinality_type intersection_cardinality(const roaring_container & a, const roaring_container & b)
+					{
+						if (a.kind == ARRAY || b.kind == ARRAY) {
+							const roaring_container & arr = a.kind == ARRAY ? a : b;
+							const roaring_container & other = a.kind == ARRAY ? b : a;
+							cardinality_type n = 0;
+							if (other.kind == ARRAY) {
+								std::size_t i = 0, j = 0;
+								while (i < arr.values.size() && j < other.values.size()) {
+									if (arr.values[i] < other.values[j]) {
+										++i;
+									} else if (other.values[j] < arr.values[i]) {
+										++j;
+									} else {
+										++n;
+										++i;
+										++j;
+									}
+								}
+							} else {
+								for (std::size_t i = 0; i < arr.values.size(); ++i) {
+									n += other.contains(arr.values[i]);
+								}
+							}
+							return n;
+						}
+						if (a.kind == BITMAP && b.kind == BITMAP) {
+							cardinality_type n = 0;
+							for (std::size_t i = 0; i < BITMAP_WORDS::value; ++i) {
+								n += kerbal::numeric::popcount(static_cast<word_type>(a.words[i] & b.words[i]));
+							}
+							return n;
+						}
+						roaring_container r(a.key);
+						intersection_of(a, b, r);
+						return r.card;
+					}
+
+					static bool equal(const roaring_container & a, const roaring_container & b)
+					{
+						if (a.card != b.card) {
+							return false;
+						}
+						if (a.kind != RUN && b.kind != RUN) {
+							// both canonical with the same cardinality, hence the same kind
+							return a.kind == ARRAY ?
+									a.values == b.values :
+									roaring_bitmap_words::equal_trunk(&a.words[0], &b.words[0], BITMAP_WORDS::value);
+						}
+						if (a.kind == RUN && b.kind == RUN) {
+							return a.values == b.values;
+						}
+						word_vector wa, wb;
+						bitmap_of(a, wa);
+						bitmap_of(b, wb);
+						return roaring_bitmap_words::equal_trunk(&wa[0], &wb[0], BITMAP_WORDS::value);
+					}
+
+					void swap(roaring_container & ano) KERBAL_NOEXCEPT
+					{
+						kerbal::algorithm::swap(this->key, ano.key);
+						kerbal::algorithm::swap(this->kind, ano.kind);
+						kerbal::algorithm::swap(this->card, ano.card);
+						this->values.swap(ano.values);
+						this->words.swap(ano.words);
+					}
+
+			};
+
+		} // namespace detail
+
+	} // namespace bitset
+
+} // namespace kerbal
+
+#endif // KERBAL_BITSET_DETAIL_ROARING_CONTAINER_HPP
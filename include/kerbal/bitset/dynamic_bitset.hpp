@@ -0,0 +1,533 @@
+/**
+ * @file       dynamic_bitset.hpp
+ * @brief
+ * @date       2020-10-29
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_BITSET_DYNAMIC_BITSET_HPP
+#define KERBAL_BITSET_DYNAMIC_BITSET_HPP
+
+#include <kerbal/algorithm/modifier.hpp>
+#include <kerbal/algorithm/swap.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/compatibility/static_assert.hpp>
+#include <kerbal/memory/allocator_traits.hpp>
+#include <kerbal/numeric/bit.hpp>
+#include <kerbal/type_traits/sign_deduction.hpp>
+#include <kerbal/utility/member_compress_helper.hpp>
+
+#include <cstddef>
+#include <memory>
+
+#include <kerbal/bitset/detail/bitset_size_unrelated.hpp>
+#include <kerbal/bitset/detail/default_block_type.hpp>
+
+namespace kerbal
+{
+
+	namespace bitset
+	{
+
+		/**
+		 * Bitset whose size is chosen at run time.
+		 *
+		 * The bits of the last block beyond size() are always kept to 0, so that the whole block array
+		 * could be handed to the kernels of bitset_size_unrelated.
+		 */
+		template <typename Block = KERBAL_BITSET_DEFAULT_BLOCK_TYPE, typename Allocator = std::allocator<Block> >
+		class dynamic_bitset:
+				protected detail::bitset_size_unrelated<Block>,
+				private kerbal::utility::member_compress_helper<Allocator>
+		{
+				KERBAL_STATIC_ASSERT(kerbal::type_traits::is_unsigned<Block>::value, "Block must be unsigned type");
+
+			private:
+				typedef detail::bitset_size_unrelated<Block>					bitset_size_unrelated;
+				typedef kerbal::utility::member_compress_helper<Allocator>		allocator_compress_helper;
+				typedef kerbal::memory::allocator_traits<Allocator>				allocator_traits;
+
+			public:
+				typedef Block													block_type;
+				typedef Allocator												allocator_type;
+				typedef typename bitset_size_unrelated::BITS_PER_BLOCK			BITS_PER_BLOCK;
+				typedef std::size_t												size_type;
+				typedef typename bitset_size_unrelated::block_width_type		block_width_type;
+
+			private:
+				typedef typename bitset_size_unrelated::ALL_ONE					ALL_ONE;
+
+				block_type * m_block;
+				size_type m_size;
+				block_width_type m_block_capacity;
+
+				static block_width_type block_size_of(size_type n) KERBAL_NOEXCEPT
+				{
+					return n / BITS_PER_BLOCK::value + (n % BITS_PER_BLOCK::value != 0);
+				}
+
+				Allocator & alloc() KERBAL_NOEXCEPT
+				{
+					return allocator_compress_helper::member();
+				}
+
+				// bits of the last block that belong to the bitset
+				block_type tail_mask() const KERBAL_NOEXCEPT
+				{
+					return this->m_size % BITS_PER_BLOCK::value == 0 ?
+							ALL_ONE::value :
+							kerbal::numeric::mask<block_type>(this->m_size % BITS_PER_BLOCK::value);
+				}
+
+				void clear_tail() KERBAL_NOEXCEPT
+				{
+					if (this->m_size != 0) {
+						this->m_block[this->block_size() - 1] &= this->tail_mask();
+					}
+				}
+
+				void reallocate(block_width_type new_block_capacity)
+				{
+					block_type * p = allocator_traits::allocate(this->alloc(), new_block_capacity);
+					block_width_type used = this->block_size();
+					kerbal::algorithm::copy(this->m_block, this->m_block + used, p);
+					kerbal::algorithm::fill(p + used, p + new_block_capacity, static_cast<block_type>(0));
+					if (this->m_block != NULL) {
+						allocator_traits::deallocate(this->alloc(), this->m_block, this->m_block_capacity);
+					}
+					this->m_block = p;
+					this->m_block_capacity = new_block_capacity;
+				}
+
+				void assign_blocks(size_type n, bool value)
+				{
+					block_width_type bs = block_size_of(n);
+					if (bs != 0) {
+						this->m_block = allocator_traits::allocate(this->alloc(), bs);
+						this->m_block_capacity = bs;
+					}
+					this->m_size = n;
+					kerbal::algorithm::fill(this->m_block, this->m_block + bs,
+											value ? ALL_ONE::value : static_cast<block_type>(0));
+					this->clear_tail();
+				}
+
+			public:
+				dynamic_bitset() :
+						allocator_compress_helper(kerbal::utility::in_place_t()),
+						m_block(NULL), m_size(0), m_block_capacity(0)
+				{
+				}
+
+				explicit dynamic_bitset(const Allocator & alloc) :
+						allocator_compress_helper(kerbal::utility::in_place_t(), alloc),
+						m_block(NULL), m_size(0), m_block_capacity(0)
+				{
+				}
+
+				explicit dynamic_bitset(size_type n, bool value = false) :
+						allocator_compress_helper(kerbal::utility::in_place_t()),
+						m_block(NULL), m_size(0), m_block_capacity(0)
+				{
+					this->assign_blocks(n, value);
+				}
+
+				dynamic_bitset(size_type n, bool value, const Allocator & alloc) :
+						allocator_compress_helper(kerbal::utility::in_place_t(), alloc),
+						m_block(NULL), m_size(0), m_block_capacity(0)
+				{
+					this->assign_blocks(n, value);
+				}
+
+				dynamic_bitset(const dynamic_bitset & src) :
+						allocator_compress_helper(kerbal::utility::in_place_t(), src.allocator_compress_helper::member()),
+						m_block(NULL), m_size(0), m_block_capacity(0)
+				{
+					block_width_type bs = src.block_size();
+					if (bs != 0) {
+						this->m_block = allocator_traits::allocate(this->alloc(), bs);
+						this->m_block_capacity = bs;
+						kerbal::algorithm::copy(src.m_block, src.m_block + bs, this->m_block);
+					}
+					this->m_size = src.m_size;
+				}
+
+#		if __cplusplus >= 201103L
+
+				dynamic_bitset(dynamic_bitset && src) noexcept :
+						allocator_compress_helper(kerbal::utility::in_place_t(), src.allocator_compress_helper::member()),
+						m_block(src.m_block), m_size(src.m_size), m_block_capacity(src.m_block_capacity)
+				{
+					src.m_block = NULL;
+					src.m_size = 0;
+					src.m_block_capacity = 0;
+				}
+
+#		endif
+
+				~dynamic_bitset()
+				{
+					if (this->m_block != NULL) {
+						allocator_traits::deallocate(this->alloc(), this->m_block, this->m_block_capacity);
+					}
+				}
+
+				dynamic_bitset& operator=(const dynamic_bitset & src)
+				{
+					dynamic_bitset tmp(src);
+					this->swap(tmp);
+					return *this;
+				}
+
+#		if __cplusplus >= 201103L
+
+				dynamic_bitset& operator=(dynamic_bitset && src) noexcept
+				{
+					this->swap(src);
+					return *this;
+				}
+
+#		endif
+
+				allocator_type get_allocator() const
+				{
+					return allocator_compress_helper::member();
+				}
+
+				size_type size() const KERBAL_NOEXCEPT
+				{
+					return this->m_size;
+				}
+
+				bool empty() const KERBAL_NOEXCEPT
+				{
+					return this->m_size == 0;
+				}
+
+				block_width_type block_size() const KERBAL_NOEXCEPT
+				{
+					return block_size_of(this->m_size);
+				}
+
+				size_type capacity() const KERBAL_NOEXCEPT
+				{
+					return this->m_block_capacity * BITS_PER_BLOCK::value;
+				}
+
+				const block_type * data() const KERBAL_NOEXCEPT
+				{
+					return this->m_block;
+				}
+
+				void reserve(size_type new_cap)
+				{
+					block_width_type bs = block_size_of(new_cap);
+					if (bs > this->m_block_capacity) {
+						this->reallocate(bs);
+					}
+				}
+
+				/**
+				 * Changes the number of bits to n. The appended bits are initialized by value.
+				 */
+				void resize(size_type n, bool value = false)
+				{
+					size_type old_size = this->m_size;
+					block_width_type bs = block_size_of(n);
+					if (bs > this->m_block_capacity) {
+						block_width_type new_cap = this->m_block_capacity * 2;
+						this->reallocate(new_cap < bs ? bs : new_cap);
+					}
+					if (n < old_size) {
+						this->m_size = n;
+						kerbal::algorithm::fill(this->m_block + bs, this->m_block + block_size_of(old_size),
+												static_cast<block_type>(0));
+						this->clear_tail();
+						return;
+					}
+					this->m_size = n;
+					if (value && n > old_size) {
+						block_width_type first_full = block_size_of(old_size);
+						if (old_size % BITS_PER_BLOCK::value != 0) {
+							this->m_block[first_full - 1] |= static_cast<block_type>(
+									ALL_ONE::value << (old_size % BITS_PER_BLOCK::value));
+						}
+						kerbal::algorithm::fill(this->m_block + first_full, this->m_block + bs, ALL_ONE::value);
+						this->clear_tail();
+					}
+				}
+
+				void push_back(bool value)
+				{
+					size_type pos = this->m_size;
+					this->resize(pos + 1);
+					if (value) {
+						this->set(pos);
+					}
+				}
+
+				void pop_back() KERBAL_NOEXCEPT
+				{
+					this->reset(this->m_size - 1);
+					--this->m_size;
+				}
+
+				void clear() KERBAL_NOEXCEPT
+				{
+					kerbal::algorithm::fill(this->m_block, this->m_block + this->block_size(), static_cast<block_type>(0));
+					this->m_size = 0;
+				}
+
+				bool test(size_type pos) const KERBAL_NOEXCEPT
+				{
+					return kerbal::numeric::get_bit(this->m_block[pos / BITS_PER_BLOCK::value],
+													pos % BITS_PER_BLOCK::value);
+				}
+
+				bool operator[](size_type pos) const KERBAL_NOEXCEPT
+				{
+					return this->test(pos);
+				}
+
+				// Checks if all bits are set to true
+				bool all() const KERBAL_NOEXCEPT
+				{
+					if (this->m_size == 0) {
+						return true;
+					}
+					block_width_type bs = this->block_size();
+					return bitset_size_unrelated::all_trunk(this->m_block, bs - 1) &&
+							this->m_block[bs - 1] == this->tail_mask();
+				}
+
+				// Checks if any bits are set to true
+				bool any() const KERBAL_NOEXCEPT
+				{
+					return bitset_size_unrelated::any_trunk(this->m_block, this->block_size());
+				}
+
+				// Checks if none of the bits are set to true
+				bool none() const KERBAL_NOEXCEPT
+				{
+					return bitset_size_unrelated::none_trunk(this->m_block, this->block_size());
+				}
+
+				// Returns the number of bits that are set to true
+				size_type count() const KERBAL_NOEXCEPT
+				{
+					return bitset_size_unrelated::count_trunk(this->m_block, this->block_size());
+				}
+
+				dynamic_bitset& reset() KERBAL_NOEXCEPT
+				{
+					kerbal::algorithm::fill(this->m_block, this->m_block + this->block_size(), static_cast<block_type>(0));
+					return *this;
+				}
+
+				dynamic_bitset& reset(size_type pos) KERBAL_NOEXCEPT
+				{
+					block_type & b = this->m_block[pos / BITS_PER_BLOCK::value];
+					b = kerbal::numeric::reset_bit(b, pos % BITS_PER_BLOCK::value);
+					return *this;
+				}
+
+				dynamic_bitset& set() KERBAL_NOEXCEPT
+				{
+					kerbal::algorithm::fill(this->m_block, this->m_block + this->block_size(), ALL_ONE::value);
+					this->clear_tail();
+					return *this;
+				}
+
+				dynamic_bitset& set(size_type pos) KERBAL_NOEXCEPT
+				{
+					block_type & b = this->m_block[pos / BITS_PER_BLOCK::value];
+					b = kerbal::numeric::set_bit(b, pos % BITS_PER_BLOCK::value);
+					return *this;
+				}
+
+				dynamic_bitset& set(size_type pos, bool value) KERBAL_NOEXCEPT
+				{
+					if (value) {
+						this->set(pos);
+					} else {
+						this->reset(pos);
+					}
+					return *this;
+				}
+
+				dynamic_bitset& flip() KERBAL_NOEXCEPT
+				{
+					bitset_size_unrelated::flip(this->m_block, this->block_size());
+					this->clear_tail();
+					return *this;
+				}
+
+				dynamic_bitset& flip(size_type pos) KERBAL_NOEXCEPT
+				{
+					block_type & b = this->m_block[pos / BITS_PER_BLOCK::value];
+					b = kerbal::numeric::flip(b, pos % BITS_PER_BLOCK::value);
+					return *this;
+				}
+
+				/**
+				 * Returns the index of the first bit set to true, or size() if none.
+				 */
+				size_type find_first() const KERBAL_NOEXCEPT
+				{
+					return this->find_from(0);
+				}
+
+				/**
+				 * Returns the index of the first bit set to true after pos, or size() if none.
+				 */
+				size_type find_next(size_type pos) const KERBAL_NOEXCEPT
+				{
+					return pos >= this->m_size ? this->m_size : this->find_from(pos + 1);
+				}
+
+			private:
+
+				// index of the first bit set to true in [pos, size()), or size() if none
+				size_type find_from(size_type pos) const KERBAL_NOEXCEPT
+				{
+					if (pos >= this->m_size) {
+						return this->m_size;
+					}
+					block_width_type bs = this->block_size();
+					block_width_type idx = pos / BITS_PER_BLOCK::value;
+					block_type b = this->m_block[idx] & static_cast<block_type>(ALL_ONE::value << (pos % BITS_PER_BLOCK::value));
+					if (b == 0) {
+						idx = bitset_size_unrelated::find_first_block(this->m_block, idx + 1, bs);
+						if (idx == bs) {
+							return this->m_size;
+						}
+						b = this->m_block[idx];
+					}
+					return idx * BITS_PER_BLOCK::value + kerbal::numeric::countr_zero(b);
+				}
+
+			public:
+
+				/**
+				 * Calls f(pos) for the index of each bit set to true, in increasing order.
+				 */
+				template <typename UnaryFunction>
+				UnaryFunction for_each_set_bit(UnaryFunction f) const
+				{
+					block_width_type bs = this->block_size();
+					for (block_width_type idx = 0; idx < bs; ++idx) {
+						block_type b = this->m_block[idx];
+						while (b != 0) {
+							f(idx * BITS_PER_BLOCK::value + kerbal::numeric::countr_zero(b));
+							b &= static_cast<block_type>(b - 1);
+						}
+					}
+					return f;
+				}
+
+				dynamic_bitset& operator<<=(size_type n) KERBAL_NOEXCEPT
+				{
+					bitset_size_unrelated::left_shift_assign(this->m_block, this->block_size(), n);
+					this->clear_tail();
+					return *this;
+				}
+
+				dynamic_bitset& operator>>=(size_type n) KERBAL_NOEXCEPT
+				{
+					bitset_size_unrelated::right_shift_assign(this->m_block, this->block_size(), n);
+					return *this;
+				}
+
+				friend
+				dynamic_bitset operator<<(const dynamic_bitset & lhs, size_type n)
+				{
+					dynamic_bitset r(lhs);
+					r <<= n;
+					return r;
+				}
+
+				friend
+				dynamic_bitset operator>>(const dynamic_bitset & lhs, size_type n)
+				{
+					dynamic_bitset r(lhs);
+					r >>= n;
+					return r;
+				}
+
+				/*
+				 * The binary operations require both bitsets to have the same size.
+				 */
+
+				bool operator==(const dynamic_bitset & rhs) const KERBAL_NOEXCEPT
+				{
+					return this->m_size == rhs.m_size &&
+							bitset_size_unrelated::equal_trunk(this->m_block, rhs.m_block, this->block_size());
+				}
+
+				bool operator!=(const dynamic_bitset & rhs) const KERBAL_NOEXCEPT
+				{
+					return !(*this == rhs);
+				}
+
+				dynamic_bitset& operator&=(const dynamic_bitset & ano) KERBAL_NOEXCEPT
+				{
+					bitset_size_unrelated::bit_and_assign(this->m_block, ano.m_block, this->block_size());
+					return *this;
+				}
+
+				dynamic_bitset& operator|=(const dynamic_bitset & ano) KERBAL_NOEXCEPT
+				{
+					bitset_size_unrelated::bit_or_assign(this->m_block, ano.m_block, this->block_size());
+					return *this;
+				}
+
+				dynamic_bitset& operator^=(const dynamic_bitset & ano) KERBAL_NOEXCEPT
+				{
+					bitset_size_unrelated::bit_xor_assign(this->m_block, ano.m_block, this->block_size());
+					return *this;
+				}
+
+				friend
+				dynamic_bitset operator&(const dynamic_bitset & lhs, const dynamic_bitset & rhs)
+				{
+					dynamic_bitset r(lhs);
+					r &= rhs;
+					return r;
+				}
+
+				friend
+				dynamic_bitset operator|(const dynamic_bitset & lhs, const dynamic_bitset & rhs)
+				{
+					dynamic_bitset r(lhs);
+					r |= rhs;
+					return r;
+				}
+
+				friend
+				dynamic_bitset operator^(const dynamic_bitset & lhs, const dynamic_bitset & rhs)
+				{
+					dynamic_bitset r(lhs);
+					r ^= rhs;
+					return r;
+				}
+
+				void swap(dynamic_bitset & ano)
+				{
+					kerbal::algorithm::swap(allocator_compress_helper::member(), ano.allocator_compress_helper::member());
+					kerbal::algorithm::swap(this->m_block, ano.m_block);
+					kerbal::algorithm::swap(this->m_size, ano.m_size);
+					kerbal::algorithm::swap(this->m_block_capacity, ano.m_block_capacity);
+				}
+
+		};
+
+	} // namespace bitset
+
+} // namespace kerbal
+
+
+#endif // KERBAL_BITSET_DYNAMIC_BITSET_HPP
@@ -0,0 +1,333 @@
+/**
+ * @file       rank_select_index.hpp
+ * @brief
+ * @date       2020-10-30
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_BITSET_RANK_SELECT_INDEX_HPP
+#define KERBAL_BITSET_RANK_SELECT_INDEX_HPP
+
+#include <kerbal/algorithm/swap.hpp>
+#include <kerbal/compatibility/fixed_width_integer.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/compatibility/static_assert.hpp>
+#include <kerbal/numeric/bit.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+#include <kerbal/type_traits/sign_deduction.hpp>
+
+#include <cstddef>
+#include <vector>
+
+#include <kerbal/bitset/dynamic_bitset.hpp>
+#include <kerbal/bitset/static_bitset.hpp>
+#include <kerbal/bitset/detail/bitset_size_unrelated.hpp>
+
+namespace kerbal
+{
+
+	namespace bitset
+	{
+
+		namespace detail
+		{
+
+			/*
+			 * Position of the k-th (from 0) 1 bit of x, k must be less than popcount(x).
+			 *
+			 * Broadword version of Vigna, "Broadword Implementation of Rank/Select Queries":
+			 * the bytes of byte_sums hold the number of 1 bits up to and including each byte,
+			 * comparing all of them against k at once gives the byte holding the k-th 1 bit.
+			 */
+			inline
+			int select_in_word(kerbal::compatibility::uint64_t x, int k) KERBAL_NOEXCEPT
+			{
+
+#	if KERBAL_NUMERIC_BIT_HAS_BMI2 && KERBAL_ARCHITECTURE == KERBAL_ARCHITECTURE_AMD64
+
+				return kerbal::numeric::countr_zero(_pdep_u64(static_cast<kerbal::compatibility::uint64_t>(1) << k, x));
+
+#	else
+
+				typedef kerbal::compatibility::uint64_t uint64_t;
+				const uint64_t ONES_STEP_4 = 0x1111111111111111ull;
+				const uint64_t ONES_STEP_8 = 0x0101010101010101ull;
+				const uint64_t MSBS_STEP_8 = 0x80ull * ONES_STEP_8;
+
+				uint64_t byte_sums = x - ((x & 0xaull * ONES_STEP_4) >> 1);
+				byte_sums = (byte_sums & 3ull * ONES_STEP_4) + ((byte_sums >> 2) & 3ull * ONES_STEP_4);
+				byte_sums = (byte_sums + (byte_sums >> 4)) & 0x0full * ONES_STEP_8;
+				byte_sums *= ONES_STEP_8;
+
+				const uint64_t k_step_8 = static_cast<uint64_t>(k) * ONES_STEP_8;
+				// for each byte: byte_sums <= k
+				const uint64_t leq = ((((k_step_8 | MSBS_STEP_8) - (byte_sums & ~MSBS_STEP_8)) ^ byte_sums ^ k_step_8) & MSBS_STEP_8) >> 7;
+				const int place = static_cast<int>(((leq * ONES_STEP_8) >> 53) & ~static_cast<uint64_t>(7));
+
+				int rank_in_byte = k - static_cast<int>(((byte_sums << 8) >> place) & 0xff);
+				unsigned int byte = static_cast<unsigned int>((x >> place) & 0xff);
+				while (rank_in_byte > 0) {
+					byte &= byte - 1;
+					--rank_in_byte;
+				}
+				return place + kerbal::numeric::countr_zero(byte);
+
+#	endif
+
+			}
+
+		} // namespace detail
+
+		/**
+		 * Rank / select directory over the blocks of a bitset.
+		 *
+		 * Two-level layout of Zhou, Andersen, Kaminsky, "Space-Efficient, High-Performance Rank & Select
+		 * Structures on Uncompressed Bit Sequences": one 64-bits entry per 2048 bits holds the number of
+		 * 1 bits before it (relative to an absolute count every 2^32 bits) and the counts of its first
+		 * three 512-bits sub blocks, i.e. about 3.1% of overhead. select additionally samples the block
+		 * of every 8192-th 1 bit to narrow its binary search.
+		 *
+		 * The index refers to the blocks of the bitset it is built on, which must outlive the index and
+		 * must not be modified. Rebuild it after any modification.
+		 */
+		template <typename Block = KERBAL_BITSET_DEFAULT_BLOCK_TYPE>
+		class rank_select_index
+		{
+				KERBAL_STATIC_ASSERT(kerbal::type_traits::is_unsigned<Block>::value, "Block must be unsigned type");
+				KERBAL_STATIC_ASSERT(sizeof(Block) <= 8, "Block is too large");
+
+			public:
+				typedef Block													block_type;
+				typedef std::size_t												size_type;
+				typedef kerbal::bitset::detail::bitset_bits_per_block<Block>	BITS_PER_BLOCK;
+
+			private:
+				typedef kerbal::compatibility::uint64_t							entry_type;
+
+				typedef kerbal::type_traits::integral_constant<size_type, 512>		SUB_BLOCK_BITS;
+				typedef kerbal::type_traits::integral_constant<size_type, 2048>		BLOCK_BITS;
+				typedef kerbal::type_traits::integral_constant<size_type, 4>		SUB_BLOCKS_PER_BLOCK;
+				typedef kerbal::type_traits::integral_constant<size_type, 1u << 21>	BLOCKS_PER_UPPER;
+				typedef kerbal::type_traits::integral_constant<size_type, 8192>		SELECT_SAMPLE;
+
+				typedef kerbal::type_traits::integral_constant<size_type,
+						SUB_BLOCK_BITS::value / BITS_PER_BLOCK::value>					WORDS_PER_SUB_BLOCK;
+
+				const block_type * m_block;
+				size_type m_size;
+				size_type m_count;
+				std::vector<entry_type> m_upper;		// number of 1 bits before each 2^32 bits
+				std::vector<entry_type> m_entries;		// one per 2048 bits
+				std::vector<size_type> m_select_hints;	// 2048-bits block of every SELECT_SAMPLE-th 1 bit
+
+				size_type word_count() const KERBAL_NOEXCEPT
+				{
+					return this->m_size / BITS_PER_BLOCK::value + (this->m_size % BITS_PER_BLOCK::value != 0);
+				}
+
+				// the word, with the bits beyond size() cleared
+				block_type word(size_type i) const KERBAL_NOEXCEPT
+				{
+					block_type w = this->m_block[i];
+					if (i == this->m_size / BITS_PER_BLOCK::value) {
+						w &= kerbal::numeric::mask<block_type>(this->m_size % BITS_PER_BLOCK::value);
+					}
+					return w;
+				}
+
+				size_type sub_block_count(size_type sub_block) const KERBAL_NOEXCEPT
+				{
+					size_type first = sub_block * WORDS_PER_SUB_BLOCK::value;
+					size_type last = first + WORDS_PER_SUB_BLOCK::value;
+					size_type wc = this->word_count();
+					if (last > wc) {
+						last = wc;
+					}
+					size_type cnt = 0;
+					for (size_type i = first; i < last; ++i) {
+						cnt += kerbal::numeric::popcount(this->word(i));
+					}
+					return cnt;
+				}
+
+				size_type rank_before_block(size_type block) const KERBAL_NOEXCEPT
+				{
+					return static_cast<size_type>(this->m_upper[block / BLOCKS_PER_UPPER::value] +
+												(this->m_entries[block] & 0xffffffffu));
+				}
+
+				static size_type sub_count(entry_type e, size_type s) KERBAL_NOEXCEPT
+				{
+					return static_cast<size_type>((e >> (32 + 10 * s)) & 0x3ffu);
+				}
+
+			public:
+				rank_select_index() :
+						m_block(NULL), m_size(0), m_count(0)
+				{
+				}
+
+				rank_select_index(const block_type * blocks, size_type bits) :
+						m_block(NULL), m_size(0), m_count(0)
+				{
+					this->build(blocks, bits);
+				}
+
+				template <size_t N>
+				explicit rank_select_index(const kerbal::bitset::static_bitset<N, Block> & bs) :
+						m_block(NULL), m_size(0), m_count(0)
+				{
+					this->build(bs.data(), N);
+				}
+
+				template <typename Allocator>
+				explicit rank_select_index(const kerbal::bitset::dynamic_bitset<Block, Allocator> & bs) :
+						m_block(NULL), m_size(0), m_count(0)
+				{
+					this->build(bs.data(), bs.size());
+				}
+
+				void build(const block_type * blocks, size_type bits)
+				{
+					this->m_block = blocks;
+					this->m_size = bits;
+					this->m_upper.clear();
+					this->m_entries.clear();
+					this->m_select_hints.clear();
+
+					size_type blocks_num = bits / BLOCK_BITS::value + 1;
+					this->m_upper.reserve(blocks_num / BLOCKS_PER_UPPER::value + 1);
+					this->m_entries.reserve(blocks_num);
+
+					size_type cum = 0;
+					size_type next_sample = 0;
+					for (size_type b = 0; b < blocks_num; ++b) {
+						if (b % BLOCKS_PER_UPPER::value == 0) {
+							this->m_upper.push_back(cum);
+						}
+						entry_type e = static_cast<entry_type>(cum - this->m_upper.back());
+						size_type block_ones = 0;
+						for (size_type s = 0; s < SUB_BLOCKS_PER_BLOCK::value; ++s) {
+							size_type c = this->sub_block_count(b * SUB_BLOCKS_PER_BLOCK::value + s);
+							if (s + 1 < SUB_BLOCKS_PER_BLOCK::value) {
+								e |= static_cast<entry_type>(c) << (32 + 10 * s);
+							}
+							block_ones += c;
+						}
+						this->m_entries.push_back(e);
+						while (next_sample < cum + block_ones) {
+							this->m_select_hints.push_back(b);
+							next_sample += SELECT_SAMPLE::value;
+						}
+						cum += block_ones;
+					}
+					this->m_count = cum;
+				}
+
+				size_type size() const KERBAL_NOEXCEPT
+				{
+					return this->m_size;
+				}
+
+				// number of 1 bits
+				size_type count() const KERBAL_NOEXCEPT
+				{
+					return this->m_count;
+				}
+
+				/**
+				 * Number of 1 bits in [0, pos), pos <= size().
+				 */
+				size_type rank1(size_type pos) const KERBAL_NOEXCEPT
+				{
+					size_type b = pos / BLOCK_BITS::value;
+					entry_type e = this->m_entries[b];
+					size_type r = this->rank_before_block(b);
+					size_type sub = pos % BLOCK_BITS::value / SUB_BLOCK_BITS::value;
+					for (size_type s = 0; s < sub; ++s) {
+						r += sub_count(e, s);
+					}
+					size_type first = (b * SUB_BLOCKS_PER_BLOCK::value + sub) * WORDS_PER_SUB_BLOCK::value;
+					size_type last = pos / BITS_PER_BLOCK::value;
+					for (size_type i = first; i < last; ++i) {
+						r += kerbal::numeric::popcount(this->m_block[i]);
+					}
+					if (pos % BITS_PER_BLOCK::value != 0) {
+						r += kerbal::numeric::popcount(static_cast<block_type>(
+								this->m_block[last] & kerbal::numeric::mask<block_type>(pos % BITS_PER_BLOCK::value)));
+					}
+					return r;
+				}
+
+				/**
+				 * Number of 0 bits in [0, pos), pos <= size().
+				 */
+				size_type rank0(size_type pos) const KERBAL_NOEXCEPT
+				{
+					return pos - this->rank1(pos);
+				}
+
+				/**
+				 * Position of the k-th (from 0) 1 bit, or size() if k >= count().
+				 */
+				size_type select1(size_type k) const KERBAL_NOEXCEPT
+				{
+					if (k >= this->m_count) {
+						return this->m_size;
+					}
+
+					// the last block whose rank_before_block <= k
+					size_type lo = this->m_select_hints[k / SELECT_SAMPLE::value];
+					size_type hi = k / SELECT_SAMPLE::value + 1 < this->m_select_hints.size() ?
+									this->m_select_hints[k / SELECT_SAMPLE::value + 1] + 1 :
+									this->m_entries.size();
+					while (hi - lo > 1) {
+						size_type mid = lo + (hi - lo) / 2;
+						if (this->rank_before_block(mid) <= k) {
+							lo = mid;
+						} else {
+							hi = mid;
+						}
+					}
+
+					size_type rest = k - this->rank_before_block(lo);
+					entry_type e = this->m_entries[lo];
+					size_type sub = 0;
+					while (sub + 1 < SUB_BLOCKS_PER_BLOCK::value && sub_count(e, sub) <= rest) {
+						rest -= sub_count(e, sub);
+						++sub;
+					}
+
+					size_type i = (lo * SUB_BLOCKS_PER_BLOCK::value + sub) * WORDS_PER_SUB_BLOCK::value;
+					while (true) {
+						size_type c = kerbal::numeric::popcount(this->m_block[i]);
+						if (rest < c) {
+							break;
+						}
+						rest -= c;
+						++i;
+					}
+					return i * BITS_PER_BLOCK::value + detail::select_in_word(this->m_block[i], static_cast<int>(rest));
+				}
+
+				void swap(rank_select_index & ano) KERBAL_NOEXCEPT
+				{
+					kerbal::algorithm::swap(this->m_block, ano.m_block);
+					kerbal::algorithm::swap(this->m_size, ano.m_size);
+					kerbal::algorithm::swap(this->m_count, ano.m_count);
+					this->m_upper.swap(ano.m_upper);
+					this->m_entries.swap(ano.m_entries);
+					this->m_select_hints.swap(ano.m_select_hints);
+				}
+
+		};
+
+	} // namespace bitset
+
+} // namespace kerbal
+
+#endif // KERBAL_BITSET_RANK_SELECT_INDEX_HPP
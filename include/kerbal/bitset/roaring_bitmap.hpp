@@ -0,0 +1,306 @@
+/**
+ * @file       roaring_bitmap.hpp
+ * @brief
+ * @date       2020-10-29
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_BITSET_ROARING_BITMAP_HPP
+#define KERBAL_BITSET_ROARING_BITMAP_HPP
+
+#include <kerbal/compatibility/fixed_width_integer.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+
+#include <cstddef>
+#include <vector>
+
+#include <kerbal/bitset/detail/roaring_container.hpp>
+
+namespace kerbal
+{
+
+	namespace bitset
+	{
+
+		/**
+		 * Compressed set of 32-bits unsigned integers.
+		 *
+		 * The values are grouped by their high 16 bits, each group is stored as a sorted array (up to 4096
+		 * values), a 2^16 bits bitmap, or a list of runs, see Chambi, Lemire, Kaser, Godin,
+		 * "Better bitmap performance with Roaring bitmaps". Sparse sets cost about 2 bytes per value
+		 * instead of 2^29 bytes for a dense bitmap over the whole 2^32 universe.
+		 */
+		class roaring_bitmap
+		{
+			private:
+				typedef kerbal::bitset::detail::roaring_container		container_type;
+				typedef std::vector<container_type>						container_vector;
+
+			public:
+				typedef kerbal::compatibility::uint32_t		value_type;
+				typedef std::size_t							size_type;
+
+			private:
+				container_vector containers; // sorted by key
+
+				static container_type::value_type high_of(value_type x) KERBAL_NOEXCEPT
+				{
+					return static_cast<container_type::value_type>(x >> 16u);
+				}
+
+				static container_type::value_type low_of(value_type x) KERBAL_NOEXCEPT
+				{
+					return static_cast<container_type::value_type>(x & 0xffffu);
+				}
+
+				// index of the first container whose key >= key
+				size_type lower_bound_of(container_type::value_type key) const KERBAL_NOEXCEPT
+				{
+					size_type lo = 0, hi = this->containers.size();
+					while (lo < hi) {
+						size_type mid = lo + (hi - lo) / 2;
+						if (this->containers[mid].key < key) {
+							lo = mid + 1;
+						} else {
+							hi = mid;
+						}
+					}
+					return lo;
+				}
+
+			public:
+				roaring_bitmap()
+				{
+				}
+
+				template <typename InputIterator>
+				roaring_bitmap(InputIterator first, InputIterator last)
+				{
+					this->add(first, last);
+				}
+
+				/**
+				 * @return true if x was not in the set
+				 */
+				bool add(value_type x)
+				{
+					container_type::value_type key = high_of(x);
+					size_type i = this->lower_bound_of(key);
+					if (i == this->containers.size() || this->containers[i].key != key) {
+						this->containers.insert(this->containers.begin() + i, container_type(key));
+					}
+					return this->containers[i].add(low_of(x));
+				}
+
+				template <typename InputIterator>
+				void add(InputIterator first, InputIterator last)
+				{
+					while (first != last) {
+						this->add(static_cast<value_type>(*first));
+						++first;
+					}
+				}
+
+				/**
+				 * @return true if x was in the set
+				 */
+				bool remove(value_type x)
+				{
+					container_type::value_type key = high_of(x);
+					size_type i = this->lower_bound_of(key);
+					if (i == this->containers.size() || this->containers[i].key != key) {
+						return false;
+					}
+					if (!this->containers[i].remove(low_of(x))) {
+						return false;
+					}
+					if (this->containers[i].card == 0) {
+						this->containers.erase(this->containers.begin() + i);
+					}
+					return true;
+				}
+
+				bool contains(value_type x) const KERBAL_NOEXCEPT
+				{
+					container_type::value_type key = high_of(x);
+					size_type i = this->lower_bound_of(key);
+					return i != this->containers.size() && this->containers[i].key == key &&
+							this->containers[i].contains(low_of(x));
+				}
+
+				size_type cardinality() const KERBAL_NOEXCEPT
+				{
+					size_type n = 0;
+					for (size_type i = 0; i < this->containers.size(); ++i) {
+						n += this->containers[i].card;
+					}
+					return n;
+				}
+
+				bool empty() const KERBAL_NOEXCEPT
+				{
+					return this->containers.empty();
+				}
+
+				void clear() KERBAL_NOEXCEPT
+				{
+					this->containers.clear();
+				}
+
+				/**
+				 * Converts the chunks to run containers wherever it is smaller. Adding or removing a value later
+				 * turns the concerned chunk back into an array or a bitmap.
+				 *
+				 * @return true if any chunk is stored as runs afterwards
+				 */
+				bool run_optimize()
+				{
+					bool r = false;
+					for (size_type i = 0; i < this->containers.size(); ++i) {
+						if (this->containers[i].run_optimize()) {
+							r = true;
+						}
+					}
+					return r;
+				}
+
+				/**
+				 * Calls f(x) for each value x of the set, in increasing order.
+				 */
+				template <typename UnaryFunction>
+				UnaryFunction for_each(UnaryFunction f) const
+				{
+					for (size_type i = 0; i < this->containers.size(); ++i) {
+						this->containers[i].for_each(f);
+					}
+					return f;
+				}
+
+				roaring_bitmap& operator|=(const roaring_bitmap & ano)
+				{
+					container_vector r;
+					r.reserve(this->containers.size() + ano.containers.size());
+					size_type i = 0, j = 0;
+					while (i < this->containers.size() || j < ano.containers.size()) {
+						if (j == ano.containers.size() ||
+							(i < this->containers.size() && this->containers[i].key < ano.containers[j].key)) {
+							r.push_back(container_type(this->containers[i].key));
+							r.back().swap(this->containers[i]);
+							++i;
+						} else if (i == this->containers.size() || ano.containers[j].key < this->containers[i].key) {
+							r.push_back(ano.containers[j]);
+							++j;
+						} else {
+							r.push_back(container_type(this->containers[i].key));
+							container_type::union_of(this->containers[i], ano.containers[j], r.back());
+							++i;
+							++j;
+						}
+					}
+					this->containers.swap(r);
+					return *this;
+				}
+
+				roaring_bitmap& operator&=(const roaring_bitmap & ano)
+				{
+					container_vector r;
+					size_type i = 0, j = 0;
+					while (i < this->containers.size() && j < ano.containers.size()) {
+						if (this->containers[i].key < ano.containers[j].key) {
+							++i;
+						} else if (ano.containers[j].key < this->containers[i].key) {
+							++j;
+						} else {
+							r.push_back(container_type(this->containers[i].key));
+							container_type::intersection_of(this->containers[i], ano.containers[j], r.back());
+							if (r.back().card == 0) {
+								r.pop_back();
+							}
+							++i;
+							++j;
+						}
+					}
+					this->containers.swap(r);
+					return *this;
+				}
+
+				friend
+				roaring_bitmap operator|(const roaring_bitmap & lhs, const roaring_bitmap & rhs)
+				{
+					roaring_bitmap r(lhs);
+					r |= rhs;
+					return r;
+				}
+
+				friend
+				roaring_bitmap operator&(const roaring_bitmap & lhs, const roaring_bitmap & rhs)
+				{
+					roaring_bitmap r(lhs);
+					r &= rhs;
+					return r;
+				}
+
+				/**
+				 * Cardinality of the intersection of the two sets, without building it.
+				 */
+				size_type intersection_cardinality(const roaring_bitmap & ano) const
+				{
+					size_type n = 0;
+					size_type i = 0, j = 0;
+					while (i < this->containers.size() && j < ano.containers.size()) {
+						if (this->containers[i].key < ano.containers[j].key) {
+							++i;
+						} else if (ano.containers[j].key < this->containers[i].key) {
+							++j;
+						} else {
+							n += container_type::intersection_cardinality(this->containers[i], ano.containers[j]);
+							++i;
+							++j;
+						}
+					}
+					return n;
+				}
+
+				/**
+				 * Cardinality of the union of the two sets, without building it.
+				 */
+				size_type union_cardinality(const roaring_bitmap & ano) const
+				{
+					return this->cardinality() + ano.cardinality() - this->intersection_cardinality(ano);
+				}
+
+				bool operator==(const roaring_bitmap & rhs) const
+				{
+					if (this->containers.size() != rhs.containers.size()) {
+						return false;
+					}
+					for (size_type i = 0; i < this->containers.size(); ++i) {
+						if (this->containers[i].key != rhs.containers[i].key ||
+							!container_type::equal(this->containers[i], rhs.containers[i])) {
+							return false;
+						}
+					}
+					return true;
+				}
+
+				bool operator!=(const roaring_bitmap & rhs) const
+				{
+					return !(*this == rhs);
+				}
+
+				void swap(roaring_bitmap & ano) KERBAL_NOEXCEPT
+				{
+					this->containers.swap(ano.containers);
+				}
+
+		};
+
+	} // namespace bitset
+
+} // namespace kerbal
+
+#endif // KERBAL_BITSET_ROARING_BITMAP_HPP
@@ -104,6 +104,12 @@ namespace kerbal
 					return BLOCK_SIZE::value;
 				}
 
+				KERBAL_CONSTEXPR
+				const block_type * data() const KERBAL_NOEXCEPT
+				{
+					return m_block;
+				}
+
 				KERBAL_CONSTEXPR
 				bool test(size_type pos) const KERBAL_NOEXCEPT
 				{
@@ -284,6 +290,125 @@ namespace kerbal
 					return *this;
 				}
 
+			private:
+
+				// bits of the last block that belong to the bitset
+				KERBAL_CONSTEXPR
+				static block_type tail_mask() KERBAL_NOEXCEPT
+				{
+					return IS_DIVISIBLE::value ?
+							ALL_ONE::value :
+							kerbal::numeric::mask<block_type>(TAIL_SIZE::value);
+				}
+
+			public:
+
+				// Returns the number of bits that are set to true
+				KERBAL_CONSTEXPR14
+				size_type count() const KERBAL_NOEXCEPT
+				{
+					return bitset_size_unrelated::count_trunk(m_block, BLOCK_SIZE::value - 1) +
+							kerbal::numeric::popcount(static_cast<block_type>(m_block[BLOCK_SIZE::value - 1] & tail_mask()));
+				}
+
+			private:
+
+				// index of the first bit set to true in [pos, N), or N if none
+				KERBAL_CONSTEXPR14
+				size_type find_from(size_type pos) const KERBAL_NOEXCEPT
+				{
+					if (pos >= N) {
+						return N;
+					}
+					block_width_type idx = pos / BITS_PER_BLOCK::value;
+					block_type b = m_block[idx] & static_cast<block_type>(ALL_ONE::value << (pos % BITS_PER_BLOCK::value));
+					while (true) {
+						if (idx == BLOCK_SIZE::value - 1) {
+							b &= tail_mask();
+							return b == 0 ? N : idx * BITS_PER_BLOCK::value + kerbal::numeric::countr_zero(b);
+						}
+						if (b != 0) {
+							return idx * BITS_PER_BLOCK::value + kerbal::numeric::countr_zero(b);
+						}
+						idx = bitset_size_unrelated::find_first_block(m_block, idx + 1, BLOCK_SIZE::value - 1);
+						b = m_block[idx];
+					}
+				}
+
+			public:
+
+				/**
+				 * Returns the index of the first bit set to true, or size() if none.
+				 */
+				KERBAL_CONSTEXPR14
+				size_type find_first() const KERBAL_NOEXCEPT
+				{
+					return this->find_from(0);
+				}
+
+				/**
+				 * Returns the index of the first bit set to true after pos, or size() if none.
+				 */
+				KERBAL_CONSTEXPR14
+				size_type find_next(size_type pos) const KERBAL_NOEXCEPT
+				{
+					return pos >= N ? N : this->find_from(pos + 1);
+				}
+
+				/**
+				 * Calls f(pos) for the index of each bit set to true, in increasing order.
+				 */
+				template <typename UnaryFunction>
+				KERBAL_CONSTEXPR14
+				UnaryFunction for_each_set_bit(UnaryFunction f) const
+				{
+					for (block_width_type idx = 0; idx < BLOCK_SIZE::value; ++idx) {
+						block_type b = m_block[idx];
+						if (idx == BLOCK_SIZE::value - 1) {
+							b &= tail_mask();
+						}
+						while (b != 0) {
+							f(idx * BITS_PER_BLOCK::value + kerbal::numeric::countr_zero(b));
+							b &= static_cast<block_type>(b - 1);
+						}
+					}
+					return f;
+				}
+
+				KERBAL_CONSTEXPR14
+				static_bitset& operator<<=(size_type n) KERBAL_NOEXCEPT
+				{
+					bitset_size_unrelated::left_shift_assign(m_block, BLOCK_SIZE::value, n);
+					return *this;
+				}
+
+				KERBAL_CONSTEXPR14
+				static_bitset& operator>>=(size_type n) KERBAL_NOEXCEPT
+				{
+					// the bits beyond N may be set (by set() or flip()), they mustn't be shifted in
+					m_block[BLOCK_SIZE::value - 1] &= tail_mask();
+					bitset_size_unrelated::right_shift_assign(m_block, BLOCK_SIZE::value, n);
+					return *this;
+				}
+
+				KERBAL_CONSTEXPR14
+				friend
+				static_bitset operator<<(const static_bitset & lhs, size_type n) KERBAL_NOEXCEPT
+				{
+					static_bitset r(lhs);
+					r <<= n;
+					return r;
+				}
+
+				KERBAL_CONSTEXPR14
+				friend
+				static_bitset operator>>(const static_bitset & lhs, size_type n) KERBAL_NOEXCEPT
+				{
+					static_bitset r(lhs);
+					r >>= n;
+					return r;
+				}
+
 			private:
 				template <bool c>
 				KERBAL_CONSTEXPR14
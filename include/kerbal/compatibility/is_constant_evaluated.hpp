@@ -0,0 +1,83 @@
+/**
+ * @file       is_constant_evaluated.hpp
+ * @brief
+ * @date       2020-10-20
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_COMPATIBILITY_IS_CONSTANT_EVALUATED_HPP
+#define KERBAL_COMPATIBILITY_IS_CONSTANT_EVALUATED_HPP
+
+#include <kerbal/compatibility/constexpr.hpp>
+#include <kerbal/config/compiler_id.hpp>
+#include <kerbal/config/compiler_version.hpp>
+
+
+#ifndef KERBAL_IS_CONSTANT_EVALUATED
+
+#	if KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_GNU
+
+// https://gcc.gnu.org/gcc-9/changes.html
+
+#		if KERBAL_GNU_VERSION_MEETS(9, 1, 0)
+#			define KERBAL_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#		endif
+
+#	elif KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_CLANG
+
+#		include <kerbal/config/compiler_private/clang/builtin_detection.hpp>
+
+#		if KERBAL_CLANG_PRIVATE_HAS_BUILTIN(__builtin_is_constant_evaluated)
+#			define KERBAL_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#		endif
+
+#	elif KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_MSVC
+
+#		if KERBAL_MSVC_VERSION_MEETS(19, 25, 0) // VS2019 16.5
+#			define KERBAL_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#		endif
+
+#	elif KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_ICC
+
+#		include <kerbal/config/compiler_private/icc/builtin_detection.hpp>
+
+#		if KERBAL_ICC_PRIVATE_HAS_BUILTIN(__builtin_is_constant_evaluated)
+#			define KERBAL_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#		endif
+
+#	endif
+
+#endif
+
+/*
+ * When KERBAL_IS_CONSTANT_EVALUATED_SUPPORTED is 0, callers which want to stay usable in constant
+ * expressions should always take their portable path.
+ */
+#undef KERBAL_IS_CONSTANT_EVALUATED_SUPPORTED
+#ifdef KERBAL_IS_CONSTANT_EVALUATED
+#	define KERBAL_IS_CONSTANT_EVALUATED_SUPPORTED 1
+#else
+#	define KERBAL_IS_CONSTANT_EVALUATED_SUPPORTED 0
+#endif
+
+/*
+ * KERBAL_CONSTEXPR14_RUNTIME_PATH() tells a KERBAL_CONSTEXPR14 function whether it is allowed to take a
+ * path which is not usable in constant expressions (intrinsics, memcpy...):
+ *  - the function is not constexpr at all (before C++14): always
+ *  - the compiler could tell us: only when not constant evaluated
+ *  - otherwise: never, the function must stay usable in constant expressions
+ */
+#undef KERBAL_CONSTEXPR14_RUNTIME_PATH
+#if !KERBAL_ENABLE_CONSTEXPR14
+#	define KERBAL_CONSTEXPR14_RUNTIME_PATH() true
+#elif KERBAL_IS_CONSTANT_EVALUATED_SUPPORTED
+#	define KERBAL_CONSTEXPR14_RUNTIME_PATH() (!KERBAL_IS_CONSTANT_EVALUATED())
+#else
+#	define KERBAL_CONSTEXPR14_RUNTIME_PATH() false
+#endif
+
+#endif // KERBAL_COMPATIBILITY_IS_CONSTANT_EVALUATED_HPP
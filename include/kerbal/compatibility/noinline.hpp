@@ -0,0 +1,40 @@
+/**
+ * @file       noinline.hpp
+ * @brief
+ * @date       2020-11-14
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_COMPATIBILITY_NOINLINE_HPP
+#define KERBAL_COMPATIBILITY_NOINLINE_HPP
+
+#include <kerbal/config/compiler_id.hpp>
+
+
+/*
+ * KERBAL_NOINLINE keeps a function out of its callers, e.g. a path for huge sizes which the compiler would
+ * otherwise analyse against the small objects of the caller. It is empty where the compiler provides no way
+ * to do it.
+ */
+
+#ifndef KERBAL_NOINLINE
+
+#	if KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_GNU || KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_CLANG
+#		define KERBAL_NOINLINE __attribute__((__noinline__))
+#	elif KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_ICC && defined(__GNUC__)
+#		define KERBAL_NOINLINE __attribute__((__noinline__))
+#	elif KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_MSVC
+#		define KERBAL_NOINLINE __declspec(noinline)
+#	endif
+
+#	ifndef KERBAL_NOINLINE
+#		define KERBAL_NOINLINE
+#	endif
+
+#endif
+
+#endif // KERBAL_COMPATIBILITY_NOINLINE_HPP
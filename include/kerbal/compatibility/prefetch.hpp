@@ -0,0 +1,64 @@
+/**
+ * @file       prefetch.hpp
+ * @brief
+ * @date       2020-11-08
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_COMPATIBILITY_PREFETCH_HPP
+#define KERBAL_COMPATIBILITY_PREFETCH_HPP
+
+#include <kerbal/config/architecture.hpp>
+#include <kerbal/config/compiler_id.hpp>
+
+#if KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_CLANG
+#	include <kerbal/config/compiler_private/clang/builtin_detection.hpp>
+#elif KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_ICC
+#	include <kerbal/config/compiler_private/icc/builtin_detection.hpp>
+#endif
+
+
+/*
+ * KERBAL_PREFETCH_READ(p) hints the processor to bring the cache line containing p into all the cache levels
+ * for a later read. It never faults, p may point anywhere (even past the end of an array). It is a no-op
+ * where the compiler provides no way to issue a prefetch.
+ */
+
+#ifndef KERBAL_PREFETCH_READ
+
+#	if KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_GNU
+
+#		define KERBAL_PREFETCH_READ(p) __builtin_prefetch(static_cast<const void *>(p), 0, 3)
+
+#	elif KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_CLANG
+
+#		if KERBAL_CLANG_PRIVATE_HAS_BUILTIN(__builtin_prefetch)
+#			define KERBAL_PREFETCH_READ(p) __builtin_prefetch(static_cast<const void *>(p), 0, 3)
+#		endif
+
+#	elif KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_ICC
+
+#		if KERBAL_ICC_PRIVATE_HAS_BUILTIN(__builtin_prefetch)
+#			define KERBAL_PREFETCH_READ(p) __builtin_prefetch(static_cast<const void *>(p), 0, 3)
+#		endif
+
+#	elif KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_MSVC
+
+#		if KERBAL_ARCHITECTURE == KERBAL_ARCHITECTURE_X86 || KERBAL_ARCHITECTURE == KERBAL_ARCHITECTURE_AMD64
+#			include <xmmintrin.h>
+#			define KERBAL_PREFETCH_READ(p) _mm_prefetch(static_cast<const char *>(static_cast<const void *>(p)), _MM_HINT_T0)
+#		endif
+
+#	endif
+
+#	ifndef KERBAL_PREFETCH_READ
+#		define KERBAL_PREFETCH_READ(p) static_cast<void>(p)
+#	endif
+
+#endif
+
+#endif // KERBAL_COMPATIBILITY_PREFETCH_HPP
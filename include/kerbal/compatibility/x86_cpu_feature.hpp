@@ -0,0 +1,151 @@
+/**
+ * @file       x86_cpu_feature.hpp
+ * @brief
+ * @date       2020-10-20
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_COMPATIBILITY_X86_CPU_FEATURE_HPP
+#define KERBAL_COMPATIBILITY_X86_CPU_FEATURE_HPP
+
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/config/compiler_id.hpp>
+#include <kerbal/config/x86_intrinsics.hpp>
+
+#if KERBAL_X86_INTRINSICS_SUPPORTED && KERBAL_COMPILER_ID != KERBAL_COMPILER_ID_MSVC
+#	include <cpuid.h>
+#endif
+
+namespace kerbal
+{
+
+	namespace compatibility
+	{
+
+		/**
+		 * Instruction set extensions supported by the running processor (and enabled by the OS for
+		 * the ones extending the register file). All of the flags are false on non-x86 platforms.
+		 */
+		class x86_cpu_feature
+		{
+			public:
+				bool sse2;
+				bool ssse3;
+				bool sse41;
+				bool sse42;
+				bool popcnt;
+				bool pclmul;
+				bool avx;
+				bool avx2;
+				bool bmi1;
+				bool bmi2;
+				bool sha;
+				bool avx512f;
+				bool avx512bw;
+
+			private:
+
+#		if KERBAL_X86_INTRINSICS_SUPPORTED
+
+				static void cpuid(unsigned int leaf, unsigned int subleaf, unsigned int reg[4]) KERBAL_NOEXCEPT
+				{
+
+#			if KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_MSVC
+					int r[4];
+					::__cpuidex(r, static_cast<int>(leaf), static_cast<int>(subleaf));
+					reg[0] = r[0]; reg[1] = r[1]; reg[2] = r[2]; reg[3] = r[3];
+#			else
+					__cpuid_count(leaf, subleaf, reg[0], reg[1], reg[2], reg[3]);
+#			endif
+
+				}
+
+				static unsigned long long xgetbv0() KERBAL_NOEXCEPT
+				{
+
+#			if KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_MSVC
+					return ::_xgetbv(0);
+#			else
+					unsigned int eax, edx;
+					// xgetbv, encoded manually so that no -mxsave is required
+					__asm__ __volatile__ (".byte 0x0f, 0x01, 0xd0" : "=a"(eax), "=d"(edx) : "c"(0));
+					return (static_cast<unsigned long long>(edx) << 32u) | eax;
+#			endif
+
+				}
+
+#		endif
+
+				x86_cpu_feature() KERBAL_NOEXCEPT :
+						sse2(false), ssse3(false), sse41(false), sse42(false),
+						popcnt(false), pclmul(false), avx(false), avx2(false),
+						bmi1(false), bmi2(false), sha(false), avx512f(false), avx512bw(false)
+				{
+
+#		if KERBAL_X86_INTRINSICS_SUPPORTED
+
+					unsigned int reg[4] = {0, 0, 0, 0};
+					cpuid(0, 0, reg);
+					unsigned int max_leaf = reg[0];
+					if (max_leaf < 1) {
+						return;
+					}
+
+					cpuid(1, 0, reg);
+					unsigned int ecx1 = reg[2];
+					unsigned int edx1 = reg[3];
+
+					sse2   = (edx1 >> 26u) & 1u;
+					ssse3  = (ecx1 >>  9u) & 1u;
+					sse41  = (ecx1 >> 19u) & 1u;
+					sse42  = (ecx1 >> 20u) & 1u;
+					popcnt = (ecx1 >> 23u) & 1u;
+					pclmul = (ecx1 >>  1u) & 1u;
+
+					bool osxsave = (ecx1 >> 27u) & 1u;
+					unsigned long long xcr0 = osxsave ? xgetbv0() : 0;
+					bool os_ymm = (xcr0 & 0x06u) == 0x06u; // xmm, ymm
+					bool os_zmm = (xcr0 & 0xe6u) == 0xe6u; // xmm, ymm, opmask, zmm
+
+					avx = os_ymm && ((ecx1 >> 28u) & 1u);
+
+					if (max_leaf < 7) {
+						return;
+					}
+
+					cpuid(7, 0, reg);
+					unsigned int ebx7 = reg[1];
+
+					bmi1     = (ebx7 >>  3u) & 1u;
+					bmi2     = (ebx7 >>  8u) & 1u;
+					sha      = (ebx7 >> 29u) & 1u;
+					avx2     = avx && ((ebx7 >>  5u) & 1u);
+					avx512f  = os_zmm && ((ebx7 >> 16u) & 1u);
+					avx512bw = avx512f && ((ebx7 >> 30u) & 1u);
+
+#		endif
+
+				}
+
+			public:
+
+				/**
+				 * Features of the current processor. The detection is run once, at the first call.
+				 */
+				static const x86_cpu_feature & instance() KERBAL_NOEXCEPT
+				{
+					static const x86_cpu_feature feature;
+					return feature;
+				}
+
+		};
+
+	} // namespace compatibility
+
+} // namespace kerbal
+
+#endif // KERBAL_COMPATIBILITY_X86_CPU_FEATURE_HPP
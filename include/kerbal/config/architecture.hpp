@@ -63,6 +63,14 @@
 #			endif
 #		endif
 
+#		if defined(__i386__)
+#			if defined(KERBAL_ARCHITECTURE) && KERBAL_ARCHITECTURE != KERBAL_ARCHITECTURE_X86
+#				warning "Macro KERBAL_ARCHITECTURE has defined!"
+#			else
+#				define KERBAL_ARCHITECTURE KERBAL_ARCHITECTURE_X86
+#			endif
+#		endif
+
 #	elif KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_CLANG
 
 #		if defined(__amd64__)
@@ -89,6 +97,14 @@
 #			endif
 #		endif
 
+#		if defined(__i386__)
+#			if defined(KERBAL_ARCHITECTURE) && KERBAL_ARCHITECTURE != KERBAL_ARCHITECTURE_X86
+#				warning "Macro KERBAL_ARCHITECTURE has defined!"
+#			else
+#				define KERBAL_ARCHITECTURE KERBAL_ARCHITECTURE_X86
+#			endif
+#		endif
+
 #	elif KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_MSVC
 
 #		if defined(_M_IX86)
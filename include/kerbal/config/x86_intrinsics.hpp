@@ -0,0 +1,84 @@
+/**
+ * @file       x86_intrinsics.hpp
+ * @brief
+ * @date       2020-10-20
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_CONFIG_X86_INTRINSICS_HPP
+#define KERBAL_CONFIG_X86_INTRINSICS_HPP
+
+#include <kerbal/config/architecture.hpp>
+#include <kerbal/config/compiler_id.hpp>
+#include <kerbal/config/compiler_version.hpp>
+
+
+/*
+ * KERBAL_X86_INTRINSICS_SUPPORTED is 1 if the intrinsics of all x86 instruction set extensions
+ * could be used inside the functions marked by KERBAL_X86_TARGET(ext), no matter which -m flags
+ * the translation unit is compiled with. The caller is responsible for checking the extension
+ * is available at runtime before calling such functions (see kerbal/compatibility/x86_cpu_feature.hpp).
+ */
+
+#ifndef KERBAL_X86_INTRINSICS_SUPPORTED
+
+#	if KERBAL_ARCHITECTURE == KERBAL_ARCHITECTURE_X86 || KERBAL_ARCHITECTURE == KERBAL_ARCHITECTURE_AMD64
+
+#		if KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_GNU
+
+// https://gcc.gnu.org/gcc-4.9/changes.html
+
+#			if KERBAL_GNU_VERSION_MEETS(4, 9, 0)
+#				define KERBAL_X86_INTRINSICS_SUPPORTED 1
+#				define KERBAL_X86_TARGET(ext) __attribute__((__target__(ext)))
+#			endif
+
+#		elif KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_CLANG
+
+#			if KERBAL_CLANG_VERSION_MEETS(3, 8, 0)
+#				define KERBAL_X86_INTRINSICS_SUPPORTED 1
+#				define KERBAL_X86_TARGET(ext) __attribute__((__target__(ext)))
+#			endif
+
+#		elif KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_MSVC
+
+#			if KERBAL_MSVC_VERSION_MEETS(19, 0, 0) // VS2015
+#				define KERBAL_X86_INTRINSICS_SUPPORTED 1
+#				define KERBAL_X86_TARGET(ext)
+#			endif
+
+#		elif KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_ICC
+
+#			if KERBAL_ICC_VERSION_MEETS(19, 0, 0) && defined(__GNUC__)
+#				define KERBAL_X86_INTRINSICS_SUPPORTED 1
+#				define KERBAL_X86_TARGET(ext) __attribute__((__target__(ext)))
+#			endif
+
+#		endif
+
+#	endif
+
+#	ifndef KERBAL_X86_INTRINSICS_SUPPORTED
+#		define KERBAL_X86_INTRINSICS_SUPPORTED 0
+#	endif
+
+#endif
+
+#ifndef KERBAL_X86_TARGET
+#	define KERBAL_X86_TARGET(ext)
+#endif
+
+
+#if KERBAL_X86_INTRINSICS_SUPPORTED
+#	if KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_MSVC
+#		include <intrin.h>
+#	else
+#		include <immintrin.h>
+#	endif
+#endif
+
+#endif // KERBAL_CONFIG_X86_INTRINSICS_HPP
@@ -0,0 +1,148 @@
+/**
+ * @file       bloom_filter.hpp
+ * @brief
+ * @date       2020-10-26
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_CONTAINER_BLOOM_FILTER_HPP
+#define KERBAL_CONTAINER_BLOOM_FILTER_HPP
+
+#include <kerbal/container/detail/bloom_filter_base.hpp>
+
+#include <kerbal/algorithm/swap.hpp>
+#include <kerbal/bitset/static_bitset.hpp>
+#include <kerbal/bitset/detail/default_block_type.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/compatibility/static_assert.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+#include <kerbal/utility/member_compress_helper.hpp>
+
+#include <cstddef>
+
+namespace kerbal
+{
+
+	namespace container
+	{
+
+		/**
+		 * Bloom filter of Bits bits and K probes per element, stored in a static_bitset.
+		 *
+		 * contains() never returns false for an inserted element, and returns true for a not inserted one
+		 * with a probability about (1 - e^(-K * n / Bits))^K after n insertions.
+		 */
+		template <typename T, std::size_t Bits, std::size_t K,
+				typename Hash = kerbal::container::bloom_filter_murmur_hash<T>,
+				typename Block = KERBAL_BITSET_DEFAULT_BLOCK_TYPE>
+		class bloom_filter:
+				private kerbal::utility::member_compress_helper<Hash>
+		{
+				KERBAL_STATIC_ASSERT(Bits > 0, "Bits must be positive");
+				KERBAL_STATIC_ASSERT(K > 0, "K must be positive");
+
+			private:
+				typedef kerbal::utility::member_compress_helper<Hash> hash_compress_helper;
+
+			public:
+				typedef T														value_type;
+				typedef const T &												const_reference;
+				typedef Hash													hasher;
+				typedef std::size_t												size_type;
+				typedef kerbal::bitset::static_bitset<Bits, Block>				bitset_type;
+
+				typedef kerbal::type_traits::integral_constant<size_type, Bits>	BITS;
+				typedef kerbal::type_traits::integral_constant<size_type, K>	HASH_COUNT;
+
+			private:
+				bitset_type bits;
+
+			public:
+				bloom_filter() :
+						hash_compress_helper(kerbal::utility::in_place_t()), bits()
+				{
+				}
+
+				explicit bloom_filter(const Hash & hash) :
+						hash_compress_helper(kerbal::utility::in_place_t(), hash), bits()
+				{
+				}
+
+				hasher hash_function() const
+				{
+					return hash_compress_helper::member();
+				}
+
+				const bitset_type & bitset() const KERBAL_NOEXCEPT
+				{
+					return this->bits;
+				}
+
+				void insert(const_reference value)
+				{
+					detail::bloom_filter_probe probe(hash_compress_helper::member()(value), Bits);
+					for (size_type i = 0; i < K; ++i, ++probe) {
+						this->bits.set(*probe);
+					}
+				}
+
+				template <typename InputIterator>
+				void insert(InputIterator first, InputIterator last)
+				{
+					while (first != last) {
+						this->insert(*first);
+						++first;
+					}
+				}
+
+				/**
+				 * @return false if the value has never been inserted, true if it probably has been.
+				 */
+				bool contains(const_reference value) const
+				{
+					detail::bloom_filter_probe probe(hash_compress_helper::member()(value), Bits);
+					for (size_type i = 0; i < K; ++i, ++probe) {
+						if (!this->bits.test(*probe)) {
+							return false;
+						}
+					}
+					return true;
+				}
+
+				void clear() KERBAL_NOEXCEPT
+				{
+					this->bits.reset();
+				}
+
+				bool empty() const KERBAL_NOEXCEPT
+				{
+					return this->bits.none();
+				}
+
+				/**
+				 * After merge, the filter contains everything that was inserted into any of the two filters.
+				 * Both filters must use the same hash function.
+				 */
+				bloom_filter& merge(const bloom_filter & ano) KERBAL_NOEXCEPT
+				{
+					this->bits |= ano.bits;
+					return *this;
+				}
+
+				void swap(bloom_filter & ano)
+				{
+					kerbal::algorithm::swap(hash_compress_helper::member(), ano.hash_compress_helper::member());
+					this->bits.swap(ano.bits);
+				}
+
+		};
+
+	} // namespace container
+
+} // namespace kerbal
+
+#endif // KERBAL_CONTAINER_BLOOM_FILTER_HPP
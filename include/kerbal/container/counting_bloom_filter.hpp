@@ -0,0 +1,167 @@
+/**
+ * @file       counting_bloom_filter.hpp
+ * @brief
+ * @date       2020-10-26
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_CONTAINER_COUNTING_BLOOM_FILTER_HPP
+#define KERBAL_CONTAINER_COUNTING_BLOOM_FILTER_HPP
+
+#include <kerbal/container/detail/bloom_filter_base.hpp>
+
+#include <kerbal/algorithm/modifier.hpp>
+#include <kerbal/algorithm/swap.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/compatibility/static_assert.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+#include <kerbal/utility/member_compress_helper.hpp>
+
+#include <cstddef>
+
+namespace kerbal
+{
+
+	namespace container
+	{
+
+		/**
+		 * Bloom filter with Counters 8-bits counters instead of bits, so that elements could be erased.
+		 *
+		 * A counter that reaches 255 sticks there and is never decremented again, which keeps the filter free of
+		 * false negatives at the price of never forgetting the elements that hit it.
+		 */
+		template <typename T, std::size_t Counters, std::size_t K,
+				typename Hash = kerbal::container::bloom_filter_murmur_hash<T> >
+		class counting_bloom_filter:
+				private kerbal::utility::member_compress_helper<Hash>
+		{
+				KERBAL_STATIC_ASSERT(Counters > 0, "Counters must be positive");
+				KERBAL_STATIC_ASSERT(K > 0, "K must be positive");
+
+			private:
+				typedef kerbal::utility::member_compress_helper<Hash> hash_compress_helper;
+
+			public:
+				typedef T														value_type;
+				typedef const T &												const_reference;
+				typedef Hash													hasher;
+				typedef std::size_t												size_type;
+				typedef unsigned char											counter_type;
+
+				typedef kerbal::type_traits::integral_constant<size_type, Counters>	COUNTERS;
+				typedef kerbal::type_traits::integral_constant<size_type, K>	HASH_COUNT;
+
+			private:
+				typedef kerbal::type_traits::integral_constant<counter_type, static_cast<counter_type>(~0u)> COUNTER_MAX;
+
+				counter_type counters[Counters];
+
+			public:
+				counting_bloom_filter() :
+						hash_compress_helper(kerbal::utility::in_place_t())
+				{
+					this->clear();
+				}
+
+				explicit counting_bloom_filter(const Hash & hash) :
+						hash_compress_helper(kerbal::utility::in_place_t(), hash)
+				{
+					this->clear();
+				}
+
+				hasher hash_function() const
+				{
+					return hash_compress_helper::member();
+				}
+
+				void insert(const_reference value)
+				{
+					detail::bloom_filter_probe probe(hash_compress_helper::member()(value), Counters);
+					for (size_type i = 0; i < K; ++i, ++probe) {
+						counter_type & c = this->counters[*probe];
+						if (c != COUNTER_MAX::value) {
+							++c;
+						}
+					}
+				}
+
+				template <typename InputIterator>
+				void insert(InputIterator first, InputIterator last)
+				{
+					while (first != last) {
+						this->insert(*first);
+						++first;
+					}
+				}
+
+				/**
+				 * Remove one occurrence of the value.
+				 *
+				 * @warning The value must have been inserted before, erasing a value that has never been inserted
+				 *          may introduce false negatives.
+				 */
+				void erase(const_reference value)
+				{
+					detail::bloom_filter_probe probe(hash_compress_helper::member()(value), Counters);
+					for (size_type i = 0; i < K; ++i, ++probe) {
+						counter_type & c = this->counters[*probe];
+						if (c != 0 && c != COUNTER_MAX::value) {
+							--c;
+						}
+					}
+				}
+
+				/**
+				 * @return false if the value is not in the filter, true if it probably is.
+				 */
+				bool contains(const_reference value) const
+				{
+					detail::bloom_filter_probe probe(hash_compress_helper::member()(value), Counters);
+					for (size_type i = 0; i < K; ++i, ++probe) {
+						if (this->counters[*probe] == 0) {
+							return false;
+						}
+					}
+					return true;
+				}
+
+				/**
+				 * @return an upper bound of the number of times the value has been inserted (and not erased),
+				 *         or 255 if it's saturated.
+				 */
+				counter_type count(const_reference value) const
+				{
+					detail::bloom_filter_probe probe(hash_compress_helper::member()(value), Counters);
+					counter_type r = COUNTER_MAX::value;
+					for (size_type i = 0; i < K; ++i, ++probe) {
+						counter_type c = this->counters[*probe];
+						if (c < r) {
+							r = c;
+						}
+					}
+					return r;
+				}
+
+				void clear() KERBAL_NOEXCEPT
+				{
+					kerbal::algorithm::fill(this->counters, this->counters + Counters, static_cast<counter_type>(0));
+				}
+
+				void swap(counting_bloom_filter & ano)
+				{
+					kerbal::algorithm::swap(hash_compress_helper::member(), ano.hash_compress_helper::member());
+					kerbal::algorithm::swap(this->counters, ano.counters);
+				}
+
+		};
+
+	} // namespace container
+
+} // namespace kerbal
+
+#endif // KERBAL_CONTAINER_COUNTING_BLOOM_FILTER_HPP
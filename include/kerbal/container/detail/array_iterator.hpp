@@ -21,6 +21,7 @@
 #include <kerbal/operators/incr_decr.hpp>
 #include <kerbal/operators/less_than_comparable.hpp>
 #include <kerbal/operators/subtractable.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
 
 
 namespace kerbal
@@ -199,6 +200,25 @@ namespace kerbal
 
 	} //namespace container
 
+	namespace iterator
+	{
+
+		// array iterators wrap a pointer into the underlying C array
+
+		template <typename ValueType>
+		struct __is_contiguous_iterator_helper<kerbal::container::detail::__arr_iter<ValueType> >:
+				kerbal::type_traits::true_type
+		{
+		};
+
+		template <typename ValueType>
+		struct __is_contiguous_iterator_helper<kerbal::container::detail::__arr_kiter<ValueType> >:
+				kerbal::type_traits::true_type
+		{
+		};
+
+	} //namespace iterator
+
 } //namespace kerbal
 
 
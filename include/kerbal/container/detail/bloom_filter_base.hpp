@@ -0,0 +1,128 @@
+/**
+ * @file       bloom_filter_base.hpp
+ * @brief
+ * @date       2020-10-26
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_CONTAINER_DETAIL_BLOOM_FILTER_BASE_HPP
+#define KERBAL_CONTAINER_DETAIL_BLOOM_FILTER_BASE_HPP
+
+#include <kerbal/compatibility/constexpr.hpp>
+#include <kerbal/compatibility/fixed_width_integer.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/compatibility/static_assert.hpp>
+#include <kerbal/hash/murmur_hash2.hpp>
+#include <kerbal/type_traits/conditional.hpp>
+#include <kerbal/type_traits/fundamental_deduction.hpp>
+#include <kerbal/type_traits/pointer_deduction.hpp>
+
+#include <cstddef>
+
+#if __cplusplus >= 201103L
+#	include <type_traits>
+#endif
+
+namespace kerbal
+{
+
+	namespace container
+	{
+
+		struct bloom_filter_hash_pair
+		{
+				kerbal::compatibility::uint32_t h1;
+				kerbal::compatibility::uint32_t h2;
+		};
+
+		/*
+		 * The types whose equal values have the same object representation: integral, pointer and (since C++11)
+		 * enumeration types.
+		 */
+		template <typename T>
+		struct bloom_filter_murmur_hashable : kerbal::type_traits::conditional_boolean<
+												kerbal::type_traits::is_integral<T>::value ||
+												kerbal::type_traits::is_pointer<T>::value
+#	if __cplusplus >= 201103L
+												|| std::is_enum<T>::value
+#	endif
+											>
+		{
+		};
+
+		/**
+		 * Default hash of the Bloom filters: two murmur hash 2 of the object representation with different seeds.
+		 *
+		 * Only given to the types of bloom_filter_murmur_hashable: equal values holding different bytes (a string,
+		 * a padded struct...) would hash differently and yield false negatives. Any other type must supply a
+		 * custom hash, callable as `bloom_filter_hash_pair operator()(const T &) const`. The i-th probe of a
+		 * Bloom filter is derived from h1 + i * h2 (double hashing, Kirsch and Mitzenmacher).
+		 */
+		template <typename T>
+		struct bloom_filter_murmur_hash
+		{
+				KERBAL_STATIC_ASSERT(bloom_filter_murmur_hashable<T>::value,
+									"the default hash of the Bloom filters only takes integral, enumeration and pointer types, "
+									"supply a Hash for the others");
+
+				typedef bloom_filter_hash_pair result_type;
+				typedef T argument_type;
+
+				result_type operator()(const T & obj) const
+				{
+					result_type r;
+					r.h1 = kerbal::hash::murmur_hash2_context(0x9747b28cu).digest(&obj, &obj + 1);
+					r.h2 = kerbal::hash::murmur_hash2_context(0x5bd1e995u).digest(&obj, &obj + 1);
+					return r;
+				}
+		};
+
+		namespace detail
+		{
+
+			/*
+			 * Generates the probes h1 + i * h2 (mod m) without overflow and without a division per probe.
+			 * The step is taken in [1, m), so that the probes never all stay on the same bit.
+			 */
+			class bloom_filter_probe
+			{
+				private:
+					std::size_t pos;
+					std::size_t step;
+					std::size_t m;
+
+				public:
+					KERBAL_CONSTEXPR14
+					bloom_filter_probe(const bloom_filter_hash_pair & h, std::size_t m) KERBAL_NOEXCEPT :
+							pos(h.h1 % m), step(m > 1 ? 1 + h.h2 % (m - 1) : 0), m(m)
+					{
+					}
+
+					KERBAL_CONSTEXPR14
+					std::size_t operator*() const KERBAL_NOEXCEPT
+					{
+						return pos;
+					}
+
+					KERBAL_CONSTEXPR14
+					bloom_filter_probe& operator++() KERBAL_NOEXCEPT
+					{
+						pos += step;
+						if (pos >= m) {
+							pos -= m;
+						}
+						return *this;
+					}
+			};
+
+		} // namespace detail
+
+	} // namespace container
+
+} // namespace kerbal
+
+#endif // KERBAL_CONTAINER_DETAIL_BLOOM_FILTER_BASE_HPP
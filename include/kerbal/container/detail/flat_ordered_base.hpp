@@ -14,11 +14,13 @@
 
 #include <kerbal/algorithm/binary_search.hpp>
 #include <kerbal/algorithm/modifier.hpp>
+#include <kerbal/algorithm/search_policy.hpp>
 #include <kerbal/algorithm/sort.hpp>
 #include <kerbal/compatibility/move.hpp>
 #include <kerbal/compatibility/noexcept.hpp>
 #include <kerbal/iterator/iterator.hpp>
 #include <kerbal/iterator/iterator_traits.hpp>
+#include <kerbal/operators/generic_assign.hpp>
 #include <kerbal/type_traits/can_be_empty_base.hpp>
 #include <kerbal/type_traits/cv_deduction.hpp>
 #include <kerbal/type_traits/enable_if.hpp>
@@ -27,6 +29,8 @@
 
 #include <utility>
 
+#include <kerbal/container/vector.hpp>
+
 #if __cplusplus >= 201103L
 #	include <type_traits>
 #endif
@@ -645,6 +649,28 @@ namespace kerbal
 																   lower_bound_kc_adapter(this));
 					}
 
+					/**
+					 * @param policy selects the search engine, e.g. kerbal::algorithm::exponential_search_policy for
+					 *        monotone queries or kerbal::algorithm::interpolation_search_policy for near-uniform
+					 *        numeric keys (see algorithm/search_policy.hpp)
+					 */
+					template <typename SearchPolicy>
+					KERBAL_CONSTEXPR14
+					iterator lower_bound(const key_type & key, const_iterator hint, SearchPolicy policy)
+					{
+						iterator first(this->begin());
+						return policy.lower_bound(first, this->end(), key,
+												  kerbal::iterator::next(first, kerbal::iterator::distance(this->cbegin(), hint)),
+												  lower_bound_kc_adapter(this));
+					}
+
+					template <typename SearchPolicy>
+					KERBAL_CONSTEXPR14
+					const_iterator lower_bound(const key_type & key, const_iterator hint, SearchPolicy policy) const
+					{
+						return policy.lower_bound(this->cbegin(), this->cend(), key, hint, lower_bound_kc_adapter(this));
+					}
+
 
 					KERBAL_CONSTEXPR14
 					iterator upper_bound(const key_type & key)
@@ -870,6 +896,181 @@ namespace kerbal
 						return first;
 					}
 
+				protected:
+					/*
+					 * [begin, nth(mid)) and [nth(mid), end) are sorted, and none of the keys of the latter is
+					 * equivalent to one of the former. Merges them backward through a buffer holding the latter, so
+					 * the prefix of the former which is less than the whole tail is never touched.
+					 *
+					 * If an exception is thrown, the container is left sorted: the elements of the tail not merged
+					 * yet are dropped, and so is an element of the former whose move threw.
+					 */
+					void __merge_tail(size_type mid)
+					{
+						Extract e;
+						iterator first(this->begin());
+						iterator tail(this->nth(mid));
+						iterator last(this->end());
+						if (tail == first || tail == last ||
+							static_cast<bool>(this->key_comp_obj()(e(*kerbal::iterator::prev(tail)), e(*tail)))) {
+							return; // already in order
+						}
+
+						kerbal::container::vector<value_type> buffer;
+#		if __cpp_exceptions
+						try {
+#		endif
+							buffer.reserve(static_cast<size_type>(kerbal::iterator::distance(tail, last)));
+							for (iterator it(tail); it != last; ++it) {
+								buffer.push_back(kerbal::compatibility::to_xvalue(*it));
+							}
+#		if __cpp_exceptions
+						} catch (...) {
+							this->erase(tail, last);
+							throw;
+						}
+#		endif
+
+						typename kerbal::container::vector<value_type>::iterator b_first(buffer.begin());
+						typename kerbal::container::vector<value_type>::iterator b_last(buffer.end());
+						iterator a_last(tail);
+						iterator out(last);
+#		if __cpp_exceptions
+						try {
+#		endif
+							while (b_first != b_last) {
+								iterator dest(kerbal::iterator::prev(out));
+								if (a_last != first &&
+									static_cast<bool>(this->key_comp_obj()(
+											e(*kerbal::iterator::prev(b_last)), e(*kerbal::iterator::prev(a_last))))) {
+									// a_last[-1] > b_last[-1]
+									kerbal::operators::generic_assign(*dest,
+											kerbal::compatibility::to_xvalue(*kerbal::iterator::prev(a_last)));
+									--a_last;
+								} else {
+									kerbal::operators::generic_assign(*dest,
+											kerbal::compatibility::to_xvalue(*kerbal::iterator::prev(b_last)));
+									--b_last;
+								}
+								out = dest;
+							}
+#		if __cpp_exceptions
+						} catch (...) {
+							// [first, a_last) and [out, last) are in order, what lies between them was moved away
+							this->erase(a_last, out);
+							throw;
+						}
+#		endif
+					}
+
+					/*
+					 * [nth(mid), end) is sorted. Drops the elements of it whose key is equivalent to the one of the
+					 * element kept before it or to one of [begin, nth(mid)).
+					 */
+					void __unique_tail(size_type mid)
+					{
+						Extract e;
+						iterator tail(this->nth(mid));
+						iterator last(this->end());
+						iterator hint(this->begin());
+						iterator out(tail);
+						for (iterator it(tail); it != last; ++it) {
+							if (out != tail &&
+								!static_cast<bool>(this->key_comp_obj()(e(*kerbal::iterator::prev(out)), e(*it)))) {
+								continue; // duplicates the previous new element
+							}
+							// the tail is sorted, so each search gallops from the previous result: the k searches
+							// cost O(k log(n / k + 1)), which is O(n + k)
+							hint = kerbal::algorithm::exponential_lower_bound(this->begin(), tail, e(*it), hint,
+																				lower_bound_kc_adapter(this));
+							if (hint != tail && !static_cast<bool>(this->key_comp_obj()(e(*it), e(*hint)))) {
+								continue; // already present
+							}
+							if (out != it) {
+								kerbal::operators::generic_assign(*out, kerbal::compatibility::to_xvalue(*it));
+							}
+							++out;
+						}
+						size_type new_size = this->index_of(out);
+						this->erase(this->nth(new_size), this->cend());
+					}
+
+				public:
+					/**
+					 * @brief Inserts the elements of [first, last) whose keys are not present yet, as try_insert does
+					 *        one by one, in O(n + k log k) instead of O(k * n).
+					 *
+					 * The elements are appended, the appended tail is sorted, its duplicates and the keys already
+					 * present are dropped, and then it is merged in one pass. An element already present is kept
+					 * over the new ones with the same key, which one of several new ones is kept is unspecified.
+					 *
+					 * If an exception is thrown, the container is left sorted, without the new elements not merged
+					 * yet.
+					 *
+					 * @return The first element not inserted because the container is full, or last.
+					 */
+					template <typename InputIterator>
+					typename kerbal::type_traits::enable_if<
+							kerbal::iterator::is_input_compatible_iterator<InputIterator>::value,
+							InputIterator
+					>::type
+					insert_bulk(InputIterator first, InputIterator last)
+					{
+						while (first != last && this->size() != this->max_size()) {
+							size_type mid = this->size();
+#		if __cpp_exceptions
+							try {
+#		endif
+								do {
+									sequence.push_back(*first);
+									++first;
+								} while (first != last && this->size() != this->max_size());
+								kerbal::algorithm::sort(this->nth(mid), this->end(), this->value_comp());
+								this->__unique_tail(mid);
+#		if __cpp_exceptions
+							} catch (...) {
+								this->erase(this->nth(mid), this->cend());
+								throw;
+							}
+#		endif
+							this->__merge_tail(mid);
+						}
+						return first;
+					}
+
+					/**
+					 * @brief Same as insert_bulk, for a range already sorted by key, which is not sorted again.
+					 *        Of the new elements with the same key, the first one is kept. Appending keys greater
+					 *        than all the present ones costs O(k + log n).
+					 */
+					template <typename InputIterator>
+					typename kerbal::type_traits::enable_if<
+							kerbal::iterator::is_input_compatible_iterator<InputIterator>::value,
+							InputIterator
+					>::type
+					unique_insert_sorted(InputIterator first, InputIterator last)
+					{
+						while (first != last && this->size() != this->max_size()) {
+							size_type mid = this->size();
+#		if __cpp_exceptions
+							try {
+#		endif
+								do {
+									sequence.push_back(*first);
+									++first;
+								} while (first != last && this->size() != this->max_size());
+								this->__unique_tail(mid);
+#		if __cpp_exceptions
+							} catch (...) {
+								this->erase(this->nth(mid), this->cend());
+								throw;
+							}
+#		endif
+							this->__merge_tail(mid);
+						}
+						return first;
+					}
+
 					KERBAL_CONSTEXPR14
 					iterator insert(const_reference src)
 					{
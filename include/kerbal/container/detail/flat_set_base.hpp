@@ -180,6 +180,13 @@ namespace kerbal
 						return ordered.lower_bound(key, hint);
 					}
 
+					template <typename SearchPolicy>
+					KERBAL_CONSTEXPR14
+					const_iterator lower_bound(const key_type & key, const_iterator hint, SearchPolicy policy) const
+					{
+						return ordered.lower_bound(key, hint, policy);
+					}
+
 					KERBAL_CONSTEXPR14
 					const_iterator upper_bound(const key_type & key) const
 					{
@@ -410,6 +417,24 @@ namespace kerbal
 						this->ordered.try_insert(first, last);
 					}
 
+					/**
+					 * @brief Inserts a range in O(n + k log k), see flat_ordered_base::insert_bulk.
+					 */
+					template <typename InputIterator>
+					InputIterator insert_bulk(InputIterator first, InputIterator last)
+					{
+						return this->ordered.insert_bulk(first, last);
+					}
+
+					/**
+					 * @brief Inserts a range sorted by key, see flat_ordered_base::unique_insert_sorted.
+					 */
+					template <typename InputIterator>
+					InputIterator unique_insert_sorted(InputIterator first, InputIterator last)
+					{
+						return this->ordered.unique_insert_sorted(first, last);
+					}
+
 					KERBAL_CONSTEXPR14
 					const_iterator erase(const key_type & key)
 					{
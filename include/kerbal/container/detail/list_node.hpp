@@ -13,6 +13,7 @@
 #define KERBAL_CONTAINER_DETAIL_LIST_NODE_HPP
 
 #include <kerbal/container/fwd/list.fwd.hpp>
+#include <kerbal/container/fwd/pairing_heap.fwd.hpp>
 
 #include <kerbal/algorithm/modifier.hpp>
 #include <kerbal/compatibility/constexpr.hpp>
@@ -63,6 +64,9 @@ namespace kerbal
 					template <typename Tp>
 					friend class list_kiter;
 
+					template <typename Tp, typename KeyCompare, typename Allocator>
+					friend class kerbal::container::pairing_heap;
+
 				private:
 					list_node_base* prev;
 					list_node_base* next;
@@ -130,6 +134,9 @@ namespace kerbal
 
 					friend class kerbal::container::detail::list_kiter<Tp>;
 
+					template <typename Up, typename KeyCompare, typename Allocator>
+					friend class kerbal::container::pairing_heap;
+
 				private:
 					Tp value;
 
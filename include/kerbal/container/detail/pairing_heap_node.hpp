@@ -0,0 +1,105 @@
+/**
+ * @file       pairing_heap_node.hpp
+ * @brief
+ * @date       2020-11-10
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_CONTAINER_DETAIL_PAIRING_HEAP_NODE_HPP
+#define KERBAL_CONTAINER_DETAIL_PAIRING_HEAP_NODE_HPP
+
+#include <kerbal/container/fwd/pairing_heap.fwd.hpp>
+
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/utility/in_place.hpp>
+
+#include <cstddef>
+
+#if __cplusplus >= 201103L
+#	include <type_traits>
+#	include <utility> // forward
+#endif
+
+#include <kerbal/container/detail/list_node.hpp>
+
+namespace kerbal
+{
+
+	namespace container
+	{
+
+		namespace detail
+		{
+
+			/*
+			 * A node of a pairing heap is a list node with a list of sons:
+			 *  - next: the next sibling, NULL for the last one
+			 *  - prev: the previous sibling, or the father for the first son, NULL for the root
+			 *  - child: the first son, NULL for a leaf
+			 */
+			template <typename Tp>
+			class pairing_heap_node: public list_node<Tp>
+			{
+				private:
+					typedef list_node<Tp> super;
+
+				private:
+					template <typename Up, typename KeyCompare, typename Allocator>
+					friend class kerbal::container::pairing_heap;
+
+				private:
+					list_node_base * child;
+
+				public:
+
+#		if __cplusplus >= 201103L
+
+					template <typename ... Args>
+					explicit pairing_heap_node(kerbal::utility::in_place_t in_place, Args&& ... args)
+										KERBAL_CONDITIONAL_NOEXCEPT(
+												(std::is_nothrow_constructible<Tp, Args...>::value)
+										)
+							: super(in_place, std::forward<Args>(args)...), child(NULL)
+					{
+					}
+
+#		else
+
+					explicit pairing_heap_node(kerbal::utility::in_place_t in_place)
+							: super(in_place), child(NULL)
+					{
+					}
+
+					template <typename Arg0>
+					explicit pairing_heap_node(kerbal::utility::in_place_t in_place, const Arg0 & arg0)
+							: super(in_place, arg0), child(NULL)
+					{
+					}
+
+					template <typename Arg0, typename Arg1>
+					explicit pairing_heap_node(kerbal::utility::in_place_t in_place, const Arg0 & arg0, const Arg1 & arg1)
+							: super(in_place, arg0, arg1), child(NULL)
+					{
+					}
+
+					template <typename Arg0, typename Arg1, typename Arg2>
+					explicit pairing_heap_node(kerbal::utility::in_place_t in_place, const Arg0 & arg0, const Arg1 & arg1, const Arg2 & arg2)
+							: super(in_place, arg0, arg1, arg2), child(NULL)
+					{
+					}
+
+#		endif
+
+			};
+
+		} // namespace detail
+
+	} // namespace container
+
+} // namespace kerbal
+
+#endif // KERBAL_CONTAINER_DETAIL_PAIRING_HEAP_NODE_HPP
@@ -0,0 +1,171 @@
+/**
+ * @file       small_vector_base.hpp
+ * @brief
+ * @date       2020-11-04
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_CONTAINER_DETAIL_SMALL_VECTOR_BASE_HPP
+#define KERBAL_CONTAINER_DETAIL_SMALL_VECTOR_BASE_HPP
+
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/compatibility/static_assert.hpp>
+#include <kerbal/memory/allocator_traits.hpp>
+#include <kerbal/type_traits/can_be_pseudo_destructible.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+#include <kerbal/type_traits/is_trivially_relocatable.hpp>
+#include <kerbal/utility/in_place.hpp>
+#include <kerbal/utility/member_compress_helper.hpp>
+
+#include <cstddef>
+
+#include <kerbal/container/detail/static_vector_base.hpp>
+
+namespace kerbal
+{
+
+	namespace container
+	{
+
+		namespace detail
+		{
+
+			/*
+			 * The elements live in the storage of static_vector_base while there are at most N of them, and in a
+			 * buffer obtained from Allocator after that. `len` of static_vector_base is the number of the elements
+			 * in both cases, m_buffer points to whichever storage is in use.
+			 *
+			 * The inline elements are destroyed by static_vector_base, the heap ones here, so that the constructors
+			 * of small_vector need no cleanup job if they throw.
+			 */
+			template <typename Tp, size_t N, typename Allocator>
+			class small_vector_base:
+					protected kerbal::container::detail::static_vector_base<Tp, N>,
+					private kerbal::utility::member_compress_helper<Allocator>
+			{
+					KERBAL_STATIC_ASSERT(N > 0, "N must be greater than 0");
+
+				private:
+					typedef kerbal::container::detail::static_vector_base<Tp, N>	inline_base;
+					typedef kerbal::utility::member_compress_helper<Allocator>		allocator_compress_helper;
+
+				protected:
+					typedef kerbal::memory::allocator_traits<Allocator>				allocator_traits;
+
+				public:
+					typedef Tp			value_type;
+					typedef size_t		size_type;
+
+				protected:
+					KERBAL_STATIC_ASSERT(sizeof(typename inline_base::storage_type) == sizeof(value_type),
+										"the inline storage must be laid out as an array of Tp");
+
+					value_type * m_buffer;
+					size_type m_capacity;
+
+					small_vector_base() :
+							inline_base(),
+							allocator_compress_helper(kerbal::utility::in_place_t()),
+							m_buffer(this->__inline_buffer()), m_capacity(N)
+					{
+					}
+
+					explicit small_vector_base(const Allocator & alloc) :
+							inline_base(),
+							allocator_compress_helper(kerbal::utility::in_place_t(), alloc),
+							m_buffer(this->__inline_buffer()), m_capacity(N)
+					{
+					}
+
+					~small_vector_base() KERBAL_NOEXCEPT
+					{
+						if (this->__is_spilled()) {
+							this->__destroy(this->m_buffer, this->m_buffer + this->len);
+							allocator_traits::deallocate(this->alloc(), this->m_buffer, this->m_capacity);
+							this->len = 0; // nothing left for static_vector_base
+						}
+					}
+
+					Allocator & alloc() KERBAL_NOEXCEPT
+					{
+						return allocator_compress_helper::member();
+					}
+
+					const Allocator & alloc() const KERBAL_NOEXCEPT
+					{
+						return allocator_compress_helper::member();
+					}
+
+					value_type * __inline_buffer() KERBAL_NOEXCEPT
+					{
+						return this->storage[0].raw_pointer();
+					}
+
+					const value_type * __inline_buffer() const KERBAL_NOEXCEPT
+					{
+						return this->storage[0].raw_pointer();
+					}
+
+					bool __is_spilled() const KERBAL_NOEXCEPT
+					{
+						return this->m_buffer != this->__inline_buffer();
+					}
+
+				private:
+					void __destroy(value_type * first, value_type * last, kerbal::type_traits::false_type) KERBAL_NOEXCEPT
+					{
+						while (first != last) {
+							--last;
+							allocator_traits::destroy(this->alloc(), last);
+						}
+					}
+
+					void __destroy(value_type *, value_type *, kerbal::type_traits::true_type) KERBAL_NOEXCEPT
+					{
+					}
+
+				protected:
+					void __destroy(value_type * first, value_type * last) KERBAL_NOEXCEPT
+					{
+						this->__destroy(first, last, kerbal::type_traits::bool_constant<
+												kerbal::type_traits::can_be_pseudo_destructible<value_type>::value
+										>());
+					}
+
+					/*
+					 * Ends the lifetime of the sources of a relocation. A trivially relocatable element has been taken
+					 * over bitwise by its destination, so its source must not be destroyed.
+					 */
+					void __destroy_relocated(value_type * first, value_type * last) KERBAL_NOEXCEPT
+					{
+						if (!kerbal::type_traits::is_trivially_relocatable<value_type>::value) {
+							this->__destroy(first, last);
+						}
+					}
+
+					/*
+					 * Releases the heap buffer and goes back to the inline storage.
+					 * pre-condition: the elements of the heap buffer have been destroyed or relocated
+					 */
+					void __deallocate_heap() KERBAL_NOEXCEPT
+					{
+						if (this->__is_spilled()) {
+							allocator_traits::deallocate(this->alloc(), this->m_buffer, this->m_capacity);
+							this->m_buffer = this->__inline_buffer();
+							this->m_capacity = N;
+						}
+					}
+
+			};
+
+		} // namespace detail
+
+	} // namespace container
+
+} // namespace kerbal
+
+#endif // KERBAL_CONTAINER_DETAIL_SMALL_VECTOR_BASE_HPP
@@ -22,6 +22,7 @@
 #include <kerbal/operators/incr_decr.hpp>
 #include <kerbal/operators/less_than_comparable.hpp>
 #include <kerbal/operators/subtractable.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
 
 namespace kerbal
 {
@@ -210,6 +211,25 @@ namespace kerbal
 
 	} //namespace container
 
+	namespace iterator
+	{
+
+		// the storage of static_vector is laid out as an array of ValueType
+
+		template <typename ValueType>
+		struct __is_contiguous_iterator_helper<kerbal::container::detail::__stavec_iter<ValueType> >:
+				kerbal::type_traits::true_type
+		{
+		};
+
+		template <typename ValueType>
+		struct __is_contiguous_iterator_helper<kerbal::container::detail::__stavec_kiter<ValueType> >:
+				kerbal::type_traits::true_type
+		{
+		};
+
+	} //namespace iterator
+
 } //namespace kerbal
 
 #endif // KERBAL_CONTAINER_DETAIL_STATIC_VECTOR_ITERATOR_HPP
@@ -0,0 +1,65 @@
+/**
+ * @file       trivially_relocate.hpp
+ * @brief
+ * @date       2020-11-06
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_CONTAINER_DETAIL_TRIVIALLY_RELOCATE_HPP
+#define KERBAL_CONTAINER_DETAIL_TRIVIALLY_RELOCATE_HPP
+
+#include <kerbal/compatibility/noexcept.hpp>
+
+#include <cstddef>
+#include <cstring>
+
+namespace kerbal
+{
+
+	namespace container
+	{
+
+		namespace detail
+		{
+
+			/*
+			 * Exchanges the bytes of two non-overlapping blocks, which swaps the trivially relocatable objects they
+			 * hold. The exchange goes through a small buffer on the stack, so that each chunk is copied by three
+			 * memcpy of a known size.
+			 */
+			inline
+			void trivially_relocate_swap(void * p, void * q, std::size_t bytes) KERBAL_NOEXCEPT
+			{
+				enum
+				{
+					CHUNK = 64
+				};
+				unsigned char buffer[CHUNK];
+				unsigned char * a = static_cast<unsigned char *>(p);
+				unsigned char * b = static_cast<unsigned char *>(q);
+				while (bytes >= CHUNK) {
+					std::memcpy(buffer, a, CHUNK);
+					std::memcpy(a, b, CHUNK);
+					std::memcpy(b, buffer, CHUNK);
+					a += CHUNK;
+					b += CHUNK;
+					bytes -= CHUNK;
+				}
+				if (bytes != 0) {
+					std::memcpy(buffer, a, bytes);
+					std::memcpy(a, b, bytes);
+					std::memcpy(b, buffer, bytes);
+				}
+			}
+
+		} // namespace detail
+
+	} // namespace container
+
+} // namespace kerbal
+
+#endif // KERBAL_CONTAINER_DETAIL_TRIVIALLY_RELOCATE_HPP
@@ -0,0 +1,134 @@
+/**
+ * @file       vector_base.hpp
+ * @brief
+ * @date       2020-11-02
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_CONTAINER_DETAIL_VECTOR_BASE_HPP
+#define KERBAL_CONTAINER_DETAIL_VECTOR_BASE_HPP
+
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/memory/allocator_traits.hpp>
+#include <kerbal/type_traits/can_be_pseudo_destructible.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+#include <kerbal/type_traits/is_trivially_relocatable.hpp>
+#include <kerbal/utility/in_place.hpp>
+#include <kerbal/utility/member_compress_helper.hpp>
+
+#include <cstddef>
+
+namespace kerbal
+{
+
+	namespace container
+	{
+
+		namespace detail
+		{
+
+			/*
+			 * Owns the buffer of vector: the elements [m_buffer, m_buffer + m_size) are destroyed and the buffer is
+			 * released on destruction, so that the constructors of vector need no cleanup job if they throw.
+			 */
+			template <typename Tp, typename Allocator>
+			class vector_base:
+					private kerbal::utility::member_compress_helper<Allocator>
+			{
+				private:
+					typedef kerbal::utility::member_compress_helper<Allocator>		allocator_compress_helper;
+
+				protected:
+					typedef kerbal::memory::allocator_traits<Allocator>				allocator_traits;
+
+				public:
+					typedef Tp			value_type;
+					typedef size_t		size_type;
+
+				protected:
+					value_type * m_buffer;
+					size_type m_size;
+					size_type m_capacity;
+
+					vector_base() :
+							allocator_compress_helper(kerbal::utility::in_place_t()),
+							m_buffer(NULL), m_size(0), m_capacity(0)
+					{
+					}
+
+					explicit vector_base(const Allocator & alloc) :
+							allocator_compress_helper(kerbal::utility::in_place_t(), alloc),
+							m_buffer(NULL), m_size(0), m_capacity(0)
+					{
+					}
+
+					~vector_base() KERBAL_NOEXCEPT
+					{
+						this->__destroy(this->m_buffer, this->m_buffer + this->m_size);
+						this->__deallocate_buffer();
+					}
+
+					Allocator & alloc() KERBAL_NOEXCEPT
+					{
+						return allocator_compress_helper::member();
+					}
+
+					const Allocator & alloc() const KERBAL_NOEXCEPT
+					{
+						return allocator_compress_helper::member();
+					}
+
+				private:
+					void __destroy(value_type * first, value_type * last, kerbal::type_traits::false_type) KERBAL_NOEXCEPT
+					{
+						while (first != last) {
+							--last;
+							allocator_traits::destroy(this->alloc(), last);
+						}
+					}
+
+					void __destroy(value_type *, value_type *, kerbal::type_traits::true_type) KERBAL_NOEXCEPT
+					{
+					}
+
+				protected:
+					void __destroy(value_type * first, value_type * last) KERBAL_NOEXCEPT
+					{
+						this->__destroy(first, last, kerbal::type_traits::bool_constant<
+												kerbal::type_traits::can_be_pseudo_destructible<value_type>::value
+										>());
+					}
+
+					/*
+					 * Ends the lifetime of the sources of a relocation. A trivially relocatable element has been taken
+					 * over bitwise by its destination, so its source must not be destroyed.
+					 */
+					void __destroy_relocated(value_type * first, value_type * last) KERBAL_NOEXCEPT
+					{
+						if (!kerbal::type_traits::is_trivially_relocatable<value_type>::value) {
+							this->__destroy(first, last);
+						}
+					}
+
+					void __deallocate_buffer() KERBAL_NOEXCEPT
+					{
+						if (this->m_buffer != NULL) {
+							allocator_traits::deallocate(this->alloc(), this->m_buffer, this->m_capacity);
+							this->m_buffer = NULL;
+							this->m_capacity = 0;
+						}
+					}
+
+			};
+
+		} // namespace detail
+
+	} // namespace container
+
+} // namespace kerbal
+
+#endif // KERBAL_CONTAINER_DETAIL_VECTOR_BASE_HPP
@@ -0,0 +1,277 @@
+/**
+ * @file       dynamic_bloom_filter.hpp
+ * @brief
+ * @date       2020-10-26
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_CONTAINER_DYNAMIC_BLOOM_FILTER_HPP
+#define KERBAL_CONTAINER_DYNAMIC_BLOOM_FILTER_HPP
+
+#include <kerbal/container/detail/bloom_filter_base.hpp>
+
+#include <kerbal/algorithm/modifier.hpp>
+#include <kerbal/algorithm/swap.hpp>
+#include <kerbal/bitset/detail/bitset_size_unrelated.hpp>
+#include <kerbal/bitset/detail/default_block_type.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/compatibility/static_assert.hpp>
+#include <kerbal/memory/allocator_traits.hpp>
+#include <kerbal/numeric/bit.hpp>
+#include <kerbal/type_traits/sign_deduction.hpp>
+#include <kerbal/utility/member_compress_helper.hpp>
+#include <kerbal/utility/throw_this_exception.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+
+namespace kerbal
+{
+
+	namespace container
+	{
+
+		/**
+		 * Bloom filter whose number of bits and number of probes are chosen at run time.
+		 */
+		template <typename T,
+				typename Hash = kerbal::container::bloom_filter_murmur_hash<T>,
+				typename Block = KERBAL_BITSET_DEFAULT_BLOCK_TYPE,
+				typename Allocator = std::allocator<Block> >
+		class dynamic_bloom_filter:
+				private kerbal::utility::member_compress_helper<Hash>,
+				private kerbal::utility::member_compress_helper<Allocator>
+		{
+				KERBAL_STATIC_ASSERT(kerbal::type_traits::is_unsigned<Block>::value, "Block must be unsigned type");
+
+			private:
+				typedef kerbal::utility::member_compress_helper<Hash>		hash_compress_helper;
+				typedef kerbal::utility::member_compress_helper<Allocator>	allocator_compress_helper;
+				typedef kerbal::memory::allocator_traits<Allocator>			allocator_traits;
+
+			public:
+				typedef T														value_type;
+				typedef const T &												const_reference;
+				typedef Hash													hasher;
+				typedef Allocator												allocator_type;
+				typedef std::size_t												size_type;
+				typedef Block													block_type;
+				typedef kerbal::bitset::detail::bitset_bits_per_block<Block>	BITS_PER_BLOCK;
+
+			private:
+				block_type * m_block;
+				size_type m_bits;
+				size_type m_hash_count;
+
+				size_type block_size() const KERBAL_NOEXCEPT
+				{
+					return m_bits / BITS_PER_BLOCK::value + (m_bits % BITS_PER_BLOCK::value != 0);
+				}
+
+				Allocator & alloc() KERBAL_NOEXCEPT
+				{
+					return allocator_compress_helper::member();
+				}
+
+				void allocate_blocks()
+				{
+					if (this->m_bits == 0) {
+						kerbal::utility::throw_this_exception_helper<std::invalid_argument>::throw_this_exception((const char*)"dynamic_bloom_filter needs at least one bit");
+					}
+					size_type n = this->block_size();
+					this->m_block = allocator_traits::allocate(this->alloc(), n);
+					kerbal::algorithm::fill(this->m_block, this->m_block + n, static_cast<block_type>(0));
+				}
+
+			public:
+
+				/**
+				 * Number of bits that keeps the false positive rate at p after n insertions: -n ln(p) / ln(2)^2
+				 */
+				static size_type optimal_bits(size_type n, double p)
+				{
+					const double ln2 = 0.69314718055994530942;
+					double m = std::ceil(-static_cast<double>(n) * std::log(p) / (ln2 * ln2));
+					return m < 1.0 ? 1 : static_cast<size_type>(m);
+				}
+
+				/**
+				 * Number of probes that minimizes the false positive rate after n insertions: bits / n * ln(2)
+				 */
+				static size_type optimal_hash_count(size_type bits, size_type n)
+				{
+					const double ln2 = 0.69314718055994530942;
+					double k = std::floor(static_cast<double>(bits) / static_cast<double>(n == 0 ? 1 : n) * ln2 + 0.5);
+					return k < 1.0 ? 1 : static_cast<size_type>(k);
+				}
+
+				/**
+				 * @param bits number of bits, must be positive
+				 * @param hash_count number of probes per element, must be positive
+				 * @throw std::invalid_argument if bits is 0
+				 */
+				dynamic_bloom_filter(size_type bits, size_type hash_count) :
+						hash_compress_helper(kerbal::utility::in_place_t()),
+						allocator_compress_helper(kerbal::utility::in_place_t()),
+						m_block(NULL), m_bits(bits), m_hash_count(hash_count)
+				{
+					this->allocate_blocks();
+				}
+
+				dynamic_bloom_filter(size_type bits, size_type hash_count, const Hash & hash,
+									const Allocator & alloc = Allocator()) :
+						hash_compress_helper(kerbal::utility::in_place_t(), hash),
+						allocator_compress_helper(kerbal::utility::in_place_t(), alloc),
+						m_block(NULL), m_bits(bits), m_hash_count(hash_count)
+				{
+					this->allocate_blocks();
+				}
+
+				dynamic_bloom_filter(const dynamic_bloom_filter & src) :
+						hash_compress_helper(kerbal::utility::in_place_t(), src.hash_compress_helper::member()),
+						allocator_compress_helper(kerbal::utility::in_place_t(), src.allocator_compress_helper::member()),
+						m_block(NULL), m_bits(src.m_bits), m_hash_count(src.m_hash_count)
+				{
+					size_type n = this->block_size();
+					this->m_block = allocator_traits::allocate(this->alloc(), n);
+					kerbal::algorithm::copy(src.m_block, src.m_block + n, this->m_block);
+				}
+
+#		if __cplusplus >= 201103L
+
+				// the moved-from filter has no bit: it contains nothing and ignores the insertions
+				dynamic_bloom_filter(dynamic_bloom_filter && src) noexcept :
+						hash_compress_helper(kerbal::utility::in_place_t(), src.hash_compress_helper::member()),
+						allocator_compress_helper(kerbal::utility::in_place_t(), src.allocator_compress_helper::member()),
+						m_block(src.m_block), m_bits(src.m_bits), m_hash_count(src.m_hash_count)
+				{
+					src.m_block = NULL;
+					src.m_bits = 0;
+				}
+
+#		endif
+
+				~dynamic_bloom_filter()
+				{
+					if (this->m_block != NULL) {
+						allocator_traits::deallocate(this->alloc(), this->m_block, this->block_size());
+					}
+				}
+
+				dynamic_bloom_filter& operator=(const dynamic_bloom_filter & src)
+				{
+					dynamic_bloom_filter tmp(src);
+					this->swap(tmp);
+					return *this;
+				}
+
+#		if __cplusplus >= 201103L
+
+				dynamic_bloom_filter& operator=(dynamic_bloom_filter && src) noexcept
+				{
+					this->swap(src);
+					return *this;
+				}
+
+#		endif
+
+				hasher hash_function() const
+				{
+					return hash_compress_helper::member();
+				}
+
+				allocator_type get_allocator() const
+				{
+					return allocator_compress_helper::member();
+				}
+
+				size_type bits() const KERBAL_NOEXCEPT
+				{
+					return this->m_bits;
+				}
+
+				size_type hash_count() const KERBAL_NOEXCEPT
+				{
+					return this->m_hash_count;
+				}
+
+				void insert(const_reference value)
+				{
+					if (this->m_bits == 0) {
+						return;
+					}
+					detail::bloom_filter_probe probe(hash_compress_helper::member()(value), this->m_bits);
+					for (size_type i = 0; i < this->m_hash_count; ++i, ++probe) {
+						size_type pos = *probe;
+						block_type & b = this->m_block[pos / BITS_PER_BLOCK::value];
+						b = kerbal::numeric::set_bit(b, pos % BITS_PER_BLOCK::value);
+					}
+				}
+
+				template <typename InputIterator>
+				void insert(InputIterator first, InputIterator last)
+				{
+					while (first != last) {
+						this->insert(*first);
+						++first;
+					}
+				}
+
+				/**
+				 * @return false if the value has never been inserted, true if it probably has been.
+				 */
+				bool contains(const_reference value) const
+				{
+					if (this->m_bits == 0) {
+						return false;
+					}
+					detail::bloom_filter_probe probe(hash_compress_helper::member()(value), this->m_bits);
+					for (size_type i = 0; i < this->m_hash_count; ++i, ++probe) {
+						size_type pos = *probe;
+						if (!kerbal::numeric::get_bit(this->m_block[pos / BITS_PER_BLOCK::value], pos % BITS_PER_BLOCK::value)) {
+							return false;
+						}
+					}
+					return true;
+				}
+
+				void clear() KERBAL_NOEXCEPT
+				{
+					kerbal::algorithm::fill(this->m_block, this->m_block + this->block_size(), static_cast<block_type>(0));
+				}
+
+				/**
+				 * After merge, the filter contains everything that was inserted into any of the two filters.
+				 * Both filters must have the same number of bits, number of probes and hash function.
+				 */
+				dynamic_bloom_filter& merge(const dynamic_bloom_filter & ano) KERBAL_NOEXCEPT
+				{
+					size_type n = this->block_size();
+					for (size_type i = 0; i < n; ++i) {
+						this->m_block[i] |= ano.m_block[i];
+					}
+					return *this;
+				}
+
+				void swap(dynamic_bloom_filter & ano)
+				{
+					kerbal::algorithm::swap(hash_compress_helper::member(), ano.hash_compress_helper::member());
+					kerbal::algorithm::swap(allocator_compress_helper::member(), ano.allocator_compress_helper::member());
+					kerbal::algorithm::swap(this->m_block, ano.m_block);
+					kerbal::algorithm::swap(this->m_bits, ano.m_bits);
+					kerbal::algorithm::swap(this->m_hash_count, ano.m_hash_count);
+				}
+
+		};
+
+	} // namespace container
+
+} // namespace kerbal
+
+#endif // KERBAL_CONTAINER_DYNAMIC_BLOOM_FILTER_HPP
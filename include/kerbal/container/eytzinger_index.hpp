@@ -0,0 +1,286 @@
+/**
+ * @file       eytzinger_index.hpp
+ * @brief
+ * @date       2020-11-08
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_CONTAINER_EYTZINGER_INDEX_HPP
+#define KERBAL_CONTAINER_EYTZINGER_INDEX_HPP
+
+#include <kerbal/algorithm/swap.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/compatibility/prefetch.hpp>
+#include <kerbal/iterator/iterator.hpp>
+#include <kerbal/numeric/bit.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+#include <kerbal/utility/in_place.hpp>
+#include <kerbal/utility/member_compress_helper.hpp>
+
+#include <cstddef>
+#include <functional>
+
+#include <kerbal/container/vector.hpp>
+#include <kerbal/container/detail/flat_ordered_base.hpp>
+
+namespace kerbal
+{
+
+	namespace container
+	{
+
+		/**
+		 * A read-optimized search index over the keys of a sorted sequence (e.g. flat_ordered, static_ordered,
+		 * flat_set), in Eytzinger (BFS) layout: the children of slot k are 2k and 2k + 1.
+		 *
+		 * The first levels of the implicit tree share a handful of cache lines, and the 16 descendants four levels
+		 * below the current slot are contiguous, so they are prefetched while the next four comparisons run. The
+		 * descent is branchless. A lookup costs about log2(n) / 4 cache misses instead of the log2(n) ones of a
+		 * binary search over the sorted array.
+		 *
+		 * The index keeps a copy of the keys and answers ranks: lower_bound(key) is the index in the snapshot of
+		 * its first element not less than key, use snapshot.nth(rank) to get the element. The index is not
+		 * updated with the snapshot, rebuild it after any modification.
+		 */
+		template <typename Key, typename KeyCompare = std::less<Key> >
+		class eytzinger_index:
+				private kerbal::utility::member_compress_helper<KeyCompare>
+		{
+			private:
+				typedef kerbal::utility::member_compress_helper<KeyCompare>		key_compare_compress_helper;
+
+			public:
+				typedef Key						key_type;
+				typedef KeyCompare				key_compare;
+				typedef std::size_t				size_type;
+
+			private:
+				// descendants of slot k four levels below: [16k, 16k + 16)
+				typedef kerbal::type_traits::integral_constant<size_type, 16>		PREFETCH_STRIDE;
+
+				kerbal::container::vector<key_type> m_keys;		// m_keys[0] is unused
+				kerbal::container::vector<size_type> m_ranks;	// rank in the snapshot of m_keys[k]
+
+			public:
+				eytzinger_index() :
+						key_compare_compress_helper(kerbal::utility::in_place_t())
+				{
+				}
+
+				explicit eytzinger_index(const key_compare & kc) :
+						key_compare_compress_helper(kerbal::utility::in_place_t(), kc)
+				{
+				}
+
+				/**
+				 * @param first, last the keys in ascending order according to kc
+				 */
+				template <typename ForwardIterator>
+				eytzinger_index(ForwardIterator first, ForwardIterator last, const key_compare & kc = key_compare()) :
+						key_compare_compress_helper(kerbal::utility::in_place_t(), kc)
+				{
+					this->build(first, last);
+				}
+
+				/**
+				 * Builds the index of the keys of a flat_ordered / static_ordered, and takes its key_comp().
+				 */
+				template <typename Entity, typename Extract, typename Sequence>
+				explicit eytzinger_index(const kerbal::container::detail::flat_ordered_base<
+												Entity, Key, KeyCompare, Extract, Sequence> & src) :
+						key_compare_compress_helper(kerbal::utility::in_place_t(), src.key_comp())
+				{
+					this->build(src.cbegin(), src.cend(), Extract());
+				}
+
+				template <typename ForwardIterator>
+				void build(ForwardIterator first, ForwardIterator last)
+				{
+					this->build(first, last, kerbal::container::default_extract<Key, Key>());
+				}
+
+				/**
+				 * @param first, last elements in ascending order of their keys
+				 * @param extract gets the key of an element
+				 */
+				template <typename ForwardIterator, typename Extract>
+				void build(ForwardIterator first, ForwardIterator last, Extract extract)
+				{
+					size_type n = static_cast<size_type>(kerbal::iterator::distance(first, last));
+					this->m_keys.clear();
+					this->m_ranks.clear();
+					if (n == 0) {
+						return;
+					}
+					this->m_keys.assign(n + 1, extract(*first));
+					this->m_ranks.assign(n + 1, 0);
+					size_type rank = 0;
+					this->__fill(first, extract, rank, 1);
+				}
+
+				template <typename Entity, typename Extract, typename Sequence>
+				void build(const kerbal::container::detail::flat_ordered_base<
+										Entity, Key, KeyCompare, Extract, Sequence> & src)
+				{
+					this->key_comp_obj() = src.key_comp();
+					this->build(src.cbegin(), src.cend(), Extract());
+				}
+
+			private:
+				// in-order traversal of the implicit tree consumes the sorted input front to back
+				template <typename ForwardIterator, typename Extract>
+				void __fill(ForwardIterator & it, Extract & extract, size_type & rank, size_type k)
+				{
+					size_type n = this->size();
+					if (k > n) {
+						return;
+					}
+					this->__fill(it, extract, rank, 2 * k);
+					this->m_keys[k] = extract(*it);
+					this->m_ranks[k] = rank;
+					++rank;
+					++it;
+					this->__fill(it, extract, rank, 2 * k + 1);
+				}
+
+				key_compare & key_comp_obj() KERBAL_NOEXCEPT
+				{
+					return key_compare_compress_helper::member();
+				}
+
+				const key_compare & key_comp_obj() const KERBAL_NOEXCEPT
+				{
+					return key_compare_compress_helper::member();
+				}
+
+				/*
+				 * Descends until falling off the tree. Each step appends one bit to k: 1 if the search goes right.
+				 * The answer is the last slot where the search went left, found by stripping the trailing 1 bits
+				 * and the 0 bit before them; 0 if the search never went left.
+				 */
+				template <typename GoRight>
+				size_type __search(GoRight go_right) const
+				{
+					const key_type * keys = this->m_keys.data();
+					size_type n = this->size();
+					size_type k = 1;
+					while (k <= n) {
+						if (k * PREFETCH_STRIDE::value <= n) {
+							KERBAL_PREFETCH_READ(keys + k * PREFETCH_STRIDE::value);
+						}
+						k = 2 * k + static_cast<size_type>(static_cast<bool>(go_right(keys[k])));
+					}
+					k >>= kerbal::numeric::countr_zero(~k) + 1;
+					return k;
+				}
+
+				struct lower_bound_go_right
+				{
+						const key_compare & kc;
+						const key_type & key;
+
+						lower_bound_go_right(const key_compare & kc, const key_type & key) KERBAL_NOEXCEPT :
+								kc(kc), key(key)
+						{
+						}
+
+						bool operator()(const key_type & item) const
+						{
+							return kc(item, key);
+						}
+				};
+
+				struct upper_bound_go_right
+				{
+						const key_compare & kc;
+						const key_type & key;
+
+						upper_bound_go_right(const key_compare & kc, const key_type & key) KERBAL_NOEXCEPT :
+								kc(kc), key(key)
+						{
+						}
+
+						bool operator()(const key_type & item) const
+						{
+							return !kc(key, item);
+						}
+				};
+
+				size_type __rank_of(size_type k) const KERBAL_NOEXCEPT
+				{
+					return k == 0 ? this->size() : this->m_ranks[k];
+				}
+
+			public:
+				key_compare key_comp() const
+				{
+					return this->key_comp_obj();
+				}
+
+				size_type size() const KERBAL_NOEXCEPT
+				{
+					return this->m_keys.empty() ? 0 : this->m_keys.size() - 1;
+				}
+
+				bool empty() const KERBAL_NOEXCEPT
+				{
+					return this->m_keys.empty();
+				}
+
+				/**
+				 * @return the rank of the first key not less than key, or size() if there is none
+				 */
+				size_type lower_bound(const key_type & key) const
+				{
+					return this->__rank_of(this->__search(lower_bound_go_right(this->key_comp_obj(), key)));
+				}
+
+				/**
+				 * @return the rank of the first key greater than key, or size() if there is none
+				 */
+				size_type upper_bound(const key_type & key) const
+				{
+					return this->__rank_of(this->__search(upper_bound_go_right(this->key_comp_obj(), key)));
+				}
+
+				/**
+				 * @return the rank of a key equivalent to key, or size() if there is none
+				 */
+				size_type find(const key_type & key) const
+				{
+					size_type k = this->__search(lower_bound_go_right(this->key_comp_obj(), key));
+					if (k == 0 || this->key_comp_obj()(key, this->m_keys[k])) {
+						return this->size();
+					}
+					return this->m_ranks[k];
+				}
+
+				bool contains(const key_type & key) const
+				{
+					return this->find(key) != this->size();
+				}
+
+				void clear() KERBAL_NOEXCEPT
+				{
+					this->m_keys.clear();
+					this->m_ranks.clear();
+				}
+
+				void swap(eytzinger_index & with)
+				{
+					kerbal::algorithm::swap(this->key_comp_obj(), with.key_comp_obj());
+					this->m_keys.swap(with.m_keys);
+					this->m_ranks.swap(with.m_ranks);
+				}
+
+		};
+
+	} // namespace container
+
+} // namespace kerbal
+
+#endif // KERBAL_CONTAINER_EYTZINGER_INDEX_HPP
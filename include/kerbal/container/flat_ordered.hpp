@@ -13,10 +13,10 @@
 #define KERBAL_CONTAINER_FLAT_ORDERED_HPP
 
 #include <kerbal/algorithm/swap.hpp>
+#include <kerbal/container/vector.hpp>
 #include <kerbal/container/detail/flat_ordered_base.hpp>
 
 #include <cstddef>
-#include <vector>
 
 namespace kerbal
 {
@@ -28,11 +28,11 @@ namespace kerbal
 				typename Extract = default_extract<Key, Entity>, typename Allocator = std::allocator<Entity> >
 		class flat_ordered:
 				public kerbal::container::detail::flat_ordered_base<
-						Entity, Key, KeyCompare, Extract, std::vector<Entity, Allocator>
+						Entity, Key, KeyCompare, Extract, kerbal::container::vector<Entity, Allocator>
 				>
 		{
 			public:
-				typedef std::vector<Entity, Allocator> Sequence;
+				typedef kerbal::container::vector<Entity, Allocator> Sequence;
 
 			private:
 				typedef kerbal::container::detail::flat_ordered_base<
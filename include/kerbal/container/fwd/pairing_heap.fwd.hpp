@@ -0,0 +1,36 @@
+/**
+ * @file       pairing_heap.fwd.hpp
+ * @brief
+ * @date       2020-11-10
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_CONTAINER_FWD_PAIRING_HEAP_FWD_HPP
+#define KERBAL_CONTAINER_FWD_PAIRING_HEAP_FWD_HPP
+
+namespace kerbal
+{
+
+	namespace container
+	{
+
+		template <typename Tp, typename KeyCompare, typename Allocator>
+		class pairing_heap;
+
+		namespace detail
+		{
+
+			template <typename Tp>
+			class pairing_heap_node;
+
+		} // namespace detail
+
+	} // namespace container
+
+} // namespace kerbal
+
+#endif // KERBAL_CONTAINER_FWD_PAIRING_HEAP_FWD_HPP
@@ -14,8 +14,10 @@
 
 #include <kerbal/algorithm/modifier.hpp>
 #include <kerbal/algorithm/swap.hpp>
+#include <kerbal/compatibility/is_constant_evaluated.hpp>
 #include <kerbal/compatibility/move.hpp>
 #include <kerbal/operators/generic_assign.hpp>
+#include <kerbal/type_traits/is_trivially_relocatable.hpp>
 #include <kerbal/utility/throw_this_exception.hpp>
 
 #if __cplusplus >= 201103L
@@ -23,6 +25,7 @@
 #endif
 
 #include <kerbal/container/array.hpp>
+#include <kerbal/container/detail/trivially_relocate.hpp>
 
 namespace kerbal
 {
@@ -430,6 +433,13 @@ namespace kerbal
 		KERBAL_CONSTEXPR14
 		void array<Tp, N>::swap(array & with)
 		{
+			if (kerbal::type_traits::is_trivially_relocatable<value_type>::value && KERBAL_CONSTEXPR14_RUNTIME_PATH()) {
+				if (this != &with) {
+					kerbal::container::detail::trivially_relocate_swap(
+							static_cast<void*>(this->storage), static_cast<void*>(with.storage), sizeof(this->storage));
+				}
+				return;
+			}
 			kerbal::algorithm::swap(this->storage, with.storage);
 		}
 
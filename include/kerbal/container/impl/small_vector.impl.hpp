@@ -0,0 +1,997 @@
+/**
+ * @file       small_vector.impl.hpp
+ * @brief
+ * @date       2020-11-04
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_CONTAINER_IMPL_SMALL_VECTOR_IMPL_HPP
+#define KERBAL_CONTAINER_IMPL_SMALL_VECTOR_IMPL_HPP
+
+#include <kerbal/algorithm/modifier.hpp>
+#include <kerbal/algorithm/swap.hpp>
+#include <kerbal/compatibility/move.hpp>
+#include <kerbal/compatibility/static_assert.hpp>
+#include <kerbal/iterator/iterator.hpp>
+#include <kerbal/utility/throw_this_exception.hpp>
+
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <utility> // std::forward, std::move_if_noexcept
+
+#include <kerbal/container/small_vector.hpp>
+
+namespace kerbal
+{
+
+	namespace container
+	{
+
+		//===================
+		//construct/copy/destroy
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		small_vector<Tp, N, Allocator, GrowthPolicy>::small_vector() :
+				super()
+		{
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		small_vector<Tp, N, Allocator, GrowthPolicy>::small_vector(const Allocator & alloc) :
+				super(alloc)
+		{
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		small_vector<Tp, N, Allocator, GrowthPolicy>::small_vector(const small_vector & src) :
+				super(src.alloc())
+		{
+			// if any exception thrown, small_vector_base will do the cleanup job
+			this->__range_append(src.cbegin(), src.cend(), std::random_access_iterator_tag());
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		small_vector<Tp, N, Allocator, GrowthPolicy>::small_vector(const small_vector & src, const Allocator & alloc) :
+				super(alloc)
+		{
+			this->__range_append(src.cbegin(), src.cend(), std::random_access_iterator_tag());
+		}
+
+#	if __cplusplus >= 201103L
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		small_vector<Tp, N, Allocator, GrowthPolicy>::small_vector(small_vector && src) :
+				super(src.alloc())
+		{
+			this->__steal(src);
+		}
+
+#	endif
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		small_vector<Tp, N, Allocator, GrowthPolicy>::small_vector(size_type n) :
+				super()
+		{
+			this->__value_init_append(n);
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		small_vector<Tp, N, Allocator, GrowthPolicy>::small_vector(size_type n, const Allocator & alloc) :
+				super(alloc)
+		{
+			this->__value_init_append(n);
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		small_vector<Tp, N, Allocator, GrowthPolicy>::small_vector(size_type n, const_reference val) :
+				super()
+		{
+			this->__fill_append(n, val);
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		small_vector<Tp, N, Allocator, GrowthPolicy>::small_vector(size_type n, const_reference val, const Allocator & alloc) :
+				super(alloc)
+		{
+			this->__fill_append(n, val);
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		template <typename InputIterator>
+		small_vector<Tp, N, Allocator, GrowthPolicy>::small_vector(InputIterator first, InputIterator last,
+				typename kerbal::type_traits::enable_if<
+						kerbal::iterator::is_input_compatible_iterator<InputIterator>::value
+						, int
+				>::type) :
+				super()
+		{
+			this->__range_append(first, last, kerbal::iterator::iterator_category(first));
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		template <typename InputIterator>
+		small_vector<Tp, N, Allocator, GrowthPolicy>::small_vector(InputIterator first, InputIterator last, const Allocator & alloc,
+				typename kerbal::type_traits::enable_if<
+						kerbal::iterator::is_input_compatible_iterator<InputIterator>::value
+						, int
+				>::type) :
+				super(alloc)
+		{
+			this->__range_append(first, last, kerbal::iterator::iterator_category(first));
+		}
+
+#	if __cplusplus >= 201103L
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		small_vector<Tp, N, Allocator, GrowthPolicy>::small_vector(std::initializer_list<value_type> src) :
+				super()
+		{
+			this->__range_append(src.begin(), src.end(), std::random_access_iterator_tag());
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		small_vector<Tp, N, Allocator, GrowthPolicy>::small_vector(std::initializer_list<value_type> src, const Allocator & alloc) :
+				super(alloc)
+		{
+			this->__range_append(src.begin(), src.end(), std::random_access_iterator_tag());
+		}
+
+#	else
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		template <typename Up>
+		small_vector<Tp, N, Allocator, GrowthPolicy>::small_vector(const kerbal::assign::assign_list<Up> & src) :
+				super()
+		{
+			this->__range_append(src.cbegin(), src.cend(), kerbal::iterator::iterator_category(src.cbegin()));
+		}
+
+#	endif
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		small_vector<Tp, N, Allocator, GrowthPolicy>&
+		small_vector<Tp, N, Allocator, GrowthPolicy>::operator=(const small_vector & src)
+		{
+			if (this != &src) {
+				this->assign(src.cbegin(), src.cend());
+			}
+			return *this;
+		}
+
+#	if __cplusplus >= 201103L
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		small_vector<Tp, N, Allocator, GrowthPolicy>&
+		small_vector<Tp, N, Allocator, GrowthPolicy>::operator=(small_vector && src)
+		{
+			if (this != &src) {
+				this->clear();
+				this->__steal(src);
+			}
+			return *this;
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		small_vector<Tp, N, Allocator, GrowthPolicy>&
+		small_vector<Tp, N, Allocator, GrowthPolicy>::operator=(std::initializer_list<value_type> src)
+		{
+			this->assign(src);
+			return *this;
+		}
+
+#	else
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		template <typename Up>
+		small_vector<Tp, N, Allocator, GrowthPolicy>&
+		small_vector<Tp, N, Allocator, GrowthPolicy>::operator=(const kerbal::assign::assign_list<Up> & src)
+		{
+			this->assign(src);
+			return *this;
+		}
+
+#	endif
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		void small_vector<Tp, N, Allocator, GrowthPolicy>::assign(size_type new_size, const_reference val)
+		{
+			if (new_size > this->m_capacity) {
+				small_vector tmp(new_size, val, this->alloc());
+				this->swap(tmp);
+				return;
+			}
+			size_type common = new_size < this->len ? new_size : this->len;
+			kerbal::algorithm::fill(this->m_buffer, this->m_buffer + common, val);
+			if (new_size < this->len) {
+				this->__shrink_back_to(new_size);
+			} else {
+				this->__fill_append(new_size - this->len, val);
+			}
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		template <typename InputIterator>
+		typename kerbal::type_traits::enable_if<
+				kerbal::iterator::is_input_compatible_iterator<InputIterator>::value
+		>::type
+		small_vector<Tp, N, Allocator, GrowthPolicy>::assign(InputIterator first, InputIterator last)
+		{
+			this->__assign(first, last, kerbal::iterator::iterator_category(first));
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		template <typename InputIterator>
+		void small_vector<Tp, N, Allocator, GrowthPolicy>::__assign(InputIterator first, InputIterator last,
+																std::input_iterator_tag)
+		{
+			iterator it(this->begin());
+			iterator end(this->end());
+			while (first != last && it != end) {
+				*it = *first;
+				++it;
+				++first;
+			}
+			if (first == last) {
+				this->__shrink_back_to(it - this->begin());
+			} else {
+				this->__range_append(first, last, std::input_iterator_tag());
+			}
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		template <typename ForwardIterator>
+		void small_vector<Tp, N, Allocator, GrowthPolicy>::__assign(ForwardIterator first, ForwardIterator last,
+																std::forward_iterator_tag)
+		{
+			if (static_cast<size_type>(kerbal::iterator::distance(first, last)) > this->m_capacity) {
+				// don't relocate the elements which are going to be overwritten
+				this->clear();
+				this->__deallocate_heap();
+				this->__range_append(first, last, std::forward_iterator_tag());
+				return;
+			}
+			this->__assign(first, last, std::input_iterator_tag());
+		}
+
+#	if __cplusplus >= 201103L
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		void small_vector<Tp, N, Allocator, GrowthPolicy>::assign(std::initializer_list<value_type> src)
+		{
+			this->assign(src.begin(), src.end());
+		}
+
+#	else
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		template <typename Up>
+		void small_vector<Tp, N, Allocator, GrowthPolicy>::assign(const kerbal::assign::assign_list<Up> & src)
+		{
+			this->assign(src.cbegin(), src.cend());
+		}
+
+#	endif
+
+		//===================
+		//element access
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		typename small_vector<Tp, N, Allocator, GrowthPolicy>::reference
+		small_vector<Tp, N, Allocator, GrowthPolicy>::at(size_type index)
+		{
+			if (index >= this->len) {
+				kerbal::utility::throw_this_exception_helper<std::out_of_range>::throw_this_exception((const char*)"range check fail in small_vector");
+			}
+			return (*this)[index];
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		typename small_vector<Tp, N, Allocator, GrowthPolicy>::const_reference
+		small_vector<Tp, N, Allocator, GrowthPolicy>::at(size_type index) const
+		{
+			if (index >= this->len) {
+				kerbal::utility::throw_this_exception_helper<std::out_of_range>::throw_this_exception((const char*)"range check fail in small_vector");
+			}
+			return (*this)[index];
+		}
+
+		//===================
+		//capacity
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		typename small_vector<Tp, N, Allocator, GrowthPolicy>::size_type
+		small_vector<Tp, N, Allocator, GrowthPolicy>::__next_capacity(size_type required) const
+		{
+			if (required > this->max_size()) {
+				kerbal::utility::throw_this_exception_helper<std::length_error>::throw_this_exception((const char*)"small_vector is too long");
+			}
+			return GrowthPolicy::next_capacity(this->m_capacity, required, this->max_size());
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		void small_vector<Tp, N, Allocator, GrowthPolicy>::reserve(size_type new_cap)
+		{
+			if (new_cap > this->m_capacity) {
+				if (new_cap > this->max_size()) {
+					kerbal::utility::throw_this_exception_helper<std::length_error>::throw_this_exception((const char*)"small_vector is too long");
+				}
+				this->__reallocate(new_cap);
+			}
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		void small_vector<Tp, N, Allocator, GrowthPolicy>::shrink_to_fit()
+		{
+			if (!this->__is_spilled() || this->len == this->m_capacity) {
+				return;
+			}
+			if (this->len <= N) {
+				this->__move_to_inline();
+			} else {
+				this->__reallocate(this->len);
+			}
+		}
+
+		// pre-condition: new_cap >= size() && new_cap > N
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		void small_vector<Tp, N, Allocator, GrowthPolicy>::__reallocate(size_type new_cap)
+		{
+			if (this->__is_spilled()) {
+				this->__reallocate_heap(new_cap, REALLOCATE_IN_PLACE());
+			} else {
+				// the inline storage can't be handed to the allocator
+				this->__reallocate_heap(new_cap, kerbal::type_traits::false_type());
+			}
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		void small_vector<Tp, N, Allocator, GrowthPolicy>::__reallocate_heap(size_type new_cap, kerbal::type_traits::false_type)
+		{
+			pointer new_buffer = allocator_traits::allocate(this->alloc(), new_cap);
+#	if __cpp_exceptions
+			try {
+#	endif // __cpp_exceptions
+				this->__relocate(this->m_buffer, this->m_buffer + this->len, new_buffer, TRIVIALLY_RELOCATABLE());
+#	if __cpp_exceptions
+			} catch (...) {
+				allocator_traits::deallocate(this->alloc(), new_buffer, new_cap);
+				throw;
+			}
+#	endif // __cpp_exceptions
+			this->__destroy_relocated(this->m_buffer, this->m_buffer + this->len);
+			this->__deallocate_heap();
+			this->m_buffer = new_buffer;
+			this->m_capacity = new_cap;
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		void small_vector<Tp, N, Allocator, GrowthPolicy>::__reallocate_heap(size_type new_cap, kerbal::type_traits::true_type)
+		{
+			// the elements are moved bitwise by the allocator, possibly without moving the block at all
+			this->m_buffer = this->alloc().reallocate(this->m_buffer, this->m_capacity, new_cap);
+			this->m_capacity = new_cap;
+		}
+
+		/*
+		 * Constructs [to, to + (last - first)) from [first, last), the source elements are left for the caller
+		 * to end with __destroy_relocated. If an exception is thrown, nothing remains constructed at `to` and the source is intact.
+		 */
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		void small_vector<Tp, N, Allocator, GrowthPolicy>::__relocate(pointer first, pointer last, pointer to,
+																kerbal::type_traits::false_type)
+		{
+			pointer cur = to;
+#	if __cpp_exceptions
+			try {
+#	endif // __cpp_exceptions
+				while (first != last) {
+#	if __cplusplus >= 201103L
+					allocator_traits::construct(this->alloc(), cur, std::move_if_noexcept(*first));
+#	else
+					allocator_traits::construct(this->alloc(), cur, *first);
+#	endif
+					++cur;
+					++first;
+				}
+#	if __cpp_exceptions
+			} catch (...) {
+				this->__destroy(to, cur);
+				throw;
+			}
+#	endif // __cpp_exceptions
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		void small_vector<Tp, N, Allocator, GrowthPolicy>::__relocate(pointer first, pointer last, pointer to,
+																kerbal::type_traits::true_type) KERBAL_NOEXCEPT
+		{
+			if (first != last) {
+				std::memcpy(static_cast<void*>(to), static_cast<const void*>(first),
+							static_cast<size_type>(last - first) * sizeof(value_type));
+			}
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		void small_vector<Tp, N, Allocator, GrowthPolicy>::resize(size_type new_size)
+		{
+			if (new_size < this->len) {
+				this->__shrink_back_to(new_size);
+			} else {
+				this->__value_init_append(new_size - this->len);
+			}
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		void small_vector<Tp, N, Allocator, GrowthPolicy>::resize(size_type new_size, const_reference val)
+		{
+			if (new_size < this->len) {
+				this->__shrink_back_to(new_size);
+			} else {
+				this->__fill_append(new_size - this->len, val);
+			}
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		void small_vector<Tp, N, Allocator, GrowthPolicy>::resize_default_init(size_type new_size)
+		{
+			if (new_size < this->len) {
+				this->__shrink_back_to(new_size);
+			} else {
+				this->__default_init_append(new_size - this->len,
+						kerbal::type_traits::bool_constant<
+								kerbal::container::detail::vector_trivially_default_constructible<value_type>::value
+						>());
+			}
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		void small_vector<Tp, N, Allocator, GrowthPolicy>::resize_uninitialized(size_type new_size)
+		{
+			KERBAL_STATIC_ASSERT(kerbal::container::detail::vector_trivially_default_constructible<value_type>::value,
+								"resize_uninitialized is only available for the trivial types");
+			if (new_size < this->len) {
+				this->__shrink_back_to(new_size);
+			} else {
+				this->__grow_to(new_size);
+				this->len = new_size;
+			}
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		void small_vector<Tp, N, Allocator, GrowthPolicy>::__value_init_append(size_type n)
+		{
+			if (n == 0) {
+				return;
+			}
+			this->__grow_to(this->len + n);
+#	if __cpp_exceptions
+			size_type old_size = this->len;
+			try {
+#	endif // __cpp_exceptions
+				while (n != 0) {
+					allocator_traits::construct(this->alloc(), this->m_buffer + this->len);
+					++this->len;
+					--n;
+				}
+#	if __cpp_exceptions
+			} catch (...) {
+				this->__shrink_back_to(old_size);
+				throw;
+			}
+#	endif // __cpp_exceptions
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		void small_vector<Tp, N, Allocator, GrowthPolicy>::__default_init_append(size_type n, kerbal::type_traits::false_type)
+		{
+			if (n == 0) {
+				return;
+			}
+			this->__grow_to(this->len + n);
+#	if __cpp_exceptions
+			size_type old_size = this->len;
+			try {
+#	endif // __cpp_exceptions
+				while (n != 0) {
+					::new (static_cast<void*>(this->m_buffer + this->len)) value_type;
+					++this->len;
+					--n;
+				}
+#	if __cpp_exceptions
+			} catch (...) {
+				this->__shrink_back_to(old_size);
+				throw;
+			}
+#	endif // __cpp_exceptions
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		void small_vector<Tp, N, Allocator, GrowthPolicy>::__default_init_append(size_type n, kerbal::type_traits::true_type)
+																									KERBAL_NOEXCEPT
+		{
+			// default-initialization of a trivial type does nothing
+			this->__grow_to(this->len + n);
+			this->len += n;
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		void small_vector<Tp, N, Allocator, GrowthPolicy>::__fill_append(size_type n, const_reference val)
+		{
+			if (n == 0) {
+				return;
+			}
+			const_pointer pval = &val;
+			if (this->len + n > this->m_capacity) {
+				// val may refer to an element of the small_vector itself
+				if (this->m_buffer <= pval && pval < this->m_buffer + this->len) {
+					size_type index = pval - this->m_buffer;
+					this->__grow_to(this->len + n);
+					pval = this->m_buffer + index;
+				} else {
+					this->__grow_to(this->len + n);
+				}
+			}
+#	if __cpp_exceptions
+			size_type old_size = this->len;
+			try {
+#	endif // __cpp_exceptions
+				while (n != 0) {
+					allocator_traits::construct(this->alloc(), this->m_buffer + this->len, *pval);
+					++this->len;
+					--n;
+				}
+#	if __cpp_exceptions
+			} catch (...) {
+				this->__shrink_back_to(old_size);
+				throw;
+			}
+#	endif // __cpp_exceptions
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		template <typename InputIterator>
+		void small_vector<Tp, N, Allocator, GrowthPolicy>::__range_append(InputIterator first, InputIterator last,
+																	std::input_iterator_tag)
+		{
+#	if __cpp_exceptions
+			size_type old_size = this->len;
+			try {
+#	endif // __cpp_exceptions
+				while (first != last) {
+					this->emplace_back(*first);
+					++first;
+				}
+#	if __cpp_exceptions
+			} catch (...) {
+				this->__shrink_back_to(old_size);
+				throw;
+			}
+#	endif // __cpp_exceptions
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		template <typename ForwardIterator>
+		void small_vector<Tp, N, Allocator, GrowthPolicy>::__range_append(ForwardIterator first, ForwardIterator last,
+																	std::forward_iterator_tag)
+		{
+			this->__grow_to(this->len + static_cast<size_type>(kerbal::iterator::distance(first, last)));
+#	if __cpp_exceptions
+			size_type old_size = this->len;
+			try {
+#	endif // __cpp_exceptions
+				while (first != last) {
+					allocator_traits::construct(this->alloc(), this->m_buffer + this->len, *first);
+					++this->len;
+					++first;
+				}
+#	if __cpp_exceptions
+			} catch (...) {
+				this->__shrink_back_to(old_size);
+				throw;
+			}
+#	endif // __cpp_exceptions
+		}
+
+		//===================
+		//insert
+
+		/*
+		 * new_buffer[index] has been constructed, relocates the elements around it and replaces the buffer.
+		 * If an exception is thrown, new_buffer is released and the small_vector is left untouched.
+		 */
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		void small_vector<Tp, N, Allocator, GrowthPolicy>::__emplace_realloc_commit(pointer new_buffer, size_type new_cap,
+																			size_type index)
+		{
+			pointer old_pos = this->m_buffer + index;
+			pointer old_end = this->m_buffer + this->len;
+#	if __cpp_exceptions
+			try {
+#	endif // __cpp_exceptions
+				this->__relocate(this->m_buffer, old_pos, new_buffer, TRIVIALLY_RELOCATABLE());
+#	if __cpp_exceptions
+				try {
+#	endif // __cpp_exceptions
+					this->__relocate(old_pos, old_end, new_buffer + index + 1, TRIVIALLY_RELOCATABLE());
+#	if __cpp_exceptions
+				} catch (...) {
+					this->__destroy(new_buffer, new_buffer + index);
+					throw;
+				}
+			} catch (...) {
+				this->__destroy(new_buffer + index, new_buffer + index + 1);
+				allocator_traits::deallocate(this->alloc(), new_buffer, new_cap);
+				throw;
+			}
+#	endif // __cpp_exceptions
+			this->__destroy_relocated(this->m_buffer, old_end);
+			this->__deallocate_heap();
+			this->m_buffer = new_buffer;
+			this->m_capacity = new_cap;
+			++this->len;
+		}
+
+#	if __cplusplus >= 201103L
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		template <typename ... Args>
+		typename small_vector<Tp, N, Allocator, GrowthPolicy>::iterator
+		small_vector<Tp, N, Allocator, GrowthPolicy>::__emplace_realloc(size_type index, Args&& ...args)
+		{
+			size_type new_cap = this->__next_capacity(this->len + 1);
+			pointer new_buffer = allocator_traits::allocate(this->alloc(), new_cap);
+			// constructed before the relocation, so args may refer to the elements
+#		if __cpp_exceptions
+			try {
+#		endif // __cpp_exceptions
+				allocator_traits::construct(this->alloc(), new_buffer + index, std::forward<Args>(args)...);
+#		if __cpp_exceptions
+			} catch (...) {
+				allocator_traits::deallocate(this->alloc(), new_buffer, new_cap);
+				throw;
+			}
+#		endif // __cpp_exceptions
+			this->__emplace_realloc_commit(new_buffer, new_cap, index);
+			return this->m_buffer + index;
+		}
+
+#	else
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		typename small_vector<Tp, N, Allocator, GrowthPolicy>::iterator
+		small_vector<Tp, N, Allocator, GrowthPolicy>::__emplace_realloc(size_type index, const_reference val)
+		{
+			size_type new_cap = this->__next_capacity(this->len + 1);
+			pointer new_buffer = allocator_traits::allocate(this->alloc(), new_cap);
+#		if __cpp_exceptions
+			try {
+#		endif // __cpp_exceptions
+				allocator_traits::construct(this->alloc(), new_buffer + index, val);
+#		if __cpp_exceptions
+			} catch (...) {
+				allocator_traits::deallocate(this->alloc(), new_buffer, new_cap);
+				throw;
+			}
+#		endif // __cpp_exceptions
+			this->__emplace_realloc_commit(new_buffer, new_cap, index);
+			return this->m_buffer + index;
+		}
+
+#	endif
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		void small_vector<Tp, N, Allocator, GrowthPolicy>::push_back(const_reference src)
+		{
+			this->emplace_back(src);
+		}
+
+#	if __cplusplus >= 201103L
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		void small_vector<Tp, N, Allocator, GrowthPolicy>::push_back(rvalue_reference src)
+		{
+			this->emplace_back(kerbal::compatibility::move(src));
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		template <typename ... Args>
+		typename small_vector<Tp, N, Allocator, GrowthPolicy>::reference
+		small_vector<Tp, N, Allocator, GrowthPolicy>::emplace_back(Args&& ...args)
+		{
+			if (this->len == this->m_capacity) {
+				return *this->__emplace_realloc(this->len, std::forward<Args>(args)...);
+			}
+			allocator_traits::construct(this->alloc(), this->m_buffer + this->len, std::forward<Args>(args)...);
+			++this->len;
+			return this->back();
+		}
+
+#	else
+
+#		define __emplace_back_body(args, realloc_arg) \
+			if (this->len == this->m_capacity) { \
+				return *this->__emplace_realloc(this->len, realloc_arg); \
+			} \
+			allocator_traits::construct args; \
+			++this->len; \
+			return this->back();
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		typename small_vector<Tp, N, Allocator, GrowthPolicy>::reference
+		small_vector<Tp, N, Allocator, GrowthPolicy>::emplace_back()
+		{
+			__emplace_back_body((this->alloc(), this->m_buffer + this->len), value_type())
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		template <typename Arg0>
+		typename small_vector<Tp, N, Allocator, GrowthPolicy>::reference
+		small_vector<Tp, N, Allocator, GrowthPolicy>::emplace_back(const Arg0& arg0)
+		{
+			__emplace_back_body((this->alloc(), this->m_buffer + this->len, arg0), value_type(arg0))
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		template <typename Arg0, typename Arg1>
+		typename small_vector<Tp, N, Allocator, GrowthPolicy>::reference
+		small_vector<Tp, N, Allocator, GrowthPolicy>::emplace_back(const Arg0& arg0, const Arg1& arg1)
+		{
+			__emplace_back_body((this->alloc(), this->m_buffer + this->len, arg0, arg1), value_type(arg0, arg1))
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		template <typename Arg0, typename Arg1, typename Arg2>
+		typename small_vector<Tp, N, Allocator, GrowthPolicy>::reference
+		small_vector<Tp, N, Allocator, GrowthPolicy>::emplace_back(const Arg0& arg0, const Arg1& arg1, const Arg2& arg2)
+		{
+			__emplace_back_body((this->alloc(), this->m_buffer + this->len, arg0, arg1, arg2), value_type(arg0, arg1, arg2))
+		}
+
+#		undef __emplace_back_body
+
+#	endif
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		void small_vector<Tp, N, Allocator, GrowthPolicy>::pop_back() KERBAL_NOEXCEPT
+		{
+			this->__shrink_back_to(this->len - 1);
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		void small_vector<Tp, N, Allocator, GrowthPolicy>::__shrink_back_to(size_type new_size) KERBAL_NOEXCEPT
+		{
+			this->__destroy(this->m_buffer + new_size, this->m_buffer + this->len);
+			this->len = new_size;
+		}
+
+#	if __cplusplus >= 201103L
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		template <typename ... Args>
+		typename small_vector<Tp, N, Allocator, GrowthPolicy>::iterator
+		small_vector<Tp, N, Allocator, GrowthPolicy>::emplace(const_iterator pos, Args&& ...args)
+		{
+			size_type index = this->index_of(pos);
+			if (this->len == this->m_capacity) {
+				return this->__emplace_realloc(index, std::forward<Args>(args)...);
+			}
+			if (index == this->len) {
+				allocator_traits::construct(this->alloc(), this->m_buffer + this->len, std::forward<Args>(args)...);
+				++this->len;
+				return this->m_buffer + index;
+			}
+			// args may refer to the elements which are going to be shifted
+			value_type tmp(std::forward<Args>(args)...);
+			pointer old_end = this->m_buffer + this->len;
+			allocator_traits::construct(this->alloc(), old_end, kerbal::compatibility::move(*(old_end - 1)));
+			++this->len;
+			kerbal::algorithm::move_backward(this->m_buffer + index, old_end - 1, old_end);
+			this->m_buffer[index] = kerbal::compatibility::move(tmp);
+			return this->m_buffer + index;
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		typename small_vector<Tp, N, Allocator, GrowthPolicy>::iterator
+		small_vector<Tp, N, Allocator, GrowthPolicy>::insert(const_iterator pos, const_reference val)
+		{
+			return this->emplace(pos, val);
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		typename small_vector<Tp, N, Allocator, GrowthPolicy>::iterator
+		small_vector<Tp, N, Allocator, GrowthPolicy>::insert(const_iterator pos, rvalue_reference val)
+		{
+			return this->emplace(pos, kerbal::compatibility::move(val));
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		typename small_vector<Tp, N, Allocator, GrowthPolicy>::iterator
+		small_vector<Tp, N, Allocator, GrowthPolicy>::insert(const_iterator pos, std::initializer_list<value_type> ilist)
+		{
+			return this->insert(pos, ilist.begin(), ilist.end());
+		}
+
+#	else
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		typename small_vector<Tp, N, Allocator, GrowthPolicy>::iterator
+		small_vector<Tp, N, Allocator, GrowthPolicy>::insert(const_iterator pos, const_reference val)
+		{
+			size_type index = this->index_of(pos);
+			if (this->len == this->m_capacity) {
+				return this->__emplace_realloc(index, val);
+			}
+			if (index == this->len) {
+				allocator_traits::construct(this->alloc(), this->m_buffer + this->len, val);
+				++this->len;
+				return this->m_buffer + index;
+			}
+			// val may refer to the elements which are going to be shifted
+			value_type tmp(val);
+			pointer old_end = this->m_buffer + this->len;
+			allocator_traits::construct(this->alloc(), old_end, *(old_end - 1));
+			++this->len;
+			kerbal::algorithm::copy_backward(this->m_buffer + index, old_end - 1, old_end);
+			this->m_buffer[index] = tmp;
+			return this->m_buffer + index;
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		typename small_vector<Tp, N, Allocator, GrowthPolicy>::iterator
+		small_vector<Tp, N, Allocator, GrowthPolicy>::emplace(const_iterator pos)
+		{
+			return this->insert(pos, value_type());
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		template <typename Arg0>
+		typename small_vector<Tp, N, Allocator, GrowthPolicy>::iterator
+		small_vector<Tp, N, Allocator, GrowthPolicy>::emplace(const_iterator pos, const Arg0& arg0)
+		{
+			return this->insert(pos, value_type(arg0));
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		template <typename Arg0, typename Arg1>
+		typename small_vector<Tp, N, Allocator, GrowthPolicy>::iterator
+		small_vector<Tp, N, Allocator, GrowthPolicy>::emplace(const_iterator pos, const Arg0& arg0, const Arg1& arg1)
+		{
+			return this->insert(pos, value_type(arg0, arg1));
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		template <typename Arg0, typename Arg1, typename Arg2>
+		typename small_vector<Tp, N, Allocator, GrowthPolicy>::iterator
+		small_vector<Tp, N, Allocator, GrowthPolicy>::emplace(const_iterator pos, const Arg0& arg0, const Arg1& arg1, const Arg2& arg2)
+		{
+			return this->insert(pos, value_type(arg0, arg1, arg2));
+		}
+
+#	endif
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		typename small_vector<Tp, N, Allocator, GrowthPolicy>::iterator
+		small_vector<Tp, N, Allocator, GrowthPolicy>::insert(const_iterator pos, size_type n, const_reference val)
+		{
+			size_type index = this->index_of(pos);
+			size_type old_size = this->len;
+			this->__fill_append(n, val);
+			iterator first(this->begin());
+			kerbal::algorithm::rotate(first + index, first + old_size, this->end());
+			return first + index;
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		template <typename InputIterator>
+		typename kerbal::type_traits::enable_if<
+				kerbal::iterator::is_input_compatible_iterator<InputIterator>::value,
+				typename small_vector<Tp, N, Allocator, GrowthPolicy>::iterator
+		>::type
+		small_vector<Tp, N, Allocator, GrowthPolicy>::insert(const_iterator pos, InputIterator first, InputIterator last)
+		{
+			size_type index = this->index_of(pos);
+			size_type old_size = this->len;
+			this->__range_append(first, last, kerbal::iterator::iterator_category(first));
+			iterator b(this->begin());
+			kerbal::algorithm::rotate(b + index, b + old_size, this->end());
+			return b + index;
+		}
+
+		//===================
+		//erase
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		typename small_vector<Tp, N, Allocator, GrowthPolicy>::iterator
+		small_vector<Tp, N, Allocator, GrowthPolicy>::erase(const_iterator pos)
+		{
+			size_type index = this->index_of(pos);
+			iterator pos_mut(this->begin() + index);
+			kerbal::algorithm::move(pos_mut + 1, this->end(), pos_mut);
+			this->pop_back();
+			return pos_mut;
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		typename small_vector<Tp, N, Allocator, GrowthPolicy>::iterator
+		small_vector<Tp, N, Allocator, GrowthPolicy>::erase(const_iterator first, const_iterator last)
+		{
+			iterator first_mut(this->begin() + this->index_of(first));
+			if (first != last) {
+				iterator last_mut(this->begin() + this->index_of(last));
+				iterator new_end(kerbal::algorithm::move(last_mut, this->end(), first_mut));
+				this->__shrink_back_to(new_end - this->begin());
+			}
+			return first_mut;
+		}
+
+		// pre-condition: the heap buffer is in use and size() <= N
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		void small_vector<Tp, N, Allocator, GrowthPolicy>::__move_to_inline()
+		{
+			pointer heap = this->m_buffer;
+			this->__relocate(heap, heap + this->len, this->__inline_buffer(), TRIVIALLY_RELOCATABLE());
+			this->__destroy_relocated(heap, heap + this->len);
+			this->__deallocate_heap();
+		}
+
+		/*
+		 * Takes over the elements of src, src is left empty. The heap buffer of src is taken as it is, the inline
+		 * elements are relocated one by one.
+		 * pre-condition: this->empty() && the allocators are equal
+		 */
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		void small_vector<Tp, N, Allocator, GrowthPolicy>::__steal(small_vector & src)
+		{
+			if (src.__is_spilled()) {
+				this->__deallocate_heap();
+				this->m_buffer = src.m_buffer;
+				this->m_capacity = src.m_capacity;
+				this->len = src.len;
+				src.m_buffer = src.__inline_buffer();
+				src.m_capacity = N;
+				src.len = 0;
+				return;
+			}
+			// the capacity is never less than N
+			this->__relocate(src.m_buffer, src.m_buffer + src.len, this->m_buffer, TRIVIALLY_RELOCATABLE());
+			this->len = src.len;
+			src.__destroy_relocated(src.m_buffer, src.m_buffer + src.len);
+			src.len = 0;
+		}
+
+		//===================
+		//operation
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		void small_vector<Tp, N, Allocator, GrowthPolicy>::swap(small_vector & with)
+		{
+			if (this->__is_spilled() && with.__is_spilled()) {
+				kerbal::algorithm::swap(this->alloc(), with.alloc());
+				kerbal::algorithm::swap(this->m_buffer, with.m_buffer);
+				kerbal::algorithm::swap(this->len, with.len);
+				kerbal::algorithm::swap(this->m_capacity, with.m_capacity);
+				return;
+			}
+			small_vector tmp(this->alloc());
+			tmp.__steal(*this);
+			this->__steal(with);
+			with.__steal(tmp);
+			kerbal::algorithm::swap(this->alloc(), with.alloc());
+		}
+
+		template <typename Tp, std::size_t N, typename Allocator, typename GrowthPolicy>
+		void small_vector<Tp, N, Allocator, GrowthPolicy>::clear() KERBAL_NOEXCEPT
+		{
+			this->__shrink_back_to(0);
+		}
+
+	} // namespace container
+
+} // namespace kerbal
+
+#endif // KERBAL_CONTAINER_IMPL_SMALL_VECTOR_IMPL_HPP
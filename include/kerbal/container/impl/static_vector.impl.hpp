@@ -14,6 +14,7 @@
 
 #include <kerbal/algorithm/modifier.hpp>
 #include <kerbal/algorithm/swap.hpp>
+#include <kerbal/compatibility/is_constant_evaluated.hpp>
 #include <kerbal/compatibility/move.hpp>
 #include <kerbal/iterator/iterator.hpp>
 #include <kerbal/operators/generic_assign.hpp>
@@ -22,6 +23,7 @@
 #include <kerbal/type_traits/integral_constant.hpp>
 #include <kerbal/utility/throw_this_exception.hpp>
 
+#include <cstring>
 #include <stdexcept>
 #include <utility> // std::forward
 
@@ -33,6 +35,7 @@
 #endif
 
 #include <kerbal/container/static_vector.hpp>
+#include <kerbal/container/detail/trivially_relocate.hpp>
 
 namespace kerbal
 {
@@ -727,6 +730,13 @@ namespace kerbal
 				// A A A O O O
 				//          ^
 				this->push_back(val); // copy construct
+			} else if (TRIVIALLY_RELOCATABLE::value && KERBAL_CONSTEXPR14_RUNTIME_PATH()) {
+				// A A A X Y Z V O O
+				//          ^
+				this->push_back(val); // copy construct, val may refer to an element
+				// A A A V X Y Z O O
+				//          ^
+				this->__relocate_back_to(mutable_pos); // memmove
 			} else {
 				// *this couldn't be empty otherwise the argument pos is invalid
 
@@ -771,6 +781,9 @@ namespace kerbal
 				// A A A O O O
 				//          ^
 				this->emplace_back(std::forward<Args>(args)...); // construct by args
+			} else if (TRIVIALLY_RELOCATABLE::value && KERBAL_CONSTEXPR14_RUNTIME_PATH()) {
+				this->emplace_back(std::forward<Args>(args)...); // construct by args
+				this->__relocate_back_to(mutable_pos); // memmove
 			} else {
 				this->push_back(kerbal::compatibility::move(this->back())); // move construct
 				// A A A X Y Z Z O O
@@ -790,6 +803,9 @@ namespace kerbal
 			iterator mutable_pos(pos.cast_to_mutable()); \
 			if (pos == this->cend()) { \
 				this->emplace_back(args); \
+			} else if (TRIVIALLY_RELOCATABLE::value) { \
+				this->emplace_back(args); \
+				this->__relocate_back_to(mutable_pos); \
 			} else { \
 				this->push_back(kerbal::compatibility::to_xvalue(this->back())); \
 				kerbal::algorithm::move_backward(mutable_pos, this->end() - 2, this->end() - 1); \
@@ -845,6 +861,10 @@ namespace kerbal
 			}
 
 			// pre-condition: pos != cend()
+			if (TRIVIALLY_RELOCATABLE::value && KERBAL_CONSTEXPR14_RUNTIME_PATH()) {
+				return this->__erase_relocate(mutable_pos, mutable_pos + 1);
+			}
+
 			kerbal::algorithm::move(mutable_pos + 1, this->end(), mutable_pos);
 			this->pop_back();
 			return mutable_pos;
@@ -858,6 +878,10 @@ namespace kerbal
 			iterator mutable_first(first.cast_to_mutable());
 			iterator mutable_last(last.cast_to_mutable());
 
+			if (TRIVIALLY_RELOCATABLE::value && KERBAL_CONSTEXPR14_RUNTIME_PATH()) {
+				return this->__erase_relocate(mutable_first, mutable_last);
+			}
+
 			kerbal::algorithm::move(mutable_last, this->end(), mutable_first);
 
 			iterator new_end = this->end() - (mutable_last - mutable_first);
@@ -888,7 +912,9 @@ namespace kerbal
 		KERBAL_CONSTEXPR14
 		void static_vector<Tp, N>::swap(static_vector & with)
 		{
-			if (this->size() > with.size()) {
+			if (TRIVIALLY_RELOCATABLE::value && KERBAL_CONSTEXPR14_RUNTIME_PATH()) {
+				this->__swap_relocate(with);
+			} else if (this->size() > with.size()) {
 				with.swap_helper(*this);
 			} else {
 				this->swap_helper(with);
@@ -1014,6 +1040,51 @@ namespace kerbal
 			(itor.current)->destroy();
 		}
 
+		/*
+		 * The last element has just been appended, moves it to pos and the elements [pos, end - 1) one position
+		 * backward, all bitwise.
+		 */
+		template <typename Tp, size_t N>
+		void static_vector<Tp, N>::__relocate_back_to(iterator pos) KERBAL_NOEXCEPT
+		{
+			storage_type * first = pos.current;
+			storage_type * back = this->storage + (this->len - 1);
+			unsigned char buffer[sizeof(storage_type)];
+			std::memcpy(buffer, static_cast<const void*>(back), sizeof(storage_type));
+			std::memmove(static_cast<void*>(first + 1), static_cast<const void*>(first),
+						static_cast<size_type>(back - first) * sizeof(storage_type));
+			std::memcpy(static_cast<void*>(first), buffer, sizeof(storage_type));
+		}
+
+		template <typename Tp, size_t N>
+		typename static_vector<Tp, N>::iterator
+		static_vector<Tp, N>::__erase_relocate(iterator first, iterator last)
+		{
+			storage_type * const end = this->storage + this->len;
+			for (storage_type * it = first.current; it != last.current; ++it) {
+				it->destroy();
+			}
+			std::memmove(static_cast<void*>(first.current), static_cast<const void*>(last.current),
+						static_cast<size_type>(end - last.current) * sizeof(storage_type));
+			this->len -= static_cast<size_type>(last.current - first.current);
+			return first;
+		}
+
+		template <typename Tp, size_t N>
+		void static_vector<Tp, N>::__swap_relocate(static_vector & with) KERBAL_NOEXCEPT
+		{
+			if (this == &with) {
+				return;
+			}
+			size_type n = this->len < with.len ? with.len : this->len;
+			// the slots beyond the shorter one hold no object, exchanging their bytes does no harm
+			kerbal::container::detail::trivially_relocate_swap(
+					static_cast<void*>(this->storage), static_cast<void*>(with.storage), n * sizeof(storage_type));
+			size_type t = this->len;
+			this->len = with.len;
+			with.len = t;
+		}
+
 	} // namespace container
 
 } // namespace kerbal
@@ -0,0 +1,387 @@
+/**
+ * @file       indexed_priority_queue.hpp
+ * @brief
+ * @date       2020-11-10
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_CONTAINER_INDEXED_PRIORITY_QUEUE_HPP
+#define KERBAL_CONTAINER_INDEXED_PRIORITY_QUEUE_HPP
+
+#include <kerbal/algorithm/swap.hpp>
+#include <kerbal/compatibility/move.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/compatibility/static_assert.hpp>
+
+#include <cstddef>
+#include <functional>
+
+#include <kerbal/container/vector.hpp>
+
+namespace kerbal
+{
+
+	namespace container
+	{
+
+		/**
+		 * An addressable d-ary heap: push returns a handle to the element, through which the element can be read,
+		 * re-prioritized or erased while it is in the queue. Like static_priority_queue, top() is the greatest
+		 * element according to KeyCompare.
+		 *
+		 * increase_key moves an element towards the top and decrease_key away from it, both in O(log n). With
+		 * KeyCompare = std::greater<Tp> (top() is the smallest element, as in Dijkstra's algorithm), shortening a
+		 * distance is an increase_key. update() accepts a change in either direction.
+		 *
+		 * A handle is invalidated when its element leaves the queue (pop, erase, clear); its slot may then be
+		 * reused by a later push.
+		 */
+		template <typename Tp, typename KeyCompare = std::less<Tp>, std::size_t Arity = 2>
+		class indexed_priority_queue
+		{
+				KERBAL_STATIC_ASSERT(Arity >= 2, "the arity of a heap must be at least 2");
+
+			public:
+				typedef KeyCompare					value_compare;
+
+				typedef Tp							value_type;
+				typedef const value_type			const_type;
+				typedef value_type&					reference;
+				typedef const value_type&			const_reference;
+				typedef value_type*					pointer;
+				typedef const value_type*			const_pointer;
+
+#		if __cplusplus >= 201103L
+				typedef value_type&&				rvalue_reference;
+				typedef const value_type&&			const_rvalue_reference;
+#		endif
+
+				typedef std::size_t					size_type;
+				typedef std::ptrdiff_t				difference_type;
+
+				class handle_type
+				{
+					private:
+						friend class indexed_priority_queue;
+
+						size_type id;
+
+						explicit handle_type(size_type id) KERBAL_NOEXCEPT :
+								id(id)
+						{
+						}
+
+					public:
+						/**
+						 * A handle to no element, only meant to be assigned over.
+						 */
+						handle_type() KERBAL_NOEXCEPT :
+								id(static_cast<size_type>(-1))
+						{
+						}
+
+						friend bool operator==(const handle_type & lhs, const handle_type & rhs) KERBAL_NOEXCEPT
+						{
+							return lhs.id == rhs.id;
+						}
+
+						friend bool operator!=(const handle_type & lhs, const handle_type & rhs) KERBAL_NOEXCEPT
+						{
+							return lhs.id != rhs.id;
+						}
+				};
+
+			private:
+				struct entry
+				{
+						value_type value;
+						size_type id;
+
+						entry(const_reference value, size_type id) :
+								value(value), id(id)
+						{
+						}
+
+#		if __cplusplus >= 201103L
+
+						entry(rvalue_reference value, size_type id) :
+								value(kerbal::compatibility::move(value)), id(id)
+						{
+						}
+
+#		endif
+
+				};
+
+				static size_type npos() KERBAL_NOEXCEPT
+				{
+					return static_cast<size_type>(-1);
+				}
+
+				kerbal::container::vector<entry> m_heap;
+				kerbal::container::vector<size_type> m_pos;		// position in m_heap of the element of each id, npos if the id is free
+				kerbal::container::vector<size_type> m_free;	// the free ids; its capacity covers all the ids, so that freeing one never allocates
+				value_compare vc;
+
+			public:
+				indexed_priority_queue() :
+						m_heap(), m_pos(), m_free(), vc()
+				{
+				}
+
+				explicit indexed_priority_queue(value_compare kc) :
+						m_heap(), m_pos(), m_free(), vc(kc)
+				{
+				}
+
+				bool empty() const KERBAL_NOEXCEPT
+				{
+					return m_heap.empty();
+				}
+
+				size_type size() const KERBAL_NOEXCEPT
+				{
+					return m_heap.size();
+				}
+
+				const_reference top() const
+				{
+					return m_heap.front().value;
+				}
+
+				handle_type top_handle() const
+				{
+					return handle_type(m_heap.front().id);
+				}
+
+				/**
+				 * @return whether the element of h is in the queue
+				 */
+				bool contains(handle_type h) const KERBAL_NOEXCEPT
+				{
+					return h.id < m_pos.size() && m_pos[h.id] != npos();
+				}
+
+				/**
+				 * @pre contains(h)
+				 */
+				const_reference value(handle_type h) const
+				{
+					return m_heap[m_pos[h.id]].value;
+				}
+
+				handle_type push(const_reference val)
+				{
+					size_type id(this->__prepare_id());
+#		if __cpp_exceptions
+					try {
+#		endif
+						m_heap.push_back(entry(val, id));
+#		if __cpp_exceptions
+					} catch (...) {
+						this->__cancel_id(id);
+						throw;
+					}
+#		endif
+					return this->__commit_id(id);
+				}
+
+#		if __cplusplus >= 201103L
+
+				handle_type push(rvalue_reference val)
+				{
+					size_type id(this->__prepare_id());
+#			if __cpp_exceptions
+					try {
+#			endif
+						m_heap.push_back(entry(kerbal::compatibility::move(val), id));
+#			if __cpp_exceptions
+					} catch (...) {
+						this->__cancel_id(id);
+						throw;
+					}
+#			endif
+					return this->__commit_id(id);
+				}
+
+#		endif
+
+				void pop()
+				{
+					this->__erase_at(0);
+				}
+
+				/**
+				 * @pre contains(h)
+				 */
+				void erase(handle_type h)
+				{
+					this->__erase_at(m_pos[h.id]);
+				}
+
+				/**
+				 * Replaces the element of h by val, which must not compare less than it.
+				 * @pre contains(h)
+				 */
+				void increase_key(handle_type h, const_reference val)
+				{
+					size_type i = m_pos[h.id];
+					m_heap[i].value = val;
+					this->__adjust_up(i);
+				}
+
+				/**
+				 * Replaces the element of h by val, which must not compare greater than it.
+				 * @pre contains(h)
+				 */
+				void decrease_key(handle_type h, const_reference val)
+				{
+					size_type i = m_pos[h.id];
+					m_heap[i].value = val;
+					this->__adjust_down(i);
+				}
+
+				/**
+				 * Replaces the element of h by val.
+				 * @pre contains(h)
+				 */
+				void update(handle_type h, const_reference val)
+				{
+					size_type i = m_pos[h.id];
+					m_heap[i].value = val;
+					if (this->__adjust_up(i) == i) {
+						this->__adjust_down(i);
+					}
+				}
+
+				void clear() KERBAL_NOEXCEPT
+				{
+					m_heap.clear();
+					m_pos.clear();
+					m_free.clear();
+				}
+
+				void swap(indexed_priority_queue & with)
+				{
+					m_heap.swap(with.m_heap);
+					m_pos.swap(with.m_pos);
+					m_free.swap(with.m_free);
+					kerbal::algorithm::swap(this->vc, with.vc);
+				}
+
+				value_compare value_comp() const
+				{
+					return this->vc;
+				}
+
+			private:
+				// reserves an id for the element about to be pushed, without taking it yet
+				size_type __prepare_id()
+				{
+					if (!m_free.empty()) {
+						return m_free.back();
+					}
+					size_type id = m_pos.size();
+					m_pos.push_back(npos());
+#		if __cpp_exceptions
+					try {
+#		endif
+						m_free.reserve(m_pos.size());
+#		if __cpp_exceptions
+					} catch (...) {
+						m_pos.pop_back();
+						throw;
+					}
+#		endif
+					return id;
+				}
+
+				void __cancel_id(size_type /*id*/) KERBAL_NOEXCEPT
+				{
+					if (m_free.empty()) { // a new id
+						m_pos.pop_back();
+					}
+				}
+
+				handle_type __commit_id(size_type id)
+				{
+					if (!m_free.empty()) { // a reused id, it is m_free.back()
+						m_free.pop_back();
+					}
+					size_type i = m_heap.size() - 1;
+					m_pos[id] = i;
+					this->__adjust_up(i);
+					return handle_type(id);
+				}
+
+				void __swap_entries(size_type i, size_type j)
+				{
+					kerbal::algorithm::swap(m_heap[i], m_heap[j]);
+					m_pos[m_heap[i].id] = i;
+					m_pos[m_heap[j].id] = j;
+				}
+
+				// @return the final position of the element
+				size_type __adjust_up(size_type i)
+				{
+					while (i > 0) {
+						size_type parent = (i - 1) / Arity;
+						if (vc(m_heap[parent].value, m_heap[i].value)) { // parent < current
+							this->__swap_entries(parent, i);
+							i = parent;
+						} else {
+							break;
+						}
+					}
+					return i;
+				}
+
+				void __adjust_down(size_type i)
+				{
+					size_type len = m_heap.size();
+					while (i < (len + Arity - 2) / Arity) { // i has a son
+						size_type son = i * Arity + 1;
+						size_type sons_end = len - son > Arity ? son + Arity : len;
+						size_type max_one = son;
+						for (++son; son < sons_end; ++son) {
+							if (vc(m_heap[max_one].value, m_heap[son].value)) {
+								max_one = son;
+							}
+						}
+						if (vc(m_heap[i].value, m_heap[max_one].value)) { // current < max_one
+							this->__swap_entries(i, max_one);
+							i = max_one;
+						} else {
+							break;
+						}
+					}
+				}
+
+				void __erase_at(size_type i)
+				{
+					size_type back = m_heap.size() - 1;
+					if (i != back) {
+						this->__swap_entries(i, back);
+					}
+					size_type id = m_heap.back().id;
+					m_pos[id] = npos();
+					m_free.push_back(id); // never allocates, see m_free
+					m_heap.pop_back();
+					if (i != back) {
+						if (this->__adjust_up(i) == i) {
+							this->__adjust_down(i);
+						}
+					}
+				}
+
+		};
+
+	} // namespace container
+
+} // namespace kerbal
+
+#endif // KERBAL_CONTAINER_INDEXED_PRIORITY_QUEUE_HPP
@@ -0,0 +1,527 @@
+/**
+ * @file       pairing_heap.hpp
+ * @brief
+ * @date       2020-11-10
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_CONTAINER_PAIRING_HEAP_HPP
+#define KERBAL_CONTAINER_PAIRING_HEAP_HPP
+
+#include <kerbal/container/fwd/pairing_heap.fwd.hpp>
+
+#include <kerbal/algorithm/swap.hpp>
+#include <kerbal/compatibility/move.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/memory/allocator_traits.hpp>
+#include <kerbal/utility/in_place.hpp>
+#include <kerbal/utility/member_compress_helper.hpp>
+#include <kerbal/utility/noncopyable.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+#if __cplusplus >= 201103L
+#	include <utility> // forward
+#endif
+
+#include <kerbal/container/detail/pairing_heap_node.hpp>
+
+namespace kerbal
+{
+
+	namespace container
+	{
+
+		/**
+		 * An addressable pairing heap. Like static_priority_queue, top() is the greatest element according to
+		 * KeyCompare. push, top, merge and increase_key are O(1), pop, erase and decrease_key are O(log n)
+		 * amortized.
+		 *
+		 * Each element lives in its own node, so the handle returned by push stays valid until the element is
+		 * popped or erased, even across merge (the handles of the merged heap then belong to this one).
+		 * increase_key moves an element towards the top and decrease_key away from it; with
+		 * KeyCompare = std::greater<Tp>, shortening a distance in Dijkstra's algorithm is an increase_key.
+		 */
+		template <typename Tp, typename KeyCompare = std::less<Tp>, typename Allocator = std::allocator<Tp> >
+		class pairing_heap:
+				private kerbal::utility::noncopyable,
+				private kerbal::utility::member_compress_helper<
+						typename kerbal::memory::allocator_traits<Allocator>::template
+								rebind_alloc<kerbal::container::detail::pairing_heap_node<Tp> >::other
+				>
+		{
+			private:
+				typedef kerbal::container::detail::list_node_base				node_base;
+				typedef kerbal::container::detail::pairing_heap_node<Tp>		node;
+
+				typedef kerbal::memory::allocator_traits<Allocator>								tp_allocator_traits;
+				typedef typename tp_allocator_traits::template rebind_alloc<node>::other		node_allocator_type;
+				typedef typename tp_allocator_traits::template rebind_traits<node>::other		node_allocator_traits;
+				typedef kerbal::utility::member_compress_helper<node_allocator_type>			node_allocator_compress_helper;
+
+			public:
+				typedef KeyCompare					value_compare;
+				typedef Allocator					allocator_type;
+
+				typedef Tp							value_type;
+				typedef const value_type			const_type;
+				typedef value_type&					reference;
+				typedef const value_type&			const_reference;
+				typedef value_type*					pointer;
+				typedef const value_type*			const_pointer;
+
+#		if __cplusplus >= 201103L
+				typedef value_type&&				rvalue_reference;
+				typedef const value_type&&			const_rvalue_reference;
+#		endif
+
+				typedef std::size_t					size_type;
+				typedef std::ptrdiff_t				difference_type;
+
+				class handle_type
+				{
+					private:
+						friend class pairing_heap;
+
+						node * p;
+
+						explicit handle_type(node * p) KERBAL_NOEXCEPT :
+								p(p)
+						{
+						}
+
+					public:
+						/**
+						 * A handle to no element, only meant to be assigned over.
+						 */
+						handle_type() KERBAL_NOEXCEPT :
+								p(NULL)
+						{
+						}
+
+						friend bool operator==(const handle_type & lhs, const handle_type & rhs) KERBAL_NOEXCEPT
+						{
+							return lhs.p == rhs.p;
+						}
+
+						friend bool operator!=(const handle_type & lhs, const handle_type & rhs) KERBAL_NOEXCEPT
+						{
+							return lhs.p != rhs.p;
+						}
+				};
+
+			private:
+				node * m_root;
+				size_type m_size;
+				value_compare vc;
+
+			public:
+				pairing_heap() :
+						node_allocator_compress_helper(kerbal::utility::in_place_t()),
+						m_root(NULL), m_size(0), vc()
+				{
+				}
+
+				explicit pairing_heap(value_compare kc) :
+						node_allocator_compress_helper(kerbal::utility::in_place_t()),
+						m_root(NULL), m_size(0), vc(kc)
+				{
+				}
+
+				pairing_heap(value_compare kc, const Allocator & alloc) :
+						node_allocator_compress_helper(kerbal::utility::in_place_t(), alloc),
+						m_root(NULL), m_size(0), vc(kc)
+				{
+				}
+
+				~pairing_heap()
+				{
+					this->clear();
+				}
+
+				bool empty() const KERBAL_NOEXCEPT
+				{
+					return m_root == NULL;
+				}
+
+				size_type size() const KERBAL_NOEXCEPT
+				{
+					return m_size;
+				}
+
+				const_reference top() const KERBAL_NOEXCEPT
+				{
+					return m_root->value;
+				}
+
+				handle_type top_handle() const KERBAL_NOEXCEPT
+				{
+					return handle_type(m_root);
+				}
+
+				static const_reference value(handle_type h) KERBAL_NOEXCEPT
+				{
+					return h.p->value;
+				}
+
+				handle_type push(const_reference val)
+				{
+					return this->__push_node(this->__build_node(val));
+				}
+
+#		if __cplusplus >= 201103L
+
+				handle_type push(rvalue_reference val)
+				{
+					return this->__push_node(this->__build_node(kerbal::compatibility::move(val)));
+				}
+
+				template <typename ... Args>
+				handle_type emplace(Args&& ... args)
+				{
+					return this->__push_node(this->__build_node(std::forward<Args>(args)...));
+				}
+
+#		else
+
+				handle_type emplace()
+				{
+					return this->__push_node(this->__build_node());
+				}
+
+				template <typename Arg0>
+				handle_type emplace(const Arg0& arg0)
+				{
+					return this->__push_node(this->__build_node(arg0));
+				}
+
+				template <typename Arg0, typename Arg1>
+				handle_type emplace(const Arg0& arg0, const Arg1& arg1)
+				{
+					return this->__push_node(this->__build_node(arg0, arg1));
+				}
+
+				template <typename Arg0, typename Arg1, typename Arg2>
+				handle_type emplace(const Arg0& arg0, const Arg1& arg1, const Arg2& arg2)
+				{
+					return this->__push_node(this->__build_node(arg0, arg1, arg2));
+				}
+
+#		endif
+
+				void pop()
+				{
+					node * p = m_root;
+					m_root = this->__merge_pairs(p->child);
+					p->child = NULL;
+					--m_size;
+					this->__destroy_node(p);
+				}
+
+				/**
+				 * @pre h refers to an element of this heap
+				 */
+				void erase(handle_type h)
+				{
+					node * p = h.p;
+					if (p == m_root) {
+						this->pop();
+						return;
+					}
+					this->__cut(p);
+					m_root = this->__meld(m_root, this->__merge_pairs(p->child));
+					p->child = NULL;
+					--m_size;
+					this->__destroy_node(p);
+				}
+
+				/**
+				 * Replaces the element of h by val, which must not compare less than it.
+				 * @pre h refers to an element of this heap
+				 */
+				void increase_key(handle_type h, const_reference val)
+				{
+					node * p = h.p;
+					p->value = val;
+					if (p != m_root) {
+						this->__cut(p);
+						m_root = this->__meld(m_root, p);
+					}
+				}
+
+				/**
+				 * Replaces the element of h by val, which must not compare greater than it.
+				 * @pre h refers to an element of this heap
+				 */
+				void decrease_key(handle_type h, const_reference val)
+				{
+					node * p = h.p;
+					p->value = val;
+					node * sons = this->__merge_pairs(p->child);
+					p->child = NULL;
+					if (p == m_root) {
+						m_root = this->__meld(sons, p);
+					} else {
+						this->__cut(p);
+						m_root = this->__meld(this->__meld(m_root, sons), p);
+					}
+				}
+
+				/**
+				 * Replaces the element of h by val.
+				 * @pre h refers to an element of this heap
+				 */
+				void update(handle_type h, const_reference val)
+				{
+					if (vc(val, h.p->value)) { // val < old
+						this->decrease_key(h, val);
+					} else {
+						this->increase_key(h, val);
+					}
+				}
+
+				/**
+				 * Moves all the elements of other into this heap in O(1), without copying them.
+				 * If the comparison throws, neither heap is changed.
+				 * @pre the allocators of both heaps compare equal
+				 */
+				void merge(pairing_heap & other)
+				{
+					if (&other == this) {
+						return;
+					}
+					m_root = this->__meld(m_root, other.m_root);
+					m_size += other.m_size;
+					other.m_root = NULL;
+					other.m_size = 0;
+				}
+
+				void clear() KERBAL_NOEXCEPT
+				{
+					// the nodes left to destroy are chained through next, the sons of each one are spliced in
+					node_base * p = m_root;
+					while (p != NULL) {
+						node * n = static_cast<node *>(p);
+						node_base * next = n->next;
+						if (n->child != NULL) {
+							node_base * last_son = n->child;
+							while (last_son->next != NULL) {
+								last_son = last_son->next;
+							}
+							last_son->next = next;
+							next = n->child;
+						}
+						this->__destroy_node(n);
+						p = next;
+					}
+					m_root = NULL;
+					m_size = 0;
+				}
+
+				/**
+				 * @pre the allocators of both heaps compare equal
+				 */
+				void swap(pairing_heap & with) KERBAL_NOEXCEPT
+				{
+					kerbal::algorithm::swap(this->m_root, with.m_root);
+					kerbal::algorithm::swap(this->m_size, with.m_size);
+					kerbal::algorithm::swap(this->vc, with.vc);
+				}
+
+				value_compare value_comp() const
+				{
+					return this->vc;
+				}
+
+			private:
+				node_allocator_type & alloc() KERBAL_NOEXCEPT
+				{
+					return node_allocator_compress_helper::member();
+				}
+
+#		if __cplusplus >= 201103L
+
+				template <typename ... Args>
+				node * __build_node(Args&& ... args)
+				{
+					node * p = node_allocator_traits::allocate(this->alloc(), 1);
+#			if __cpp_exceptions
+					try {
+#			endif
+						node_allocator_traits::construct(this->alloc(), p, kerbal::utility::in_place_t(), std::forward<Args>(args)...);
+#			if __cpp_exceptions
+					} catch (...) {
+						node_allocator_traits::deallocate(this->alloc(), p, 1);
+						throw;
+					}
+#			endif
+					return p;
+				}
+
+#		else
+
+#			if __cpp_exceptions
+#				define __build_node_body(args...) \
+					{ \
+						node * p = node_allocator_traits::allocate(this->alloc(), 1); \
+						try { \
+							node_allocator_traits::construct(this->alloc(), p, args); \
+						} catch (...) { \
+							node_allocator_traits::deallocate(this->alloc(), p, 1); \
+							throw; \
+						} \
+						return p; \
+					}
+#			else
+#				define __build_node_body(args...) \
+					{ \
+						node * p = node_allocator_traits::allocate(this->alloc(), 1); \
+						node_allocator_traits::construct(this->alloc(), p, args); \
+						return p; \
+					}
+#			endif
+
+				node * __build_node()
+				{
+					__build_node_body(kerbal::utility::in_place_t());
+				}
+
+				template <typename Arg0>
+				node * __build_node(const Arg0& arg0)
+				{
+					__build_node_body(kerbal::utility::in_place_t(), arg0);
+				}
+
+				template <typename Arg0, typename Arg1>
+				node * __build_node(const Arg0& arg0, const Arg1& arg1)
+				{
+					__build_node_body(kerbal::utility::in_place_t(), arg0, arg1);
+				}
+
+				template <typename Arg0, typename Arg1, typename Arg2>
+				node * __build_node(const Arg0& arg0, const Arg1& arg1, const Arg2& arg2)
+				{
+					__build_node_body(kerbal::utility::in_place_t(), arg0, arg1, arg2);
+				}
+
+#			undef __build_node_body
+
+#		endif
+
+				void __destroy_node(node * p) KERBAL_NOEXCEPT
+				{
+					node_allocator_traits::destroy(this->alloc(), p);
+					node_allocator_traits::deallocate(this->alloc(), p, 1);
+				}
+
+				/*
+				 * Takes the ownership of p, which is destroyed if the comparison throws.
+				 */
+				handle_type __push_node(node * p)
+				{
+#			if __cpp_exceptions
+					try {
+#			endif
+						m_root = this->__meld(m_root, p);
+#			if __cpp_exceptions
+					} catch (...) {
+						this->__destroy_node(p);
+						throw;
+					}
+#			endif
+					++m_size;
+					return handle_type(p);
+				}
+
+				/*
+				 * Links two roots, the lesser one becomes the first son of the other.
+				 * pre: a and b have no father and no sibling
+				 */
+				node * __meld(node * a, node * b) const
+				{
+					if (a == NULL) {
+						return b;
+					}
+					if (b == NULL) {
+						return a;
+					}
+					if (vc(a->value, b->value)) { // a < b
+						kerbal::algorithm::swap(a, b);
+					}
+					b->next = a->child;
+					if (a->child != NULL) {
+						a->child->prev = b;
+					}
+					b->prev = a;
+					a->child = b;
+					return a;
+				}
+
+				// detaches the subtree of p, which is not the root
+				static void __cut(node * p) KERBAL_NOEXCEPT
+				{
+					node * prev = static_cast<node *>(p->prev);
+					if (prev->child == p) { // p is the first son of prev
+						prev->child = p->next;
+					} else {
+						prev->next = p->next;
+					}
+					if (p->next != NULL) {
+						p->next->prev = prev;
+					}
+					p->prev = NULL;
+					p->next = NULL;
+				}
+
+				/*
+				 * The two-pass pairing of the sons of a removed node: melds them by pairs from left to right, then
+				 * melds the pairs from right to left. The pairs are stacked through prev in between.
+				 */
+				node * __merge_pairs(node_base * first) const
+				{
+					node * pairs = NULL;
+					while (first != NULL) {
+						node * a = static_cast<node *>(first);
+						node * b = static_cast<node *>(a->next);
+						a->prev = NULL;
+						a->next = NULL;
+						if (b == NULL) {
+							a->prev = pairs;
+							pairs = a;
+							break;
+						}
+						first = b->next;
+						b->prev = NULL;
+						b->next = NULL;
+						node * m = this->__meld(a, b);
+						m->prev = pairs;
+						pairs = m;
+					}
+					if (pairs == NULL) {
+						return NULL;
+					}
+					node * root = pairs;
+					pairs = static_cast<node *>(root->prev);
+					root->prev = NULL;
+					while (pairs != NULL) {
+						node * m = pairs;
+						pairs = static_cast<node *>(m->prev);
+						m->prev = NULL;
+						root = this->__meld(root, m);
+					}
+					return root;
+				}
+
+		};
+
+	} // namespace container
+
+} // namespace kerbal
+
+#endif // KERBAL_CONTAINER_PAIRING_HEAP_HPP
@@ -13,6 +13,8 @@
 #define KERBAL_CONTAINER_STATIC_PRIORITY_QUEUE_HPP
 
 #include <kerbal/algorithm/heap.hpp>
+#include <kerbal/algorithm/swap.hpp>
+#include <kerbal/compatibility/is_constant_evaluated.hpp>
 #include <kerbal/compatibility/move.hpp>
 #include <kerbal/container/static_vector.hpp>
 #include <kerbal/iterator/iterator_traits.hpp>
@@ -29,7 +31,11 @@ namespace kerbal
 	namespace container
 	{
 
-		template <typename Tp, size_t N, typename KeyCompare = std::less<Tp> >
+		/**
+		 * @tparam Arity the number of sons of a node of the heap. A 4-ary or 8-ary heap is shallower than a binary
+		 *         one, which usually speeds up push and pop of small elements.
+		 */
+		template <typename Tp, size_t N, typename KeyCompare = std::less<Tp>, size_t Arity = 2>
 		class static_priority_queue
 		{
 			public:
@@ -81,7 +87,7 @@ namespace kerbal
 						>::type = 0) :
 						c(first, last), vc()
 				{
-					kerbal::algorithm::make_heap(c.begin(), c.end(), this->vc);
+					kerbal::algorithm::make_heap<Arity>(c.begin(), c.end(), this->vc);
 				}
 
 				template <typename InputIterator>
@@ -93,7 +99,7 @@ namespace kerbal
 						>::type = 0) :
 						c(first, last), vc(kc)
 				{
-					kerbal::algorithm::make_heap(c.begin(), c.end(), this->vc);
+					kerbal::algorithm::make_heap<Arity>(c.begin(), c.end(), this->vc);
 				}
 
 #		if __cplusplus >= 201103L
@@ -146,26 +152,59 @@ namespace kerbal
 				void push(const_reference val)
 				{
 					c.push_back(val);
-					kerbal::algorithm::push_heap(c.begin(), c.end(), vc);
+					kerbal::algorithm::push_heap<Arity>(c.begin(), c.end(), vc);
 				}
 
+				/**
+				 * Same as push_range at run time; pushes the elements one by one in constant evaluation, where
+				 * push_range is not usable before C++20.
+				 */
 				template <typename InputIterator>
 				KERBAL_CONSTEXPR14
 				void push(InputIterator first, InputIterator last)
 				{
+					if (KERBAL_CONSTEXPR14_RUNTIME_PATH()) {
+						this->push_range(first, last);
+						return;
+					}
 					while (first != last) {
 						this->push(*first);
 						++first;
 					}
 				}
 
+				/**
+				 * Pushes the elements of [first, last), by appending all of them then restoring the heap at once,
+				 * which rebuilds it when the batch is large compared with the queue.
+				 */
+				template <typename InputIterator>
+				KERBAL_CONSTEXPR20
+				void push_range(InputIterator first, InputIterator last)
+				{
+					difference_type old_size(c.size());
+#		if __cpp_exceptions
+					try {
+#		endif
+						while (first != last) {
+							c.push_back(*first);
+							++first;
+						}
+#		if __cpp_exceptions
+					} catch (...) {
+						kerbal::algorithm::heap_push_range<Arity>(c.begin(), c.begin() + old_size, c.end(), vc);
+						throw;
+					}
+#		endif
+					kerbal::algorithm::heap_push_range<Arity>(c.begin(), c.begin() + old_size, c.end(), vc);
+				}
+
 #		if __cplusplus >= 201103L
 
 				KERBAL_CONSTEXPR14
 				void push(rvalue_reference val)
 				{
 					c.push_back(kerbal::compatibility::move(val));
-					kerbal::algorithm::push_heap(c.begin(), c.end(), vc);
+					kerbal::algorithm::push_heap<Arity>(c.begin(), c.end(), vc);
 				}
 
 #		endif
@@ -177,7 +216,7 @@ namespace kerbal
 				void emplace(Args&& ... args)
 				{
 					c.emplace_back(std::forward<Args>(args)...);
-					kerbal::algorithm::push_heap(c.begin(), c.end(), vc);
+					kerbal::algorithm::push_heap<Arity>(c.begin(), c.end(), vc);
 				}
 
 #		else
@@ -185,28 +224,28 @@ namespace kerbal
 				void emplace()
 				{
 					c.emplace_back();
-					kerbal::algorithm::push_heap(c.begin(), c.end(), vc);
+					kerbal::algorithm::push_heap<Arity>(c.begin(), c.end(), vc);
 				}
 
 				template <typename Arg0>
 				void emplace(const Arg0& arg0)
 				{
 					c.emplace_back(arg0);
-					kerbal::algorithm::push_heap(c.begin(), c.end(), vc);
+					kerbal::algorithm::push_heap<Arity>(c.begin(), c.end(), vc);
 				}
 
 				template <typename Arg0, typename Arg1>
 				void emplace(const Arg0& arg0, const Arg1& arg1)
 				{
 					c.emplace_back(arg0, arg1);
-					kerbal::algorithm::push_heap(c.begin(), c.end(), vc);
+					kerbal::algorithm::push_heap<Arity>(c.begin(), c.end(), vc);
 				}
 
 				template <typename Arg0, typename Arg1, typename Arg2>
 				void emplace(const Arg0& arg0, const Arg1& arg1, const Arg2& arg2)
 				{
 					c.emplace_back(arg0, arg1, arg2);
-					kerbal::algorithm::push_heap(c.begin(), c.end(), vc);
+					kerbal::algorithm::push_heap<Arity>(c.begin(), c.end(), vc);
 				}
 
 #		endif
@@ -214,15 +253,50 @@ namespace kerbal
 				KERBAL_CONSTEXPR14
 				void pop()
 				{
-					kerbal::algorithm::pop_heap(c.begin(), c.end(), vc);
+					kerbal::algorithm::pop_heap<Arity>(c.begin(), c.end(), vc);
 					c.pop_back();
 				}
 
-				template <size_t M>
+				/**
+				 * Replaces the top by val, as pop() followed by push(val) but with a single sift-down.
+				 * @pre !empty()
+				 */
+				KERBAL_CONSTEXPR14
+				void replace_top(const_reference val)
+				{
+					c.front() = val;
+					kerbal::algorithm::detail::d_ary_heap_adjust_down<Arity>(c.begin(), 0,
+												static_cast<difference_type>(c.size()), vc);
+				}
+
+#		if __cplusplus >= 201103L
+
+				KERBAL_CONSTEXPR14
+				void replace_top(rvalue_reference val)
+				{
+					c.front() = kerbal::compatibility::move(val);
+					kerbal::algorithm::detail::d_ary_heap_adjust_down<Arity>(c.begin(), 0,
+												static_cast<difference_type>(c.size()), vc);
+				}
+
+#		endif
+
+				KERBAL_CONSTEXPR14
+				void clear()
+				{
+					c.clear();
+				}
+
+				KERBAL_CONSTEXPR
+				value_compare value_comp() const
+				{
+					return this->vc;
+				}
+
 				KERBAL_CONSTEXPR14
-				void swap(static_priority_queue<Tp, M> & with)
+				void swap(static_priority_queue & with)
 				{
-					c.swap(with);
+					c.swap(with.c);
 					kerbal::algorithm::swap(this->vc, with.vc);
 				}
 
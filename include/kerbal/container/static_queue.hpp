@@ -13,16 +13,20 @@
 #define KERBAL_CONTAINER_STATIC_QUEUE_HPP
 
 #include <kerbal/compatibility/constexpr.hpp>
+#include <kerbal/compatibility/is_constant_evaluated.hpp>
 #include <kerbal/compatibility/move.hpp>
 #include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/type_traits/is_trivially_relocatable.hpp>
 
 #include <cstddef>
+#include <cstring>
 
 #if __cplusplus >= 201103L
 #	include <initializer_list>
 #endif
 
 #include <kerbal/container/detail/static_queue_base.hpp>
+#include <kerbal/container/detail/trivially_relocate.hpp>
 
 namespace kerbal
 {
@@ -67,10 +71,18 @@ namespace kerbal
 
 #			if __cplusplus >= 201103L
 
+				/**
+				 * @brief Move constructor. The elements of a trivially relocatable type are taken over bitwise and
+				 *        src is left empty.
+				 */
 				KERBAL_CONSTEXPR14
 				static_queue(static_queue && src)
 						: super()
 				{
+					if (TRIVIALLY_RELOCATABLE::value && KERBAL_CONSTEXPR14_RUNTIME_PATH()) {
+						this->__relocate_from(src);
+						return;
+					}
 					for (size_type j = src.ibegin; j != src.iend; j = src.next(j)) {
 						this->push(kerbal::compatibility::move(src.storage[j].raw_value()));
 					}
@@ -120,9 +132,12 @@ namespace kerbal
 				KERBAL_CONSTEXPR14
 				void assign(const static_queue & src)
 				{
+					if (this == &src) {
+						return;
+					}
 					this->clear();
 					for (size_type j = src.ibegin; j != src.iend; j = src.next(j)) {
-						this->push(this->storage[j].raw_value());
+						this->push(src.storage[j].raw_value());
 					}
 				}
 
@@ -131,9 +146,16 @@ namespace kerbal
 				KERBAL_CONSTEXPR14
 				void assign(static_queue && src)
 				{
+					if (this == &src) {
+						return;
+					}
 					this->clear();
+					if (TRIVIALLY_RELOCATABLE::value && KERBAL_CONSTEXPR14_RUNTIME_PATH()) {
+						this->__relocate_from(src);
+						return;
+					}
 					for (size_type j = src.ibegin; j != src.iend; j = src.next(j)) {
-						this->push(kerbal::compatibility::move(this->storage[j].raw_value()));
+						this->push(kerbal::compatibility::move(src.storage[j].raw_value()));
 					}
 				}
 
@@ -167,7 +189,7 @@ namespace kerbal
 					this->storage[this->iend].construct(std::forward<Args>(args)...);
 					size_type iback = this->iend;
 					this->iend = this->next(this->iend);
-					return this->storage[iback];
+					return this->storage[iback].raw_value();
 				}
 
 #		else
@@ -177,7 +199,7 @@ namespace kerbal
 					this->storage[this->iend].construct();
 					size_type iback = this->iend;
 					this->iend = this->next(this->iend);
-					return this->storage[iback];
+					return this->storage[iback].raw_value();
 				}
 
 				template <typename Arg0>
@@ -186,7 +208,7 @@ namespace kerbal
 					this->storage[this->iend].construct(arg0);
 					size_type iback = this->iend;
 					this->iend = this->next(this->iend);
-					return this->storage[iback];
+					return this->storage[iback].raw_value();
 				}
 
 				template <typename Arg0, typename Arg1>
@@ -195,7 +217,7 @@ namespace kerbal
 					this->storage[this->iend].construct(arg0, arg1);
 					size_type iback = this->iend;
 					this->iend = this->next(this->iend);
-					return this->storage[iback];
+					return this->storage[iback].raw_value();
 				}
 
 				template <typename Arg0, typename Arg1, typename Arg2>
@@ -204,7 +226,7 @@ namespace kerbal
 					this->storage[this->iend].construct(arg0, arg1, arg2);
 					size_type iback = this->iend;
 					this->iend = this->next(this->iend);
-					return this->storage[iback];
+					return this->storage[iback].raw_value();
 				}
 
 #		endif
@@ -260,7 +282,67 @@ namespace kerbal
 					return this->storage[this->prev(this->iend)].raw_value();
 				}
 
-				void swap(static_queue& with);
+				KERBAL_CONSTEXPR14
+				void swap(static_queue & with)
+				{
+					if (TRIVIALLY_RELOCATABLE::value && KERBAL_CONSTEXPR14_RUNTIME_PATH()) {
+						this->__swap_relocate(with);
+						return;
+					}
+					static_queue tmp(kerbal::compatibility::to_xvalue(with));
+					with.assign(kerbal::compatibility::to_xvalue(*this));
+					this->assign(kerbal::compatibility::to_xvalue(tmp));
+				}
+
+			private:
+				typedef kerbal::type_traits::is_trivially_relocatable<value_type>	TRIVIALLY_RELOCATABLE;
+
+				typedef typename super::storage_type	storage_type;
+
+				static void __memcpy_slots(storage_type * to, const storage_type * from, size_type n) KERBAL_NOEXCEPT
+				{
+					std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), n * sizeof(storage_type));
+				}
+
+				/*
+				 * Takes over the elements of src bitwise, at the same positions of the ring, src is left empty.
+				 * pre-condition: this->empty()
+				 */
+				void __relocate_from(static_queue & src) KERBAL_NOEXCEPT
+				{
+					if (src.ibegin <= src.iend) {
+						__memcpy_slots(this->storage + src.ibegin, src.storage + src.ibegin, src.iend - src.ibegin);
+					} else {
+						__memcpy_slots(this->storage + src.ibegin, src.storage + src.ibegin, N + 1 - src.ibegin);
+						__memcpy_slots(this->storage, src.storage, src.iend);
+					}
+					this->ibegin = src.ibegin;
+					this->iend = src.iend;
+					src.iend = src.ibegin;
+				}
+
+				void __swap_relocate(static_queue & with) KERBAL_NOEXCEPT
+				{
+					if (this == &with) {
+						return;
+					}
+					// exchange the bytes of the slots in use by either queue, the free slots hold no object
+					size_type first = 0;
+					size_type last = N + 1;
+					if (this->ibegin <= this->iend && with.ibegin <= with.iend) {
+						first = this->ibegin < with.ibegin ? this->ibegin : with.ibegin;
+						last = this->iend < with.iend ? with.iend : this->iend;
+					}
+					kerbal::container::detail::trivially_relocate_swap(
+							static_cast<void*>(this->storage + first), static_cast<void*>(with.storage + first),
+							(last - first) * sizeof(storage_type));
+					size_type t = this->ibegin;
+					this->ibegin = with.ibegin;
+					with.ibegin = t;
+					t = this->iend;
+					this->iend = with.iend;
+					with.iend = t;
+				}
 
 		};
 
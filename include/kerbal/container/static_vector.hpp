@@ -21,6 +21,7 @@
 #include <kerbal/iterator/reverse_iterator.hpp>
 #include <kerbal/type_traits/array_traits.hpp>
 #include <kerbal/type_traits/enable_if.hpp>
+#include <kerbal/type_traits/is_trivially_relocatable.hpp>
 
 #include <cstddef>
 
@@ -547,6 +548,19 @@ namespace kerbal
 				KERBAL_CONSTEXPR14
 				void __destroy_at(iterator);
 
+				typedef kerbal::type_traits::is_trivially_relocatable<value_type>	TRIVIALLY_RELOCATABLE;
+
+				/*
+				 * The bitwise fast paths of insert, emplace, erase and swap for trivially relocatable elements. They
+				 * call memmove/memcpy, so they are only taken when KERBAL_CONSTEXPR14_RUNTIME_PATH() holds.
+				 */
+
+				void __relocate_back_to(iterator pos) KERBAL_NOEXCEPT;
+
+				iterator __erase_relocate(iterator first, iterator last);
+
+				void __swap_relocate(static_vector & with) KERBAL_NOEXCEPT;
+
 		};
 
 		template <typename Tp, size_t M, size_t N>
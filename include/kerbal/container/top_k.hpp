@@ -0,0 +1,243 @@
+/**
+ * @file       top_k.hpp
+ * @brief
+ * @date       2020-11-12
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_CONTAINER_TOP_K_HPP
+#define KERBAL_CONTAINER_TOP_K_HPP
+
+#include <kerbal/algorithm/heap.hpp>
+#include <kerbal/algorithm/modifier.hpp>
+#include <kerbal/compatibility/constexpr.hpp>
+#include <kerbal/compatibility/move.hpp>
+#include <kerbal/container/static_priority_queue.hpp>
+#include <kerbal/container/static_vector.hpp>
+
+#include <cstddef>
+#include <functional>
+
+namespace kerbal
+{
+
+	namespace container
+	{
+
+		/**
+		 * A streaming accumulator of the K greatest elements (according to KeyCompare) pushed into it, in O(K)
+		 * space whatever the length of the stream.
+		 *
+		 * The kept elements live in a static_priority_queue whose top is the least of them, i.e. the threshold an
+		 * element has to exceed to get in. Once K elements are kept, most of the elements of a long stream are
+		 * rejected by a single comparison with it; the others replace it in O(log K).
+		 */
+		template <typename Tp, std::size_t K, typename KeyCompare = std::less<Tp>, std::size_t Arity = 2>
+		class top_k
+		{
+			private:
+				struct inverse_compare
+				{
+						KeyCompare kc;
+
+						KERBAL_CONSTEXPR
+						inverse_compare() :
+								kc()
+						{
+						}
+
+						KERBAL_CONSTEXPR
+						explicit inverse_compare(const KeyCompare & kc) :
+								kc(kc)
+						{
+						}
+
+						KERBAL_CONSTEXPR
+						bool operator()(const Tp & lhs, const Tp & rhs) const
+						{
+							return kc(rhs, lhs);
+						}
+				};
+
+				typedef kerbal::container::static_priority_queue<Tp, K, inverse_compare, Arity>	queue_type;
+
+			public:
+				typedef KeyCompare							value_compare;
+
+				typedef Tp									value_type;
+				typedef const value_type&					const_reference;
+
+#		if __cplusplus >= 201103L
+				typedef value_type&&						rvalue_reference;
+#		endif
+
+				typedef typename queue_type::size_type			size_type;
+				typedef typename queue_type::const_iterator		const_iterator;
+
+			private:
+				queue_type q;
+
+			public:
+				KERBAL_CONSTEXPR
+				top_k() :
+						q()
+				{
+				}
+
+				KERBAL_CONSTEXPR
+				explicit top_k(value_compare kc) :
+						q(inverse_compare(kc))
+				{
+				}
+
+				KERBAL_CONSTEXPR
+				bool empty() const
+				{
+					return q.empty();
+				}
+
+				/**
+				 * @return whether K elements are kept, after which an element has to exceed threshold() to get in
+				 */
+				KERBAL_CONSTEXPR
+				bool full() const
+				{
+					return q.full();
+				}
+
+				KERBAL_CONSTEXPR
+				size_type size() const
+				{
+					return q.size();
+				}
+
+				KERBAL_CONSTEXPR
+				size_type max_size() const
+				{
+					return q.max_size();
+				}
+
+				/**
+				 * @return the least of the kept elements, i.e. the K-th greatest one pushed so far once full()
+				 * @pre !empty()
+				 */
+				KERBAL_CONSTEXPR14
+				const_reference threshold() const
+				{
+					return q.top();
+				}
+
+				/**
+				 * @return whether val is kept, possibly evicting the least of the kept elements
+				 */
+				KERBAL_CONSTEXPR14
+				bool push(const_reference val)
+				{
+					if (!q.full()) {
+						q.push(val);
+						return true;
+					}
+					if (K == 0 || !this->value_comp()(q.top(), val)) { // val <= threshold
+						return false;
+					}
+					q.replace_top(val);
+					return true;
+				}
+
+#		if __cplusplus >= 201103L
+
+				KERBAL_CONSTEXPR14
+				bool push(rvalue_reference val)
+				{
+					if (!q.full()) {
+						q.push(kerbal::compatibility::move(val));
+						return true;
+					}
+					if (K == 0 || !this->value_comp()(q.top(), val)) { // val <= threshold
+						return false;
+					}
+					q.replace_top(kerbal::compatibility::move(val));
+					return true;
+				}
+
+#		endif
+
+				template <typename InputIterator>
+				KERBAL_CONSTEXPR14
+				void push(InputIterator first, InputIterator last)
+				{
+					while (first != last) {
+						this->push(*first);
+						++first;
+					}
+				}
+
+				/**
+				 * Copies the kept elements to out, the greatest first.
+				 * @return the end of the copied elements
+				 */
+				template <typename OutputIterator>
+				KERBAL_CONSTEXPR14
+				OutputIterator copy_sorted(OutputIterator out) const
+				{
+					kerbal::container::static_vector<Tp, K> buffer(q.cbegin(), q.cend());
+					kerbal::algorithm::sort_heap<Arity>(buffer.begin(), buffer.end(), q.value_comp());
+					return kerbal::algorithm::copy(buffer.cbegin(), buffer.cend(), out);
+				}
+
+				/**
+				 * The kept elements in heap order.
+				 */
+				KERBAL_CONSTEXPR
+				const_iterator begin() const
+				{
+					return q.cbegin();
+				}
+
+				KERBAL_CONSTEXPR
+				const_iterator end() const
+				{
+					return q.cend();
+				}
+
+				KERBAL_CONSTEXPR
+				const_iterator cbegin() const
+				{
+					return q.cbegin();
+				}
+
+				KERBAL_CONSTEXPR
+				const_iterator cend() const
+				{
+					return q.cend();
+				}
+
+				KERBAL_CONSTEXPR14
+				void clear()
+				{
+					q.clear();
+				}
+
+				KERBAL_CONSTEXPR14
+				void swap(top_k & with)
+				{
+					q.swap(with.q);
+				}
+
+				KERBAL_CONSTEXPR
+				value_compare value_comp() const
+				{
+					return q.value_comp().kc;
+				}
+
+		};
+
+	} // namespace container
+
+} // namespace kerbal
+
+#endif // KERBAL_CONTAINER_TOP_K_HPP
@@ -0,0 +1,643 @@
+/**
+ * @file       vector.hpp
+ * @brief
+ * @date       2020-11-02
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_CONTAINER_VECTOR_HPP
+#define KERBAL_CONTAINER_VECTOR_HPP
+
+#include <kerbal/algorithm/sequence_compare.hpp>
+#include <kerbal/assign/ilist.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/compatibility/static_assert.hpp>
+#include <kerbal/iterator/iterator_traits.hpp>
+#include <kerbal/iterator/reverse_iterator.hpp>
+#include <kerbal/memory/allocator_traits.hpp>
+#include <kerbal/type_traits/enable_if.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+#include <kerbal/type_traits/is_trivially_relocatable.hpp>
+
+#include <cstddef>
+#include <memory>
+
+#if __cplusplus >= 201103L
+#	include <initializer_list>
+#	include <type_traits>
+#else
+#	include <kerbal/type_traits/fundamental_deduction.hpp>
+#	include <kerbal/type_traits/member_pointer_deduction.hpp>
+#	include <kerbal/type_traits/pointer_deduction.hpp>
+#endif
+
+#include <kerbal/container/detail/vector_base.hpp>
+
+namespace kerbal
+{
+
+	namespace container
+	{
+
+		/**
+		 * @brief Growth policy of vector: the capacity is multiplied by Numerator / Denominator whenever the
+		 *        elements don't fit any more.
+		 * @details 2 / 1 (the default) needs the fewest reallocations, 3 / 2 allows the allocator to reuse the
+		 *          memory released by the former reallocations.
+		 */
+		template <std::size_t Numerator, std::size_t Denominator = 1>
+		struct vector_growth_factor
+		{
+				KERBAL_STATIC_ASSERT(Denominator != 0 && Numerator > Denominator,
+									"growth factor must be greater than 1");
+
+				static std::size_t next_capacity(std::size_t capacity, std::size_t required, std::size_t max_size)
+																							KERBAL_NOEXCEPT
+				{
+					std::size_t grown = capacity > max_size / Numerator ?
+											max_size : capacity * Numerator / Denominator;
+					return grown < required ? required : grown;
+				}
+		};
+
+		namespace detail
+		{
+
+#	if __cplusplus >= 201103L
+
+			template <typename Tp>
+			struct vector_trivially_default_constructible: kerbal::type_traits::bool_constant<
+					std::is_trivial<Tp>::value
+			>
+			{
+			};
+
+#	else
+
+			template <typename Tp>
+			struct vector_trivially_default_constructible: kerbal::type_traits::bool_constant<
+					kerbal::type_traits::is_fundamental<Tp>::value ||
+					kerbal::type_traits::is_member_pointer<Tp>::value ||
+					kerbal::type_traits::is_pointer<Tp>::value
+			>
+			{
+			};
+
+#	endif
+
+		} // namespace detail
+
+		/**
+		 * @brief Array with flexible length that stored on heap storage duration.
+		 * @details Compared with std::vector, it offers resize_default_init / resize_uninitialized which make
+		 *          room for the elements without value-initializing them, grows buffers of trivially
+		 *          relocatable elements by the reallocate member of the allocator when there is one (see
+		 *          kerbal::memory::malloc_allocator) instead of allocate-copy-deallocate, and takes the growth
+		 *          factor as a template parameter.
+		 * @tparam Tp Type of the elements.
+		 * @tparam Allocator Allocator of the elements.
+		 * @tparam GrowthPolicy Type that provides static next_capacity(capacity, required, max_size).
+		 */
+		template <typename Tp, typename Allocator = std::allocator<Tp>,
+				typename GrowthPolicy = kerbal::container::vector_growth_factor<2> >
+		class vector:
+				protected kerbal::container::detail::vector_base<Tp, Allocator>
+		{
+			private:
+				typedef kerbal::container::detail::vector_base<Tp, Allocator>	super;
+				typedef typename super::allocator_traits						allocator_traits;
+
+			public:
+				typedef Tp							value_type;
+				typedef const value_type			const_type;
+				typedef value_type&					reference;
+				typedef const value_type&			const_reference;
+				typedef value_type*					pointer;
+				typedef const value_type*			const_pointer;
+
+#		if __cplusplus >= 201103L
+				typedef value_type&&				rvalue_reference;
+				typedef const value_type&&			const_rvalue_reference;
+#		endif
+
+				typedef std::size_t					size_type;
+				typedef std::ptrdiff_t				difference_type;
+
+				typedef pointer												iterator;
+				typedef const_pointer										const_iterator;
+				typedef kerbal::iterator::reverse_iterator<iterator>		reverse_iterator;
+				typedef kerbal::iterator::reverse_iterator<const_iterator>	const_reverse_iterator;
+
+				typedef Allocator					allocator_type;
+				typedef GrowthPolicy				growth_policy;
+
+			public:
+
+				/**
+				 * @brief Empty container constructor (Default constructor)
+				 */
+				vector();
+
+				explicit vector(const Allocator & alloc);
+
+				vector(const vector & src);
+
+				vector(const vector & src, const Allocator & alloc);
+
+#		if __cplusplus >= 201103L
+
+				vector(vector && src) KERBAL_NOEXCEPT;
+
+#		endif
+
+				/**
+				 * @brief Construct the array with n value-initialized elements.
+				 * @param n number of elements
+				 */
+				explicit vector(size_type n);
+
+				vector(size_type n, const Allocator & alloc);
+
+				/**
+				 * @brief Construct the array with n copies of val.
+				 * @param n number of elements
+				 * @param val value to fill the array with
+				 */
+				vector(size_type n, const_reference val);
+
+				vector(size_type n, const_reference val, const Allocator & alloc);
+
+				/**
+				 * @brief Range constructor
+				 * @param first the iterator that points to the range begin
+				 * @param last the iterator that points to the range end
+				 * @tparam InputIterator An input iterator type that points to elements of a type
+				 */
+				template <typename InputIterator>
+				vector(InputIterator first, InputIterator last,
+						typename kerbal::type_traits::enable_if<
+								kerbal::iterator::is_input_compatible_iterator<InputIterator>::value
+								, int
+						>::type = 0
+				);
+
+				template <typename InputIterator>
+				vector(InputIterator first, InputIterator last, const Allocator & alloc,
+						typename kerbal::type_traits::enable_if<
+								kerbal::iterator::is_input_compatible_iterator<InputIterator>::value
+								, int
+						>::type = 0
+				);
+
+#		if __cplusplus >= 201103L
+
+				/**
+				 * @brief Construct the array by coping the contents in initializer list
+				 * @param src the initializer list
+				 */
+				vector(std::initializer_list<value_type> src);
+
+				vector(std::initializer_list<value_type> src, const Allocator & alloc);
+
+#		else
+
+				template <typename Up>
+				vector(const kerbal::assign::assign_list<Up> & src);
+
+#		endif
+
+				vector& operator=(const vector & src);
+
+#		if __cplusplus >= 201103L
+
+				vector& operator=(vector && src) KERBAL_NOEXCEPT;
+
+				vector& operator=(std::initializer_list<value_type> src);
+
+#		else
+
+				template <typename Up>
+				vector& operator=(const kerbal::assign::assign_list<Up> & src);
+
+#		endif
+
+				/**
+				 * @brief Assign the array by using n value(s).
+				 * @param new_size numbers of the value(s)
+				 * @param val value
+				 */
+				void assign(size_type new_size, const_reference val);
+
+				/**
+				 * @brief Assign the array by using a range of elements.
+				 * @param first the iterator that points to the range begin
+				 * @param last the iterator that points to the range end
+				 * @tparam InputIterator An input iterator type that points to elements of a type
+				 */
+				template <typename InputIterator>
+				typename kerbal::type_traits::enable_if<
+						kerbal::iterator::is_input_compatible_iterator<InputIterator>::value
+				>::type
+				assign(InputIterator first, InputIterator last);
+
+#		if __cplusplus >= 201103L
+
+				void assign(std::initializer_list<value_type> src);
+
+#		else
+
+				template <typename Up>
+				void assign(const kerbal::assign::assign_list<Up> & src);
+
+#		endif
+
+				allocator_type get_allocator() const
+				{
+					return this->alloc();
+				}
+
+				iterator begin() KERBAL_NOEXCEPT
+				{
+					return this->m_buffer;
+				}
+
+				iterator end() KERBAL_NOEXCEPT
+				{
+					return this->m_buffer + this->m_size;
+				}
+
+				const_iterator begin() const KERBAL_NOEXCEPT
+				{
+					return this->m_buffer;
+				}
+
+				const_iterator end() const KERBAL_NOEXCEPT
+				{
+					return this->m_buffer + this->m_size;
+				}
+
+				const_iterator cbegin() const KERBAL_NOEXCEPT
+				{
+					return this->m_buffer;
+				}
+
+				const_iterator cend() const KERBAL_NOEXCEPT
+				{
+					return this->m_buffer + this->m_size;
+				}
+
+				reverse_iterator rbegin() KERBAL_NOEXCEPT
+				{
+					return reverse_iterator(this->end());
+				}
+
+				reverse_iterator rend() KERBAL_NOEXCEPT
+				{
+					return reverse_iterator(this->begin());
+				}
+
+				const_reverse_iterator rbegin() const KERBAL_NOEXCEPT
+				{
+					return const_reverse_iterator(this->end());
+				}
+
+				const_reverse_iterator rend() const KERBAL_NOEXCEPT
+				{
+					return const_reverse_iterator(this->begin());
+				}
+
+				const_reverse_iterator crbegin() const KERBAL_NOEXCEPT
+				{
+					return const_reverse_iterator(this->end());
+				}
+
+				const_reverse_iterator crend() const KERBAL_NOEXCEPT
+				{
+					return const_reverse_iterator(this->begin());
+				}
+
+				iterator nth(size_type index) KERBAL_NOEXCEPT
+				{
+					return this->begin() + index;
+				}
+
+				const_iterator nth(size_type index) const KERBAL_NOEXCEPT
+				{
+					return this->cbegin() + index;
+				}
+
+				size_type index_of(const_iterator it) const KERBAL_NOEXCEPT
+				{
+					return it - this->cbegin();
+				}
+
+				/**
+				 * @brief Count the number of the elements that the array has contained.
+				 * @return the number of the elements that the array has contained
+				 */
+				size_type size() const KERBAL_NOEXCEPT
+				{
+					return this->m_size;
+				}
+
+				/**
+				 * @brief Returns the size() of the largest possible vector.
+				 */
+				size_type max_size() const KERBAL_NOEXCEPT
+				{
+					return static_cast<size_type>(-1) / sizeof(value_type);
+				}
+
+				/**
+				 * @brief Number of the elements that the array can hold without reallocation.
+				 */
+				size_type capacity() const KERBAL_NOEXCEPT
+				{
+					return this->m_capacity;
+				}
+
+				/**
+				 * @brief Judge whether the array is empty.
+				 * @return If the array is empty, return true, otherwise return false
+				 */
+				bool empty() const KERBAL_NOEXCEPT
+				{
+					return this->m_size == 0;
+				}
+
+				reference operator[](size_type index) KERBAL_NOEXCEPT
+				{
+					return this->m_buffer[index];
+				}
+
+				const_reference operator[](size_type index) const KERBAL_NOEXCEPT
+				{
+					return this->m_buffer[index];
+				}
+
+				reference at(size_type index);
+				const_reference at(size_type index) const;
+
+				reference front()
+				{
+					return this->m_buffer[0];
+				}
+
+				const_reference front() const
+				{
+					return this->m_buffer[0];
+				}
+
+				reference back()
+				{
+					return this->m_buffer[this->m_size - 1];
+				}
+
+				const_reference back() const
+				{
+					return this->m_buffer[this->m_size - 1];
+				}
+
+				pointer data() KERBAL_NOEXCEPT
+				{
+					return this->m_buffer;
+				}
+
+				const_pointer data() const KERBAL_NOEXCEPT
+				{
+					return this->m_buffer;
+				}
+
+				/**
+				 * @brief Make the capacity at least new_cap.
+				 * @details If the elements are trivially relocatable and the allocator has a reallocate member,
+				 *          the buffer is grown by it (realloc, which may extend the block in place or remap its
+				 *          pages), otherwise the elements are moved (copied pre C++11 or if the move constructor
+				 *          may throw) to a new buffer.
+				 */
+				void reserve(size_type new_cap);
+
+				/**
+				 * @brief Release the unused capacity.
+				 */
+				void shrink_to_fit();
+
+				void resize(size_type new_size);
+
+				void resize(size_type new_size, const_reference val);
+
+				/**
+				 * @brief Resize the array, the new elements are default-initialized, i.e. left indeterminate if
+				 *        Tp is a trivial type.
+				 */
+				void resize_default_init(size_type new_size);
+
+				/**
+				 * @brief Resize the array without touching the new elements.
+				 * @details Only available for the trivial types. The new elements have indeterminate values and
+				 *          should be written (e.g. through data()) before being read.
+				 */
+				void resize_uninitialized(size_type new_size);
+
+				void push_back(const_reference src);
+
+#		if __cplusplus >= 201103L
+
+				void push_back(rvalue_reference src);
+
+#		endif
+
+#		if __cplusplus >= 201103L
+
+				template <typename ... Args>
+				reference emplace_back(Args&& ...args);
+
+#		else
+
+				reference emplace_back();
+
+				template <typename Arg0>
+				reference emplace_back(const Arg0& arg0);
+
+				template <typename Arg0, typename Arg1>
+				reference emplace_back(const Arg0& arg0, const Arg1& arg1);
+
+				template <typename Arg0, typename Arg1, typename Arg2>
+				reference emplace_back(const Arg0& arg0, const Arg1& arg1, const Arg2& arg2);
+
+#		endif
+
+				void pop_back() KERBAL_NOEXCEPT;
+
+				iterator insert(const_iterator pos, const_reference val);
+
+				iterator insert(const_iterator pos, size_type n, const_reference val);
+
+				template <typename InputIterator>
+				typename kerbal::type_traits::enable_if<
+						kerbal::iterator::is_input_compatible_iterator<InputIterator>::value,
+						iterator
+				>::type
+				insert(const_iterator pos, InputIterator first, InputIterator last);
+
+#		if __cplusplus >= 201103L
+
+				iterator insert(const_iterator pos, rvalue_reference val);
+
+				iterator insert(const_iterator pos, std::initializer_list<value_type> ilist);
+
+#		endif
+
+#		if __cplusplus >= 201103L
+
+				template <typename ... Args>
+				iterator emplace(const_iterator pos, Args&& ...args);
+
+#		else
+
+				iterator emplace(const_iterator pos);
+
+				template <typename Arg0>
+				iterator emplace(const_iterator pos, const Arg0& arg0);
+
+				template <typename Arg0, typename Arg1>
+				iterator emplace(const_iterator pos, const Arg0& arg0, const Arg1& arg1);
+
+				template <typename Arg0, typename Arg1, typename Arg2>
+				iterator emplace(const_iterator pos, const Arg0& arg0, const Arg1& arg1, const Arg2& arg2);
+
+#		endif
+
+				iterator erase(const_iterator pos);
+
+				iterator erase(const_iterator first, const_iterator last);
+
+				/**
+				 * @brief Swap the array with another one.
+				 * @param with another array to be swaped with
+				 */
+				void swap(vector & with) KERBAL_NOEXCEPT;
+
+				/**
+				 * @brief Clear all the elements in the array, the capacity is kept.
+				 */
+				void clear() KERBAL_NOEXCEPT;
+
+			private:
+				typedef kerbal::type_traits::is_trivially_relocatable<value_type>
+																		TRIVIALLY_RELOCATABLE;
+
+				typedef kerbal::type_traits::bool_constant<
+						TRIVIALLY_RELOCATABLE::value &&
+						kerbal::memory::allocator_has_reallocate<Allocator>::value
+				>																REALLOCATE_IN_PLACE;
+
+				size_type __next_capacity(size_type required) const;
+
+				void __grow_to(size_type required)
+				{
+					if (required > this->m_capacity) {
+						this->__reallocate(this->__next_capacity(required));
+					}
+				}
+
+				void __reallocate(size_type new_cap);
+				void __reallocate(size_type new_cap, kerbal::type_traits::false_type);
+				void __reallocate(size_type new_cap, kerbal::type_traits::true_type);
+
+				void __relocate(pointer first, pointer last, pointer to, kerbal::type_traits::false_type);
+				void __relocate(pointer first, pointer last, pointer to, kerbal::type_traits::true_type) KERBAL_NOEXCEPT;
+
+				void __shrink_back_to(size_type new_size) KERBAL_NOEXCEPT;
+
+				void __value_init_append(size_type n);
+
+				void __default_init_append(size_type n, kerbal::type_traits::false_type);
+				void __default_init_append(size_type n, kerbal::type_traits::true_type) KERBAL_NOEXCEPT;
+
+				void __fill_append(size_type n, const_reference val);
+
+				template <typename InputIterator>
+				void __range_append(InputIterator first, InputIterator last, std::input_iterator_tag);
+
+				template <typename ForwardIterator>
+				void __range_append(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag);
+
+				template <typename InputIterator>
+				void __assign(InputIterator first, InputIterator last, std::input_iterator_tag);
+
+				template <typename ForwardIterator>
+				void __assign(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag);
+
+				void __emplace_realloc_commit(pointer new_buffer, size_type new_cap, size_type index);
+
+#		if __cplusplus >= 201103L
+
+				template <typename ... Args>
+				iterator __emplace_realloc(size_type index, Args&& ...args);
+
+				template <typename ... Args>
+				iterator __emplace_realloc(kerbal::type_traits::false_type, size_type index, Args&& ...args);
+
+				template <typename ... Args>
+				iterator __emplace_realloc(kerbal::type_traits::true_type, size_type index, Args&& ...args);
+
+#		else
+
+				iterator __emplace_realloc(size_type index, const_reference val);
+				iterator __emplace_realloc(kerbal::type_traits::false_type, size_type index, const_reference val);
+				iterator __emplace_realloc(kerbal::type_traits::true_type, size_type index, const_reference val);
+
+#		endif
+
+				iterator __emplace_relocatable(size_type index, reference tmp);
+
+		};
+
+		template <typename Tp, typename Alloc, typename GP, typename Alloc2, typename GP2>
+		bool operator==(const vector<Tp, Alloc, GP> & lhs, const vector<Tp, Alloc2, GP2> & rhs)
+		{
+			return kerbal::algorithm::sequence_equal_to(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+		}
+
+		template <typename Tp, typename Alloc, typename GP, typename Alloc2, typename GP2>
+		bool operator!=(const vector<Tp, Alloc, GP> & lhs, const vector<Tp, Alloc2, GP2> & rhs)
+		{
+			return kerbal::algorithm::sequence_not_equal_to(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+		}
+
+		template <typename Tp, typename Alloc, typename GP, typename Alloc2, typename GP2>
+		bool operator<(const vector<Tp, Alloc, GP> & lhs, const vector<Tp, Alloc2, GP2> & rhs)
+		{
+			return kerbal::algorithm::sequence_less(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+		}
+
+		template <typename Tp, typename Alloc, typename GP, typename Alloc2, typename GP2>
+		bool operator<=(const vector<Tp, Alloc, GP> & lhs, const vector<Tp, Alloc2, GP2> & rhs)
+		{
+			return kerbal::algorithm::sequence_less_equal(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+		}
+
+		template <typename Tp, typename Alloc, typename GP, typename Alloc2, typename GP2>
+		bool operator>(const vector<Tp, Alloc, GP> & lhs, const vector<Tp, Alloc2, GP2> & rhs)
+		{
+			return kerbal::algorithm::sequence_greater(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+		}
+
+		template <typename Tp, typename Alloc, typename GP, typename Alloc2, typename GP2>
+		bool operator>=(const vector<Tp, Alloc, GP> & lhs, const vector<Tp, Alloc2, GP2> & rhs)
+		{
+			return kerbal::algorithm::sequence_greater_equal(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+		}
+
+	} // namespace container
+
+} // namespace kerbal
+
+#include <kerbal/container/impl/vector.impl.hpp>
+
+#endif // KERBAL_CONTAINER_VECTOR_HPP
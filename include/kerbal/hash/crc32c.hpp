@@ -0,0 +1,213 @@
+/**
+ * @file       crc32c.hpp
+ * @brief      CRC-32C (Castagnoli), as used by iSCSI, SCTP, ext4 and btrfs
+ * @date       2020-10-21
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ *
+ *	Check value
+ *	"123456789"
+ *	  E3069283
+ */
+
+#ifndef KERBAL_HASH_CRC32C_HPP
+#define KERBAL_HASH_CRC32C_HPP
+
+#include <kerbal/hash/detail/crc32c_x86_update.hpp>
+
+#include <kerbal/compatibility/constexpr.hpp>
+#include <kerbal/compatibility/fixed_width_integer.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/compatibility/static_assert.hpp>
+#include <kerbal/compatibility/x86_cpu_feature.hpp>
+#include <kerbal/config/architecture.hpp>
+#include <kerbal/config/x86_intrinsics.hpp>
+#include <kerbal/iterator/iterator_traits.hpp>
+#include <kerbal/type_traits/is_same.hpp>
+
+#include <cstddef>
+
+namespace kerbal
+{
+
+	namespace hash
+	{
+
+		struct CRC32C_policy
+		{
+			/*
+			 * slicing-by-8 table driven
+			 */
+			struct fast {};
+
+			/*
+			 * Uses the SSE4.2 crc32 instruction (and PCLMUL folding of three interleaved streams for long
+			 * inputs) if the running processor supports them, otherwise falls back to the policy fast
+			 */
+			struct simd {};
+		};
+
+		namespace detail
+		{
+
+			class crc32c_table
+			{
+				public:
+					kerbal::compatibility::uint32_t table[8][256];
+
+				private:
+					crc32c_table() KERBAL_NOEXCEPT
+					{
+						for (kerbal::compatibility::uint32_t i = 0; i < 256; ++i) {
+							kerbal::compatibility::uint32_t c = i;
+							for (int k = 0; k < 8; ++k) {
+								c = (c & 1u) ? ((c >> 1u) ^ CRC32C_POLY::value) : (c >> 1u);
+							}
+							table[0][i] = c;
+						}
+						for (int k = 1; k < 8; ++k) {
+							for (int i = 0; i < 256; ++i) {
+								table[k][i] = (table[k - 1][i] >> 8u) ^ table[0][table[k - 1][i] & 0xffu];
+							}
+						}
+					}
+
+				public:
+					static const crc32c_table & instance() KERBAL_NOEXCEPT
+					{
+						static const crc32c_table t;
+						return t;
+					}
+			};
+
+			inline
+			kerbal::compatibility::uint32_t crc32c_update_portable(kerbal::compatibility::uint32_t crc,
+																	const unsigned char * p, std::size_t n) KERBAL_NOEXCEPT
+			{
+				typedef kerbal::compatibility::uint32_t uint32_t;
+
+				const uint32_t (&t)[8][256] = crc32c_table::instance().table;
+
+				while (n >= 8) {
+					uint32_t lo = crc ^ (static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8u) |
+										(static_cast<uint32_t>(p[2]) << 16u) | (static_cast<uint32_t>(p[3]) << 24u));
+					crc = t[7][lo & 0xffu] ^ t[6][(lo >> 8u) & 0xffu] ^ t[5][(lo >> 16u) & 0xffu] ^ t[4][lo >> 24u] ^
+							t[3][p[4]] ^ t[2][p[5]] ^ t[1][p[6]] ^ t[0][p[7]];
+					p += 8;
+					n -= 8;
+				}
+
+				while (n != 0) {
+					crc = (crc >> 8u) ^ t[0][(crc ^ *p) & 0xffu];
+					++p;
+					--n;
+				}
+				return crc;
+			}
+
+			template <typename Policy>
+			struct crc32c_update_overload;
+
+			template <>
+			struct crc32c_update_overload<CRC32C_policy::fast>
+			{
+					static kerbal::compatibility::uint32_t
+					update(kerbal::compatibility::uint32_t crc, const unsigned char * p, std::size_t n) KERBAL_NOEXCEPT
+					{
+						return crc32c_update_portable(crc, p, n);
+					}
+			};
+
+			template <>
+			struct crc32c_update_overload<CRC32C_policy::simd>
+			{
+					static kerbal::compatibility::uint32_t
+					update(kerbal::compatibility::uint32_t crc, const unsigned char * p, std::size_t n) KERBAL_NOEXCEPT
+					{
+
+#	if KERBAL_X86_INTRINSICS_SUPPORTED
+
+						const kerbal::compatibility::x86_cpu_feature & feature = kerbal::compatibility::x86_cpu_feature::instance();
+
+#		if KERBAL_ARCHITECTURE == KERBAL_ARCHITECTURE_AMD64
+						if (feature.sse42 && feature.pclmul) {
+							return crc32c_update_pclmul(crc, p, n);
+						}
+#		endif
+
+						if (feature.sse42) {
+							return crc32c_update_sse42(crc, p, n);
+						}
+
+#	endif
+
+						return crc32c_update_portable(crc, p, n);
+					}
+			};
+
+		} // namespace detail
+
+		template <typename Policy>
+		class CRC32C_context
+		{
+			public:
+				typedef kerbal::compatibility::uint32_t result_type;
+				typedef result_type result;
+
+			protected:
+				result_type crc; // inverted
+
+			public:
+				KERBAL_CONSTEXPR
+				CRC32C_context() KERBAL_NOEXCEPT :
+						crc(0xFFFFFFFFu)
+				{
+				}
+
+				/*
+				 * Run your data through this.
+				 */
+				void update(const unsigned char * first, const unsigned char * last) KERBAL_NOEXCEPT
+				{
+					this->crc = detail::crc32c_update_overload<Policy>::update(this->crc, first, static_cast<std::size_t>(last - first));
+				}
+
+				template <typename ForwardIterator> // unsigned char
+				void update(ForwardIterator first, ForwardIterator last) KERBAL_NOEXCEPT
+				{
+					typedef ForwardIterator iterator;
+					typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+					KERBAL_STATIC_ASSERT((kerbal::type_traits::is_same<value_type, unsigned char>::value), "Iterator must refers to unsigned char");
+
+					unsigned char c[256];
+					while (first != last) {
+						std::size_t i = 0;
+						while (i < sizeof(c) && first != last) {
+							c[i] = *first;
+							++i;
+							++first;
+						}
+						const unsigned char * const cfirst = c;
+						this->update(cfirst, cfirst + i);
+					}
+				}
+
+				/**
+				 * Return the checksum of the data have been run through. The context could still be updated after that.
+				 */
+				KERBAL_CONSTEXPR
+				result_type digest() const KERBAL_NOEXCEPT
+				{
+					return ~this->crc;
+				}
+
+		};
+
+	} // namespace hash
+
+} // namespace kerbal
+
+#endif // KERBAL_HASH_CRC32C_HPP
@@ -0,0 +1,172 @@
+/**
+ * @file       crc32c_x86_update.hpp
+ * @brief
+ * @date       2020-10-21
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_HASH_DETAIL_CRC32C_X86_UPDATE_HPP
+#define KERBAL_HASH_DETAIL_CRC32C_X86_UPDATE_HPP
+
+#include <kerbal/compatibility/fixed_width_integer.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/config/architecture.hpp>
+#include <kerbal/config/x86_intrinsics.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+
+#include <cstddef>
+#include <cstring>
+
+namespace kerbal
+{
+
+	namespace hash
+	{
+
+		namespace detail
+		{
+
+			typedef kerbal::type_traits::integral_constant<kerbal::compatibility::uint32_t, 0x82F63B78u> CRC32C_POLY; // reflected
+
+			/*
+			 * x^n mod P, bit 31 of the result is the coefficient of x^0 (reflected representation)
+			 */
+			inline
+			kerbal::compatibility::uint32_t crc32c_xpow(std::size_t n) KERBAL_NOEXCEPT
+			{
+				kerbal::compatibility::uint32_t r = 0x80000000u;
+				while (n != 0) {
+					r = (r & 1u) ? ((r >> 1u) ^ CRC32C_POLY::value) : (r >> 1u);
+					--n;
+				}
+				return r;
+			}
+
+#	if KERBAL_X86_INTRINSICS_SUPPORTED
+
+			KERBAL_X86_TARGET("sse4.2")
+			inline
+			kerbal::compatibility::uint32_t crc32c_update_sse42(kerbal::compatibility::uint32_t crc,
+																const unsigned char * p, std::size_t n) KERBAL_NOEXCEPT
+			{
+				while (n != 0 && (reinterpret_cast<std::size_t>(p) & 7u) != 0) {
+					crc = _mm_crc32_u8(crc, *p);
+					++p;
+					--n;
+				}
+
+#		if KERBAL_ARCHITECTURE == KERBAL_ARCHITECTURE_AMD64
+				kerbal::compatibility::uint64_t c = crc;
+				while (n >= 8) {
+					kerbal::compatibility::uint64_t v;
+					std::memcpy(&v, p, 8);
+					c = _mm_crc32_u64(c, v);
+					p += 8;
+					n -= 8;
+				}
+				crc = static_cast<kerbal::compatibility::uint32_t>(c);
+#		endif
+
+				while (n >= 4) {
+					kerbal::compatibility::uint32_t v;
+					std::memcpy(&v, p, 4);
+					crc = _mm_crc32_u32(crc, v);
+					p += 4;
+					n -= 4;
+				}
+
+				while (n != 0) {
+					crc = _mm_crc32_u8(crc, *p);
+					++p;
+					--n;
+				}
+				return crc;
+			}
+
+#		if KERBAL_ARCHITECTURE == KERBAL_ARCHITECTURE_AMD64
+
+			/*
+			 * The crc32 instruction has a latency of 3 cycles but a throughput of 1 per cycle,
+			 * so three independent streams of STRIPE bytes are computed in an interleaved way,
+			 * then folded together with carry-less multiplication:
+			 *
+			 *     crc(A B C) = crc(A) * x^(16 * STRIPE) + crc(B) * x^(8 * STRIPE) + crc(C)   (mod P)
+			 *
+			 * where crc32(0, clmul(a, x^(n - 33) mod P)) == a * x^n mod P.
+			 */
+			struct crc32c_pclmul_constant
+			{
+					typedef kerbal::type_traits::integral_constant<std::size_t, 2048> STRIPE;
+
+					kerbal::compatibility::uint64_t k1; // x^(16 * STRIPE - 33) mod P
+					kerbal::compatibility::uint64_t k2; // x^(8 * STRIPE - 33) mod P
+
+				private:
+					crc32c_pclmul_constant() KERBAL_NOEXCEPT :
+							k1(crc32c_xpow(16 * STRIPE::value - 33)),
+							k2(crc32c_xpow(8 * STRIPE::value - 33))
+					{
+					}
+
+				public:
+					static const crc32c_pclmul_constant & instance() KERBAL_NOEXCEPT
+					{
+						static const crc32c_pclmul_constant constant;
+						return constant;
+					}
+			};
+
+			KERBAL_X86_TARGET("sse4.2,pclmul")
+			inline
+			kerbal::compatibility::uint32_t crc32c_update_pclmul(kerbal::compatibility::uint32_t crc,
+																const unsigned char * p, std::size_t n) KERBAL_NOEXCEPT
+			{
+				typedef kerbal::compatibility::uint64_t uint64_t;
+				typedef crc32c_pclmul_constant::STRIPE STRIPE;
+
+				if (n < 3 * STRIPE::value) {
+					return crc32c_update_sse42(crc, p, n);
+				}
+
+				const crc32c_pclmul_constant & constant = crc32c_pclmul_constant::instance();
+				const __m128i k = _mm_set_epi64x(static_cast<long long>(constant.k2), static_cast<long long>(constant.k1));
+
+				while (n >= 3 * STRIPE::value) {
+					uint64_t c0 = crc, c1 = 0, c2 = 0;
+					for (std::size_t i = 0; i < STRIPE::value; i += 8) {
+						uint64_t v0, v1, v2;
+						std::memcpy(&v0, p + i, 8);
+						std::memcpy(&v1, p + STRIPE::value + i, 8);
+						std::memcpy(&v2, p + 2 * STRIPE::value + i, 8);
+						c0 = _mm_crc32_u64(c0, v0);
+						c1 = _mm_crc32_u64(c1, v1);
+						c2 = _mm_crc32_u64(c2, v2);
+					}
+
+					__m128i t0 = _mm_clmulepi64_si128(_mm_cvtsi64_si128(static_cast<long long>(c0)), k, 0x00);
+					__m128i t1 = _mm_clmulepi64_si128(_mm_cvtsi64_si128(static_cast<long long>(c1)), k, 0x10);
+					c2 ^= _mm_crc32_u64(0, static_cast<uint64_t>(_mm_cvtsi128_si64(_mm_xor_si128(t0, t1))));
+					crc = static_cast<kerbal::compatibility::uint32_t>(c2);
+
+					p += 3 * STRIPE::value;
+					n -= 3 * STRIPE::value;
+				}
+
+				return crc32c_update_sse42(crc, p, n);
+			}
+
+#		endif
+
+#	endif
+
+		} // namespace detail
+
+	} // namespace hash
+
+} // namespace kerbal
+
+#endif // KERBAL_HASH_DETAIL_CRC32C_X86_UPDATE_HPP
@@ -15,6 +15,7 @@
 #include <kerbal/compatibility/constexpr.hpp>
 #include <kerbal/compatibility/fixed_width_integer.hpp>
 #include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
 
 #include <ostream>
 #include <string>
@@ -31,6 +32,12 @@ namespace kerbal
 				template <typename Policy>
 				friend class SHA1_context;
 
+				template <size_t Lanes>
+				friend class SHA1_multi_buffer_context;
+
+			public:
+				typedef kerbal::type_traits::integral_constant<size_t, 20> DIGEST_SIZE;
+
 			private:
 				unsigned char hash[20];
 
@@ -85,6 +92,12 @@ namespace kerbal
 					return this->hash;
 				}
 
+				KERBAL_CONSTEXPR
+				static size_t size() KERBAL_NOEXCEPT
+				{
+					return DIGEST_SIZE::value;
+				}
+
 		};
 
 	} // namespace hash
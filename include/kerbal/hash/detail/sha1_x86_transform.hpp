@@ -0,0 +1,287 @@
+/**
+ * @file       sha1_x86_transform.hpp
+ * @brief
+ * @date       2020-10-20
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_HASH_DETAIL_SHA1_X86_TRANSFORM_HPP
+#define KERBAL_HASH_DETAIL_SHA1_X86_TRANSFORM_HPP
+
+#include <kerbal/compatibility/fixed_width_integer.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/compatibility/x86_cpu_feature.hpp>
+#include <kerbal/config/x86_intrinsics.hpp>
+
+#include <cstddef>
+
+namespace kerbal
+{
+
+	namespace hash
+	{
+
+		namespace detail
+		{
+
+#	if KERBAL_X86_INTRINSICS_SUPPORTED
+
+			inline
+			bool sha1_shani_supported() KERBAL_NOEXCEPT
+			{
+				const kerbal::compatibility::x86_cpu_feature & feature = kerbal::compatibility::x86_cpu_feature::instance();
+				return feature.sha && feature.ssse3 && feature.sse41;
+			}
+
+			/*
+			 * Four rounds driven by the SHA extensions.
+			 * The message words of W[t..t+3] are first folded into E by sha1nexte.
+			 */
+			template <int Func>
+			KERBAL_X86_TARGET("sha,ssse3,sse4.1")
+			inline
+			void sha1_shani_rnds4(__m128i & abcd, __m128i & e_in, __m128i & e_out, __m128i msg) KERBAL_NOEXCEPT
+			{
+				e_in = _mm_sha1nexte_epu32(e_in, msg);
+				e_out = abcd;
+				abcd = _mm_sha1rnds4_epu32(abcd, e_in, Func);
+			}
+
+			/*
+			 * W[t..t+3] = rotl(W[t-16..t-13] ^ W[t-14..t-11] ^ W[t-8..t-5] ^ W[t-3..t], 1)
+			 */
+			KERBAL_X86_TARGET("sha,ssse3,sse4.1")
+			inline
+			__m128i sha1_shani_schedule(__m128i w16, __m128i w12, __m128i w8, __m128i w4) KERBAL_NOEXCEPT
+			{
+				return _mm_sha1msg2_epu32(_mm_xor_si128(_mm_sha1msg1_epu32(w16, w12), w8), w4);
+			}
+
+			/*
+			 * SHA-1 compression of n consecutive 64 bytes blocks with the SHA extensions (SHA-NI).
+			 * Only call it if sha1_shani_supported().
+			 */
+			KERBAL_X86_TARGET("sha,ssse3,sse4.1")
+			inline
+			void sha1_transform_shani(kerbal::compatibility::uint32_t state[5],
+									const unsigned char * data, std::size_t n) KERBAL_NOEXCEPT
+			{
+				const __m128i BSWAP_MASK = _mm_set_epi64x(0x0001020304050607LL, 0x08090a0b0c0d0e0fLL);
+
+				__m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0x1B);
+				__m128i e0 = _mm_set_epi32(static_cast<int>(state[4]), 0, 0, 0);
+				__m128i e1;
+
+				for (; n != 0; --n, data += 64) {
+					const __m128i abcd_save = abcd;
+					const __m128i e0_save = e0;
+
+					__m128i m0 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data +  0)), BSWAP_MASK);
+					__m128i m1 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16)), BSWAP_MASK);
+					__m128i m2 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 32)), BSWAP_MASK);
+					__m128i m3 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 48)), BSWAP_MASK);
+
+					// rounds 0-3
+					e0 = _mm_add_epi32(e0, m0);
+					e1 = abcd;
+					abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+
+					// rounds 4-19
+					sha1_shani_rnds4<0>(abcd, e1, e0, m1);
+					sha1_shani_rnds4<0>(abcd, e0, e1, m2);
+					sha1_shani_rnds4<0>(abcd, e1, e0, m3);
+					m0 = sha1_shani_schedule(m0, m1, m2, m3);
+					sha1_shani_rnds4<0>(abcd, e0, e1, m0);
+
+					// rounds 20-39
+					m1 = sha1_shani_schedule(m1, m2, m3, m0);
+					sha1_shani_rnds4<1>(abcd, e1, e0, m1);
+					m2 = sha1_shani_schedule(m2, m3, m0, m1);
+					sha1_shani_rnds4<1>(abcd, e0, e1, m2);
+					m3 = sha1_shani_schedule(m3, m0, m1, m2);
+					sha1_shani_rnds4<1>(abcd, e1, e0, m3);
+					m0 = sha1_shani_schedule(m0, m1, m2, m3);
+					sha1_shani_rnds4<1>(abcd, e0, e1, m0);
+					m1 = sha1_shani_schedule(m1, m2, m3, m0);
+					sha1_shani_rnds4<1>(abcd, e1, e0, m1);
+
+					// rounds 40-59
+					m2 = sha1_shani_schedule(m2, m3, m0, m1);
+					sha1_shani_rnds4<2>(abcd, e0, e1, m2);
+					m3 = sha1_shani_schedule(m3, m0, m1, m2);
+					sha1_shani_rnds4<2>(abcd, e1, e0, m3);
+					m0 = sha1_shani_schedule(m0, m1, m2, m3);
+					sha1_shani_rnds4<2>(abcd, e0, e1, m0);
+					m1 = sha1_shani_schedule(m1, m2, m3, m0);
+					sha1_shani_rnds4<2>(abcd, e1, e0, m1);
+					m2 = sha1_shani_schedule(m2, m3, m0, m1);
+					sha1_shani_rnds4<2>(abcd, e0, e1, m2);
+
+					// rounds 60-79
+					m3 = sha1_shani_schedule(m3, m0, m1, m2);
+					sha1_shani_rnds4<3>(abcd, e1, e0, m3);
+					m0 = sha1_shani_schedule(m0, m1, m2, m3);
+					sha1_shani_rnds4<3>(abcd, e0, e1, m0);
+					m1 = sha1_shani_schedule(m1, m2, m3, m0);
+					sha1_shani_rnds4<3>(abcd, e1, e0, m1);
+					m2 = sha1_shani_schedule(m2, m3, m0, m1);
+					sha1_shani_rnds4<3>(abcd, e0, e1, m2);
+					m3 = sha1_shani_schedule(m3, m0, m1, m2);
+					sha1_shani_rnds4<3>(abcd, e1, e0, m3);
+
+					e0 = _mm_sha1nexte_epu32(e0, e0_save);
+					abcd = _mm_add_epi32(abcd, abcd_save);
+				}
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_shuffle_epi32(abcd, 0x1B));
+				state[4] = static_cast<kerbal::compatibility::uint32_t>(_mm_extract_epi32(e0, 3));
+			}
+
+			/*
+			 * Multi-buffer kernels: every 32-bit lane of a vector register holds the working
+			 * variable of an independent message, so that 4 (SSE2) or 8 (AVX2) blocks belonging
+			 * to different messages are compressed at once.
+			 *
+			 * state[i][lane] is the i-th hash word of the lane, w[t][lane] is the t-th big-endian
+			 * message word of the lane's current block.
+			 */
+
+			template <int S>
+			KERBAL_X86_TARGET("sse2")
+			inline
+			__m128i sha1_mb_rotl(__m128i x) KERBAL_NOEXCEPT
+			{
+				return _mm_or_si128(_mm_slli_epi32(x, S), _mm_srli_epi32(x, 32 - S));
+			}
+
+			KERBAL_X86_TARGET("sse2")
+			inline
+			void sha1_transform_sse2_x4(kerbal::compatibility::uint32_t state[5][4],
+										const kerbal::compatibility::uint32_t w_in[16][4]) KERBAL_NOEXCEPT
+			{
+				__m128i w[16];
+				for (int t = 0; t < 16; ++t) {
+					w[t] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(w_in[t]));
+				}
+
+				__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state[0]));
+				__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state[1]));
+				__m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state[2]));
+				__m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state[3]));
+				__m128i e = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state[4]));
+
+#		define SCHEDULE(t) ((t) < 16 ? w[(t)] : (w[(t) & 15] = sha1_mb_rotl<1>( \
+					_mm_xor_si128(_mm_xor_si128(w[((t) - 3) & 15], w[((t) - 8) & 15]), \
+								_mm_xor_si128(w[((t) - 14) & 15], w[(t) & 15])))))
+
+#		define STEP(f, k, t) do { \
+					__m128i tmp = _mm_add_epi32(_mm_add_epi32(sha1_mb_rotl<5>(a), (f)), \
+												_mm_add_epi32(_mm_add_epi32(e, (k)), SCHEDULE(t))); \
+					e = d; d = c; c = sha1_mb_rotl<30>(b); b = a; a = tmp; \
+				} while (false)
+
+				const __m128i k0 = _mm_set1_epi32(0x5A827999);
+				const __m128i k1 = _mm_set1_epi32(0x6ED9EBA1);
+				const __m128i k2 = _mm_set1_epi32(static_cast<int>(0x8F1BBCDCu));
+				const __m128i k3 = _mm_set1_epi32(static_cast<int>(0xCA62C1D6u));
+
+				int t = 0;
+				for (; t < 20; ++t) {
+					STEP(_mm_xor_si128(d, _mm_and_si128(b, _mm_xor_si128(c, d))), k0, t);
+				}
+				for (; t < 40; ++t) {
+					STEP(_mm_xor_si128(_mm_xor_si128(b, c), d), k1, t);
+				}
+				for (; t < 60; ++t) {
+					STEP(_mm_or_si128(_mm_and_si128(b, c), _mm_and_si128(d, _mm_or_si128(b, c))), k2, t);
+				}
+				for (; t < 80; ++t) {
+					STEP(_mm_xor_si128(_mm_xor_si128(b, c), d), k3, t);
+				}
+
+#		undef STEP
+#		undef SCHEDULE
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(state[0]), _mm_add_epi32(a, _mm_loadu_si128(reinterpret_cast<const __m128i*>(state[0]))));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(state[1]), _mm_add_epi32(b, _mm_loadu_si128(reinterpret_cast<const __m128i*>(state[1]))));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(state[2]), _mm_add_epi32(c, _mm_loadu_si128(reinterpret_cast<const __m128i*>(state[2]))));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(state[3]), _mm_add_epi32(d, _mm_loadu_si128(reinterpret_cast<const __m128i*>(state[3]))));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(state[4]), _mm_add_epi32(e, _mm_loadu_si128(reinterpret_cast<const __m128i*>(state[4]))));
+			}
+
+			template <int S>
+			KERBAL_X86_TARGET("avx2")
+			inline
+			__m256i sha1_mb_rotl(__m256i x) KERBAL_NOEXCEPT
+			{
+				return _mm256_or_si256(_mm256_slli_epi32(x, S), _mm256_srli_epi32(x, 32 - S));
+			}
+
+			KERBAL_X86_TARGET("avx2")
+			inline
+			void sha1_transform_avx2_x8(kerbal::compatibility::uint32_t state[5][8],
+										const kerbal::compatibility::uint32_t w_in[16][8]) KERBAL_NOEXCEPT
+			{
+				__m256i w[16];
+				for (int t = 0; t < 16; ++t) {
+					w[t] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w_in[t]));
+				}
+
+				__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[0]));
+				__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[1]));
+				__m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[2]));
+				__m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[3]));
+				__m256i e = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[4]));
+
+#		define SCHEDULE(t) ((t) < 16 ? w[(t)] : (w[(t) & 15] = sha1_mb_rotl<1>( \
+					_mm256_xor_si256(_mm256_xor_si256(w[((t) - 3) & 15], w[((t) - 8) & 15]), \
+									_mm256_xor_si256(w[((t) - 14) & 15], w[(t) & 15])))))
+
+#		define STEP(f, k, t) do { \
+					__m256i tmp = _mm256_add_epi32(_mm256_add_epi32(sha1_mb_rotl<5>(a), (f)), \
+													_mm256_add_epi32(_mm256_add_epi32(e, (k)), SCHEDULE(t))); \
+					e = d; d = c; c = sha1_mb_rotl<30>(b); b = a; a = tmp; \
+				} while (false)
+
+				const __m256i k0 = _mm256_set1_epi32(0x5A827999);
+				const __m256i k1 = _mm256_set1_epi32(0x6ED9EBA1);
+				const __m256i k2 = _mm256_set1_epi32(static_cast<int>(0x8F1BBCDCu));
+				const __m256i k3 = _mm256_set1_epi32(static_cast<int>(0xCA62C1D6u));
+
+				int t = 0;
+				for (; t < 20; ++t) {
+					STEP(_mm256_xor_si256(d, _mm256_and_si256(b, _mm256_xor_si256(c, d))), k0, t);
+				}
+				for (; t < 40; ++t) {
+					STEP(_mm256_xor_si256(_mm256_xor_si256(b, c), d), k1, t);
+				}
+				for (; t < 60; ++t) {
+					STEP(_mm256_or_si256(_mm256_and_si256(b, c), _mm256_and_si256(d, _mm256_or_si256(b, c))), k2, t);
+				}
+				for (; t < 80; ++t) {
+					STEP(_mm256_xor_si256(_mm256_xor_si256(b, c), d), k3, t);
+				}
+
+#		undef STEP
+#		undef SCHEDULE
+
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(state[0]), _mm256_add_epi32(a, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[0]))));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(state[1]), _mm256_add_epi32(b, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[1]))));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(state[2]), _mm256_add_epi32(c, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[2]))));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(state[3]), _mm256_add_epi32(d, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[3]))));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(state[4]), _mm256_add_epi32(e, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[4]))));
+			}
+
+#	endif
+
+		} // namespace detail
+
+	} // namespace hash
+
+} // namespace kerbal
+
+#endif // KERBAL_HASH_DETAIL_SHA1_X86_TRANSFORM_HPP
@@ -0,0 +1,102 @@
+/**
+ * @file       sha256_x86_transform.hpp
+ * @brief
+ * @date       2020-10-21
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_HASH_DETAIL_SHA256_X86_TRANSFORM_HPP
+#define KERBAL_HASH_DETAIL_SHA256_X86_TRANSFORM_HPP
+
+#include <kerbal/compatibility/fixed_width_integer.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/compatibility/x86_cpu_feature.hpp>
+#include <kerbal/config/x86_intrinsics.hpp>
+
+#include <cstddef>
+
+namespace kerbal
+{
+
+	namespace hash
+	{
+
+		namespace detail
+		{
+
+#	if KERBAL_X86_INTRINSICS_SUPPORTED
+
+			inline
+			bool sha256_shani_supported() KERBAL_NOEXCEPT
+			{
+				const kerbal::compatibility::x86_cpu_feature & feature = kerbal::compatibility::x86_cpu_feature::instance();
+				return feature.sha && feature.ssse3 && feature.sse41;
+			}
+
+			/*
+			 * SHA-256 compression of n consecutive 64 bytes blocks with the SHA extensions (SHA-NI).
+			 * Only call it if sha256_shani_supported().
+			 *
+			 * The state is kept as the register pair {ABEF, CDGH} required by sha256rnds2.
+			 */
+			KERBAL_X86_TARGET("sha,ssse3,sse4.1")
+			inline
+			void sha256_transform_shani(kerbal::compatibility::uint32_t state[8],
+										const unsigned char * data, std::size_t n,
+										const kerbal::compatibility::uint32_t k[64]) KERBAL_NOEXCEPT
+			{
+				const __m128i BSWAP_MASK = _mm_set_epi64x(0x0c0d0e0f08090a0bLL, 0x0405060700010203LL);
+
+				__m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 0)), 0xB1); // CDAB
+				__m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4)), 0x1B); // EFGH
+				__m128i state0 = _mm_alignr_epi8(tmp, state1, 8); // ABEF
+				state1 = _mm_blend_epi16(state1, tmp, 0xF0); // CDGH
+
+				for (; n != 0; --n, data += 64) {
+					const __m128i abef_save = state0;
+					const __m128i cdgh_save = state1;
+
+					__m128i msg[4];
+					msg[0] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data +  0)), BSWAP_MASK);
+					msg[1] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16)), BSWAP_MASK);
+					msg[2] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 32)), BSWAP_MASK);
+					msg[3] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 48)), BSWAP_MASK);
+
+					for (int g = 0; g < 16; ++g) {
+						__m128i & w = msg[g & 3];
+						if (g >= 4) {
+							// W[t..t+3] = W[t-16..] + s0(W[t-15..]) + W[t-7..] + s1(W[t-2..])
+							const __m128i & w4 = msg[(g + 3) & 3];
+							const __m128i & w8 = msg[(g + 2) & 3];
+							w = _mm_sha256msg2_epu32(
+									_mm_add_epi32(_mm_sha256msg1_epu32(w, msg[(g + 1) & 3]), _mm_alignr_epi8(w4, w8, 4)),
+									w4);
+						}
+						__m128i wk = _mm_add_epi32(w, _mm_loadu_si128(reinterpret_cast<const __m128i*>(k + 4 * g)));
+						state1 = _mm_sha256rnds2_epu32(state1, state0, wk);
+						state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(wk, 0x0E));
+					}
+
+					state0 = _mm_add_epi32(state0, abef_save);
+					state1 = _mm_add_epi32(state1, cdgh_save);
+				}
+
+				tmp = _mm_shuffle_epi32(state0, 0x1B); // FEBA
+				state1 = _mm_shuffle_epi32(state1, 0xB1); // DCHG
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(state + 0), _mm_blend_epi16(tmp, state1, 0xF0)); // DCBA
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), _mm_alignr_epi8(state1, tmp, 8)); // HGFE
+			}
+
+#	endif
+
+		} // namespace detail
+
+	} // namespace hash
+
+} // namespace kerbal
+
+#endif // KERBAL_HASH_DETAIL_SHA256_X86_TRANSFORM_HPP
@@ -0,0 +1,142 @@
+/**
+ * @file       sha2_result.hpp
+ * @brief
+ * @date       2020-10-21
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_HASH_DETAIL_SHA2_RESULT_HPP
+#define KERBAL_HASH_DETAIL_SHA2_RESULT_HPP
+
+#include <kerbal/compatibility/constexpr.hpp>
+#include <kerbal/compatibility/fixed_width_integer.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+namespace kerbal
+{
+
+	namespace hash
+	{
+
+		namespace detail
+		{
+
+			template <typename TransformOverload, typename Result>
+			class sha2_context;
+
+			/*
+			 * Big-endian serialization of the first DigestSize bytes of the state words,
+			 * shared by SHA256_result and SHA512_result.
+			 */
+			template <typename Word, std::size_t DigestSize>
+			class sha2_result_base
+			{
+				public:
+					typedef kerbal::type_traits::integral_constant<std::size_t, DigestSize> DIGEST_SIZE;
+
+				protected:
+					unsigned char hash[DigestSize];
+
+					KERBAL_CONSTEXPR14
+					explicit sha2_result_base(const Word state[]) KERBAL_NOEXCEPT
+
+#	if __cplusplus >= 201103L
+						: hash { }
+#	endif
+
+					{
+						for (std::size_t i = 0; i < DigestSize; ++i) {
+							this->hash[i] = static_cast<unsigned char>(
+									(state[i / sizeof(Word)] >> ((sizeof(Word) - 1 - i % sizeof(Word)) * 8)) & 255u);
+						}
+					}
+
+					KERBAL_CONSTEXPR
+					static char to_ocx(char c) KERBAL_NOEXCEPT
+					{
+						return static_cast<char>(c < 10 ? '0' + c : 'a' - 10 + c);
+					}
+
+				public:
+					friend
+					std::ostream& operator<<(std::ostream& out, const sha2_result_base & result)
+					{
+						out << static_cast<std::string>(result);
+						return out;
+					}
+
+					operator std::string() const
+					{
+						char tmp[DigestSize * 2 + 1];
+						tmp[DigestSize * 2] = '\0';
+						for (std::size_t i = 0; i < DigestSize; ++i) {
+							tmp[i * 2 + 0] = to_ocx(static_cast<char>(hash[i] >> 4u));
+							tmp[i * 2 + 1] = to_ocx(static_cast<char>(hash[i] % 16u));
+						}
+						return std::string(tmp);
+					}
+
+					KERBAL_CONSTEXPR14
+					const unsigned char * data() const KERBAL_NOEXCEPT
+					{
+						return this->hash;
+					}
+
+					KERBAL_CONSTEXPR
+					static std::size_t size() KERBAL_NOEXCEPT
+					{
+						return DigestSize;
+					}
+
+			};
+
+		} // namespace detail
+
+		class SHA256_result : public detail::sha2_result_base<kerbal::compatibility::uint32_t, 32>
+		{
+			private:
+				template <typename TransformOverload, typename Result>
+				friend class detail::sha2_context;
+
+				typedef detail::sha2_result_base<kerbal::compatibility::uint32_t, 32> super;
+
+			private:
+				KERBAL_CONSTEXPR14
+				explicit SHA256_result(const kerbal::compatibility::uint32_t state[8]) KERBAL_NOEXCEPT
+						: super(state)
+				{
+				}
+
+		};
+
+		class SHA512_result : public detail::sha2_result_base<kerbal::compatibility::uint64_t, 64>
+		{
+			private:
+				template <typename TransformOverload, typename Result>
+				friend class detail::sha2_context;
+
+				typedef detail::sha2_result_base<kerbal::compatibility::uint64_t, 64> super;
+
+			private:
+				KERBAL_CONSTEXPR14
+				explicit SHA512_result(const kerbal::compatibility::uint64_t state[8]) KERBAL_NOEXCEPT
+						: super(state)
+				{
+				}
+
+		};
+
+	} // namespace hash
+
+} // namespace kerbal
+
+#endif // KERBAL_HASH_DETAIL_SHA2_RESULT_HPP
@@ -0,0 +1,302 @@
+/**
+ * @file       hash_file.hpp
+ * @brief      Feed the whole content of a file into a hash context
+ * @date       2020-10-24
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_HASH_HASH_FILE_HPP
+#define KERBAL_HASH_HASH_FILE_HPP
+
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+#include <kerbal/utility/noncopyable.hpp>
+#include <kerbal/utility/throw_this_exception.hpp>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <exception>
+#include <string>
+
+#ifndef KERBAL_HASH_FILE_USE_POSIX
+#	if defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))
+#		include <unistd.h>
+#		if defined(_POSIX_VERSION)
+#			define KERBAL_HASH_FILE_USE_POSIX 1
+#		endif
+#	endif
+#endif
+
+#ifndef KERBAL_HASH_FILE_USE_POSIX
+#	define KERBAL_HASH_FILE_USE_POSIX 0
+#endif
+
+#if KERBAL_HASH_FILE_USE_POSIX
+#	include <unistd.h>
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <sys/types.h>
+#endif
+
+namespace kerbal
+{
+
+	namespace hash
+	{
+
+		class hash_file_error:
+				public std::exception,
+				public kerbal::utility::throw_this_exception_helper<hash_file_error>
+		{
+			private:
+				int err;
+
+			public:
+				explicit hash_file_error(int err) KERBAL_NOEXCEPT :
+						err(err)
+				{
+				}
+
+				/**
+				 * The errno value reported by the failed system call.
+				 */
+				int error_code() const KERBAL_NOEXCEPT
+				{
+					return this->err;
+				}
+
+				virtual const char* what() const KERBAL_NOEXCEPT
+				{
+					return "Failed to open or read the file to hash.";
+				}
+		};
+
+		namespace detail
+		{
+
+			/*
+			 * Size of one block of the read() fall back. Large enough to amortize the system calls,
+			 * small enough to stay in the L2 cache while being hashed.
+			 */
+			typedef kerbal::type_traits::integral_constant<std::size_t, 1024 * 1024> HASH_FILE_BLOCK_SIZE;
+
+			class hash_file_block_buffer: private kerbal::utility::noncopyable
+			{
+				public:
+					unsigned char * p;
+
+					hash_file_block_buffer() :
+							p(new unsigned char[HASH_FILE_BLOCK_SIZE::value])
+					{
+					}
+
+					~hash_file_block_buffer() KERBAL_NOEXCEPT
+					{
+						delete[] p;
+					}
+			};
+
+#	if KERBAL_HASH_FILE_USE_POSIX
+
+			class hash_file_descriptor: private kerbal::utility::noncopyable
+			{
+				public:
+					int fd;
+
+					explicit hash_file_descriptor(const char * path) KERBAL_NOEXCEPT :
+							fd(::open(path, O_RDONLY))
+					{
+					}
+
+					~hash_file_descriptor() KERBAL_NOEXCEPT
+					{
+						if (fd != -1) {
+							::close(fd);
+						}
+					}
+			};
+
+			class hash_file_mapping: private kerbal::utility::noncopyable
+			{
+				public:
+					void * addr;
+					std::size_t len;
+
+					hash_file_mapping(int fd, std::size_t len) KERBAL_NOEXCEPT :
+							addr(::mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0)), len(len)
+					{
+					}
+
+					~hash_file_mapping() KERBAL_NOEXCEPT
+					{
+						if (addr != MAP_FAILED) {
+							::munmap(addr, len);
+						}
+					}
+			};
+
+			/*
+			 * Read the file block by block. While one block is being hashed, the kernel has already been
+			 * asked to bring the next one into the page cache, so the disk and the hash overlap.
+			 */
+			template <typename Context>
+			void update_from_file_read(Context & ctx, int fd)
+			{
+				typedef HASH_FILE_BLOCK_SIZE BLOCK_SIZE;
+
+#		if defined(POSIX_FADV_SEQUENTIAL)
+				::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#		endif
+
+				hash_file_block_buffer buffer;
+				off_t offset = 0;
+				while (true) {
+					std::size_t filled = 0;
+					while (filled < BLOCK_SIZE::value) {
+						ssize_t r = ::read(fd, buffer.p + filled, BLOCK_SIZE::value - filled);
+						if (r > 0) {
+							filled += static_cast<std::size_t>(r);
+						} else if (r == 0) {
+							break;
+						} else if (errno != EINTR) {
+							hash_file_error::throw_this_exception(errno);
+						}
+					}
+					if (filled == 0) {
+						break;
+					}
+					offset += static_cast<off_t>(filled);
+
+#		if defined(POSIX_FADV_WILLNEED)
+					::posix_fadvise(fd, offset, static_cast<off_t>(BLOCK_SIZE::value), POSIX_FADV_WILLNEED);
+#		endif
+
+					const unsigned char * const first = buffer.p;
+					ctx.update(first, first + filled);
+					if (filled < BLOCK_SIZE::value) {
+						break;
+					}
+				}
+			}
+
+#	endif
+
+		} // namespace detail
+
+		/**
+		 * Run the whole content of the file through the context.
+		 *
+		 * Regular files are memory mapped and fed to the context directly from the page cache, files
+		 * that can't be mapped (pipes, character devices, files larger than the address space...) are
+		 * read in large blocks instead.
+		 *
+		 * @throws hash_file_error if the file could not be opened or read.
+		 */
+		template <typename Context>
+		void update_from_file(Context & ctx, const char * path)
+		{
+
+#	if KERBAL_HASH_FILE_USE_POSIX
+
+			detail::hash_file_descriptor file(path);
+			if (file.fd == -1) {
+				hash_file_error::throw_this_exception(errno);
+			}
+
+			struct stat st;
+			if (::fstat(file.fd, &st) != 0) {
+				hash_file_error::throw_this_exception(errno);
+			}
+
+			if (S_ISREG(st.st_mode) && st.st_size > 0 &&
+				static_cast<unsigned long long>(st.st_size) <= static_cast<std::size_t>(-1)) {
+				std::size_t len = static_cast<std::size_t>(st.st_size);
+				detail::hash_file_mapping mapping(file.fd, len);
+				if (mapping.addr != MAP_FAILED) {
+
+#		if defined(POSIX_MADV_SEQUENTIAL)
+					::posix_madvise(mapping.addr, len, POSIX_MADV_SEQUENTIAL);
+#		endif
+
+					const unsigned char * const first = static_cast<const unsigned char *>(mapping.addr);
+					ctx.update(first, first + len);
+					return;
+				}
+			}
+
+			detail::update_from_file_read(ctx, file.fd);
+
+#	else
+
+			std::FILE * fp = std::fopen(path, "rb");
+			if (fp == NULL) {
+				hash_file_error::throw_this_exception(errno);
+			}
+
+			struct file_guard
+			{
+					std::FILE * fp;
+
+					~file_guard() KERBAL_NOEXCEPT
+					{
+						std::fclose(fp);
+					}
+			} guard = {fp};
+
+			detail::hash_file_block_buffer buffer;
+			std::size_t r;
+			while ((r = std::fread(buffer.p, 1, detail::HASH_FILE_BLOCK_SIZE::value, guard.fp)) != 0) {
+				const unsigned char * const first = buffer.p;
+				ctx.update(first, first + r);
+			}
+			if (std::ferror(guard.fp)) {
+				hash_file_error::throw_this_exception(errno);
+			}
+
+#	endif
+
+		}
+
+		template <typename Context>
+		void update_from_file(Context & ctx, const std::string & path)
+		{
+			kerbal::hash::update_from_file(ctx, path.c_str());
+		}
+
+		/**
+		 * Hash the whole content of the file with a fresh context.
+		 *
+		 * @code
+		 * kerbal::hash::SHA1_result r =
+		 *     kerbal::hash::hash_file<kerbal::hash::SHA1_context<kerbal::hash::SHA1_policy::fast> >("a.iso");
+		 * @endcode
+		 *
+		 * @throws hash_file_error if the file could not be opened or read.
+		 */
+		template <typename Context>
+		typename Context::result
+		hash_file(const char * path)
+		{
+			Context ctx;
+			kerbal::hash::update_from_file(ctx, path);
+			return ctx.digest();
+		}
+
+		template <typename Context>
+		typename Context::result
+		hash_file(const std::string & path)
+		{
+			return kerbal::hash::hash_file<Context>(path.c_str());
+		}
+
+	} // namespace hash
+
+} // namespace kerbal
+
+#endif // KERBAL_HASH_HASH_FILE_HPP
@@ -19,6 +19,7 @@
 #include <kerbal/type_traits/is_same.hpp>
 
 #include <kerbal/hash/sha1.hpp>
+#include <kerbal/hash/detail/sha1_x86_transform.hpp>
 
 namespace kerbal
 {
@@ -256,6 +257,59 @@ namespace kerbal
 			this->state[4] += e;
 		}
 
+		KERBAL_CONSTEXPR14
+		inline
+		void SHA1_transform_overload<SHA1_policy::size>::transform_blocks(const unsigned char * first, size_t n) KERBAL_NOEXCEPT
+		{
+			for (size_t i = 0; i < n; ++i) {
+				this->transform(first);
+				first += 64;
+			}
+		}
+
+		KERBAL_CONSTEXPR14
+		inline
+		void SHA1_transform_overload<SHA1_policy::fast>::transform_blocks(const unsigned char * first, size_t n) KERBAL_NOEXCEPT
+		{
+			for (size_t i = 0; i < n; ++i) {
+				this->transform(first);
+				first += 64;
+			}
+		}
+
+#	if KERBAL_IS_CONSTANT_EVALUATED_SUPPORTED && KERBAL_ENABLE_CONSTEXPR14
+		constexpr
+#	endif
+		inline
+		void SHA1_transform_overload<SHA1_policy::simd>::transform(const unsigned char buffer[64]) KERBAL_NOEXCEPT
+		{
+			this->transform_blocks(buffer, 1);
+		}
+
+#	if KERBAL_IS_CONSTANT_EVALUATED_SUPPORTED && KERBAL_ENABLE_CONSTEXPR14
+		constexpr
+#	endif
+		inline
+		void SHA1_transform_overload<SHA1_policy::simd>::transform_blocks(const unsigned char * first, size_t n) KERBAL_NOEXCEPT
+		{
+
+#	if KERBAL_X86_INTRINSICS_SUPPORTED
+
+#		if KERBAL_IS_CONSTANT_EVALUATED_SUPPORTED && KERBAL_ENABLE_CONSTEXPR14
+			if (!KERBAL_IS_CONSTANT_EVALUATED())
+#		endif
+			{
+				if (detail::sha1_shani_supported()) {
+					detail::sha1_transform_shani(this->state, first, n);
+					return;
+				}
+			}
+
+#	endif
+
+			super::transform_blocks(first, n);
+		}
+
 		template <typename Policy>
 		template <typename RandomAccessIterator>
 		KERBAL_CONSTEXPR14
@@ -336,11 +390,9 @@ namespace kerbal
 
 				this->transform(this->buffer);
 
-				int loop = (last - first) / 64;
-				for (int i = 0; i < loop; ++i) {
-					this->transform(first);
-					first += 64;
-				}
+				size_t loop = (last - first) / 64;
+				this->transform_blocks(first, loop);
+				first += loop * 64;
 				j = 0;
 			}
 
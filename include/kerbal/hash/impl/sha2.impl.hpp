@@ -0,0 +1,368 @@
+/**
+ * @file       sha2.impl.hpp
+ * @brief
+ * @date       2020-10-21
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_HASH_IMPL_SHA2_IMPL_HPP
+#define KERBAL_HASH_IMPL_SHA2_IMPL_HPP
+
+#include <kerbal/algorithm/modifier.hpp>
+#include <kerbal/compatibility/static_assert.hpp>
+#include <kerbal/iterator/iterator.hpp>
+#include <kerbal/iterator/iterator_traits.hpp>
+#include <kerbal/numeric/bit.hpp>
+#include <kerbal/type_traits/is_same.hpp>
+
+#include <kerbal/hash/sha2.hpp>
+#include <kerbal/hash/detail/sha256_x86_transform.hpp>
+
+namespace kerbal
+{
+
+	namespace hash
+	{
+
+#	define KERBAL_SHA256_ROUND_CONSTANTS \
+			0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5, \
+			0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, \
+			0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da, \
+			0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967, \
+			0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, \
+			0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070, \
+			0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3, \
+			0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+
+		namespace detail
+		{
+
+#	if __cplusplus >= 201103L
+
+			template <typename Word>
+			constexpr
+			sha2_context_base<Word>::sha2_context_base(Word h0, Word h1, Word h2, Word h3,
+														Word h4, Word h5, Word h6, Word h7) noexcept :
+					state { h0, h1, h2, h3, h4, h5, h6, h7 },
+					count(0), buffer { }
+			{
+			}
+
+#	else
+
+			template <typename Word>
+			sha2_context_base<Word>::sha2_context_base(Word h0, Word h1, Word h2, Word h3,
+														Word h4, Word h5, Word h6, Word h7) KERBAL_NOEXCEPT
+			{
+				this->state[0] = h0;
+				this->state[1] = h1;
+				this->state[2] = h2;
+				this->state[3] = h3;
+				this->state[4] = h4;
+				this->state[5] = h5;
+				this->state[6] = h6;
+				this->state[7] = h7;
+
+				this->count = 0;
+
+				// buffer doesn't need init
+			}
+
+#	endif
+
+			template <typename Word>
+			KERBAL_CONSTEXPR14
+			Word sha2_load_be(const unsigned char * p) KERBAL_NOEXCEPT
+			{
+				Word r = 0;
+				for (std::size_t i = 0; i < sizeof(Word); ++i) {
+					r = static_cast<Word>((r << 8u) | p[i]);
+				}
+				return r;
+			}
+
+		} // namespace detail
+
+
+
+		KERBAL_CONSTEXPR
+		inline
+		SHA256_transform_overload<SHA2_policy::fast>::SHA256_transform_overload() KERBAL_NOEXCEPT :
+				detail::sha2_context_base<kerbal::compatibility::uint32_t>(
+					0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+					0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19)
+		{
+		}
+
+		KERBAL_CONSTEXPR14
+		inline
+		void SHA256_transform_overload<SHA2_policy::fast>::transform_blocks(const unsigned char * first, std::size_t n) KERBAL_NOEXCEPT
+		{
+			typedef kerbal::compatibility::uint32_t uint32_t;
+
+			const uint32_t K[64] = { KERBAL_SHA256_ROUND_CONSTANTS };
+
+			for (; n != 0; --n, first += 64) {
+				uint32_t w[16] = {};
+				for (int i = 0; i < 16; ++i) {
+					w[i] = detail::sha2_load_be<uint32_t>(first + 4 * i);
+				}
+
+				uint32_t a = this->state[0];
+				uint32_t b = this->state[1];
+				uint32_t c = this->state[2];
+				uint32_t d = this->state[3];
+				uint32_t e = this->state[4];
+				uint32_t f = this->state[5];
+				uint32_t g = this->state[6];
+				uint32_t h = this->state[7];
+
+				for (int t = 0; t < 64; ++t) {
+					if (t >= 16) {
+						uint32_t w15 = w[(t - 15) & 15];
+						uint32_t w2 = w[(t - 2) & 15];
+						uint32_t s0 = kerbal::numeric::rotr(w15, 7) ^ kerbal::numeric::rotr(w15, 18) ^ (w15 >> 3u);
+						uint32_t s1 = kerbal::numeric::rotr(w2, 17) ^ kerbal::numeric::rotr(w2, 19) ^ (w2 >> 10u);
+						w[t & 15] += s0 + w[(t - 7) & 15] + s1;
+					}
+					uint32_t S1 = kerbal::numeric::rotr(e, 6) ^ kerbal::numeric::rotr(e, 11) ^ kerbal::numeric::rotr(e, 25);
+					uint32_t ch = (e & f) ^ (~e & g);
+					uint32_t temp1 = h + S1 + ch + K[t] + w[t & 15];
+					uint32_t S0 = kerbal::numeric::rotr(a, 2) ^ kerbal::numeric::rotr(a, 13) ^ kerbal::numeric::rotr(a, 22);
+					uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+					uint32_t temp2 = S0 + maj;
+
+					h = g;
+					g = f;
+					f = e;
+					e = d + temp1;
+					d = c;
+					c = b;
+					b = a;
+					a = temp1 + temp2;
+				}
+
+				this->state[0] += a;
+				this->state[1] += b;
+				this->state[2] += c;
+				this->state[3] += d;
+				this->state[4] += e;
+				this->state[5] += f;
+				this->state[6] += g;
+				this->state[7] += h;
+			}
+		}
+
+#	if KERBAL_IS_CONSTANT_EVALUATED_SUPPORTED && KERBAL_ENABLE_CONSTEXPR14
+		constexpr
+#	endif
+		inline
+		void SHA256_transform_overload<SHA2_policy::simd>::transform_blocks(const unsigned char * first, std::size_t n) KERBAL_NOEXCEPT
+		{
+
+#	if KERBAL_X86_INTRINSICS_SUPPORTED
+
+#		if KERBAL_IS_CONSTANT_EVALUATED_SUPPORTED && KERBAL_ENABLE_CONSTEXPR14
+			if (!KERBAL_IS_CONSTANT_EVALUATED())
+#		endif
+			{
+				if (detail::sha256_shani_supported()) {
+					const kerbal::compatibility::uint32_t K[64] = { KERBAL_SHA256_ROUND_CONSTANTS };
+					detail::sha256_transform_shani(this->state, first, n, K);
+					return;
+				}
+			}
+
+#	endif
+
+			super::transform_blocks(first, n);
+		}
+
+
+
+		KERBAL_CONSTEXPR
+		inline
+		SHA512_transform_overload<SHA2_policy::fast>::SHA512_transform_overload() KERBAL_NOEXCEPT :
+				detail::sha2_context_base<kerbal::compatibility::uint64_t>(
+					0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+					0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL)
+		{
+		}
+
+		KERBAL_CONSTEXPR14
+		inline
+		void SHA512_transform_overload<SHA2_policy::fast>::transform_blocks(const unsigned char * first, std::size_t n) KERBAL_NOEXCEPT
+		{
+			typedef kerbal::compatibility::uint64_t uint64_t;
+
+			const uint64_t K[80] = {
+				0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+				0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+				0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+				0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+				0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+				0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+				0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+				0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+				0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+				0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+				0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+				0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+				0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+				0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+				0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+				0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+				0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+				0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+				0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+				0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL,
+			};
+
+			for (; n != 0; --n, first += 128) {
+				uint64_t w[16] = {};
+				for (int i = 0; i < 16; ++i) {
+					w[i] = detail::sha2_load_be<uint64_t>(first + 8 * i);
+				}
+
+				uint64_t a = this->state[0];
+				uint64_t b = this->state[1];
+				uint64_t c = this->state[2];
+				uint64_t d = this->state[3];
+				uint64_t e = this->state[4];
+				uint64_t f = this->state[5];
+				uint64_t g = this->state[6];
+				uint64_t h = this->state[7];
+
+				for (int t = 0; t < 80; ++t) {
+					if (t >= 16) {
+						uint64_t w15 = w[(t - 15) & 15];
+						uint64_t w2 = w[(t - 2) & 15];
+						uint64_t s0 = kerbal::numeric::rotr(w15, 1) ^ kerbal::numeric::rotr(w15, 8) ^ (w15 >> 7u);
+						uint64_t s1 = kerbal::numeric::rotr(w2, 19) ^ kerbal::numeric::rotr(w2, 61) ^ (w2 >> 6u);
+						w[t & 15] += s0 + w[(t - 7) & 15] + s1;
+					}
+					uint64_t S1 = kerbal::numeric::rotr(e, 14) ^ kerbal::numeric::rotr(e, 18) ^ kerbal::numeric::rotr(e, 41);
+					uint64_t ch = (e & f) ^ (~e & g);
+					uint64_t temp1 = h + S1 + ch + K[t] + w[t & 15];
+					uint64_t S0 = kerbal::numeric::rotr(a, 28) ^ kerbal::numeric::rotr(a, 34) ^ kerbal::numeric::rotr(a, 39);
+					uint64_t maj = (a & b) ^ (a & c) ^ (b & c);
+					uint64_t temp2 = S0 + maj;
+
+					h = g;
+					g = f;
+					f = e;
+					e = d + temp1;
+					d = c;
+					c = b;
+					b = a;
+					a = temp1 + temp2;
+				}
+
+				this->state[0] += a;
+				this->state[1] += b;
+				this->state[2] += c;
+				this->state[3] += d;
+				this->state[4] += e;
+				this->state[5] += f;
+				this->state[6] += g;
+				this->state[7] += h;
+			}
+		}
+
+#	undef KERBAL_SHA256_ROUND_CONSTANTS
+
+
+
+		namespace detail
+		{
+
+			template <typename TransformOverload, typename Result>
+			KERBAL_CONSTEXPR14
+			void sha2_context<TransformOverload, Result>::update(const unsigned char * first, const unsigned char * last) KERBAL_NOEXCEPT
+			{
+				std::size_t len = static_cast<std::size_t>(last - first);
+				std::size_t j = static_cast<std::size_t>(this->count % BLOCK_SIZE::value);
+				this->count += len;
+
+				if (len >= BLOCK_SIZE::value - j) {
+					const unsigned char * next = first + (BLOCK_SIZE::value - j);
+					kerbal::algorithm::copy(first, next, this->buffer + j);
+					first = next;
+
+					this->transform_blocks(this->buffer, 1);
+
+					std::size_t loop = static_cast<std::size_t>(last - first) / BLOCK_SIZE::value;
+					this->transform_blocks(first, loop);
+					first += loop * BLOCK_SIZE::value;
+					j = 0;
+				}
+
+				kerbal::algorithm::copy(first, last, this->buffer + j);
+			}
+
+			template <typename TransformOverload, typename Result>
+			template <typename ForwardIterator>
+			KERBAL_CONSTEXPR14
+			void sha2_context<TransformOverload, Result>::update(ForwardIterator first, ForwardIterator last) KERBAL_NOEXCEPT
+			{
+				typedef ForwardIterator iterator;
+				typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+				KERBAL_STATIC_ASSERT((kerbal::type_traits::is_same<value_type, unsigned char>::value), "Iterator must refers to unsigned char");
+
+				unsigned char c[BLOCK_SIZE::value] = {};
+				while (first != last) {
+					std::size_t i = 0;
+					while (i < BLOCK_SIZE::value && first != last) {
+						c[i] = *first;
+						++i;
+						++first;
+					}
+					const unsigned char * const cfirst = c;
+					this->update(cfirst, cfirst + i);
+				}
+			}
+
+			template <typename TransformOverload, typename Result>
+			KERBAL_CONSTEXPR14
+			typename sha2_context<TransformOverload, Result>::result
+			sha2_context<TransformOverload, Result>::digest() KERBAL_NOEXCEPT
+			{
+				typedef kerbal::compatibility::uint64_t uint64_t;
+
+				// SHA-256 appends the bit length as a 64-bits integer, SHA-512 as a 128-bits one
+				const std::size_t length_field = 2 * sizeof(word_type);
+				const uint64_t bits_low = this->count << 3u;
+				const uint64_t bits_high = this->count >> 61u;
+
+				unsigned char final_count[2 * sizeof(uint64_t)] = {};
+				for (std::size_t i = 0; i < 8; ++i) {
+					final_count[15 - i] = static_cast<unsigned char>(bits_low >> (i * 8));
+					final_count[7 - i] = static_cast<unsigned char>(bits_high >> (i * 8));
+				}
+
+				{
+					const unsigned char p[BLOCK_SIZE::value] = {0200};
+					std::size_t j = static_cast<std::size_t>(this->count % BLOCK_SIZE::value);
+					std::size_t pad_len = j < BLOCK_SIZE::value - length_field ?
+											BLOCK_SIZE::value - length_field - j :
+											2 * BLOCK_SIZE::value - length_field - j;
+					this->update(p + 0, p + pad_len);
+				}
+
+				const unsigned char * const cfinal = final_count;
+				this->update(cfinal + (sizeof(final_count) - length_field), cfinal + sizeof(final_count));
+
+				return result(this->state);
+			}
+
+		} // namespace detail
+
+	} // namespace hash
+
+} // namespace kerbal
+
+#endif // KERBAL_HASH_IMPL_SHA2_IMPL_HPP
@@ -44,6 +44,7 @@
 
 #include <kerbal/compatibility/constexpr.hpp>
 #include <kerbal/compatibility/fixed_width_integer.hpp>
+#include <kerbal/compatibility/is_constant_evaluated.hpp>
 #include <kerbal/compatibility/noexcept.hpp>
 
 #include <cstddef>
@@ -100,6 +101,12 @@ namespace kerbal
 		{
 			struct fast {};
 			struct size {};
+
+			/*
+			 * Uses the x86 SHA extensions if the running processor supports them,
+			 * otherwise (or during constant evaluation) falls back to the policy fast
+			 */
+			struct simd {};
 		};
 
 		template <typename Policy>
@@ -119,6 +126,10 @@ namespace kerbal
 				KERBAL_CONSTEXPR14
 				void transform(const unsigned char buffer[64]) KERBAL_NOEXCEPT;
 
+				// warning: The function will read n * 64 unsigned char data from the iterator
+				KERBAL_CONSTEXPR14
+				void transform_blocks(const unsigned char * first, size_t n) KERBAL_NOEXCEPT;
+
 		};
 
 		template <>
@@ -134,6 +145,34 @@ namespace kerbal
 				KERBAL_CONSTEXPR14
 				void transform(const unsigned char buffer[64]) KERBAL_NOEXCEPT;
 
+				KERBAL_CONSTEXPR14
+				void transform_blocks(const unsigned char * first, size_t n) KERBAL_NOEXCEPT;
+
+		};
+
+		template <>
+		class SHA1_transform_overload<SHA1_policy::simd> : protected SHA1_transform_overload<SHA1_policy::fast>
+		{
+			private:
+				typedef SHA1_transform_overload<SHA1_policy::fast> super;
+
+			protected:
+
+#		if __cplusplus >= 201103L
+				constexpr
+				SHA1_transform_overload() noexcept = default;
+#		endif
+
+#		if KERBAL_IS_CONSTANT_EVALUATED_SUPPORTED && KERBAL_ENABLE_CONSTEXPR14
+				constexpr
+#		endif
+				void transform(const unsigned char buffer[64]) KERBAL_NOEXCEPT;
+
+#		if KERBAL_IS_CONSTANT_EVALUATED_SUPPORTED && KERBAL_ENABLE_CONSTEXPR14
+				constexpr
+#		endif
+				void transform_blocks(const unsigned char * first, size_t n) KERBAL_NOEXCEPT;
+
 		};
 
 		template <typename Policy>
@@ -0,0 +1,237 @@
+/**
+ * @file       sha1_multi_buffer.hpp
+ * @brief
+ * @date       2020-10-20
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_HASH_SHA1_MULTI_BUFFER_HPP
+#define KERBAL_HASH_SHA1_MULTI_BUFFER_HPP
+
+#include <kerbal/hash/sha1.hpp>
+#include <kerbal/hash/detail/sha1_result.hpp>
+#include <kerbal/hash/detail/sha1_x86_transform.hpp>
+
+#include <kerbal/algorithm/modifier.hpp>
+#include <kerbal/compatibility/fixed_width_integer.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/compatibility/static_assert.hpp>
+#include <kerbal/compatibility/x86_cpu_feature.hpp>
+#include <kerbal/config/x86_intrinsics.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+
+#include <cstddef>
+
+namespace kerbal
+{
+
+	namespace hash
+	{
+
+		namespace detail
+		{
+
+			/*
+			 * Drives a lane-parallel kernel over L messages of arbitrary (and possibly different) lengths.
+			 * Each lane is padded on its own; the lanes which have run out of blocks are fed with
+			 * a dummy block and their states are left untouched.
+			 */
+			template <std::size_t L>
+			struct sha1_multi_buffer_driver
+			{
+					typedef kerbal::compatibility::uint32_t uint32_t;
+					typedef kerbal::compatibility::uint64_t uint64_t;
+					typedef void (*kernel_type)(uint32_t state[5][L], const uint32_t w[16][L]);
+
+					static uint32_t load_be32(const unsigned char * p) KERBAL_NOEXCEPT
+					{
+						return (static_cast<uint32_t>(p[0]) << 24u) | (static_cast<uint32_t>(p[1]) << 16u) |
+								(static_cast<uint32_t>(p[2]) << 8u) | static_cast<uint32_t>(p[3]);
+					}
+
+					static void run(kernel_type kernel,
+									const unsigned char * const first[], const unsigned char * const last[],
+									uint32_t result[][5]) KERBAL_NOEXCEPT
+					{
+						uint32_t state[5][L];
+						uint32_t w[16][L];
+						std::size_t full_blocks[L];
+						std::size_t total_blocks[L];
+						unsigned char tail[L][128];
+
+						std::size_t max_blocks = 0;
+
+						for (std::size_t i = 0; i < L; ++i) {
+							state[0][i] = 0x67452301;
+							state[1][i] = 0xEFCDAB89;
+							state[2][i] = 0x98BADCFE;
+							state[3][i] = 0x10325476;
+							state[4][i] = 0xC3D2E1F0;
+
+							std::size_t len = last[i] - first[i];
+							std::size_t rest = len % 64;
+							full_blocks[i] = len / 64;
+							std::size_t tail_blocks = rest + 9 <= 64 ? 1 : 2;
+							total_blocks[i] = full_blocks[i] + tail_blocks;
+							if (total_blocks[i] > max_blocks) {
+								max_blocks = total_blocks[i];
+							}
+
+							unsigned char * pad = tail[i];
+							kerbal::algorithm::copy(first[i] + full_blocks[i] * 64, last[i], pad);
+							pad[rest] = 0x80;
+							kerbal::algorithm::fill(pad + rest + 1, pad + tail_blocks * 64 - 8, static_cast<unsigned char>(0));
+							uint64_t bit_len = static_cast<uint64_t>(len) << 3u;
+							for (int k = 0; k < 8; ++k) {
+								pad[tail_blocks * 64 - 1 - k] = static_cast<unsigned char>(bit_len >> (k * 8));
+							}
+						}
+
+						for (std::size_t j = 0; j < max_blocks; ++j) {
+							bool all_active = true;
+							for (std::size_t i = 0; i < L; ++i) {
+								const unsigned char * block = tail[i];
+								if (j < full_blocks[i]) {
+									block = first[i] + j * 64;
+								} else if (j < total_blocks[i]) {
+									block = tail[i] + (j - full_blocks[i]) * 64;
+								} else {
+									all_active = false;
+								}
+								for (int t = 0; t < 16; ++t) {
+									w[t][i] = load_be32(block + 4 * t);
+								}
+							}
+
+							if (all_active) {
+								kernel(state, w);
+							} else {
+								uint32_t next[5][L];
+								kerbal::algorithm::copy(&state[0][0], &state[0][0] + 5 * L, &next[0][0]);
+								kernel(next, w);
+								for (std::size_t i = 0; i < L; ++i) {
+									if (j < total_blocks[i]) {
+										for (int k = 0; k < 5; ++k) {
+											state[k][i] = next[k][i];
+										}
+									}
+								}
+							}
+						}
+
+						for (std::size_t i = 0; i < L; ++i) {
+							for (int k = 0; k < 5; ++k) {
+								result[i][k] = state[k][i];
+							}
+						}
+					}
+			};
+
+		} // namespace detail
+
+		/**
+		 * Computes the SHA-1 digests of Lanes independent messages at once.
+		 *
+		 * Where the x86 vector extensions are available, the messages are compressed in the
+		 * parallel lanes of SSE2 (4 lanes) or AVX2 (8 lanes) registers, which is far more throughput
+		 * than hashing them one by one when a single message is too short to saturate the core.
+		 * The lanes stay busy only as long as their messages, so it pays off most with batches
+		 * of messages of similar length.
+		 *
+		 * Otherwise each message is hashed by SHA1_context<SHA1_policy::fast>.
+		 */
+		template <std::size_t Lanes>
+		class SHA1_multi_buffer_context
+		{
+				KERBAL_STATIC_ASSERT(Lanes == 4 || Lanes == 8, "Lanes must be 4 or 8");
+
+			public:
+				typedef SHA1_result result;
+				typedef kerbal::type_traits::integral_constant<std::size_t, Lanes> LANES;
+
+			private:
+				typedef kerbal::compatibility::uint32_t uint32_t;
+
+				template <typename OutputIterator>
+				static OutputIterator scalar_digest(const unsigned char * const first[], const unsigned char * const last[],
+													std::size_t n, OutputIterator out)
+				{
+					for (std::size_t i = 0; i < n; ++i) {
+						SHA1_context<SHA1_policy::fast> ctx;
+						ctx.update(first[i], last[i]);
+						*out = ctx.digest();
+						++out;
+					}
+					return out;
+				}
+
+				template <typename OutputIterator>
+				static OutputIterator lanes_digest(const unsigned char * const first[], const unsigned char * const last[],
+													OutputIterator out, kerbal::type_traits::integral_constant<std::size_t, 4>)
+				{
+
+#		if KERBAL_X86_INTRINSICS_SUPPORTED
+
+					if (kerbal::compatibility::x86_cpu_feature::instance().sse2) {
+						uint32_t state[4][5];
+						detail::sha1_multi_buffer_driver<4>::run(detail::sha1_transform_sse2_x4, first, last, state);
+						for (std::size_t i = 0; i < 4; ++i) {
+							*out = result(state[i]);
+							++out;
+						}
+						return out;
+					}
+
+#		endif
+
+					return scalar_digest(first, last, 4, out);
+				}
+
+				template <typename OutputIterator>
+				static OutputIterator lanes_digest(const unsigned char * const first[], const unsigned char * const last[],
+													OutputIterator out, kerbal::type_traits::integral_constant<std::size_t, 8>)
+				{
+
+#		if KERBAL_X86_INTRINSICS_SUPPORTED
+
+					if (kerbal::compatibility::x86_cpu_feature::instance().avx2) {
+						uint32_t state[8][5];
+						detail::sha1_multi_buffer_driver<8>::run(detail::sha1_transform_avx2_x8, first, last, state);
+						for (std::size_t i = 0; i < 8; ++i) {
+							*out = result(state[i]);
+							++out;
+						}
+						return out;
+					}
+
+#		endif
+
+					typedef kerbal::type_traits::integral_constant<std::size_t, 4> HALF;
+					out = lanes_digest(first, last, out, HALF());
+					return lanes_digest(first + 4, last + 4, out, HALF());
+				}
+
+			public:
+
+				/**
+				 * Hashes the messages [first[i], last[i]) for i in [0, Lanes),
+				 * the results are written to out in the same order.
+				 */
+				template <typename OutputIterator>
+				OutputIterator digest(const unsigned char * const first[Lanes], const unsigned char * const last[Lanes],
+										OutputIterator out) const
+				{
+					return lanes_digest(first, last, out, LANES());
+				}
+
+		};
+
+	} // namespace hash
+
+} // namespace kerbal
+
+#endif // KERBAL_HASH_SHA1_MULTI_BUFFER_HPP
@@ -0,0 +1,191 @@
+/**
+ * @file       sha2.hpp
+ * @brief      SHA-256 and SHA-512 (FIPS PUB 180-4)
+ * @date       2020-10-21
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ *
+ *	Test Vectors
+ *	SHA-256 "abc"
+ *	  BA7816BF 8F01CFEA 414140DE 5DAE2223 B00361A3 96177A9C B410FF61 F20015AD
+ *	SHA-512 "abc"
+ *	  DDAF35A1 93617ABA CC417349 AE204131 12E6FA4E 89A97EA2 0A9EEEE6 4B55D39A
+ *	  2192992A 274FC1A8 36BA3C23 A3FEEBBD 454D4423 643CE80E 2A9AC94F A54CA49F
+ */
+
+#ifndef KERBAL_HASH_SHA2_HPP
+#define KERBAL_HASH_SHA2_HPP
+
+#include <kerbal/hash/detail/sha2_result.hpp>
+
+#include <kerbal/compatibility/constexpr.hpp>
+#include <kerbal/compatibility/fixed_width_integer.hpp>
+#include <kerbal/compatibility/is_constant_evaluated.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+
+#include <cstddef>
+
+namespace kerbal
+{
+
+	namespace hash
+	{
+
+		struct SHA2_policy
+		{
+			struct fast {};
+
+			/*
+			 * SHA-256 uses the x86 SHA extensions if the running processor supports them,
+			 * otherwise (or during constant evaluation) falls back to the policy fast.
+			 * SHA-512 has no widely deployed instructions yet, so it's the same as fast.
+			 */
+			struct simd {};
+		};
+
+		namespace detail
+		{
+
+			template <typename Word>
+			class sha2_context_base
+			{
+				public:
+					typedef Word word_type;
+					typedef kerbal::type_traits::integral_constant<std::size_t, 16 * sizeof(Word)> BLOCK_SIZE;
+
+				protected:
+					Word state[8];
+					kerbal::compatibility::uint64_t count; // bytes have been processed
+					unsigned char buffer[BLOCK_SIZE::value];
+
+					KERBAL_CONSTEXPR
+					sha2_context_base(Word h0, Word h1, Word h2, Word h3,
+									Word h4, Word h5, Word h6, Word h7) KERBAL_NOEXCEPT;
+
+			};
+
+		} // namespace detail
+
+		template <typename Policy>
+		class SHA256_transform_overload;
+
+		template <>
+		class SHA256_transform_overload<SHA2_policy::fast> :
+				protected detail::sha2_context_base<kerbal::compatibility::uint32_t>
+		{
+			protected:
+				KERBAL_CONSTEXPR
+				SHA256_transform_overload() KERBAL_NOEXCEPT;
+
+				// warning: The function will read n * 64 unsigned char data from the iterator
+				KERBAL_CONSTEXPR14
+				void transform_blocks(const unsigned char * first, std::size_t n) KERBAL_NOEXCEPT;
+
+		};
+
+		template <>
+		class SHA256_transform_overload<SHA2_policy::simd> :
+				protected SHA256_transform_overload<SHA2_policy::fast>
+		{
+			private:
+				typedef SHA256_transform_overload<SHA2_policy::fast> super;
+
+			protected:
+				KERBAL_CONSTEXPR
+				SHA256_transform_overload() KERBAL_NOEXCEPT
+				{
+				}
+
+#		if KERBAL_IS_CONSTANT_EVALUATED_SUPPORTED && KERBAL_ENABLE_CONSTEXPR14
+				constexpr
+#		endif
+				void transform_blocks(const unsigned char * first, std::size_t n) KERBAL_NOEXCEPT;
+
+		};
+
+		template <typename Policy>
+		class SHA512_transform_overload;
+
+		template <>
+		class SHA512_transform_overload<SHA2_policy::fast> :
+				protected detail::sha2_context_base<kerbal::compatibility::uint64_t>
+		{
+			protected:
+				KERBAL_CONSTEXPR
+				SHA512_transform_overload() KERBAL_NOEXCEPT;
+
+				// warning: The function will read n * 128 unsigned char data from the iterator
+				KERBAL_CONSTEXPR14
+				void transform_blocks(const unsigned char * first, std::size_t n) KERBAL_NOEXCEPT;
+
+		};
+
+		template <>
+		class SHA512_transform_overload<SHA2_policy::simd> :
+				protected SHA512_transform_overload<SHA2_policy::fast>
+		{
+			protected:
+				KERBAL_CONSTEXPR
+				SHA512_transform_overload() KERBAL_NOEXCEPT
+				{
+				}
+		};
+
+		namespace detail
+		{
+
+			template <typename TransformOverload, typename Result>
+			class sha2_context : protected TransformOverload
+			{
+				private:
+					typedef TransformOverload super;
+					typedef typename super::word_type word_type;
+					typedef typename super::BLOCK_SIZE BLOCK_SIZE;
+
+				public:
+					typedef Result result;
+
+				public:
+					/*
+					 * Run your data through this.
+					 */
+					template <typename ForwardIterator> // unsigned char
+					KERBAL_CONSTEXPR14
+					void update(ForwardIterator first, ForwardIterator last) KERBAL_NOEXCEPT;
+
+					KERBAL_CONSTEXPR14
+					void update(const unsigned char * first, const unsigned char * last) KERBAL_NOEXCEPT;
+
+					/**
+					 * Add padding and return the message digest.
+					 */
+					KERBAL_CONSTEXPR14
+					result digest() KERBAL_NOEXCEPT;
+
+			};
+
+		} // namespace detail
+
+		template <typename Policy>
+		class SHA256_context :
+				public detail::sha2_context<SHA256_transform_overload<Policy>, SHA256_result>
+		{
+		};
+
+		template <typename Policy>
+		class SHA512_context :
+				public detail::sha2_context<SHA512_transform_overload<Policy>, SHA512_result>
+		{
+		};
+
+	} // namespace hash
+
+} // namespace kerbal
+
+#include <kerbal/hash/impl/sha2.impl.hpp>
+
+#endif // KERBAL_HASH_SHA2_HPP
@@ -0,0 +1,281 @@
+/**
+ * @file       tree_hash.hpp
+ * @brief      Tree hashing mode, leaves are hashed in parallel by openMP
+ * @date       2020-10-25
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ *
+ *	Definition of the output, for a message M of length L split into leaves M[0], M[1], ... of LeafSize bytes
+ *	(the last one may be shorter, an empty message consists of one empty leaf):
+ *
+ *	  leaf(i)        = H(0x00 || M[i])
+ *	  node(l, r)     = H(0x01 || l || r)
+ *	  digest         = H(0x02 || root || L as 64-bits big-endian)
+ *
+ *	where H is the underlying context and a digest is serialized by its bytes (integral digests in big-endian).
+ *	The root is the left-balanced binary tree over the leaves: the largest perfect subtree is on the left and
+ *	the rest is built in the same way on the right. The output only depends on the message and LeafSize,
+ *	never on the number of threads.
+ */
+
+#ifndef KERBAL_HASH_TREE_HASH_HPP
+#define KERBAL_HASH_TREE_HASH_HPP
+
+#include <kerbal/compatibility/fixed_width_integer.hpp>
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/compatibility/static_assert.hpp>
+#include <kerbal/iterator/iterator_traits.hpp>
+#include <kerbal/type_traits/fundamental_deduction.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+#include <kerbal/type_traits/is_same.hpp>
+
+#include <cstddef>
+#include <cstring>
+
+namespace kerbal
+{
+
+	namespace hash
+	{
+
+		namespace detail
+		{
+
+			template <typename Result, bool = kerbal::type_traits::is_integral<Result>::value>
+			struct tree_hash_digest_traits;
+
+			template <typename Result>
+			struct tree_hash_digest_traits<Result, true>
+			{
+					typedef kerbal::type_traits::integral_constant<std::size_t, sizeof(Result)> DIGEST_SIZE;
+
+					static void serialize(const Result & r, unsigned char * out) KERBAL_NOEXCEPT
+					{
+						for (std::size_t i = 0; i < sizeof(Result); ++i) {
+							out[i] = static_cast<unsigned char>(r >> ((sizeof(Result) - 1 - i) * 8));
+						}
+					}
+			};
+
+			template <typename Result>
+			struct tree_hash_digest_traits<Result, false>
+			{
+					typedef typename Result::DIGEST_SIZE DIGEST_SIZE;
+
+					static void serialize(const Result & r, unsigned char * out) KERBAL_NOEXCEPT
+					{
+						std::memcpy(out, r.data(), DIGEST_SIZE::value);
+					}
+			};
+
+		} // namespace detail
+
+		/**
+		 * Context of the tree hashing mode on top of another hash context (SHA1_context, SHA256_context,
+		 * CRC32C_context ...), which must provide update(const unsigned char *, const unsigned char *) and digest().
+		 *
+		 * Each call to update hashes the complete leaves it contains in parallel when openMP is enabled, so
+		 * pass large spans (for instance a whole mapped file, see hash_file) to keep all the cores busy.
+		 */
+		template <typename Context, std::size_t LeafSize = 1024 * 1024>
+		class tree_hash_context
+		{
+			public:
+				typedef typename Context::result result;
+				typedef kerbal::type_traits::integral_constant<std::size_t, LeafSize> LEAF_SIZE;
+
+			private:
+				typedef detail::tree_hash_digest_traits<typename Context::result> digest_traits;
+				typedef typename digest_traits::DIGEST_SIZE DIGEST_SIZE;
+
+				KERBAL_STATIC_ASSERT(LeafSize > 0, "LeafSize must be positive");
+
+				/*
+				 * number of leaves hashed by one parallel region
+				 */
+				typedef kerbal::type_traits::integral_constant<std::size_t, 64> BATCH;
+
+				enum
+				{
+					LEAF_PREFIX = 0x00,
+					NODE_PREFIX = 0x01,
+					ROOT_PREFIX = 0x02
+				};
+
+				/*
+				 * stack[i] is the root of a perfect subtree, the sizes of the subtrees are strictly decreasing,
+				 * and are given by the bits of leaf_count
+				 */
+				unsigned char stack[64][DIGEST_SIZE::value];
+				std::size_t depth;
+				kerbal::compatibility::uint64_t leaf_count;
+				kerbal::compatibility::uint64_t count; // bytes have been processed
+
+				Context leaf_ctx; // the leaf being filled
+				std::size_t leaf_fill;
+
+				static void feed_byte(Context & ctx, unsigned char c) KERBAL_NOEXCEPT
+				{
+					const unsigned char * const p = &c;
+					ctx.update(p, p + 1);
+				}
+
+				static void hash_leaf(const unsigned char * first, std::size_t len, unsigned char * out) KERBAL_NOEXCEPT
+				{
+					Context ctx;
+					feed_byte(ctx, LEAF_PREFIX);
+					ctx.update(first, first + len);
+					digest_traits::serialize(ctx.digest(), out);
+				}
+
+				static void hash_node(const unsigned char * l, const unsigned char * r, unsigned char * out) KERBAL_NOEXCEPT
+				{
+					Context ctx;
+					feed_byte(ctx, NODE_PREFIX);
+					ctx.update(l, l + DIGEST_SIZE::value);
+					ctx.update(r, r + DIGEST_SIZE::value);
+					digest_traits::serialize(ctx.digest(), out);
+				}
+
+				void push_leaf(const unsigned char * digest) KERBAL_NOEXCEPT
+				{
+					std::memcpy(this->stack[this->depth], digest, DIGEST_SIZE::value);
+					++this->depth;
+					++this->leaf_count;
+					for (kerbal::compatibility::uint64_t c = this->leaf_count; (c & 1u) == 0; c >>= 1u) {
+						--this->depth;
+						hash_node(this->stack[this->depth - 1], this->stack[this->depth], this->stack[this->depth - 1]);
+					}
+				}
+
+				void finish_leaf() KERBAL_NOEXCEPT
+				{
+					unsigned char digest[DIGEST_SIZE::value];
+					digest_traits::serialize(this->leaf_ctx.digest(), digest);
+					this->push_leaf(digest);
+					this->leaf_ctx = Context();
+					feed_byte(this->leaf_ctx, LEAF_PREFIX);
+					this->leaf_fill = 0;
+				}
+
+				void update_leaves(const unsigned char * first, std::size_t n) KERBAL_NOEXCEPT
+				{
+					unsigned char digests[BATCH::value][DIGEST_SIZE::value];
+					while (n != 0) {
+						std::size_t batch = n < BATCH::value ? n : BATCH::value;
+						std::ptrdiff_t sbatch = static_cast<std::ptrdiff_t>(batch);
+
+#	if defined(_OPENMP)
+#						pragma omp parallel for schedule(static)
+#	endif
+						for (std::ptrdiff_t i = 0; i < sbatch; ++i) {
+							hash_leaf(first + i * LeafSize, LeafSize, digests[i]);
+						}
+
+						for (std::size_t i = 0; i < batch; ++i) {
+							this->push_leaf(digests[i]);
+						}
+						first += batch * LeafSize;
+						n -= batch;
+					}
+				}
+
+			public:
+				tree_hash_context() KERBAL_NOEXCEPT :
+						depth(0), leaf_count(0), count(0), leaf_ctx(), leaf_fill(0)
+				{
+					feed_byte(this->leaf_ctx, LEAF_PREFIX);
+				}
+
+				/*
+				 * Run your data through this.
+				 */
+				void update(const unsigned char * first, const unsigned char * last) KERBAL_NOEXCEPT
+				{
+					std::size_t len = static_cast<std::size_t>(last - first);
+					this->count += len;
+
+					if (this->leaf_fill != 0) {
+						std::size_t need = LeafSize - this->leaf_fill;
+						if (len < need) {
+							this->leaf_ctx.update(first, last);
+							this->leaf_fill += len;
+							return;
+						}
+						this->leaf_ctx.update(first, first + need);
+						this->finish_leaf();
+						first += need;
+						len -= need;
+					}
+
+					std::size_t leaves = len / LeafSize;
+					this->update_leaves(first, leaves);
+					first += leaves * LeafSize;
+
+					this->leaf_ctx.update(first, last);
+					this->leaf_fill = static_cast<std::size_t>(last - first);
+				}
+
+				template <typename ForwardIterator> // unsigned char
+				void update(ForwardIterator first, ForwardIterator last) KERBAL_NOEXCEPT
+				{
+					typedef ForwardIterator iterator;
+					typedef typename kerbal::iterator::iterator_traits<iterator>::value_type value_type;
+					KERBAL_STATIC_ASSERT((kerbal::type_traits::is_same<value_type, unsigned char>::value), "Iterator must refers to unsigned char");
+
+					unsigned char c[256];
+					while (first != last) {
+						std::size_t i = 0;
+						while (i < sizeof(c) && first != last) {
+							c[i] = *first;
+							++i;
+							++first;
+						}
+						const unsigned char * const cfirst = c;
+						this->update(cfirst, cfirst + i);
+					}
+				}
+
+				/**
+				 * Return the digest of the data have been run through. The context could still be updated after that.
+				 */
+				result digest() const KERBAL_NOEXCEPT
+				{
+					unsigned char node[DIGEST_SIZE::value];
+					std::size_t i = this->depth;
+
+					if (this->leaf_fill != 0 || this->leaf_count == 0) {
+						Context leaf(this->leaf_ctx);
+						digest_traits::serialize(leaf.digest(), node);
+					} else {
+						--i;
+						std::memcpy(node, this->stack[i], DIGEST_SIZE::value);
+					}
+
+					while (i != 0) {
+						--i;
+						hash_node(this->stack[i], node, node);
+					}
+
+					unsigned char length[8];
+					detail::tree_hash_digest_traits<kerbal::compatibility::uint64_t>::serialize(this->count, length);
+
+					Context ctx;
+					feed_byte(ctx, ROOT_PREFIX);
+					const unsigned char * const cnode = node;
+					ctx.update(cnode, cnode + DIGEST_SIZE::value);
+					const unsigned char * const clength = length;
+					ctx.update(clength, clength + 8);
+					return ctx.digest();
+				}
+
+		};
+
+	} // namespace hash
+
+} // namespace kerbal
+
+#endif // KERBAL_HASH_TREE_HASH_HPP
@@ -473,6 +473,39 @@ namespace kerbal
 
 		} // namespace detail
 
+		/**
+		 * Whether Alloc provides `pointer reallocate(pointer p, size_type old_n, size_type new_n)` which resizes
+		 * a block while moving its content bitwise. Pre C++11, the allocators have to opt in by specialization.
+		 */
+#	if __cplusplus >= 201103L
+
+		template <typename Alloc, typename = kerbal::type_traits::void_type<>::type>
+		struct allocator_has_reallocate: kerbal::type_traits::false_type
+		{
+		};
+
+		template <typename Alloc>
+		struct allocator_has_reallocate<Alloc, typename kerbal::type_traits::void_type<
+				decltype(
+					kerbal::utility::declval<Alloc&>().reallocate(
+							kerbal::utility::declval<typename Alloc::value_type*>(),
+							kerbal::utility::declval<size_t>(),
+							kerbal::utility::declval<size_t>()
+					)
+				)
+		>::type >: kerbal::type_traits::true_type
+		{
+		};
+
+#	else
+
+		template <typename Alloc>
+		struct allocator_has_reallocate: kerbal::type_traits::false_type
+		{
+		};
+
+#	endif // __cplusplus >= 201103L
+
 		template <typename Alloc>
 		struct allocator_traits
 		{
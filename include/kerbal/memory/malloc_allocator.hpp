@@ -0,0 +1,154 @@
+/**
+ * @file       malloc_allocator.hpp
+ * @brief
+ * @date       2020-11-02
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_MEMORY_MALLOC_ALLOCATOR_HPP
+#define KERBAL_MEMORY_MALLOC_ALLOCATOR_HPP
+
+#include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/memory/allocator_traits.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+#include <kerbal/utility/throw_this_exception.hpp>
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace kerbal
+{
+
+	namespace memory
+	{
+
+		/**
+		 * Allocator that obtains its memory from std::malloc.
+		 *
+		 * Besides allocate/deallocate it provides reallocate(p, old_n, new_n) based on std::realloc, which
+		 * containers use to grow a buffer of trivially relocatable elements in place. On glibc, a large block
+		 * is mmap-ed and realloc moves it with mremap, i.e. without copying a single page.
+		 */
+		template <typename Tp>
+		class malloc_allocator
+		{
+			public:
+				typedef Tp						value_type;
+				typedef Tp*						pointer;
+				typedef const Tp*				const_pointer;
+				typedef Tp&						reference;
+				typedef const Tp&				const_reference;
+				typedef std::size_t				size_type;
+				typedef std::ptrdiff_t			difference_type;
+
+				typedef kerbal::type_traits::true_type		propagate_on_container_move_assignment;
+				typedef kerbal::type_traits::true_type		is_always_equal;
+
+				template <typename Up>
+				struct rebind
+				{
+						typedef malloc_allocator<Up> other;
+				};
+
+			public:
+				malloc_allocator() KERBAL_NOEXCEPT
+				{
+				}
+
+				template <typename Up>
+				malloc_allocator(const malloc_allocator<Up> &) KERBAL_NOEXCEPT
+				{
+				}
+
+				size_type max_size() const KERBAL_NOEXCEPT
+				{
+					return static_cast<size_type>(-1) / sizeof(value_type);
+				}
+
+				pointer allocate(size_type n)
+				{
+					if (n > this->max_size()) {
+						kerbal::utility::throw_this_exception_helper<std::bad_alloc>::throw_this_exception();
+					}
+					void * p = std::malloc(n * sizeof(value_type));
+					if (p == NULL && n != 0) {
+						kerbal::utility::throw_this_exception_helper<std::bad_alloc>::throw_this_exception();
+					}
+					return static_cast<pointer>(p);
+				}
+
+				void deallocate(pointer p, size_type) KERBAL_NOEXCEPT
+				{
+					std::free(p);
+				}
+
+				/**
+				 * Resizes the block p of old_n objects to new_n objects, the first min(old_n, new_n) objects are
+				 * moved bitwise. p may be NULL if old_n is 0. If new_n is 0, p is freed and NULL is returned.
+				 *
+				 * @warning If the reallocation fails, std::bad_alloc is thrown and p is left untouched.
+				 */
+				pointer reallocate(pointer p, size_type /*old_n*/, size_type new_n)
+				{
+					if (new_n == 0) {
+						// what realloc(p, 0) does is implementation-defined
+						std::free(p);
+						return NULL;
+					}
+					if (new_n > this->max_size()) {
+						kerbal::utility::throw_this_exception_helper<std::bad_alloc>::throw_this_exception();
+					}
+					void * q = std::realloc(static_cast<void *>(p), new_n * sizeof(value_type));
+					if (q == NULL) {
+						kerbal::utility::throw_this_exception_helper<std::bad_alloc>::throw_this_exception();
+					}
+					return static_cast<pointer>(q);
+				}
+
+#		if __cplusplus < 201103L
+
+				void construct(pointer p, const_reference val)
+				{
+					::new(static_cast<void*>(p)) value_type(val);
+				}
+
+				void destroy(pointer p)
+				{
+					p->~value_type();
+				}
+
+#		endif
+
+		};
+
+		template <typename Tp, typename Up>
+		bool operator==(const malloc_allocator<Tp> &, const malloc_allocator<Up> &) KERBAL_NOEXCEPT
+		{
+			return true;
+		}
+
+		template <typename Tp, typename Up>
+		bool operator!=(const malloc_allocator<Tp> &, const malloc_allocator<Up> &) KERBAL_NOEXCEPT
+		{
+			return false;
+		}
+
+#	if __cplusplus < 201103L
+
+		template <typename Tp>
+		struct allocator_has_reallocate<malloc_allocator<Tp> >: kerbal::type_traits::true_type
+		{
+		};
+
+#	endif
+
+	} // namespace memory
+
+} // namespace kerbal
+
+#endif // KERBAL_MEMORY_MALLOC_ALLOCATOR_HPP
@@ -24,12 +24,19 @@
 #endif
 
 #include <kerbal/compatibility/constexpr.hpp>
+#include <kerbal/compatibility/is_constant_evaluated.hpp>
 #include <kerbal/compatibility/noexcept.hpp>
+#include <kerbal/config/architecture.hpp>
 #include <kerbal/container/array.hpp>
 #include <kerbal/type_traits/integral_constant.hpp>
 #include <kerbal/type_traits/sign_deduction.hpp>
 
+#if defined(__BMI2__)
+#	include <kerbal/config/x86_intrinsics.hpp>
+#endif
+
 #include <climits>
+#include <cstddef>
 
 namespace kerbal
 {
@@ -217,6 +224,366 @@ namespace kerbal
 
 
 
+		// carry-save adder: h, l = the high and low bits of a + b + c, bitwise
+		template <typename Unsigned>
+		KERBAL_CONSTEXPR14
+		void __popcount_csa(Unsigned & h, Unsigned & l, Unsigned a, Unsigned b, Unsigned c) KERBAL_NOEXCEPT
+		{
+			Unsigned u = static_cast<Unsigned>(a ^ b);
+			h = static_cast<Unsigned>((a & b) | (u & c));
+			l = static_cast<Unsigned>(u ^ c);
+		}
+
+		/**
+		 * Counts the number of 1 bits in [first, last).
+		 *
+		 * Harley-Seal: 16 words are summed by a tree of carry-save adders, so that only one popcount
+		 * is needed per 16 words (see Mula, Kurz, Lemire, "Faster Population Counts Using AVX2 Instructions").
+		 */
+		template <typename Unsigned>
+		KERBAL_CONSTEXPR14
+		size_t popcount_range(const Unsigned * first, const Unsigned * last) KERBAL_NOEXCEPT
+		{
+			size_t n = static_cast<size_t>(last - first);
+			size_t i = 0;
+			size_t total = 0;
+			Unsigned ones = 0, twos = 0, fours = 0, eights = 0, sixteens = 0;
+			Unsigned twos_a = 0, twos_b = 0, fours_a = 0, fours_b = 0, eights_a = 0, eights_b = 0;
+
+			for (; i + 16 <= n; i += 16) {
+				const Unsigned * p = first + i;
+				__popcount_csa(twos_a, ones, ones, p[0], p[1]);
+				__popcount_csa(twos_b, ones, ones, p[2], p[3]);
+				__popcount_csa(fours_a, twos, twos, twos_a, twos_b);
+				__popcount_csa(twos_a, ones, ones, p[4], p[5]);
+				__popcount_csa(twos_b, ones, ones, p[6], p[7]);
+				__popcount_csa(fours_b, twos, twos, twos_a, twos_b);
+				__popcount_csa(eights_a, fours, fours, fours_a, fours_b);
+				__popcount_csa(twos_a, ones, ones, p[8], p[9]);
+				__popcount_csa(twos_b, ones, ones, p[10], p[11]);
+				__popcount_csa(fours_a, twos, twos, twos_a, twos_b);
+				__popcount_csa(twos_a, ones, ones, p[12], p[13]);
+				__popcount_csa(twos_b, ones, ones, p[14], p[15]);
+				__popcount_csa(fours_b, twos, twos, twos_a, twos_b);
+				__popcount_csa(eights_b, fours, fours, fours_a, fours_b);
+				__popcount_csa(sixteens, eights, eights, eights_a, eights_b);
+				total += kerbal::numeric::popcount(sixteens);
+			}
+
+			total = 16 * total +
+					8 * static_cast<size_t>(kerbal::numeric::popcount(eights)) +
+					4 * static_cast<size_t>(kerbal::numeric::popcount(fours)) +
+					2 * static_cast<size_t>(kerbal::numeric::popcount(twos)) +
+					static_cast<size_t>(kerbal::numeric::popcount(ones));
+
+			for (; i < n; ++i) {
+				total += kerbal::numeric::popcount(first[i]);
+			}
+			return total;
+		}
+
+
+
+		template <typename Unsigned>
+		KERBAL_CONSTEXPR14
+		int __countr_zero(Unsigned x, kerbal::type_traits::false_type) KERBAL_NOEXCEPT
+		{
+			if (x == 0) {
+				return static_cast<int>(sizeof(Unsigned) * CHAR_BIT);
+			}
+			int cnt = 0;
+			while ((x & 1u) == 0) {
+				x >>= 1;
+				++cnt;
+			}
+			return cnt;
+		}
+
+
+#	if KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_GNU
+#		if KERBAL_GNU_PRIVATE_HAS_BUILTIN(__builtin_ctz)
+#			define KERBAL_BUILTIN_CTZ(x) __builtin_ctz(x)
+#		endif
+#	elif KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_CLANG
+#		if KERBAL_CLANG_PRIVATE_HAS_BUILTIN(__builtin_ctz)
+#			define KERBAL_BUILTIN_CTZ(x) __builtin_ctz(x)
+#		endif
+#	elif KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_ICC
+#		if KERBAL_ICC_PRIVATE_HAS_BUILTIN(__builtin_ctz)
+#			define KERBAL_BUILTIN_CTZ(x) __builtin_ctz(x)
+#		endif
+#	endif
+
+
+#	if KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_GNU
+#		if KERBAL_GNU_PRIVATE_HAS_BUILTIN(__builtin_ctzl)
+#			define KERBAL_BUILTIN_CTZL(x) __builtin_ctzl(x)
+#		endif
+#	elif KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_CLANG
+#		if KERBAL_CLANG_PRIVATE_HAS_BUILTIN(__builtin_ctzl)
+#			define KERBAL_BUILTIN_CTZL(x) __builtin_ctzl(x)
+#		endif
+#	elif KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_ICC
+#		if KERBAL_ICC_PRIVATE_HAS_BUILTIN(__builtin_ctzl)
+#			define KERBAL_BUILTIN_CTZL(x) __builtin_ctzl(x)
+#		endif
+#	endif
+
+
+#	if KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_GNU
+#		if KERBAL_GNU_PRIVATE_HAS_BUILTIN(__builtin_ctzll)
+#			define KERBAL_BUILTIN_CTZLL(x) __builtin_ctzll(x)
+#		endif
+#	elif KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_CLANG
+#		if KERBAL_CLANG_PRIVATE_HAS_BUILTIN(__builtin_ctzll)
+#			define KERBAL_BUILTIN_CTZLL(x) __builtin_ctzll(x)
+#		endif
+#	elif KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_ICC
+#		if KERBAL_ICC_PRIVATE_HAS_BUILTIN(__builtin_ctzll)
+#			define KERBAL_BUILTIN_CTZLL(x) __builtin_ctzll(x)
+#		endif
+#	endif
+
+
+#	if defined(KERBAL_BUILTIN_CTZ)
+
+		KERBAL_CONSTEXPR
+		inline
+		int __countr_zero(unsigned int x, kerbal::type_traits::false_type) KERBAL_NOEXCEPT
+		{
+			return x == 0 ? static_cast<int>(sizeof(unsigned int) * CHAR_BIT) : KERBAL_BUILTIN_CTZ(x);
+		}
+
+#	endif
+
+
+#	if defined(KERBAL_BUILTIN_CTZL)
+
+		KERBAL_CONSTEXPR
+		inline
+		int __countr_zero(unsigned long x, kerbal::type_traits::false_type) KERBAL_NOEXCEPT
+		{
+			return x == 0 ? static_cast<int>(sizeof(unsigned long) * CHAR_BIT) : KERBAL_BUILTIN_CTZL(x);
+		}
+
+#	endif
+
+
+#	if defined(KERBAL_BUILTIN_CTZLL)
+
+		KERBAL_CONSTEXPR
+		inline
+		int __countr_zero(unsigned long long x, kerbal::type_traits::false_type) KERBAL_NOEXCEPT
+		{
+			return x == 0 ? static_cast<int>(sizeof(unsigned long long) * CHAR_BIT) : KERBAL_BUILTIN_CTZLL(x);
+		}
+
+#	endif
+
+		template <typename Signed>
+		KERBAL_CONSTEXPR
+		int __countr_zero(Signed x, kerbal::type_traits::true_type) KERBAL_NOEXCEPT
+		{
+			typedef typename kerbal::type_traits::make_unsigned<Signed>::type unsigned_t;
+			return __countr_zero(static_cast<unsigned_t>(x), kerbal::type_traits::false_type());
+		}
+
+		/**
+		 * Counts the number of consecutive 0 bits, starting from the least significant bit.
+		 * Returns the bit width of Tp if x is 0.
+		 */
+		template <typename Tp>
+		KERBAL_CONSTEXPR
+		int countr_zero(Tp x) KERBAL_NOEXCEPT
+		{
+			return kerbal::numeric::__countr_zero(x, kerbal::type_traits::is_signed<Tp>());
+		}
+
+
+
+		template <typename Unsigned>
+		KERBAL_CONSTEXPR14
+		int __countl_zero(Unsigned x, kerbal::type_traits::false_type) KERBAL_NOEXCEPT
+		{
+			typedef kerbal::type_traits::integral_constant<int, sizeof(Unsigned) * CHAR_BIT> BIT_WIDTH;
+			if (x == 0) {
+				return BIT_WIDTH::value;
+			}
+			int cnt = 0;
+			while (((x >> (BIT_WIDTH::value - 1)) & 1u) == 0) {
+				x = static_cast<Unsigned>(x << 1);
+				++cnt;
+			}
+			return cnt;
+		}
+
+
+#	if KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_GNU
+#		if KERBAL_GNU_PRIVATE_HAS_BUILTIN(__builtin_clz)
+#			define KERBAL_BUILTIN_CLZ(x) __builtin_clz(x)
+#		endif
+#	elif KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_CLANG
+#		if KERBAL_CLANG_PRIVATE_HAS_BUILTIN(__builtin_clz)
+#			define KERBAL_BUILTIN_CLZ(x) __builtin_clz(x)
+#		endif
+#	elif KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_ICC
+#		if KERBAL_ICC_PRIVATE_HAS_BUILTIN(__builtin_clz)
+#			define KERBAL_BUILTIN_CLZ(x) __builtin_clz(x)
+#		endif
+#	endif
+
+
+#	if KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_GNU
+#		if KERBAL_GNU_PRIVATE_HAS_BUILTIN(__builtin_clzl)
+#			define KERBAL_BUILTIN_CLZL(x) __builtin_clzl(x)
+#		endif
+#	elif KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_CLANG
+#		if KERBAL_CLANG_PRIVATE_HAS_BUILTIN(__builtin_clzl)
+#			define KERBAL_BUILTIN_CLZL(x) __builtin_clzl(x)
+#		endif
+#	elif KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_ICC
+#		if KERBAL_ICC_PRIVATE_HAS_BUILTIN(__builtin_clzl)
+#			define KERBAL_BUILTIN_CLZL(x) __builtin_clzl(x)
+#		endif
+#	endif
+
+
+#	if KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_GNU
+#		if KERBAL_GNU_PRIVATE_HAS_BUILTIN(__builtin_clzll)
+#			define KERBAL_BUILTIN_CLZLL(x) __builtin_clzll(x)
+#		endif
+#	elif KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_CLANG
+#		if KERBAL_CLANG_PRIVATE_HAS_BUILTIN(__builtin_clzll)
+#			define KERBAL_BUILTIN_CLZLL(x) __builtin_clzll(x)
+#		endif
+#	elif KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_ICC
+#		if KERBAL_ICC_PRIVATE_HAS_BUILTIN(__builtin_clzll)
+#			define KERBAL_BUILTIN_CLZLL(x) __builtin_clzll(x)
+#		endif
+#	endif
+
+
+#	if defined(KERBAL_BUILTIN_CLZ)
+
+		KERBAL_CONSTEXPR
+		inline
+		int __countl_zero(unsigned int x, kerbal::type_traits::false_type) KERBAL_NOEXCEPT
+		{
+			return x == 0 ? static_cast<int>(sizeof(unsigned int) * CHAR_BIT) : KERBAL_BUILTIN_CLZ(x);
+		}
+
+#	endif
+
+
+#	if defined(KERBAL_BUILTIN_CLZL)
+
+		KERBAL_CONSTEXPR
+		inline
+		int __countl_zero(unsigned long x, kerbal::type_traits::false_type) KERBAL_NOEXCEPT
+		{
+			return x == 0 ? static_cast<int>(sizeof(unsigned long) * CHAR_BIT) : KERBAL_BUILTIN_CLZL(x);
+		}
+
+#	endif
+
+
+#	if defined(KERBAL_BUILTIN_CLZLL)
+
+		KERBAL_CONSTEXPR
+		inline
+		int __countl_zero(unsigned long long x, kerbal::type_traits::false_type) KERBAL_NOEXCEPT
+		{
+			return x == 0 ? static_cast<int>(sizeof(unsigned long long) * CHAR_BIT) : KERBAL_BUILTIN_CLZLL(x);
+		}
+
+#	endif
+
+		template <typename Signed>
+		KERBAL_CONSTEXPR
+		int __countl_zero(Signed x, kerbal::type_traits::true_type) KERBAL_NOEXCEPT
+		{
+			typedef typename kerbal::type_traits::make_unsigned<Signed>::type unsigned_t;
+			return __countl_zero(static_cast<unsigned_t>(x), kerbal::type_traits::false_type());
+		}
+
+		/**
+		 * Counts the number of consecutive 0 bits, starting from the most significant bit.
+		 * Returns the bit width of Tp if x is 0.
+		 */
+		template <typename Tp>
+		KERBAL_CONSTEXPR
+		int countl_zero(Tp x) KERBAL_NOEXCEPT
+		{
+			return kerbal::numeric::__countl_zero(x, kerbal::type_traits::is_signed<Tp>());
+		}
+
+		/**
+		 * Counts the number of consecutive 1 bits, starting from the most significant bit.
+		 */
+		template <typename Tp>
+		KERBAL_CONSTEXPR
+		int countl_one(Tp x) KERBAL_NOEXCEPT
+		{
+			typedef typename kerbal::type_traits::make_unsigned<Tp>::type unsigned_t;
+			return kerbal::numeric::countl_zero(static_cast<unsigned_t>(~static_cast<unsigned_t>(x)));
+		}
+
+		/**
+		 * Counts the number of consecutive 1 bits, starting from the least significant bit.
+		 */
+		template <typename Tp>
+		KERBAL_CONSTEXPR
+		int countr_one(Tp x) KERBAL_NOEXCEPT
+		{
+			typedef typename kerbal::type_traits::make_unsigned<Tp>::type unsigned_t;
+			return kerbal::numeric::countr_zero(static_cast<unsigned_t>(~static_cast<unsigned_t>(x)));
+		}
+
+
+
+		/**
+		 * The number of bits needed to represent x, i.e. 1 + floor(log2(x)) or 0 if x is 0.
+		 *
+		 * @warning Tp should be an unsigned type.
+		 */
+		template <typename Tp>
+		KERBAL_CONSTEXPR
+		int bit_width(Tp x) KERBAL_NOEXCEPT
+		{
+			return static_cast<int>(sizeof(Tp) * CHAR_BIT) - kerbal::numeric::countl_zero(x);
+		}
+
+		/**
+		 * The largest power of 2 not greater than x, or 0 if x is 0.
+		 *
+		 * @warning Tp should be an unsigned type.
+		 */
+		template <typename Tp>
+		KERBAL_CONSTEXPR
+		Tp bit_floor(Tp x) KERBAL_NOEXCEPT
+		{
+			return x == 0 ?
+					static_cast<Tp>(0) :
+					static_cast<Tp>(static_cast<Tp>(1) << (kerbal::numeric::bit_width(x) - 1));
+		}
+
+		/**
+		 * The smallest power of 2 not less than x.
+		 *
+		 * @warning Tp should be an unsigned type.
+		 * @warning Undefined behaviour if the result is not representable by Tp.
+		 */
+		template <typename Tp>
+		KERBAL_CONSTEXPR
+		Tp bit_ceil(Tp x) KERBAL_NOEXCEPT
+		{
+			return x <= 1 ?
+					static_cast<Tp>(1) :
+					static_cast<Tp>(static_cast<Tp>(1) << kerbal::numeric::bit_width(static_cast<Tp>(x - 1)));
+		}
+
+
+
 		template <typename Unsigned>
 		KERBAL_CONSTEXPR
 		bool __ispow2(Unsigned x, kerbal::type_traits::false_type) KERBAL_NOEXCEPT
@@ -275,9 +642,10 @@ namespace kerbal
 		Tp mask(size_t n) KERBAL_NOEXCEPT
 		{
 			typedef typename kerbal::type_traits::make_unsigned<Tp>::type unsigned_t;
+			// unsigned_t narrower than int is promoted, the shifted value mustn't be negative
 			return n == sizeof(unsigned_t) * CHAR_BIT ?
-					~static_cast<unsigned_t>(0) :
-					~(~static_cast<unsigned_t>(0) << n);
+					static_cast<Tp>(~static_cast<unsigned_t>(0)) :
+					static_cast<Tp>((static_cast<unsigned_t>(1) << n) - 1u);
 		}
 
 		template <typename Tp>
@@ -337,6 +705,209 @@ namespace kerbal
 
 
 
+		template <typename Unsigned, size_t Size>
+		KERBAL_CONSTEXPR14
+		Unsigned __byteswap(Unsigned x, kerbal::type_traits::integral_constant<size_t, Size>) KERBAL_NOEXCEPT
+		{
+			Unsigned r = 0;
+			for (size_t i = 0; i < Size; ++i) {
+				r = static_cast<Unsigned>((r << (CHAR_BIT - 1) << 1) | (x & static_cast<unsigned char>(~0u)));
+				x = static_cast<Unsigned>(x >> (CHAR_BIT - 1) >> 1);
+			}
+			return r;
+		}
+
+
+#	if KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_GNU
+#		if KERBAL_GNU_PRIVATE_HAS_BUILTIN(__builtin_bswap16)
+#			define KERBAL_BUILTIN_BSWAP16(x) __builtin_bswap16(x)
+#		endif
+#	elif KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_CLANG
+#		if KERBAL_CLANG_PRIVATE_HAS_BUILTIN(__builtin_bswap16)
+#			define KERBAL_BUILTIN_BSWAP16(x) __builtin_bswap16(x)
+#		endif
+#	elif KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_ICC
+#		if KERBAL_ICC_PRIVATE_HAS_BUILTIN(__builtin_bswap16)
+#			define KERBAL_BUILTIN_BSWAP16(x) __builtin_bswap16(x)
+#		endif
+#	endif
+
+
+#	if KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_GNU
+#		if KERBAL_GNU_PRIVATE_HAS_BUILTIN(__builtin_bswap32)
+#			define KERBAL_BUILTIN_BSWAP32(x) __builtin_bswap32(x)
+#		endif
+#	elif KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_CLANG
+#		if KERBAL_CLANG_PRIVATE_HAS_BUILTIN(__builtin_bswap32)
+#			define KERBAL_BUILTIN_BSWAP32(x) __builtin_bswap32(x)
+#		endif
+#	elif KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_ICC
+#		if KERBAL_ICC_PRIVATE_HAS_BUILTIN(__builtin_bswap32)
+#			define KERBAL_BUILTIN_BSWAP32(x) __builtin_bswap32(x)
+#		endif
+#	endif
+
+
+#	if KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_GNU
+#		if KERBAL_GNU_PRIVATE_HAS_BUILTIN(__builtin_bswap64)
+#			define KERBAL_BUILTIN_BSWAP64(x) __builtin_bswap64(x)
+#		endif
+#	elif KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_CLANG
+#		if KERBAL_CLANG_PRIVATE_HAS_BUILTIN(__builtin_bswap64)
+#			define KERBAL_BUILTIN_BSWAP64(x) __builtin_bswap64(x)
+#		endif
+#	elif KERBAL_COMPILER_ID == KERBAL_COMPILER_ID_ICC
+#		if KERBAL_ICC_PRIVATE_HAS_BUILTIN(__builtin_bswap64)
+#			define KERBAL_BUILTIN_BSWAP64(x) __builtin_bswap64(x)
+#		endif
+#	endif
+
+
+#	if defined(KERBAL_BUILTIN_BSWAP16) && CHAR_BIT == 8
+
+		template <typename Unsigned>
+		KERBAL_CONSTEXPR
+		Unsigned __byteswap(Unsigned x, kerbal::type_traits::integral_constant<size_t, 2>) KERBAL_NOEXCEPT
+		{
+			return static_cast<Unsigned>(KERBAL_BUILTIN_BSWAP16(x));
+		}
+
+#	endif
+
+
+#	if defined(KERBAL_BUILTIN_BSWAP32) && CHAR_BIT == 8
+
+		template <typename Unsigned>
+		KERBAL_CONSTEXPR
+		Unsigned __byteswap(Unsigned x, kerbal::type_traits::integral_constant<size_t, 4>) KERBAL_NOEXCEPT
+		{
+			return static_cast<Unsigned>(KERBAL_BUILTIN_BSWAP32(x));
+		}
+
+#	endif
+
+
+#	if defined(KERBAL_BUILTIN_BSWAP64) && CHAR_BIT == 8
+
+		template <typename Unsigned>
+		KERBAL_CONSTEXPR
+		Unsigned __byteswap(Unsigned x, kerbal::type_traits::integral_constant<size_t, 8>) KERBAL_NOEXCEPT
+		{
+			return static_cast<Unsigned>(KERBAL_BUILTIN_BSWAP64(x));
+		}
+
+#	endif
+
+		/**
+		 * Reverses the bytes of x.
+		 */
+		template <typename Tp>
+		KERBAL_CONSTEXPR
+		Tp byteswap(Tp x) KERBAL_NOEXCEPT
+		{
+			typedef typename kerbal::type_traits::make_unsigned<Tp>::type unsigned_t;
+			return static_cast<Tp>(kerbal::numeric::__byteswap(static_cast<unsigned_t>(x),
+									kerbal::type_traits::integral_constant<size_t, sizeof(Tp)>()));
+		}
+
+
+
+#	if defined(__BMI2__) && KERBAL_X86_INTRINSICS_SUPPORTED
+#		define KERBAL_NUMERIC_BIT_HAS_BMI2 1
+#	else
+#		define KERBAL_NUMERIC_BIT_HAS_BMI2 0
+#	endif
+
+		template <typename Unsigned>
+		KERBAL_CONSTEXPR14
+		Unsigned __pdep(Unsigned x, Unsigned mask) KERBAL_NOEXCEPT
+		{
+			Unsigned r = 0;
+			for (Unsigned bb = 1; mask != 0; bb = static_cast<Unsigned>(bb << 1)) {
+				Unsigned lowest = static_cast<Unsigned>(mask & static_cast<Unsigned>(~mask + 1u));
+				if (x & bb) {
+					r |= lowest;
+				}
+				mask = static_cast<Unsigned>(mask ^ lowest);
+			}
+			return r;
+		}
+
+		template <typename Unsigned>
+		KERBAL_CONSTEXPR14
+		Unsigned __pext(Unsigned x, Unsigned mask) KERBAL_NOEXCEPT
+		{
+			Unsigned r = 0;
+			for (Unsigned bb = 1; mask != 0; bb = static_cast<Unsigned>(bb << 1)) {
+				Unsigned lowest = static_cast<Unsigned>(mask & static_cast<Unsigned>(~mask + 1u));
+				if (x & lowest) {
+					r |= bb;
+				}
+				mask = static_cast<Unsigned>(mask ^ lowest);
+			}
+			return r;
+		}
+
+		/**
+		 * Parallel bits deposit: scatters the low bits of x to the positions of the 1 bits of mask,
+		 * from the least significant one.
+		 *
+		 * Uses the BMI2 pdep instruction if the translation unit is compiled with BMI2 enabled.
+		 *
+		 * @warning Tp should be an unsigned type.
+		 */
+		template <typename Tp>
+		KERBAL_CONSTEXPR14
+		Tp pdep(Tp x, Tp mask) KERBAL_NOEXCEPT
+		{
+
+#	if KERBAL_NUMERIC_BIT_HAS_BMI2
+			if (KERBAL_CONSTEXPR14_RUNTIME_PATH()) {
+				if (sizeof(Tp) <= 4) {
+					return static_cast<Tp>(_pdep_u32(static_cast<unsigned int>(x), static_cast<unsigned int>(mask)));
+				}
+#		if KERBAL_ARCHITECTURE == KERBAL_ARCHITECTURE_AMD64
+				if (sizeof(Tp) <= 8) {
+					return static_cast<Tp>(_pdep_u64(static_cast<unsigned long long>(x), static_cast<unsigned long long>(mask)));
+				}
+#		endif
+			}
+#	endif
+
+			return kerbal::numeric::__pdep(x, mask);
+		}
+
+		/**
+		 * Parallel bits extract: gathers the bits of x at the positions of the 1 bits of mask
+		 * to the low bits of the result.
+		 *
+		 * Uses the BMI2 pext instruction if the translation unit is compiled with BMI2 enabled.
+		 *
+		 * @warning Tp should be an unsigned type.
+		 */
+		template <typename Tp>
+		KERBAL_CONSTEXPR14
+		Tp pext(Tp x, Tp mask) KERBAL_NOEXCEPT
+		{
+
+#	if KERBAL_NUMERIC_BIT_HAS_BMI2
+			if (KERBAL_CONSTEXPR14_RUNTIME_PATH()) {
+				if (sizeof(Tp) <= 4) {
+					return static_cast<Tp>(_pext_u32(static_cast<unsigned int>(x), static_cast<unsigned int>(mask)));
+				}
+#		if KERBAL_ARCHITECTURE == KERBAL_ARCHITECTURE_AMD64
+				if (sizeof(Tp) <= 8) {
+					return static_cast<Tp>(_pext_u64(static_cast<unsigned long long>(x), static_cast<unsigned long long>(mask)));
+				}
+#		endif
+			}
+#	endif
+
+			return kerbal::numeric::__pext(x, mask);
+		}
+
+
+
 		template <typename Signed>
 		KERBAL_CONSTEXPR
 		Signed __rotl(Signed x, int s, kerbal::type_traits::true_type) KERBAL_NOEXCEPT
@@ -0,0 +1,66 @@
+/**
+ * @file       is_trivially_copyable.hpp
+ * @brief
+ * @date       2020-11-14
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_TYPE_TRAITS_IS_TRIVIALLY_COPYABLE_HPP
+#define KERBAL_TYPE_TRAITS_IS_TRIVIALLY_COPYABLE_HPP
+
+#include <kerbal/type_traits/integral_constant.hpp>
+
+#include <cstddef>
+
+#if __cplusplus >= 201103L
+#	include <type_traits>
+#else
+#	include <kerbal/type_traits/fundamental_deduction.hpp>
+#	include <kerbal/type_traits/member_pointer_deduction.hpp>
+#	include <kerbal/type_traits/pointer_deduction.hpp>
+#endif
+
+namespace kerbal
+{
+
+	namespace type_traits
+	{
+
+		/**
+		 * Copying the bytes of an object of a trivially copyable type to another one of the same type is the same
+		 * as assigning it, which lets the algorithms lower copies and fills to memmove and memset.
+		 *
+		 * Before C++11 only the scalar types are known to be.
+		 */
+		template <typename Tp>
+		struct is_trivially_copyable:
+				kerbal::type_traits::bool_constant<
+#	if __cplusplus >= 201103L
+						std::is_trivially_copyable<Tp>::value
+#	else
+						kerbal::type_traits::is_fundamental<Tp>::value ||
+						kerbal::type_traits::is_member_pointer<Tp>::value ||
+						kerbal::type_traits::is_pointer<Tp>::value
+#	endif
+				>
+		{
+		};
+
+#	if __cplusplus < 201103L
+
+		template <typename Tp, std::size_t N>
+		struct is_trivially_copyable<Tp[N]>: kerbal::type_traits::is_trivially_copyable<Tp>
+		{
+		};
+
+#	endif
+
+	} // namespace type_traits
+
+} // namespace kerbal
+
+#endif // KERBAL_TYPE_TRAITS_IS_TRIVIALLY_COPYABLE_HPP
@@ -0,0 +1,87 @@
+/**
+ * @file       is_trivially_relocatable.hpp
+ * @brief
+ * @date       2020-11-06
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#ifndef KERBAL_TYPE_TRAITS_IS_TRIVIALLY_RELOCATABLE_HPP
+#define KERBAL_TYPE_TRAITS_IS_TRIVIALLY_RELOCATABLE_HPP
+
+#include <kerbal/type_traits/integral_constant.hpp>
+#include <kerbal/type_traits/is_trivially_copyable.hpp>
+
+#include <cstddef>
+
+namespace kerbal
+{
+
+	namespace type_traits
+	{
+
+		/**
+		 * An object of a trivially relocatable type may be moved to another address by copying its bytes, after
+		 * which the source is treated as storage that holds no object (its destructor is not run).
+		 *
+		 * Trivially copyable types are trivially relocatable. Other types may opt in by specialization, e.g. a type
+		 * that owns a heap buffer but holds no pointer into itself:
+		 *
+		 * @code
+		 * namespace kerbal { namespace type_traits {
+		 *     template <> struct is_trivially_relocatable<my_string> : kerbal::type_traits::true_type {};
+		 * }}
+		 * @endcode
+		 *
+		 * The cv-qualified types and the arrays follow the specialization of the element type.
+		 */
+		template <typename Tp>
+		struct is_trivially_relocatable: kerbal::type_traits::is_trivially_copyable<Tp>
+		{
+		};
+
+		template <typename Tp>
+		struct is_trivially_relocatable<const Tp>: kerbal::type_traits::is_trivially_relocatable<Tp>
+		{
+		};
+
+		template <typename Tp>
+		struct is_trivially_relocatable<volatile Tp>: kerbal::type_traits::is_trivially_relocatable<Tp>
+		{
+		};
+
+		template <typename Tp>
+		struct is_trivially_relocatable<const volatile Tp>: kerbal::type_traits::is_trivially_relocatable<Tp>
+		{
+		};
+
+		template <typename Tp, std::size_t N>
+		struct is_trivially_relocatable<Tp[N]>: kerbal::type_traits::is_trivially_relocatable<Tp>
+		{
+		};
+
+		// the arrays of cv-qualified elements match both the cv-qualified and the array specializations above
+
+		template <typename Tp, std::size_t N>
+		struct is_trivially_relocatable<const Tp[N]>: kerbal::type_traits::is_trivially_relocatable<Tp>
+		{
+		};
+
+		template <typename Tp, std::size_t N>
+		struct is_trivially_relocatable<volatile Tp[N]>: kerbal::type_traits::is_trivially_relocatable<Tp>
+		{
+		};
+
+		template <typename Tp, std::size_t N>
+		struct is_trivially_relocatable<const volatile Tp[N]>: kerbal::type_traits::is_trivially_relocatable<Tp>
+		{
+		};
+
+	} // namespace type_traits
+
+} // namespace kerbal
+
+#endif // KERBAL_TYPE_TRAITS_IS_TRIVIALLY_RELOCATABLE_HPP
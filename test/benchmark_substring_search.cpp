@@ -0,0 +1,197 @@
+/**
+ * @file       benchmark_substring_search.cpp
+ * @brief
+ * @date       2020-11-17
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#include <kerbal/algorithm/aho_corasick.hpp>
+#include <kerbal/algorithm/horspool.hpp>
+#include <kerbal/algorithm/kmp.hpp>
+#include <kerbal/algorithm/substring_search.hpp>
+#include <kerbal/test/runtime_timer.hpp>
+#include <kerbal/test/test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/*
+ * Counts the occurrences of the patterns in a log-like text, overlapping ones included, by each of the searches.
+ * All of them are to agree; the times are printed in milliseconds.
+ */
+
+namespace
+{
+
+	std::size_t lcg(std::size_t & r)
+	{
+		r = r * 1103515245u + 12345u;
+		return r >> 16;
+	}
+
+	std::string make_text(std::size_t len, std::size_t & r)
+	{
+		static const char alphabet[] = "abcdefghijklmnop  ..::=0123456789\n";
+		std::string text;
+		text.reserve(len);
+		while (text.size() != len) {
+			text += alphabet[lcg(r) % (sizeof(alphabet) - 1)];
+		}
+		return text;
+	}
+
+	std::vector<std::string> make_patterns(std::size_t count, std::size_t len, std::string & text, std::size_t & r)
+	{
+		std::vector<std::string> patterns;
+		for (std::size_t i = 0; i < count; ++i) {
+			std::string p = make_text(len, r);
+			// planted a few times, so that there are occurrences to find
+			for (int k = 0; k < 4; ++k) {
+				text.replace(lcg(r) * 7919 % (text.size() - len), len, p);
+			}
+			patterns.push_back(p);
+		}
+		return patterns;
+	}
+
+	struct std_search_count
+	{
+			std::size_t operator()(const std::string & text, const std::string & p) const
+			{
+				std::size_t n = 0;
+				std::string::const_iterator it(std::search(text.begin(), text.end(), p.begin(), p.end()));
+				while (it != text.end()) {
+					++n;
+					it = std::search(it + 1, text.end(), p.begin(), p.end());
+				}
+				return n;
+			}
+	};
+
+	struct kmp_count
+	{
+			std::size_t operator()(const std::string & text, const std::string & p) const
+			{
+				std::size_t n = 0;
+				std::string::const_iterator it(kerbal::algorithm::kmp(text.begin(), text.end(), p.begin(), p.end()));
+				while (it != text.end()) {
+					++n;
+					it = kerbal::algorithm::kmp(it + 1, text.end(), p.begin(), p.end());
+				}
+				return n;
+			}
+	};
+
+	struct horspool_count
+	{
+			std::size_t operator()(const std::string & text, const std::string & p) const
+			{
+				std::size_t n = 0;
+				std::string::const_iterator it(kerbal::algorithm::horspool(text.begin(), text.end(), p.begin(), p.end()));
+				while (it != text.end()) {
+					++n;
+					it = kerbal::algorithm::horspool(it + 1, text.end(), p.begin(), p.end());
+				}
+				return n;
+			}
+	};
+
+	struct substring_search_count
+	{
+			std::size_t operator()(const std::string & text, const std::string & p) const
+			{
+				const char * first = text.data();
+				const char * last = first + text.size();
+				std::size_t n = 0;
+				const char * it = kerbal::algorithm::substring_search(first, last, p.data(), p.data() + p.size());
+				while (it != last) {
+					++n;
+					it = kerbal::algorithm::substring_search(it + 1, last, p.data(), p.data() + p.size());
+				}
+				return n;
+			}
+	};
+
+	struct match_counter
+	{
+			std::size_t * n;
+
+			void operator()(std::size_t, std::string::const_iterator) const
+			{
+				++*n;
+			}
+	};
+
+	template <typename Count>
+	std::size_t time_each_pattern(const char * name, Count count,
+								const std::string & text, const std::vector<std::string> & patterns)
+	{
+		kerbal::test::runtime_timer timer;
+		std::size_t n = 0;
+		for (std::size_t i = 0; i < patterns.size(); ++i) {
+			n += count(text, patterns[i]);
+		}
+		std::printf("    %-18s %8lu ms  %lu matches\n", name, timer.count(), static_cast<unsigned long>(n));
+		return n;
+	}
+
+	std::size_t time_aho_corasick(const std::string & text, const std::vector<std::string> & patterns)
+	{
+		kerbal::test::runtime_timer timer;
+		kerbal::algorithm::aho_corasick ac;
+		for (std::size_t i = 0; i < patterns.size(); ++i) {
+			ac.insert(patterns[i].begin(), patterns[i].end());
+		}
+		ac.build();
+		std::size_t n = 0;
+		match_counter counter = {&n};
+		ac.for_each_match(text.begin(), text.end(), counter);
+		std::printf("    %-18s %8lu ms  %lu matches\n", "aho_corasick", timer.count(), static_cast<unsigned long>(n));
+		return n;
+	}
+
+	void benchmark(kerbal::test::assert_record & record,
+					std::size_t text_len, std::size_t pattern_count, std::size_t pattern_len)
+	{
+		std::size_t r = 1;
+		std::string text(make_text(text_len, r));
+		std::vector<std::string> patterns(make_patterns(pattern_count, pattern_len, text, r));
+		std::printf("  text of %lu bytes, %lu patterns of %lu bytes\n",
+					static_cast<unsigned long>(text_len), static_cast<unsigned long>(pattern_count),
+					static_cast<unsigned long>(pattern_len));
+
+		std::size_t expect = time_each_pattern("std::search", std_search_count(), text, patterns);
+		KERBAL_TEST_CHECK_EQUAL(time_each_pattern("kmp", kmp_count(), text, patterns), expect);
+		KERBAL_TEST_CHECK_EQUAL(time_each_pattern("horspool", horspool_count(), text, patterns), expect);
+		KERBAL_TEST_CHECK_EQUAL(time_each_pattern("substring_search", substring_search_count(), text, patterns), expect);
+		KERBAL_TEST_CHECK_EQUAL(time_aho_corasick(text, patterns), expect);
+	}
+
+} // namespace
+
+KERBAL_TEST_CASE(benchmark_substring_search_short, "benchmark the searches of a short pattern")
+{
+	benchmark(record, 1 << 22, 1, 6);
+}
+
+KERBAL_TEST_CASE(benchmark_substring_search_long, "benchmark the searches of a long pattern")
+{
+	benchmark(record, 1 << 22, 1, 64);
+}
+
+KERBAL_TEST_CASE(benchmark_substring_search_many, "benchmark the searches of many patterns")
+{
+	benchmark(record, 1 << 20, 256, 12);
+}
+
+int main(int argc, char * argv[])
+{
+	kerbal::test::run_all_test_case(argc, argv);
+}
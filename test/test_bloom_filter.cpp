@@ -0,0 +1,90 @@
+/**
+ * @file       test_bloom_filter.cpp
+ * @brief
+ * @date       2020-11-17
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#include <kerbal/container/bloom_filter.hpp>
+#include <kerbal/container/dynamic_bloom_filter.hpp>
+#include <kerbal/hash/murmur_hash2.hpp>
+#include <kerbal/test/test.hpp>
+
+#include <stdexcept>
+#include <string>
+
+#if __cplusplus >= 201103L
+#	include <utility>
+#endif
+
+KERBAL_TEST_CASE(test_bloom_filter_murmur_hashable, "test the types taken by the default hash of the Bloom filters")
+{
+	KERBAL_TEST_CHECK_STATIC(kerbal::container::bloom_filter_murmur_hashable<int>::value);
+	KERBAL_TEST_CHECK_STATIC(kerbal::container::bloom_filter_murmur_hashable<unsigned long long>::value);
+	KERBAL_TEST_CHECK_STATIC(kerbal::container::bloom_filter_murmur_hashable<const char *>::value);
+	KERBAL_TEST_CHECK_STATIC(!kerbal::container::bloom_filter_murmur_hashable<std::string>::value);
+	KERBAL_TEST_CHECK_STATIC(!kerbal::container::bloom_filter_murmur_hashable<double>::value);
+}
+
+/*
+ * Hashes the characters, not the object representation, so that equal strings hash equally.
+ */
+struct string_hash
+{
+		kerbal::container::bloom_filter_hash_pair operator()(const std::string & s) const
+		{
+			kerbal::container::bloom_filter_hash_pair r;
+			r.h1 = kerbal::hash::murmur_hash2_context(0x9747b28cu).digest(s.data(), s.data() + s.size());
+			r.h2 = kerbal::hash::murmur_hash2_context(0x5bd1e995u).digest(s.data(), s.data() + s.size());
+			return r;
+		}
+};
+
+KERBAL_TEST_CASE(test_bloom_filter_custom_hash, "test the Bloom filters over a type supplying its hash")
+{
+	kerbal::container::bloom_filter<std::string, 1024, 4, string_hash> bf;
+	bf.insert(std::string("hello"));
+	std::string s("hel");
+	s += "lo";
+	KERBAL_TEST_CHECK(bf.contains(s));
+
+	kerbal::container::dynamic_bloom_filter<std::string, string_hash> dbf(1024, 4, string_hash());
+	dbf.insert(std::string("world"));
+	KERBAL_TEST_CHECK(dbf.contains(std::string("wor") + "ld"));
+}
+
+KERBAL_TEST_CASE(test_dynamic_bloom_filter_no_bit, "test dynamic_bloom_filter without any bit")
+{
+	typedef kerbal::container::dynamic_bloom_filter<int> filter;
+
+#	if __cpp_exceptions
+	bool thrown = false;
+	try {
+		filter f(0, 3);
+	} catch (const std::invalid_argument &) {
+		thrown = true;
+	}
+	KERBAL_TEST_CHECK(thrown);
+#	endif
+
+#	if __cplusplus >= 201103L
+	filter f(100, 3);
+	f.insert(42);
+	KERBAL_TEST_CHECK(f.contains(42));
+	filter g(std::move(f));
+	KERBAL_TEST_CHECK(g.contains(42));
+	KERBAL_TEST_CHECK_EQUAL(f.bits(), 0u);
+	KERBAL_TEST_CHECK(!f.contains(42));
+	f.insert(42);
+	KERBAL_TEST_CHECK(!f.contains(42));
+#	endif
+}
+
+int main(int argc, char * argv[])
+{
+	kerbal::test::run_all_test_case(argc, argv);
+}
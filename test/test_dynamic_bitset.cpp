@@ -0,0 +1,56 @@
+/**
+ * @file       test_dynamic_bitset.cpp
+ * @brief
+ * @date       2020-11-17
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#include <kerbal/bitset/dynamic_bitset.hpp>
+#include <kerbal/test/test.hpp>
+
+/*
+ * The tail of the last block is masked whenever the size isn't a multiple of the block width.
+ */
+template <typename Block>
+void test_narrow_block_impl(kerbal::test::assert_record & record)
+{
+	kerbal::bitset::dynamic_bitset<Block> bs(10, true);
+	KERBAL_TEST_CHECK(bs.all());
+	KERBAL_TEST_CHECK_EQUAL(bs.count(), 10u);
+
+	bs.reset(0);
+	bs.reset(9);
+	KERBAL_TEST_CHECK(!bs.all());
+	KERBAL_TEST_CHECK_EQUAL(bs.count(), 8u);
+	KERBAL_TEST_CHECK_EQUAL(bs.find_first(), 1u);
+	KERBAL_TEST_CHECK_EQUAL(bs.find_next(8), 10u);
+
+	bs.flip();
+	KERBAL_TEST_CHECK_EQUAL(bs.count(), 2u);
+
+	bs <<= 3;
+	KERBAL_TEST_CHECK_EQUAL(bs.count(), 1u);
+	KERBAL_TEST_CHECK_EQUAL(bs.find_first(), 3u);
+
+	bs.resize(5);
+	bs.resize(21, true);
+	KERBAL_TEST_CHECK_EQUAL(bs.count(), 17u);
+	bs.flip();
+	KERBAL_TEST_CHECK_EQUAL(bs.count(), 4u);
+}
+
+KERBAL_TEST_CASE(test_dynamic_bitset_narrow_block, "test dynamic_bitset over the blocks narrower than int")
+{
+	test_narrow_block_impl<unsigned char>(record);
+	test_narrow_block_impl<unsigned short>(record);
+	test_narrow_block_impl<unsigned int>(record);
+}
+
+int main(int argc, char * argv[])
+{
+	kerbal::test::run_all_test_case(argc, argv);
+}
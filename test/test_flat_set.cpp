@@ -0,0 +1,144 @@
+/**
+ * @file       test_flat_set.cpp
+ * @brief
+ * @date       2020-11-17
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#include <kerbal/container/flat_set.hpp>
+#include <kerbal/container/static_flat_set.hpp>
+#include <kerbal/test/test.hpp>
+
+#include <cstddef>
+
+/*
+ * Its copies throw once the countdown reaches zero, a negative countdown never does.
+ */
+struct throwing_int
+{
+		static int countdown;
+
+		int v;
+
+		throwing_int(int v) :
+				v(v)
+		{
+		}
+
+		throwing_int(const throwing_int & src) :
+				v(src.v)
+		{
+			tick();
+		}
+
+		throwing_int& operator=(const throwing_int & src)
+		{
+			tick();
+			v = src.v;
+			return *this;
+		}
+
+		static void tick()
+		{
+			if (countdown > 0 && --countdown == 0) {
+				throw 0;
+			}
+		}
+
+		friend bool operator<(const throwing_int & lhs, const throwing_int & rhs)
+		{
+			return lhs.v < rhs.v;
+		}
+};
+
+int throwing_int::countdown = -1;
+
+/*
+ * Strictly increasing, holding every element of [first, last) and findable by contains.
+ */
+template <typename Set>
+bool check_sorted_superset(const Set & set, const int * first, const int * last)
+{
+	typename Set::const_iterator it(set.cbegin());
+	typename Set::const_iterator end(set.cend());
+	if (it != end) {
+		typename Set::const_iterator prev(it);
+		while (++it != end) {
+			if (!(prev->v < it->v)) {
+				return false;
+			}
+			prev = it;
+		}
+	}
+	for (typename Set::const_iterator i(set.cbegin()); i != end; ++i) {
+		if (!set.contains(*i)) {
+			return false;
+		}
+	}
+	for (; first != last; ++first) {
+		if (!set.contains(throwing_int(*first))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template <typename Set>
+void test_bulk_insert_exception_impl(kerbal::test::assert_record & record)
+{
+	const int present[] = {0, 10, 20, 30, 40};
+	const int inserted[] = {99, 5, 1, 25, 10, 45, 3};
+	const int inserted_sorted[] = {1, 3, 5, 10, 25, 45, 99};
+	const std::size_t present_n = sizeof(present) / sizeof(present[0]);
+	const std::size_t inserted_n = sizeof(inserted) / sizeof(inserted[0]);
+
+	for (int sorted = 0; sorted != 2; ++sorted) {
+		const int * src = sorted ? inserted_sorted : inserted;
+		bool completed = false;
+		for (int countdown = 1; !completed; ++countdown) {
+			throwing_int::countdown = -1;
+			Set set;
+			for (std::size_t i = 0; i != present_n; ++i) {
+				set.insert(throwing_int(present[i]));
+			}
+			throwing_int values[] = {src[0], src[1], src[2], src[3], src[4], src[5], src[6]};
+
+			throwing_int::countdown = countdown;
+			try {
+				if (sorted) {
+					set.unique_insert_sorted(values, values + inserted_n);
+				} else {
+					set.insert_bulk(values, values + inserted_n);
+				}
+				completed = true;
+			} catch (int) {
+			}
+			throwing_int::countdown = -1;
+
+			KERBAL_TEST_CHECK(check_sorted_superset(set, present, present + present_n));
+			if (completed) {
+				KERBAL_TEST_CHECK(check_sorted_superset(set, src, src + inserted_n));
+				KERBAL_TEST_CHECK_EQUAL(set.size(), static_cast<std::size_t>(11));
+			}
+		}
+	}
+}
+
+KERBAL_TEST_CASE(test_flat_set_insert_bulk_exception, "test flat_set::insert_bulk with throwing elements")
+{
+	test_bulk_insert_exception_impl<kerbal::container::flat_set<throwing_int> >(record);
+}
+
+KERBAL_TEST_CASE(test_static_flat_set_insert_bulk_exception, "test static_flat_set::insert_bulk with throwing elements")
+{
+	test_bulk_insert_exception_impl<kerbal::container::static_flat_set<throwing_int, 16> >(record);
+}
+
+int main(int argc, char * argv[])
+{
+	kerbal::test::run_all_test_case(argc, argv);
+}
@@ -0,0 +1,53 @@
+/**
+ * @file       test_heap.cpp
+ * @brief
+ * @date       2020-11-17
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#include <kerbal/algorithm/heap.hpp>
+#include <kerbal/algorithm/sort/sort.hpp>
+#include <kerbal/test/test.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <vector>
+
+template <typename Compare>
+void test_make_heap_bidirectional_impl(kerbal::test::assert_record & record, Compare cmp)
+{
+	std::size_t r = 1;
+	for (int n = 0; n < 200; ++n) {
+		for (int kind = 0; kind < 3; ++kind) {
+			std::vector<int> v;
+			for (int i = 0; i < n; ++i) {
+				r = r * 1103515245u + 12345u;
+				v.push_back(kind == 0 ? i : kind == 1 ? n - i : static_cast<int>((r >> 16) % 32));
+			}
+			std::list<int> l(v.begin(), v.end());
+			kerbal::algorithm::make_heap(l.begin(), l.end(), cmp);
+			KERBAL_TEST_CHECK(kerbal::algorithm::is_heap(l.begin(), l.end(), cmp));
+
+			std::vector<int> w(l.begin(), l.end());
+			kerbal::algorithm::sort(v.begin(), v.end());
+			kerbal::algorithm::sort(w.begin(), w.end());
+			KERBAL_TEST_CHECK(v == w);
+		}
+	}
+}
+
+KERBAL_TEST_CASE(test_make_heap_bidirectional, "test make_heap over bidirectional iterators")
+{
+	test_make_heap_bidirectional_impl(record, std::less<int>());
+	test_make_heap_bidirectional_impl(record, std::greater<int>());
+}
+
+int main(int argc, char * argv[])
+{
+	kerbal::test::run_all_test_case(argc, argv);
+}
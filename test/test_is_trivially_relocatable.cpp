@@ -0,0 +1,86 @@
+/**
+ * @file       test_is_trivially_relocatable.cpp
+ * @brief
+ * @date       2020-11-17
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#include <kerbal/type_traits/is_trivially_relocatable.hpp>
+#include <kerbal/compatibility/static_assert.hpp>
+#include <kerbal/test/test.hpp>
+
+struct relocatable_string
+{
+		char * p;
+
+		relocatable_string() :
+				p(NULL)
+		{
+		}
+
+		relocatable_string(const relocatable_string &) :
+				p(NULL)
+		{
+		}
+
+		~relocatable_string()
+		{
+		}
+};
+
+struct self_referencing
+{
+		self_referencing * self;
+
+		self_referencing() :
+				self(this)
+		{
+		}
+
+		self_referencing(const self_referencing &) :
+				self(this)
+		{
+		}
+};
+
+namespace kerbal
+{
+
+	namespace type_traits
+	{
+
+		template <>
+		struct is_trivially_relocatable<relocatable_string>: kerbal::type_traits::true_type
+		{
+		};
+
+	} // namespace type_traits
+
+} // namespace kerbal
+
+using kerbal::type_traits::is_trivially_relocatable;
+
+KERBAL_TEST_CASE(test_is_trivially_relocatable, "test is_trivially_relocatable")
+{
+	KERBAL_TEST_CHECK_STATIC(is_trivially_relocatable<int>::value);
+	KERBAL_TEST_CHECK_STATIC(is_trivially_relocatable<const int>::value);
+	KERBAL_TEST_CHECK_STATIC(is_trivially_relocatable<int[3]>::value);
+	KERBAL_TEST_CHECK_STATIC(is_trivially_relocatable<const int[3]>::value);
+	KERBAL_TEST_CHECK_STATIC(is_trivially_relocatable<volatile int[3]>::value);
+	KERBAL_TEST_CHECK_STATIC(is_trivially_relocatable<const volatile int[3]>::value);
+	KERBAL_TEST_CHECK_STATIC(is_trivially_relocatable<const int[2][3]>::value);
+
+	KERBAL_TEST_CHECK_STATIC(is_trivially_relocatable<relocatable_string>::value);
+	KERBAL_TEST_CHECK_STATIC(is_trivially_relocatable<const relocatable_string[3]>::value);
+	KERBAL_TEST_CHECK_STATIC(!is_trivially_relocatable<self_referencing>::value);
+	KERBAL_TEST_CHECK_STATIC(!is_trivially_relocatable<const self_referencing[3]>::value);
+}
+
+int main(int argc, char * argv[])
+{
+	kerbal::test::run_all_test_case(argc, argv);
+}
@@ -0,0 +1,83 @@
+/**
+ * @file       test_pairing_heap.cpp
+ * @brief
+ * @date       2020-11-17
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#include <kerbal/container/pairing_heap.hpp>
+#include <kerbal/test/test.hpp>
+
+/*
+ * Throws when the countdown reaches 0.
+ */
+struct throwing_less
+{
+		static int countdown;
+
+		bool operator()(int lhs, int rhs) const
+		{
+			if (countdown-- == 0) {
+				throw 0;
+			}
+			return lhs < rhs;
+		}
+};
+
+int throwing_less::countdown = -1;
+
+KERBAL_TEST_CASE(test_pairing_heap_throwing_compare, "test pairing_heap when the comparison throws")
+{
+#	if __cpp_exceptions
+	typedef kerbal::container::pairing_heap<int, throwing_less> heap;
+	heap h;
+	for (int i = 0; i < 5; ++i) {
+		h.push(i);
+	}
+	heap g;
+	g.push(7);
+
+	bool thrown = false;
+	throwing_less::countdown = 0;
+	try {
+		h.push(9);
+	} catch (int) {
+		thrown = true;
+	}
+	KERBAL_TEST_CHECK(thrown);
+	KERBAL_TEST_CHECK_EQUAL(h.size(), 5u);
+	KERBAL_TEST_CHECK_EQUAL(h.top(), 4);
+
+	thrown = false;
+	throwing_less::countdown = 0;
+	try {
+		h.merge(g);
+	} catch (int) {
+		thrown = true;
+	}
+	throwing_less::countdown = -1;
+	KERBAL_TEST_CHECK(thrown);
+	KERBAL_TEST_CHECK_EQUAL(h.size(), 5u);
+	KERBAL_TEST_CHECK_EQUAL(g.size(), 1u);
+	KERBAL_TEST_CHECK_EQUAL(g.top(), 7);
+
+	h.merge(g);
+	KERBAL_TEST_CHECK_EQUAL(h.size(), 6u);
+	KERBAL_TEST_CHECK(g.empty());
+	int expect[] = {7, 4, 3, 2, 1, 0};
+	for (int i = 0; i < 6; ++i) {
+		KERBAL_TEST_CHECK_EQUAL(h.top(), expect[i]);
+		h.pop();
+	}
+	KERBAL_TEST_CHECK(h.empty());
+#	endif
+}
+
+int main(int argc, char * argv[])
+{
+	kerbal::test::run_all_test_case(argc, argv);
+}
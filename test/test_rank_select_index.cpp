@@ -0,0 +1,75 @@
+/**
+ * @file       test_rank_select_index.cpp
+ * @brief
+ * @date       2020-11-17
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#include <kerbal/bitset/rank_select_index.hpp>
+#include <kerbal/bitset/static_bitset.hpp>
+#include <kerbal/test/test.hpp>
+
+#include <cstddef>
+
+/*
+ * All the bits set, so that the bits of the last block beyond the size are set too and are to be masked.
+ */
+template <typename Block>
+void test_narrow_block_full_impl(kerbal::test::assert_record & record)
+{
+	kerbal::bitset::static_bitset<5003, Block> bs;
+	bs.set();
+	kerbal::bitset::rank_select_index<Block> idx(bs);
+
+	KERBAL_TEST_CHECK_EQUAL(idx.count(), 5003u);
+	for (std::size_t pos = 0; pos <= 5003; pos += 7) {
+		KERBAL_TEST_CHECK_EQUAL(idx.rank1(pos), pos);
+	}
+	KERBAL_TEST_CHECK_EQUAL(idx.rank1(5003), 5003u);
+	KERBAL_TEST_CHECK_EQUAL(idx.select1(5002), 5002u);
+	KERBAL_TEST_CHECK_EQUAL(idx.select1(5003), 5003u);
+}
+
+template <typename Block>
+void test_narrow_block_sparse_impl(kerbal::test::assert_record & record)
+{
+	kerbal::bitset::static_bitset<5003, Block> bs;
+	std::size_t r = 1;
+	for (std::size_t pos = 0; pos < 5003; ++pos) {
+		r = r * 1103515245u + 12345u;
+		if ((r >> 16) % 3 == 0) {
+			bs.set(pos);
+		}
+	}
+	kerbal::bitset::rank_select_index<Block> idx(bs);
+
+	std::size_t ones = 0;
+	for (std::size_t pos = 0; pos < 5003; ++pos) {
+		KERBAL_TEST_CHECK_EQUAL(idx.rank1(pos), ones);
+		if (bs.test(pos)) {
+			KERBAL_TEST_CHECK_EQUAL(idx.select1(ones), pos);
+			++ones;
+		}
+	}
+	KERBAL_TEST_CHECK_EQUAL(idx.count(), ones);
+	KERBAL_TEST_CHECK_EQUAL(idx.rank1(5003), ones);
+}
+
+KERBAL_TEST_CASE(test_rank_select_index_narrow_block, "test rank_select_index over the blocks narrower than int")
+{
+	test_narrow_block_full_impl<unsigned char>(record);
+	test_narrow_block_full_impl<unsigned short>(record);
+	test_narrow_block_full_impl<unsigned int>(record);
+	test_narrow_block_sparse_impl<unsigned char>(record);
+	test_narrow_block_sparse_impl<unsigned short>(record);
+	test_narrow_block_sparse_impl<unsigned int>(record);
+}
+
+int main(int argc, char * argv[])
+{
+	kerbal::test::run_all_test_case(argc, argv);
+}
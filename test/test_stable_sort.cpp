@@ -0,0 +1,72 @@
+/**
+ * @file       test_stable_sort.cpp
+ * @brief
+ * @date       2020-11-17
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#include <kerbal/algorithm/sort/stable_sort.hpp>
+#include <kerbal/test/test.hpp>
+
+#include <cstddef>
+#include <list>
+#include <vector>
+
+struct keyed
+{
+		int key;
+		int id;
+};
+
+struct keyed_less
+{
+		bool operator()(const keyed & lhs, const keyed & rhs) const
+		{
+			return lhs.key < rhs.key;
+		}
+};
+
+/*
+ * Few distinct keys, so that each of them spreads over both halves of every merge.
+ */
+template <typename Container>
+void test_stable_sort_stability_impl(kerbal::test::assert_record & record)
+{
+	std::size_t r = 1;
+	for (int n = 0; n < 300; ++n) {
+		Container c;
+		for (int i = 0; i < n; ++i) {
+			r = r * 1103515245u + 12345u;
+			keyed k = {static_cast<int>((r >> 16) % 5), i};
+			c.push_back(k);
+		}
+		kerbal::algorithm::stable_sort(c.begin(), c.end(), keyed_less());
+
+		typename Container::const_iterator it(c.begin());
+		if (it == c.end()) {
+			continue;
+		}
+		typename Container::const_iterator prev(it);
+		for (++it; it != c.end(); prev = it, ++it) {
+			KERBAL_TEST_CHECK(prev->key <= it->key);
+			if (prev->key == it->key) {
+				KERBAL_TEST_CHECK(prev->id < it->id);
+			}
+		}
+	}
+}
+
+KERBAL_TEST_CASE(test_stable_sort_stability, "test stable_sort keeps the equivalent elements in order")
+{
+	test_stable_sort_stability_impl<std::vector<keyed> >(record);
+	test_stable_sort_stability_impl<std::list<keyed> >(record);
+}
+
+int main(int argc, char * argv[])
+{
+	kerbal::test::run_all_test_case(argc, argv);
+}
@@ -0,0 +1,97 @@
+/**
+ * @file       test_static_bitset.cpp
+ * @brief
+ * @date       2020-11-17
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#include <kerbal/bitset/static_bitset.hpp>
+#include <kerbal/compatibility/constexpr.hpp>
+#include <kerbal/numeric/bit.hpp>
+#include <kerbal/test/test.hpp>
+
+#include <cstddef>
+
+KERBAL_TEST_CASE(test_mask_narrow, "test numeric::mask of the types narrower than int")
+{
+	KERBAL_TEST_CHECK_EQUAL(kerbal::numeric::mask<unsigned char>(0), 0u);
+	KERBAL_TEST_CHECK_EQUAL(kerbal::numeric::mask<unsigned char>(2), 3u);
+	KERBAL_TEST_CHECK_EQUAL(kerbal::numeric::mask<unsigned char>(7), 0x7Fu);
+	KERBAL_TEST_CHECK_EQUAL(kerbal::numeric::mask<unsigned char>(8), 0xFFu);
+	KERBAL_TEST_CHECK_EQUAL(kerbal::numeric::mask<unsigned short>(2), 3u);
+	KERBAL_TEST_CHECK_EQUAL(kerbal::numeric::mask<unsigned short>(15), 0x7FFFu);
+	KERBAL_TEST_CHECK_EQUAL(kerbal::numeric::mask<unsigned short>(16), 0xFFFFu);
+	KERBAL_TEST_CHECK_EQUAL(kerbal::numeric::mask<unsigned int>(31), 0x7FFFFFFFu);
+
+#	if __cplusplus >= 201103L
+	KERBAL_TEST_CHECK_EQUAL_STATIC(kerbal::numeric::mask<unsigned char>(0), 0u);
+	KERBAL_TEST_CHECK_EQUAL_STATIC(kerbal::numeric::mask<unsigned char>(2), 3u);
+	KERBAL_TEST_CHECK_EQUAL_STATIC(kerbal::numeric::mask<unsigned char>(7), 0x7Fu);
+	KERBAL_TEST_CHECK_EQUAL_STATIC(kerbal::numeric::mask<unsigned char>(8), 0xFFu);
+	KERBAL_TEST_CHECK_EQUAL_STATIC(kerbal::numeric::mask<unsigned short>(2), 3u);
+	KERBAL_TEST_CHECK_EQUAL_STATIC(kerbal::numeric::mask<unsigned short>(15), 0x7FFFu);
+	KERBAL_TEST_CHECK_EQUAL_STATIC(kerbal::numeric::mask<unsigned short>(16), 0xFFFFu);
+	KERBAL_TEST_CHECK_EQUAL_STATIC(kerbal::numeric::mask<unsigned int>(31), 0x7FFFFFFFu);
+#	endif
+}
+
+struct set_bit_sum
+{
+		std::size_t sum;
+
+		KERBAL_CONSTEXPR14
+		set_bit_sum() :
+				sum(0)
+		{
+		}
+
+		KERBAL_CONSTEXPR14
+		void operator()(std::size_t pos)
+		{
+			sum += pos;
+		}
+};
+
+/*
+ * All the bits set, then some reset: the bits of the last block beyond N stay set and are to be masked.
+ */
+template <typename Block>
+KERBAL_CONSTEXPR14
+std::size_t narrow_block_digest()
+{
+	kerbal::bitset::static_bitset<10, Block> bs;
+	bs.set();
+	bs.reset(0);
+	bs.reset(9);
+	std::size_t r = bs.count();								// 8
+	r = r * 16 + bs.find_first();							// 1
+	r = r * 16 + bs.find_next(8);							// 10, none
+	r = r * 64 + bs.for_each_set_bit(set_bit_sum()).sum;	// 1 + ... + 8
+	bs >>= 2;
+	r = r * 16 + bs.count();								// 7
+	return r;
+}
+
+KERBAL_TEST_CASE(test_static_bitset_narrow_block, "test static_bitset over the blocks narrower than int")
+{
+	const std::size_t expected = (((8 * 16 + 1) * 16 + 10) * 64 + 36) * 16 + 7;
+
+	KERBAL_TEST_CHECK_EQUAL(narrow_block_digest<unsigned char>(), expected);
+	KERBAL_TEST_CHECK_EQUAL(narrow_block_digest<unsigned short>(), expected);
+	KERBAL_TEST_CHECK_EQUAL(narrow_block_digest<unsigned int>(), expected);
+
+#	if __cplusplus >= 201402L
+	KERBAL_TEST_CHECK_EQUAL_STATIC(narrow_block_digest<unsigned char>(), expected);
+	KERBAL_TEST_CHECK_EQUAL_STATIC(narrow_block_digest<unsigned short>(), expected);
+	KERBAL_TEST_CHECK_EQUAL_STATIC(narrow_block_digest<unsigned int>(), expected);
+#	endif
+}
+
+int main(int argc, char * argv[])
+{
+	kerbal::test::run_all_test_case(argc, argv);
+}
@@ -0,0 +1,48 @@
+/**
+ * @file       test_static_priority_queue.cpp
+ * @brief
+ * @date       2020-11-17
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#include <kerbal/container/static_priority_queue.hpp>
+#include <kerbal/compatibility/constexpr.hpp>
+#include <kerbal/test/test.hpp>
+
+KERBAL_CONSTEXPR14
+int push_range_top()
+{
+	const int a[] = {3, 1, 4, 1, 5, 9, 2, 6};
+	kerbal::container::static_priority_queue<int, 16> q;
+	q.push(a, a + 8);
+	return q.top();
+}
+
+KERBAL_TEST_CASE(test_static_priority_queue_push_range, "test static_priority_queue::push(first, last)")
+{
+	KERBAL_TEST_CHECK_EQUAL(push_range_top(), 9);
+
+#	if __cplusplus >= 201402L
+	KERBAL_TEST_CHECK_EQUAL_STATIC(push_range_top(), 9);
+#	endif
+
+	const int a[] = {3, 1, 4, 1, 5, 9, 2, 6};
+	kerbal::container::static_priority_queue<int, 16> q;
+	q.push(a, a + 8);
+	q.push_range(a, a + 4);
+	int expected[] = {9, 6, 5, 4, 4, 3, 3, 2, 1, 1, 1, 1};
+	for (int i = 0; i < 12; ++i) {
+		KERBAL_TEST_CHECK_EQUAL(q.top(), expected[i]);
+		q.pop();
+	}
+	KERBAL_TEST_CHECK(q.empty());
+}
+
+int main(int argc, char * argv[])
+{
+	kerbal::test::run_all_test_case(argc, argv);
+}
@@ -0,0 +1,172 @@
+/**
+ * @file       test_vector.cpp
+ * @brief
+ * @date       2020-11-17
+ * @author     Peter
+ * @copyright
+ *      Peter of [ThinkSpirit Laboratory](http://thinkspirit.org/)
+ *   of [Nanjing University of Information Science & Technology](http://www.nuist.edu.cn/)
+ *   all rights reserved
+ */
+
+#include <kerbal/container/vector.hpp>
+#include <kerbal/memory/allocator_traits.hpp>
+#include <kerbal/memory/malloc_allocator.hpp>
+#include <kerbal/test/test.hpp>
+#include <kerbal/type_traits/integral_constant.hpp>
+#include <kerbal/type_traits/is_trivially_relocatable.hpp>
+
+#include <cstddef>
+
+/*
+ * malloc_allocator counting the calls of reallocate.
+ */
+template <typename Tp>
+struct counting_malloc_allocator : kerbal::memory::malloc_allocator<Tp>
+{
+		static std::size_t reallocate_count;
+
+		template <typename Up>
+		struct rebind
+		{
+				typedef counting_malloc_allocator<Up> other;
+		};
+
+		Tp * reallocate(Tp * p, std::size_t old_n, std::size_t new_n)
+		{
+			++reallocate_count;
+			return kerbal::memory::malloc_allocator<Tp>::reallocate(p, old_n, new_n);
+		}
+};
+
+template <typename Tp>
+std::size_t counting_malloc_allocator<Tp>::reallocate_count = 0;
+
+/*
+ * Trivially relocatable by opt-in, but its copy throws when the countdown reaches 0.
+ */
+struct throwing_relocatable
+{
+		static int countdown;
+
+		int value;
+
+		throwing_relocatable(int value) :
+				value(value)
+		{
+		}
+
+		throwing_relocatable(const throwing_relocatable & src) :
+				value(src.value)
+		{
+			if (countdown-- == 0) {
+				throw 0;
+			}
+		}
+
+		throwing_relocatable& operator=(const throwing_relocatable & src)
+		{
+			this->value = src.value;
+			return *this;
+		}
+};
+
+int throwing_relocatable::countdown = -1;
+
+namespace kerbal
+{
+
+	namespace type_traits
+	{
+
+		template <>
+		struct is_trivially_relocatable<throwing_relocatable>: kerbal::type_traits::true_type
+		{
+		};
+
+	} // namespace type_traits
+
+#	if __cplusplus < 201103L
+
+	namespace memory
+	{
+
+		template <typename Tp>
+		struct allocator_has_reallocate<counting_malloc_allocator<Tp> >: kerbal::type_traits::true_type
+		{
+		};
+
+	} // namespace memory
+
+#	endif
+
+} // namespace kerbal
+
+KERBAL_TEST_CASE(test_vector_growth_reallocate, "test the growth of vector by the reallocate member of the allocator")
+{
+	typedef counting_malloc_allocator<int> allocator;
+	kerbal::container::vector<int, allocator> v;
+	allocator::reallocate_count = 0;
+
+	v.push_back(1);
+	for (int i = 0; i < 100; ++i) {
+		// the argument refers to an element which the reallocation may move
+		v.push_back(v[0]);
+	}
+	KERBAL_TEST_CHECK_EQUAL(v.size(), 101u);
+	KERBAL_TEST_CHECK(allocator::reallocate_count > 0);
+	KERBAL_TEST_CHECK(allocator::reallocate_count < 20);
+	for (std::size_t i = 0; i < v.size(); ++i) {
+		KERBAL_TEST_CHECK_EQUAL(v[i], 1);
+	}
+
+	v.shrink_to_fit();
+	v.insert(v.begin() + 3, 7);
+	KERBAL_TEST_CHECK_EQUAL(v.size(), 102u);
+	KERBAL_TEST_CHECK_EQUAL(v[2], 1);
+	KERBAL_TEST_CHECK_EQUAL(v[3], 7);
+	KERBAL_TEST_CHECK_EQUAL(v[4], 1);
+	KERBAL_TEST_CHECK_EQUAL(v.back(), 1);
+}
+
+KERBAL_TEST_CASE(test_vector_growth_reallocate_exception, "test the growth of vector by reallocate when an element throws")
+{
+#	if __cpp_exceptions
+	kerbal::container::vector<throwing_relocatable, counting_malloc_allocator<throwing_relocatable> > v;
+	for (int i = 0; i < 4; ++i) {
+		v.push_back(throwing_relocatable(i));
+	}
+	v.shrink_to_fit();
+
+	// the copy into the grown buffer throws, after the copy of the argument
+	throwing_relocatable::countdown = 1;
+	bool thrown = false;
+	try {
+		v.insert(v.begin() + 1, throwing_relocatable(9));
+	} catch (int) {
+		thrown = true;
+	}
+	throwing_relocatable::countdown = -1;
+	KERBAL_TEST_CHECK(thrown);
+	KERBAL_TEST_CHECK_EQUAL(v.size(), 4u);
+	for (int i = 0; i < 4; ++i) {
+		KERBAL_TEST_CHECK_EQUAL(v[i].value, i);
+	}
+#	endif
+}
+
+KERBAL_TEST_CASE(test_malloc_allocator_reallocate_zero, "test malloc_allocator::reallocate to 0 objects")
+{
+	kerbal::memory::malloc_allocator<int> alloc;
+	int * p = alloc.allocate(4);
+	p = alloc.reallocate(p, 4, 0);
+	KERBAL_TEST_CHECK(p == NULL);
+	p = alloc.reallocate(p, 0, 2);
+	KERBAL_TEST_CHECK(p != NULL);
+	alloc.deallocate(p, 2);
+}
+
+int main(int argc, char * argv[])
+{
+	kerbal::test::run_all_test_case(argc, argv);
+}